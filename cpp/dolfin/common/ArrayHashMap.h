@@ -0,0 +1,190 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dolfin
+{
+
+namespace common
+{
+
+/// This is a hash map from fixed-length keys of N integers to
+/// non-negative integer values. It uses open addressing with linear
+/// probing in flat arrays, so no memory is allocated per entry. It is
+/// designed for batch insertion and lookup of many small keys, e.g.
+/// the sorted vertex indices of mesh entities.
+
+template <std::size_t N>
+class ArrayHashMap
+{
+public:
+  /// Key type
+  typedef std::array<std::int32_t, N> key_type;
+
+  /// Create empty map with space for (at least) the given number of
+  /// entries before a rehash is required
+  explicit ArrayHashMap(std::size_t capacity = 0) { resize(capacity); }
+
+  /// Copy constructor
+  ArrayHashMap(const ArrayHashMap& map) = default;
+
+  /// Move constructor
+  ArrayHashMap(ArrayHashMap&& map) = default;
+
+  /// Destructor
+  ~ArrayHashMap() = default;
+
+  /// Copy assignment
+  ArrayHashMap& operator=(const ArrayHashMap& map) = default;
+
+  /// Move assignment
+  ArrayHashMap& operator=(ArrayHashMap&& map) = default;
+
+  /// Insert entry. Returns false, and leaves the map unchanged, if the
+  /// key is already present.
+  bool insert(const key_type& key, std::int32_t value)
+  {
+    assert(value >= 0);
+    if (2 * (_size + 1) > _keys.size())
+      rehash(2 * _keys.size());
+
+    std::size_t p = slot(key);
+    while (_values[p] != -1)
+    {
+      if (_keys[p] == key)
+        return false;
+      p = (p + 1) & _mask;
+    }
+
+    _keys[p] = key;
+    _values[p] = value;
+    ++_size;
+    return true;
+  }
+
+  /// Insert n entries. The keys are stored contiguously (row-major
+  /// n x N array). Keys that are already present are not inserted.
+  void insert(const std::int32_t* keys, const std::int32_t* values,
+              std::size_t n)
+  {
+    if (2 * (_size + n) > _keys.size())
+      resize(_size + n);
+
+    key_type key;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      std::copy(keys + i * N, keys + (i + 1) * N, key.begin());
+      insert(key, values[i]);
+    }
+  }
+
+  /// Find entry. Returns -1 if the key is not present.
+  std::int32_t find(const key_type& key) const
+  {
+    std::size_t p = slot(key);
+    while (_values[p] != -1)
+    {
+      if (_keys[p] == key)
+        return _values[p];
+      p = (p + 1) & _mask;
+    }
+    return -1;
+  }
+
+  /// Find n entries and write the values to the array values. The keys
+  /// are stored contiguously (row-major n x N array). The value is -1
+  /// for keys that are not present.
+  void find(const std::int32_t* keys, std::int32_t* values,
+            std::size_t n) const
+  {
+    key_type key;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      std::copy(keys + i * N, keys + (i + 1) * N, key.begin());
+      values[i] = find(key);
+    }
+  }
+
+  /// Number of entries
+  std::size_t size() const { return _size; }
+
+  /// Return memory (bytes) used by the table
+  std::size_t memory_usage() const
+  {
+    return _keys.capacity() * sizeof(key_type)
+           + _values.capacity() * sizeof(std::int32_t);
+  }
+
+  /// Remove all entries
+  void clear()
+  {
+    std::fill(_values.begin(), _values.end(), -1);
+    _size = 0;
+  }
+
+private:
+  // Increase table size, if required, to hold the given number of
+  // entries with a load factor of at most one half
+  void resize(std::size_t capacity)
+  {
+    std::size_t table_size = 16;
+    while (table_size < 2 * capacity)
+      table_size *= 2;
+    if (table_size > _keys.size())
+      rehash(table_size);
+  }
+
+  // Re-insert all entries into a table of given size (power of two)
+  void rehash(std::size_t table_size)
+  {
+    assert((table_size & (table_size - 1)) == 0);
+    std::vector<key_type> keys(table_size);
+    std::vector<std::int32_t> values(table_size, -1);
+    std::swap(keys, _keys);
+    std::swap(values, _values);
+    _mask = table_size - 1;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+      if (values[i] != -1)
+      {
+        std::size_t p = slot(keys[i]);
+        while (_values[p] != -1)
+          p = (p + 1) & _mask;
+        _keys[p] = keys[i];
+        _values[p] = values[i];
+      }
+    }
+  }
+
+  // Initial position of key in table
+  std::size_t slot(const key_type& key) const
+  {
+    std::uint64_t h = 0;
+    for (std::size_t i = 0; i < N; ++i)
+      h = (h ^ static_cast<std::uint32_t>(key[i])) * 0x9E3779B97F4A7C15ULL;
+    return (h ^ (h >> 32)) & _mask;
+  }
+
+  // Keys and values. An empty slot has value -1.
+  std::vector<key_type> _keys;
+  std::vector<std::int32_t> _values;
+
+  // Table size - 1
+  std::size_t _mask = 0;
+
+  // Number of entries
+  std::size_t _size = 0;
+};
+} // namespace common
+} // namespace dolfin
@@ -93,6 +93,13 @@ IndexMap::ghost_owners() const
 //----------------------------------------------------------------------------
 MPI_Comm IndexMap::mpi_comm() const { return _mpi_comm; }
 //----------------------------------------------------------------------------
+std::size_t IndexMap::memory_usage() const
+{
+  return sizeof(std::int64_t) * _all_ranges.size()
+         + sizeof(PetscInt) * _ghosts.size()
+         + sizeof(std::int32_t) * _ghost_owners.size();
+}
+//----------------------------------------------------------------------------
 void IndexMap::scatter_fwd(const std::vector<std::int64_t>& local_data,
                            std::vector<std::int64_t>& remote_data, int n) const
 {
@@ -98,6 +98,9 @@ public:
   /// Return MPI communicator
   MPI_Comm mpi_comm() const;
 
+  /// Return memory (bytes) used by the index map data
+  std::size_t memory_usage() const;
+
   /// Send n values for each index that is owned to processes that have
   /// the index as a ghost. The size of the input array local_data must
   /// be the same as size_local().
@@ -0,0 +1,163 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "memory.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <iterator>
+#include <sstream>
+
+using namespace dolfin;
+using namespace dolfin::common;
+
+namespace
+{
+// Running trackers
+std::vector<MemoryTracker*>& running_trackers()
+{
+  static std::vector<MemoryTracker*> trackers;
+  return trackers;
+}
+//-----------------------------------------------------------------------------
+// Peak memory registered for each task
+std::map<std::string, std::size_t>& task_peaks()
+{
+  static std::map<std::string, std::size_t> peaks;
+  return peaks;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+//-----------------------------------------------------------------------------
+std::size_t common::total(const MemoryUsage& usage)
+{
+  std::size_t bytes = 0;
+  for (auto& u : usage)
+    bytes += u.second;
+  return bytes;
+}
+//-----------------------------------------------------------------------------
+Table common::memory_report(
+    MPI_Comm comm,
+    const std::vector<std::pair<std::string, MemoryUsage>>& objects)
+{
+  // Pack local (row, value) data, using '\0' to separate row names
+  std::string keys;
+  std::vector<double> values;
+  for (auto& object : objects)
+  {
+    for (auto& u : object.second)
+    {
+      keys += object.first + ": " + u.first + '\0';
+      values.push_back(u.second);
+    }
+    keys += object.first + ": total" + '\0';
+    values.push_back(total(object.second));
+  }
+  for (auto& peak : MemoryTracker::peaks())
+  {
+    keys += "Peak: " + peak.first + '\0';
+    values.push_back(peak.second);
+  }
+
+  // Gather to rank zero
+  std::vector<std::string> keys_all;
+  std::vector<double> values_all;
+  MPI::gather(comm, keys, keys_all, 0);
+  MPI::gather(comm, values, values_all, 0);
+
+  Table table("Memory usage [MB]");
+  if (MPI::rank(comm) > 0)
+    return table;
+
+  // Reduce, keeping rows in the order they are first seen
+  std::vector<std::string> rows;
+  std::map<std::string, std::array<double, 4>> data;
+  const double* value = values_all.data();
+  for (const std::string& k : keys_all)
+  {
+    std::stringstream keys_stream(k);
+    std::string row;
+    while (std::getline(keys_stream, row, '\0'))
+    {
+      const double mb = *(value++) / (1024.0 * 1024.0);
+      auto it = data.insert({row, {{mb, mb, 0.0, 0.0}}});
+      if (it.second)
+        rows.push_back(row);
+      auto& d = it.first->second;
+      d[0] = std::min(d[0], mb);
+      d[1] = std::max(d[1], mb);
+      d[2] += mb;
+      d[3] += 1.0;
+    }
+  }
+  assert(value == values_all.data() + values_all.size());
+
+  for (const std::string& row : rows)
+  {
+    const auto& d = data[row];
+    table(row, "min") = d[0];
+    table(row, "max") = d[1];
+    table(row, "avg") = d[2] / d[3];
+    table(row, "total") = d[2];
+  }
+
+  return table;
+}
+//-----------------------------------------------------------------------------
+MemoryTracker::MemoryTracker(std::string task)
+    : _task(task), _current(0), _peak(0), _running(true)
+{
+  running_trackers().push_back(this);
+}
+//-----------------------------------------------------------------------------
+MemoryTracker::~MemoryTracker()
+{
+  if (_running)
+    stop();
+}
+//-----------------------------------------------------------------------------
+std::size_t MemoryTracker::stop()
+{
+  if (!_running)
+    return _peak;
+  _running = false;
+
+  // Trackers normally stop in reverse order of creation, but need not
+  std::vector<MemoryTracker*>& trackers = running_trackers();
+  auto it = std::find(trackers.rbegin(), trackers.rend(), this);
+  assert(it != trackers.rend());
+  trackers.erase(std::next(it).base());
+
+  auto peak = task_peaks().insert({_task, _peak});
+  if (!peak.second)
+    peak.first->second = std::max(peak.first->second, _peak);
+
+  return _peak;
+}
+//-----------------------------------------------------------------------------
+void MemoryTracker::allocate(std::size_t bytes)
+{
+  for (MemoryTracker* tracker : running_trackers())
+  {
+    tracker->_current += bytes;
+    if (tracker->_current > (std::ptrdiff_t)tracker->_peak)
+      tracker->_peak = tracker->_current;
+  }
+}
+//-----------------------------------------------------------------------------
+void MemoryTracker::deallocate(std::size_t bytes)
+{
+  for (MemoryTracker* tracker : running_trackers())
+    tracker->_current -= bytes;
+}
+//-----------------------------------------------------------------------------
+const std::map<std::string, std::size_t>& MemoryTracker::peaks()
+{
+  return task_peaks();
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,204 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <dolfin/common/MPI.h>
+#include <dolfin/common/Set.h>
+#include <dolfin/common/Table.h>
+#include <map>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dolfin
+{
+namespace common
+{
+
+/// Memory usage (in bytes) of the components of an object, e.g.
+/// {"topology 3-0": 1048576, "geometry points": 786432}
+typedef std::map<std::string, std::size_t> MemoryUsage;
+
+/// Return memory usage summed over all components
+std::size_t total(const MemoryUsage& usage);
+
+/// @cond
+template <typename T>
+std::size_t heap_memory(const T& x);
+template <typename T>
+std::size_t heap_memory(const std::vector<T>& x);
+template <typename T>
+std::size_t heap_memory(const Set<T>& x);
+template <typename T>
+std::size_t heap_memory(const std::set<T>& x);
+template <typename K, typename V>
+std::size_t heap_memory(const std::map<K, V>& x);
+template <typename T, int R, int C, int O, int MR, int MC>
+std::size_t heap_memory(const Eigen::Array<T, R, C, O, MR, MC>& x);
+/// @endcond
+
+/// Estimate of the heap memory (bytes) used by a (possibly nested)
+/// standard container or Eigen array. Tree-based containers are assumed to use a
+/// node of three pointers and a colour per entry.
+template <typename T>
+std::size_t heap_memory(const T&)
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Memory usage estimate not implemented for type");
+  return 0;
+}
+
+/// @cond
+template <typename T>
+std::size_t heap_memory(const std::vector<T>& x)
+{
+  std::size_t bytes = x.capacity() * sizeof(T);
+  if (!std::is_trivially_copyable<T>::value)
+    for (const T& v : x)
+      bytes += heap_memory(v);
+  return bytes;
+}
+
+template <typename T>
+std::size_t heap_memory(const Set<T>& x)
+{
+  return heap_memory(x.set());
+}
+
+template <typename T>
+std::size_t heap_memory(const std::set<T>& x)
+{
+  std::size_t bytes = x.size() * (sizeof(T) + 4 * sizeof(void*));
+  if (!std::is_trivially_copyable<T>::value)
+    for (const T& v : x)
+      bytes += heap_memory(v);
+  return bytes;
+}
+
+template <typename K, typename V>
+std::size_t heap_memory(const std::map<K, V>& x)
+{
+  std::size_t bytes = x.size() * (sizeof(K) + sizeof(V) + 4 * sizeof(void*));
+  for (auto& v : x)
+    bytes += heap_memory(v.first) + heap_memory(v.second);
+  return bytes;
+}
+
+template <typename T, int R, int C, int O, int MR, int MC>
+std::size_t heap_memory(const Eigen::Array<T, R, C, O, MR, MC>& x)
+{
+  if (R == Eigen::Dynamic or C == Eigen::Dynamic)
+    return x.size() * sizeof(T);
+  else
+    return 0;
+}
+/// @endcond
+
+/// Return a summary of the memory usage (in MB) of a list of (name,
+/// memory usage) objects and of the peaks recorded by
+/// _MemoryTracker_s, with the minimum, maximum and total over all
+/// processes. Collective on comm. The table is returned on rank 0, and
+/// an empty table on other ranks.
+///
+/// @param comm (MPI_Comm)
+///   MPI communicator
+/// @param objects (std::vector<std::pair<std::string, MemoryUsage>>)
+///   Name and memory usage of each object, e.g. {"Mesh",
+///   mesh.memory_usage()}
+/// @return Table
+///   Table of memory usage
+Table memory_report(
+    MPI_Comm comm,
+    const std::vector<std::pair<std::string, MemoryUsage>>& objects);
+
+/// This class records the peak memory, relative to the start, used by
+/// a task during its lifetime, and registers it under the given task.
+/// Memory is counted explicitly: code that allocates large data
+/// structures reports them with MemoryTracker::allocate and
+/// MemoryTracker::deallocate (or a _ScopedMemory_), which updates all
+/// running trackers. Allocations that are not reported are not
+/// counted.
+///
+///   {
+///     MemoryTracker tracker("Assemble sparsity pattern");
+///     ...
+///   }
+
+class MemoryTracker
+{
+public:
+  /// Start tracking memory for task
+  MemoryTracker(std::string task);
+
+  /// Copy constructor (deleted)
+  MemoryTracker(const MemoryTracker& tracker) = delete;
+
+  /// Destructor (stops tracking)
+  ~MemoryTracker();
+
+  /// Assignment operator (deleted)
+  MemoryTracker& operator=(const MemoryTracker& tracker) = delete;
+
+  /// Stop tracking and register the peak. Returns the peak (bytes)
+  /// used since start.
+  std::size_t stop();
+
+  /// Add bytes to the memory used by all running trackers
+  static void allocate(std::size_t bytes);
+
+  /// Subtract bytes from the memory used by all running trackers
+  static void deallocate(std::size_t bytes);
+
+  /// Return the largest peak (bytes) recorded for each task
+  static const std::map<std::string, std::size_t>& peaks();
+
+private:
+  // Task name
+  std::string _task;
+
+  // Memory currently used, and peak, since start
+  std::ptrdiff_t _current;
+  std::size_t _peak;
+
+  // True when tracker is running
+  bool _running;
+};
+
+/// Reports memory, e.g. of a work array, to the running
+/// _MemoryTracker_s for the lifetime of the object
+///
+///   std::vector<std::int32_t> perm = ...;
+///   ScopedMemory perm_memory(heap_memory(perm));
+
+class ScopedMemory
+{
+public:
+  /// Report bytes as allocated
+  explicit ScopedMemory(std::size_t bytes) : _bytes(bytes)
+  {
+    MemoryTracker::allocate(_bytes);
+  }
+
+  /// Copy constructor (deleted)
+  ScopedMemory(const ScopedMemory& memory) = delete;
+
+  /// Destructor (reports bytes as deallocated)
+  ~ScopedMemory() { MemoryTracker::deallocate(_bytes); }
+
+  /// Assignment operator (deleted)
+  ScopedMemory& operator=(const ScopedMemory& memory) = delete;
+
+private:
+  std::size_t _bytes;
+};
+
+} // namespace common
+} // namespace dolfin
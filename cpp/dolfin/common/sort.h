@@ -0,0 +1,88 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace dolfin
+{
+namespace common
+{
+
+/// Sort fixed-length keys of unsigned integers in ascending
+/// lexicographic order (key[0] most significant), and apply the same
+/// permutation to perm. This is a stable least significant digit
+/// radix sort with 16-bit digits. Digits that are equal for all keys,
+/// e.g. unused high-order bits, are skipped, so the cost is
+/// proportional to the number of significant bits in the keys.
+template <typename T, std::size_t N>
+void radix_sort(std::vector<std::array<T, N>>& keys,
+                std::vector<std::int32_t>& perm)
+{
+  static_assert(std::is_unsigned<T>::value,
+                "Radix sort requires unsigned integer keys");
+  assert(keys.size() == perm.size());
+
+  constexpr int bits = 16;
+  constexpr std::size_t num_buckets = 1 << bits;
+  constexpr T mask = num_buckets - 1;
+  constexpr int num_digits = (8 * sizeof(T) + bits - 1) / bits;
+
+  const std::size_t size = keys.size();
+  std::vector<std::array<T, N>> keys_tmp(size);
+  std::vector<std::int32_t> perm_tmp(size);
+  std::vector<std::size_t> offsets(num_buckets + 1);
+  for (int w = N - 1; w >= 0; --w)
+  {
+    for (int d = 0; d < num_digits; ++d)
+    {
+      const int shift = d * bits;
+
+      // Count keys in each bucket
+      std::fill(offsets.begin(), offsets.end(), 0);
+      for (const auto& key : keys)
+        ++offsets[((key[w] >> shift) & mask) + 1];
+
+      // Nothing to do if all keys fall in the same bucket
+      if (std::find(offsets.begin(), offsets.end(), size) != offsets.end())
+        continue;
+
+      // Scatter keys to their buckets, preserving order within each
+      // bucket
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        const std::size_t pos = offsets[(keys[i][w] >> shift) & mask]++;
+        keys_tmp[pos] = keys[i];
+        perm_tmp[pos] = perm[i];
+      }
+      std::swap(keys, keys_tmp);
+      std::swap(perm, perm_tmp);
+    }
+  }
+}
+
+/// Return the permutation that stably sorts fixed-length keys of
+/// unsigned integers in ascending lexicographic order. The keys are
+/// sorted in place.
+template <typename T, std::size_t N>
+std::vector<std::int32_t> radix_argsort(std::vector<std::array<T, N>>& keys)
+{
+  std::vector<std::int32_t> perm(keys.size());
+  std::iota(perm.begin(), perm.end(), 0);
+  radix_sort(keys, perm);
+  return perm;
+}
+
+} // namespace common
+} // namespace dolfin
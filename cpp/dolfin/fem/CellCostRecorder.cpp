@@ -0,0 +1,96 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "CellCostRecorder.h"
+#include <algorithm>
+#include <cmath>
+#include <dolfin/common/MPI.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/MeshFunction.h>
+#include <numeric>
+
+using namespace dolfin;
+using namespace dolfin::fem;
+
+//-----------------------------------------------------------------------------
+CellCostRecorder::CellCostRecorder(std::shared_ptr<const mesh::Mesh> mesh)
+    : _mesh(mesh)
+{
+  assert(_mesh);
+  const int tdim = _mesh->topology().dim();
+  _costs.resize(_mesh->num_entities(tdim), 0.0);
+}
+//-----------------------------------------------------------------------------
+void CellCostRecorder::reset() { std::fill(_costs.begin(), _costs.end(), 0.0); }
+//-----------------------------------------------------------------------------
+std::vector<std::size_t> CellCostRecorder::weights(std::size_t scale) const
+{
+  const MPI_Comm mpi_comm = _mesh->mpi_comm();
+  const int tdim = _mesh->topology().dim();
+  const std::int32_t num_owned = _mesh->topology().ghost_offset(tdim);
+
+  // Average cost of an owned cell
+  const double local_cost
+      = std::accumulate(_costs.begin(), _costs.begin() + num_owned, 0.0);
+  const double total_cost = MPI::sum(mpi_comm, local_cost);
+  const std::int64_t num_cells
+      = MPI::sum(mpi_comm, (std::int64_t)num_owned);
+  const double mean_cost = num_cells > 0 ? total_cost / num_cells : 0.0;
+
+  // Unit weights if nothing has been recorded
+  std::vector<std::size_t> w(num_owned, 1);
+  if (mean_cost > 0.0)
+  {
+    for (std::int32_t c = 0; c < num_owned; ++c)
+    {
+      w[c] = std::max(
+          (std::size_t)1,
+          (std::size_t)std::llround(_costs[c] / mean_cost * scale));
+    }
+  }
+
+  return w;
+}
+//-----------------------------------------------------------------------------
+std::map<std::size_t, double> CellCostRecorder::subdomain_costs(
+    const mesh::MeshFunction<std::size_t>& cell_domains) const
+{
+  const int tdim = _mesh->topology().dim();
+  if (cell_domains.dim() != tdim)
+    throw std::runtime_error("Subdomain markers must be cell markers");
+  if (cell_domains.mesh() != _mesh)
+    throw std::runtime_error("Subdomain markers are defined on another mesh");
+
+  // Sum costs of owned cells locally
+  const std::int32_t num_owned = _mesh->topology().ghost_offset(tdim);
+  const std::size_t* markers = cell_domains.values();
+  std::map<std::size_t, double> local_costs;
+  for (std::int32_t c = 0; c < num_owned; ++c)
+    local_costs[markers[c]] += _costs[c];
+
+  // Gather (marker, cost) pairs from all processes
+  std::vector<std::size_t> local_markers;
+  std::vector<double> local_values;
+  for (const auto& m : local_costs)
+  {
+    local_markers.push_back(m.first);
+    local_values.push_back(m.second);
+  }
+  std::vector<std::vector<std::size_t>> all_markers;
+  std::vector<std::vector<double>> all_values;
+  MPI::all_gather(_mesh->mpi_comm(), local_markers, all_markers);
+  MPI::all_gather(_mesh->mpi_comm(), local_values, all_values);
+
+  // Sum over processes in process order, so that the result is the
+  // same on all processes
+  std::map<std::size_t, double> costs;
+  for (std::size_t p = 0; p < all_markers.size(); ++p)
+    for (std::size_t i = 0; i < all_markers[p].size(); ++i)
+      costs[all_markers[p][i]] += all_values[p][i];
+
+  return costs;
+}
+//-----------------------------------------------------------------------------
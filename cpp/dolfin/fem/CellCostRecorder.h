@@ -0,0 +1,82 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace dolfin
+{
+
+namespace mesh
+{
+class Mesh;
+template <typename T>
+class MeshFunction;
+} // namespace mesh
+
+namespace fem
+{
+
+/// This class records the time spent in the element kernels of each
+/// cell during assembly. Facet kernels are charged to the cells
+/// attached to the facet. Attach a recorder to a Form with
+/// Form::set_cell_cost_recorder, assemble as usual, and pass weights()
+/// to mesh::Partitioning::build_distributed_mesh when the mesh is next
+/// partitioned.
+
+class CellCostRecorder
+{
+public:
+  /// Create recorder for the cells of a mesh, with zero cost
+  explicit CellCostRecorder(std::shared_ptr<const mesh::Mesh> mesh);
+
+  /// Mesh whose cells are recorded
+  std::shared_ptr<const mesh::Mesh> mesh() const { return _mesh; }
+
+  /// Current time in seconds, for measuring kernel times
+  static double now()
+  {
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  /// Add time (in seconds) to the cost of a cell
+  void add(std::int32_t cell, double time) { _costs[cell] += time; }
+
+  /// Accumulated cost (in seconds) of each local cell, including ghost
+  /// cells (which are not assembled over, so have zero cost)
+  const std::vector<double>& costs() const { return _costs; }
+
+  /// Reset the cost of all cells to zero
+  void reset();
+
+  /// Compute integer weights for the owned cells, for use by a mesh
+  /// partitioner. The weights are proportional to the cell costs,
+  /// scaled such that the average weight over all processes is equal
+  /// to scale. Each weight is at least one. Collective.
+  std::vector<std::size_t> weights(std::size_t scale = 100) const;
+
+  /// Compute the total cost (in seconds) of the owned cells with each
+  /// marker value, summed over all processes. Collective.
+  std::map<std::size_t, double>
+  subdomain_costs(const mesh::MeshFunction<std::size_t>& cell_domains) const;
+
+private:
+  // The mesh
+  std::shared_ptr<const mesh::Mesh> _mesh;
+
+  // Cost of each cell
+  std::vector<double> _costs;
+};
+} // namespace fem
+} // namespace dolfin
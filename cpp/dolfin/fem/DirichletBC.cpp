@@ -13,6 +13,7 @@
 #include <dolfin/function/Function.h>
 #include <dolfin/function/FunctionSpace.h>
 #include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/ConnectivityLease.h>
 #include <dolfin/mesh/Facet.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshFunction.h>
@@ -108,32 +109,22 @@ get_remote_bcs(const common::IndexMap& map, const common::IndexMap& map_g,
   return dof_dof_g;
 }
 //-----------------------------------------------------------------------------
-// Return list of facet indices that are marked
+// Return list of facet indices that are marked. The facets, and the
+// facet-cell connectivity used for boundary detection, are held by
+// facet_cell.
 std::vector<std::int32_t> marked_facets(
-    const mesh::Mesh& mesh,
+    const mesh::ConnectivityLease& facet_cell,
     const std::function<EigenArrayXb(
         const Eigen::Ref<
             const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>&,
         bool only_boundary)>& mark)
 {
+  const mesh::Mesh& mesh = facet_cell.mesh();
   const int tdim = mesh.topology().dim();
-  mesh.create_entities(tdim - 1);
 
   // Marked facet indices
   std::vector<std::int32_t> facets;
 
-  // Get the dimension of the entities we are marking
-  const int dim = tdim - 1;
-
-  // Compute connectivities for boundary detection, if necessary
-  if (dim < tdim)
-  {
-    mesh.create_entities(dim);
-    if (dim != tdim - 1)
-      mesh.create_connectivity(dim, tdim - 1);
-    mesh.create_connectivity(tdim - 1, tdim);
-  }
-
   // Find all vertices on boundary
   // Set all to -1 (interior) to start with
   // If a vertex is on the boundary, give it an index from [0, count)
@@ -300,9 +291,9 @@ compute_bc_dofs_topological(const function::FunctionSpace& V,
     dofmap_g = Vg->dofmap().get();
   }
 
-  // Initialise facet-cell connectivity
-  mesh.create_entities(tdim);
-  mesh.create_connectivity(tdim - 1, tdim);
+  // Initialise facet-cell connectivity (freed on return if computed
+  // here)
+  mesh::ConnectivityLease facet_cell(mesh, tdim - 1, tdim);
 
   // Allocate space
   const std::size_t num_facet_dofs = dofmap.num_entity_closure_dofs(tdim - 1);
@@ -355,9 +346,16 @@ DirichletBC::DirichletBC(
             const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>&,
         bool only_boundary)>& mark,
     Method method)
-    : DirichletBC(V, g, marked_facets(*V->mesh(), mark), method)
+    : DirichletBC(V, g,
+                  marked_facets(mesh::ConnectivityLease(
+                                    *V->mesh(), V->mesh()->topology().dim() - 1,
+                                    V->mesh()->topology().dim()),
+                                mark),
+                  method)
 {
-  // Do nothing
+  // Do nothing. The temporary facet-cell lease lives until the
+  // delegated constructor has computed the boundary dofs, so the
+  // facets are computed at most once.
 }
 //-----------------------------------------------------------------------------
 DirichletBC::DirichletBC(std::shared_ptr<const function::FunctionSpace> V,
@@ -11,6 +11,7 @@
 #include <dolfin/function/FunctionSpace.h>
 #include <dolfin/la/PETScMatrix.h>
 #include <dolfin/la/SparsityPattern.h>
+#include <dolfin/mesh/ConnectivityLease.h>
 #include <dolfin/mesh/Edge.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshIterator.h>
@@ -41,8 +42,11 @@ DiscreteOperators::build_gradient(const function::FunctionSpace& V0,
         "do not share the same mesh");
   }
 
+  // Edges are needed only while the operator is built, so lease them
+  // with the edge-cell connectivity (freed on return if computed here)
+  mesh::ConnectivityLease edge_cell(mesh, 1, mesh.topology().dim());
+
   // Check that V0 is a (lowest-order) edge basis
-  mesh.create_entities(1);
   if (V0.dim() != mesh.num_entities_global(1))
   {
     throw std::runtime_error(
@@ -70,9 +74,6 @@ DiscreteOperators::build_gradient(const function::FunctionSpace& V0,
   Eigen::Array<std::size_t, Eigen::Dynamic, 1> local_to_global_map1
       = V1.dofmap()->tabulate_local_to_global_dofs();
 
-  // Initialize edge -> vertex connections
-  mesh.create_connectivity(1, 0);
-
   // Copy index maps from dofmaps
   std::array<std::shared_ptr<const common::IndexMap>, 2> index_maps
       = {{V0.dofmap()->index_map(), V1.dofmap()->index_map()}};
@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <dolfin/common/IndexMap.h>
 #include <dolfin/common/MPI.h>
+#include <dolfin/common/memory.h>
 #include <dolfin/common/types.h>
 #include <dolfin/mesh/Cell.h>
 #include <dolfin/mesh/MeshIterator.h>
@@ -336,6 +337,17 @@ DofMap::dof_array() const
       _dofmap.data(), _dofmap.size());
 }
 //-----------------------------------------------------------------------------
+std::map<std::string, std::size_t> DofMap::memory_usage() const
+{
+  std::map<std::string, std::size_t> usage
+      = {{"cell dofs", common::heap_memory(_dofmap)},
+         {"global nodes", common::heap_memory(_global_nodes)}};
+  if (_index_map)
+    usage["index map"] = _index_map->memory_usage();
+
+  return usage;
+}
+//-----------------------------------------------------------------------------
 std::string DofMap::str(bool verbose) const
 {
   std::stringstream s;
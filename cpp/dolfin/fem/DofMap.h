@@ -12,6 +12,7 @@
 #include <Eigen/Dense>
 #include <array>
 #include <cstdlib>
+#include <map>
 #include <memory>
 #include <set>
 #include <utility>
@@ -218,6 +219,10 @@ public:
   /// Return the map
   std::shared_ptr<const common::IndexMap> index_map() const;
 
+  /// Return memory (bytes) used by the cell dofs, global nodes and
+  /// index map
+  std::map<std::string, std::size_t> memory_usage() const;
+
   /// Return informal string representation (pretty-print)
   ///
   /// @param     verbose (bool)
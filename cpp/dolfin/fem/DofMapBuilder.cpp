@@ -7,6 +7,7 @@
 #include "DofMapBuilder.h"
 #include "DofMap.h"
 #include "ElementDofLayout.h"
+#include <algorithm>
 #include <cstdlib>
 #include <dolfin/common/IndexMap.h>
 #include <dolfin/common/MPI.h>
@@ -15,11 +16,11 @@
 #include <dolfin/graph/BoostGraphOrdering.h>
 #include <dolfin/graph/GraphBuilder.h>
 #include <dolfin/graph/SCOTCH.h>
-#include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/Connectivity.h>
 #include <dolfin/mesh/DistributedMeshTools.h>
-#include <dolfin/mesh/Facet.h>
 #include <dolfin/mesh/Mesh.h>
-#include <dolfin/mesh/MeshIterator.h>
+#include <dolfin/mesh/Topology.h>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <random>
@@ -72,9 +73,10 @@ struct DofMapStructure
 void get_cell_entities(
     std::vector<std::vector<std::int32_t>>& entity_indices_local,
     std::vector<std::vector<std::int64_t>>& entity_indices_global,
-    const mesh::Cell& cell, const std::vector<bool>& needs_mesh_entities)
+    const mesh::Topology& topology, std::int32_t c,
+    const std::vector<mesh::ConnectivityView>& cell_entities,
+    const std::vector<bool>& needs_mesh_entities)
 {
-  const mesh::Topology& topology = cell.mesh().topology();
   const int D = topology.dim();
   for (int d = 0; d < D; ++d)
   {
@@ -83,19 +85,23 @@ void get_cell_entities(
       assert(topology.have_global_indices(d));
       const std::vector<std::int64_t>& global_indices
           = topology.global_indices(d);
-      const std::int32_t* entities = cell.entities(d);
-      for (std::size_t i = 0; i < cell.num_entities(d); ++i)
+      const std::int32_t* entities = cell_entities[d].connections(c);
+      const int num_entities = cell_entities[d].size(c);
+      for (int i = 0; i < num_entities; ++i)
       {
         entity_indices_local[d][i] = entities[i];
         entity_indices_global[d][i] = global_indices[entities[i]];
       }
     }
   }
-  // Handle cell index separately because cell.entities(D) doesn't work.
+  // Handle cell index separately because there is no D - D connectivity
   if (needs_mesh_entities[D])
   {
-    entity_indices_global[D][0] = cell.global_index();
-    entity_indices_local[D][0] = cell.index();
+    const std::vector<std::int64_t>& global_indices
+        = topology.global_indices(D);
+    entity_indices_global[D][0]
+        = global_indices.empty() ? -1 : global_indices[c];
+    entity_indices_local[D][0] = c;
   }
 }
 //-----------------------------------------------------------------------------
@@ -336,12 +342,20 @@ DofMapStructure build_basic_dofmap(const mesh::Mesh& mesh,
   const std::vector<std::vector<std::set<int>>>& entity_dofs
       = element_dof_layout.entity_dofs();
 
+  // Cell - entity connectivities for the required entities
+  const mesh::Topology& topology = mesh.topology();
+  std::vector<mesh::ConnectivityView> cell_entities(D);
+  for (int d = 0; d < D; ++d)
+    if (needs_entities[d])
+      cell_entities[d] = topology.connectivity_view(D, d);
+
   // Build dofmaps from ElementDofmap
-  for (auto& cell : mesh::MeshRange<mesh::Cell>(mesh, mesh::MeshRangeType::ALL))
+  const std::int32_t num_cells = mesh.num_entities(D);
+  for (std::int32_t c = 0; c < num_cells; ++c)
   {
     // Get local (process) and global cell entity indices
-    get_cell_entities(entity_indices_local, entity_indices_global, cell,
-                      needs_entities);
+    get_cell_entities(entity_indices_local, entity_indices_global, topology,
+                      c, cell_entities, needs_entities);
 
     // Iterate over topological dimensions
     std::int32_t offset_local = 0;
@@ -371,7 +385,7 @@ DofMapStructure build_basic_dofmap(const mesh::Mesh& mesh,
           const std::int32_t count = std::distance(e_dofs->begin(), dof_local);
           const std::int32_t dof
               = offset_local + num_entity_dofs * e_index_local + count;
-          dofmap.dof(cell.index(), *dof_local) = dof;
+          dofmap.dof(c, *dof_local) = dof;
           dofmap.global_indices[dof]
               = offset_global + num_entity_dofs * e_index_global + count;
         }
@@ -402,17 +416,30 @@ compute_sharing_markers(const DofMapStructure& dofmap,
   const std::vector<std::set<int>>& facet_table
       = element_dof_layout.entity_closure_dofs()[D - 1];
 
+  // Shared cells (null if there are none)
+  const mesh::Topology& topology = mesh.topology();
+  const mesh::SharedEntities* shared_cells
+      = topology.have_shared_entities(D) ? &topology.shared_entities(D)
+                                         : nullptr;
+
   // Mark dofs associated ghost cells as ghost dofs, provisionally
+  const std::int32_t num_cells = mesh.num_entities(D);
+  const std::int32_t cell_ghost_offset = topology.ghost_offset(D);
+  const std::int32_t facet_ghost_offset = topology.ghost_offset(D - 1);
+  const mesh::ConnectivityView cell_facet_ghost
+      = (cell_ghost_offset < num_cells) ? topology.connectivity_view(D, D - 1)
+                                        : mesh::ConnectivityView();
   bool has_ghost_cells = false;
-  for (auto& c : mesh::MeshRange<mesh::Cell>(mesh, mesh::MeshRangeType::ALL))
+  for (std::int32_t c = 0; c < num_cells; ++c)
   {
-    const PetscInt* cell_nodes = dofmap.dofs(c.index());
-    if (c.is_shared())
+    const PetscInt* cell_nodes = dofmap.dofs(c);
+    const bool ghost = c >= cell_ghost_offset;
+    if (shared_cells and shared_cells->contains(c))
     {
-      const sharing_marker status = (c.is_ghost())
+      const sharing_marker status = ghost
                                         ? sharing_marker::ghost
                                         : sharing_marker::interior_ghost_layer;
-      for (std::int32_t i = 0; i < dofmap.num_dofs(c.index()); ++i)
+      for (std::int32_t i = 0; i < dofmap.num_dofs(c); ++i)
       {
         // Ensure not already set (for R space)
         if (shared_nodes[cell_nodes[i]] == sharing_marker::interior)
@@ -421,14 +448,15 @@ compute_sharing_markers(const DofMapStructure& dofmap,
     }
 
     // Change all non-ghost facet dofs of ghost cells to boundary dofs
-    if (c.is_ghost())
+    if (ghost)
     {
       has_ghost_cells = true;
-      for (auto& f : mesh::EntityRange<mesh::Facet>(c))
+      const std::int32_t* facets = cell_facet_ghost.connections(c);
+      for (int i = 0; i < cell_facet_ghost.size(c); ++i)
       {
-        if (!f.is_ghost())
+        if (facets[i] < facet_ghost_offset)
         {
-          const std::set<int>& facet_nodes = facet_table[c.index(f)];
+          const std::set<int>& facet_nodes = facet_table[i];
           for (auto facet_node : facet_nodes)
           {
             const int facet_node_local = cell_nodes[facet_node];
@@ -442,22 +470,35 @@ compute_sharing_markers(const DofMapStructure& dofmap,
   if (has_ghost_cells)
     return shared_nodes;
 
+  // Shared facets (null if there are none)
+  const mesh::SharedEntities* shared_facets
+      = topology.have_shared_entities(D - 1)
+            ? &topology.shared_entities(D - 1)
+            : nullptr;
+
   // Mark nodes on inter-process boundary
-  for (auto& f : mesh::MeshRange<mesh::Facet>(mesh, mesh::MeshRangeType::ALL))
+  const mesh::ConnectivityView facet_cell
+      = topology.connectivity_view(D - 1, D);
+  const mesh::ConnectivityView cell_facet
+      = topology.connectivity_view(D, D - 1);
+  for (std::int32_t f = 0; f < facet_cell.num_entities(); ++f)
   {
     // Skip if facet is not shared
     // NOTE: second test is for periodic problems
-    if (!f.is_shared() and f.num_entities(D) == 2)
+    const bool shared = shared_facets and shared_facets->contains(f);
+    if (!shared and facet_cell.size(f) == 2)
       continue;
 
     // Get cell to which facet belongs (pick first)
-    const mesh::Cell cell0(mesh, f.entities(D)[0]);
+    const std::int32_t cell0 = facet_cell.connections(f)[0];
 
     // Get dofs (process-wise indices) on cell
-    const PetscInt* cell_nodes = dofmap.dofs(cell0.index());
+    const PetscInt* cell_nodes = dofmap.dofs(cell0);
 
     // Get dofs which are on the facet
-    const std::set<int>& facet_nodes = facet_table[cell0.index(f)];
+    const int local_facet = cell_facet.local_index(cell0, f);
+    assert(local_facet >= 0);
+    const std::set<int>& facet_nodes = facet_table[local_facet];
 
     // Mark boundary nodes and insert into map
     for (auto facet_node : facet_nodes)
@@ -472,10 +513,13 @@ compute_sharing_markers(const DofMapStructure& dofmap,
   return shared_nodes;
 }
 //-----------------------------------------------------------------------------
-// Compute re-ordering map of indices.
+// Compute re-ordering map of indices. Unowned nodes are placed after
+// the owned nodes, ordered by the ghost cell layer (see
+// mesh::Topology::ghost_layer_offsets) of the nodes.
 std::vector<std::int32_t>
 compute_reordering_map(const DofMapStructure& dofmap,
-                       const std::vector<ownership>& node_ownership)
+                       const std::vector<ownership>& node_ownership,
+                       const std::vector<std::int32_t>& ghost_layer_offsets)
 {
   // Create map from old index to new contiguous numbering for locally
   // owned dofs. Set to -1 for unowned dofs.
@@ -537,9 +581,28 @@ compute_reordering_map(const DofMapStructure& dofmap,
                              + "' is unknown");
   }
 
+  // Compute layer of each node, i.e. the lowest ghost cell layer of
+  // the cells that contain the node (0 for owned cells)
+  std::vector<std::int32_t> node_layer(node_ownership.size(), 0);
+  if (!ghost_layer_offsets.empty())
+  {
+    std::fill(node_layer.begin(), node_layer.end(),
+              std::numeric_limits<std::int32_t>::max());
+    for (std::int32_t cell = 0; cell < dofmap.num_cells(); ++cell)
+    {
+      const std::int32_t layer
+          = std::upper_bound(ghost_layer_offsets.begin(),
+                             ghost_layer_offsets.end(), cell)
+            - ghost_layer_offsets.begin();
+      const PetscInt* nodes = dofmap.dofs(cell);
+      for (std::int32_t i = 0; i < dofmap.num_dofs(cell); ++i)
+        node_layer[nodes[i]] = std::min(node_layer[nodes[i]], layer);
+    }
+  }
+
   // Reconstruct remaped nodes, with -1 for unowned
   std::vector<int> old_to_new(node_ownership.size(), -1);
-  std::int32_t unowned_pos = owned_size;
+  std::vector<std::int32_t> unowned_nodes;
   for (std::size_t old_index = 0; old_index < node_ownership.size();
        ++old_index)
   {
@@ -547,10 +610,7 @@ compute_reordering_map(const DofMapStructure& dofmap,
 
     // Put nodes that are not owned at the end, otherwise re-number
     if (index < 0)
-    {
-      assert(old_index < old_to_new.size());
-      old_to_new[old_index] = unowned_pos++;
-    }
+      unowned_nodes.push_back(old_index);
     else
     {
       assert(old_index < old_to_new.size());
@@ -558,6 +618,15 @@ compute_reordering_map(const DofMapStructure& dofmap,
     }
   }
 
+  // Number unowned nodes by layer
+  std::stable_sort(unowned_nodes.begin(), unowned_nodes.end(),
+                   [&node_layer](std::int32_t a, std::int32_t b) {
+                     return node_layer[a] < node_layer[b];
+                   });
+  std::int32_t unowned_pos = owned_size;
+  for (std::int32_t old_index : unowned_nodes)
+    old_to_new[old_index] = unowned_pos++;
+
   return old_to_new;
 }
 //-----------------------------------------------------------------------------
@@ -700,9 +769,10 @@ DofMapBuilder::build(const mesh::Mesh& mesh,
   // Build re-ordering map for data locality. Owned dofs are re-ordred
   // via an ordering algorithm and placed at start, [0, ...,
   // num_owned_nodes -1]. Unowned dofs are placed at end of the
-  // re-ordered list. [num_owned_nodes, ..., num_nodes -1].
-  const std::vector<std::int32_t> old_to_new
-      = compute_reordering_map(node_graph0, node_ownership0);
+  // re-ordered list. [num_owned_nodes, ..., num_nodes -1], ordered by
+  // ghost cell layer.
+  const std::vector<std::int32_t> old_to_new = compute_reordering_map(
+      node_graph0, node_ownership0, mesh.topology().ghost_layer_offsets());
 
   // Compute process offset for owned nodes. Global indices for owned
   // dofs are (index_local + process_offset)
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "Form.h"
+#include "CellCostRecorder.h"
 #include "GenericDofMap.h"
 #include <dolfin/common/types.h>
 #include <dolfin/fem/CoordinateMapping.h>
@@ -165,6 +166,11 @@ std::size_t Form::max_element_tensor_size() const
 //-----------------------------------------------------------------------------
 void Form::set_mesh(std::shared_ptr<const mesh::Mesh> mesh)
 {
+  if (_cost_recorder and _cost_recorder->mesh() != mesh)
+  {
+    throw std::runtime_error(
+        "Cannot set mesh. Cell cost recorder is for a different mesh.");
+  }
   _mesh = mesh;
   // Set markers for default integrals
   _integrals.set_default_domains(*_mesh);
@@ -228,3 +234,20 @@ std::shared_ptr<const fem::CoordinateMapping> Form::coordinate_mapping() const
   return _coord_mapping;
 }
 //-----------------------------------------------------------------------------
+void Form::set_cell_cost_recorder(std::shared_ptr<CellCostRecorder> recorder)
+{
+  // The recorder stores one cost per cell of its mesh, indexed by the
+  // cells assembled over
+  if (recorder and _mesh and recorder->mesh() != _mesh)
+  {
+    throw std::runtime_error(
+        "Cannot set cell cost recorder. Recorder is for a different mesh.");
+  }
+  _cost_recorder = recorder;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<CellCostRecorder> Form::cell_cost_recorder() const
+{
+  return _cost_recorder;
+}
+//-----------------------------------------------------------------------------
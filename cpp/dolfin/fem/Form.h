@@ -23,6 +23,7 @@ namespace dolfin
 
 namespace fem
 {
+class CellCostRecorder;
 class CoordinateMapping;
 }
 
@@ -213,6 +214,17 @@ public:
   /// Get coordinate_mapping (experimental)
   std::shared_ptr<const fem::CoordinateMapping> coordinate_mapping() const;
 
+  /// Set recorder for the time spent in the element kernels of each
+  /// cell during assembly. Pass nullptr to stop recording. Throws if
+  /// the recorder is for a different mesh than the form.
+  ///
+  /// @param[in] recorder (_fem::CellCostRecorder_)
+  ///         The recorder.
+  void set_cell_cost_recorder(std::shared_ptr<CellCostRecorder> recorder);
+
+  /// Get recorder for the cell kernel times (nullptr if not recording)
+  std::shared_ptr<CellCostRecorder> cell_cost_recorder() const;
+
 private:
   // Integrals associated with the Form
   FormIntegrals _integrals;
@@ -228,6 +240,9 @@ private:
 
   // Coordinate_mapping
   std::shared_ptr<const fem::CoordinateMapping> _coord_mapping;
+
+  // Recorder for cell kernel times
+  std::shared_ptr<CellCostRecorder> _cost_recorder;
 };
 } // namespace fem
 } // namespace dolfin
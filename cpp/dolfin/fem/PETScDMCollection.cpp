@@ -7,6 +7,7 @@
 #include "PETScDMCollection.h"
 #include <Eigen/Dense>
 #include <dolfin/common/IndexMap.h>
+#include <dolfin/common/Timer.h>
 #include <dolfin/fem/CoordinateMapping.h>
 #include <dolfin/fem/FiniteElement.h>
 #include <dolfin/fem/GenericDofMap.h>
@@ -15,9 +16,12 @@
 #include <dolfin/geometry/BoundingBoxTree.h>
 #include <dolfin/la/PETScMatrix.h>
 #include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/Connectivity.h>
 #include <dolfin/mesh/MeshIterator.h>
 #include <petscdmshell.h>
 #include <petscmat.h>
+#include <algorithm>
+#include <numeric>
 
 using namespace dolfin;
 using namespace dolfin::fem;
@@ -87,10 +91,7 @@ tabulate_coordinates_to_dofs(const function::FunctionSpace& V)
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>&
@@ -113,7 +114,7 @@ tabulate_coordinates_to_dofs(const function::FunctionSpace& V)
     const int cell_index = cell.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g.connections(cell_index)[i], j);
 
     // Get local-to-global map
     auto dofs = dofmap.cell_dofs(cell.index());
@@ -193,6 +194,30 @@ PETScDMCollection::PETScDMCollection(
   }
 }
 //-----------------------------------------------------------------------------
+PETScDMCollection::PETScDMCollection(
+    std::vector<std::shared_ptr<const function::FunctionSpace>> function_spaces,
+    const std::vector<la::PETScMatrix>& prolongations)
+    : PETScDMCollection(function_spaces)
+{
+  if (prolongations.size() + 1 != _spaces.size())
+  {
+    throw std::runtime_error("Number of prolongation matrices ("
+                             + std::to_string(prolongations.size())
+                             + ") does not match number of levels ("
+                             + std::to_string(_spaces.size()) + ")");
+  }
+
+  // Attach the prolongation matrix to the fine DM. PETSc increases the
+  // reference count of the matrix.
+  for (std::size_t i = 0; i < prolongations.size(); ++i)
+  {
+    PetscErrorCode ierr = PetscObjectCompose(
+        (PetscObject)_dms[i + 1], "dolfin_prolongation",
+        (PetscObject)prolongations[i].mat());
+    CHKERRABORT(PETSC_COMM_WORLD, ierr);
+  }
+}
+//-----------------------------------------------------------------------------
 PETScDMCollection::~PETScDMCollection()
 {
   // Don't destroy all the DMs!
@@ -490,177 +515,204 @@ la::PETScMatrix PETScDMCollection::create_transfer_matrix(
                        exterior_global_indices, global_row_indices, found_ids,
                        found_points);
 
-  // Now every processor should have the information needed to
-  // assemble its portion of the matrix.  The ids of coarse cell owned
-  // by each processor are currently stored in found_ids and their
-  // respective global row indices are stored in global_row_indices.
-  // One last loop and we are ready to go!
-
-  // m_owned is the number of rows the current processor needs to set
-  // note that the processor might not own these rows
-  const std::size_t m_owned = global_row_indices.size();
-
-  // Initialise row and column indices and values of the transfer
-  // matrix
-  Eigen::Array<PetscInt, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      col_indices(m_owned, eldim);
-  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      values(m_owned, eldim);
-  Eigen::Tensor<double, 3, Eigen::RowMajor> temp_values(1, eldim, data_size);
-
-  // Initialise global sparsity pattern: record on-process and
-  // off-process dependencies of fine dofs
-  std::vector<std::vector<PetscInt>> send_dnnz(mpi_size);
-  std::vector<std::vector<PetscInt>> send_onnz(mpi_size);
-
-  // Initialise local to global dof maps (needed to allocate the
-  // entries of the transfer matrix with the correct global indices)
+  // Now every process has the coarse cells that contain its share of
+  // the fine points (found_ids), and the global fine dofs at each point
+  // (global_row_indices). Group the points by coarse cell, so that the
+  // geometry of each coarse cell is computed once and the basis is
+  // evaluated for all points of the cell together.
+  common::Timer t_eval("Evaluate transfer matrix entries");
+  const std::size_t num_found = found_ids.size();
+  std::vector<std::size_t> order(num_found);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&found_ids](std::size_t i0, std::size_t i1) {
+                     return found_ids[i0] < found_ids[i1];
+                   });
+
+  // Local to global dof map of the coarse space (columns)
   Eigen::Array<std::size_t, Eigen::Dynamic, 1> coarse_local_to_global_dofs
       = coarsemap->tabulate_local_to_global_dofs();
 
-  // Loop over the found coarse cells
-  Eigen::Map<const EigenRowArrayXXd> x(found_points.data(), found_ids.size(),
-                                       gdim);
-  const auto cmap = meshc.geometry().coord_mapping;
-  EigenRowArrayXXd X(1, gdim);
-  Eigen::Tensor<double, 3, Eigen::RowMajor> J(1, gdim, tdim);
-  EigenArrayXd detJ(1);
-  Eigen::Tensor<double, 3, Eigen::RowMajor> K(1, tdim, gdim);
-
   // Prepare cell geometry
+  if (!meshc.geometry().coord_mapping)
+  {
+    throw std::runtime_error(
+        "CoordinateMapping has not been attached to mesh.");
+  }
+  const CoordinateMapping& cmap = *meshc.geometry().coord_mapping;
   const mesh::Connectivity& connectivity_g
       = meshc.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>&
       x_g
       = meshc.geometry().points();
   EigenRowArrayXXd coordinate_dofs(num_dofs_g, gdim);
-  ; // cell dofs coordinates vector
 
-  for (unsigned int i = 0; i < found_ids.size(); ++i)
+  // Work arrays for a block of points, resized when the number of
+  // points in a cell changes
+  EigenRowArrayXXd x, X;
+  Eigen::Tensor<double, 3, Eigen::RowMajor> J, K, basis_values;
+  EigenArrayXd detJ;
+
+  // Nonzero entries of the rows computed on this process, packed for
+  // the owner of each row as (row, number of entries, columns...) and
+  // values
+  std::vector<std::vector<PetscInt>> send_rows(mpi_size);
+  std::vector<std::vector<PetscScalar>> send_values(mpi_size);
+
+  const std::shared_ptr<const common::IndexMap> fine_index_map
+      = finemap->index_map();
+  for (std::size_t b0 = 0; b0 < num_found;)
   {
-    // Get coarse cell id and point
-    unsigned int id = found_ids[i];
-
-    // Create coarse cell
-    mesh::Cell coarse_cell(meshc, static_cast<std::size_t>(id));
+    // Points in coarse cell
+    const std::size_t id = found_ids[order[b0]];
+    std::size_t b1 = b0 + 1;
+    while (b1 < num_found and found_ids[order[b1]] == id)
+      ++b1;
+    const int num_points = b1 - b0;
+
+    if (x.rows() != num_points)
+    {
+      x.resize(num_points, gdim);
+      X.resize(num_points, tdim);
+      J.resize(num_points, gdim, tdim);
+      detJ.resize(num_points);
+      K.resize(num_points, tdim, gdim);
+      basis_values.resize(num_points, (int)eldim, (int)data_size);
+    }
+    for (int i = 0; i < num_points; ++i)
+      for (int j = 0; j < gdim; ++j)
+        x(i, j) = found_points[order[b0 + i] * gdim + j];
 
-    // Get dofs coordinates of the coarse cell
-    const int cell_index = coarse_cell.index();
+    // Evaluate the coarse basis functions at the fine points
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
-
-    // Evaluate the basis functions of the coarse cells at the fine
-    // point and store the values into temp_values
-
-    cmap->compute_reference_geometry(X, J, detJ, K, x.row(i), coordinate_dofs);
-    el->evaluate_reference_basis(temp_values, X);
+        coordinate_dofs(i, j) = x_g(cell_g.connections(id)[i], j);
+    cmap.compute_reference_geometry(X, J, detJ, K, x, coordinate_dofs);
+    el->evaluate_reference_basis(basis_values, X);
 
     // Get the coarse dofs associated with this cell
-    auto temp_dofs = coarsemap->cell_dofs(id);
+    auto cell_dofs = coarsemap->cell_dofs(id);
 
-    // Loop over the fine dofs associated with this collision
-    for (unsigned k = 0; k < data_size; k++)
+    // Pack the row of each fine dof at each point for its owner,
+    // skipping entries that are zero, e.g. for basis functions of
+    // other components of a vector element
+    for (int i = 0; i < num_points; ++i)
     {
-      const unsigned int fine_row = i * data_size + k;
-      const std::size_t global_fine_dof = global_row_indices[fine_row];
-      int p = finemap->index_map()->owner(global_fine_dof / data_size);
-
-      // Loop over the coarse dofs and stuff their contributions
-      for (unsigned j = 0; j < eldim; j++)
+      for (unsigned int k = 0; k < data_size; ++k)
       {
-        const std::size_t coarse_dof
-            = coarse_local_to_global_dofs[temp_dofs[j]];
-
-        // Set the column
-        col_indices(fine_row, j) = coarse_dof;
-        // Set the value
-        values(fine_row, j) = temp_values(0, j, k);
-
-        int pc = coarsemap->index_map()->owner(coarse_dof / data_size);
-        if (p == pc)
-          send_dnnz[p].push_back(global_fine_dof);
-        else
-          send_onnz[p].push_back(global_fine_dof);
+        const PetscInt global_fine_dof
+            = global_row_indices[order[b0 + i] * data_size + k];
+        const int p = fine_index_map->owner(global_fine_dof / data_size);
+        std::vector<PetscInt>& rows = send_rows[p];
+        rows.push_back(global_fine_dof);
+        rows.push_back(0);
+        const std::size_t pos = rows.size() - 1;
+        for (std::size_t j = 0; j < eldim; ++j)
+        {
+          const double value = basis_values(i, j, k);
+          if (value != 0.0)
+          {
+            rows.push_back(coarse_local_to_global_dofs[cell_dofs[j]]);
+            send_values[p].push_back(value);
+            ++rows[pos];
+          }
+        }
       }
     }
-  }
-
-  // Communicate off-process columns nnz, and flatten to get nnz per
-  // row we also keep track of the ownership range
-  std::size_t mbegin = m[0];
-  std::size_t mend = m[1];
-  std::vector<PetscInt> recv_onnz;
-  MPI::all_to_all(mpi_comm, send_onnz, recv_onnz);
 
-  std::vector<PetscInt> onnz(m[1] - m[0], 0);
-  for (const auto& q : recv_onnz)
+    b0 = b1;
+  }
+  t_eval.stop();
+
+  // Send the rows to their owners
+  common::Timer t_insert("Build transfer matrix from rows");
+  std::vector<std::vector<PetscInt>> recv_rows;
+  std::vector<std::vector<PetscScalar>> recv_values;
+  MPI::all_to_all(mpi_comm, send_rows, recv_rows);
+  MPI::all_to_all(mpi_comm, send_values, recv_values);
+
+  // Find the rows received for each owned fine dof. A row can arrive
+  // more than once, e.g. from processes that evaluated it in different
+  // coarse cells, possibly with different zero entries dropped. The
+  // first copy received is used.
+  const std::int64_t num_local_rows = m[1] - m[0];
+  std::vector<int> row_process(num_local_rows, -1);
+  std::vector<std::pair<std::size_t, std::size_t>> row_position(
+      num_local_rows);
+  std::vector<PetscInt> row_ptr(num_local_rows + 1, 0);
+  for (std::size_t p = 0; p < mpi_size; ++p)
   {
-    assert(q >= (PetscInt)mbegin and q < (PetscInt)mend);
-    ++onnz[q - mbegin];
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < recv_rows[p].size();
+         i += 2 + recv_rows[p][i + 1])
+    {
+      const std::int64_t row = recv_rows[p][i] - m[0];
+      assert(row >= 0 and row < num_local_rows);
+      if (row_process[row] == -1)
+      {
+        row_process[row] = p;
+        row_position[row] = {i, pos};
+        row_ptr[row + 1] = recv_rows[p][i + 1];
+      }
+      pos += recv_rows[p][i + 1];
+    }
   }
-
-  // Communicate on-process columns nnz, and flatten to get nnz per
-  // row
-  std::vector<PetscInt> recv_dnnz;
-  MPI::all_to_all(mpi_comm, send_dnnz, recv_dnnz);
-  std::vector<PetscInt> dnnz(m[1] - m[0], 0);
-  for (const auto& q : recv_dnnz)
+  std::partial_sum(row_ptr.begin(), row_ptr.end(), row_ptr.begin());
+
+  // Build the owned rows in compressed sparse row format, with global
+  // column indices sorted in each row
+  std::vector<PetscInt> columns(row_ptr.back());
+  std::vector<PetscScalar> values(row_ptr.back());
+  std::vector<std::pair<PetscInt, PetscScalar>> row_entries;
+  for (std::int64_t row = 0; row < num_local_rows; ++row)
   {
-    assert(q >= (PetscInt)mbegin and q < (PetscInt)mend);
-    ++dnnz[q - mbegin];
+    const int p = row_process[row];
+    if (p == -1)
+      continue;
+    const std::size_t i = row_position[row].first;
+    const std::size_t pos = row_position[row].second;
+    const PetscInt num_entries = row_ptr[row + 1] - row_ptr[row];
+    row_entries.resize(num_entries);
+    for (PetscInt j = 0; j < num_entries; ++j)
+      row_entries[j] = {recv_rows[p][i + 2 + j], recv_values[p][pos + j]};
+    std::sort(row_entries.begin(), row_entries.end());
+    for (PetscInt j = 0; j < num_entries; ++j)
+    {
+      columns[row_ptr[row] + j] = row_entries[j].first;
+      values[row_ptr[row] + j] = row_entries[j].second;
+    }
   }
 
   // Initialise PETSc Mat and error code
   PetscErrorCode ierr;
   Mat I;
 
-  // Create and initialise the transfer matrix as MATMPIAIJ/MATSEQAIJ
+  // Create the transfer matrix as MATMPIAIJ/MATSEQAIJ, and insert all
+  // rows at once (this also assembles the matrix)
   ierr = MatCreate(mpi_comm, &I);
   CHKERRABORT(PETSC_COMM_WORLD, ierr);
-
+  ierr = MatSetSizes(I, m[1] - m[0], n[1] - n[0], M, N);
+  CHKERRABORT(PETSC_COMM_WORLD, ierr);
   if (mpi_size > 1)
   {
     ierr = MatSetType(I, MATMPIAIJ);
     CHKERRABORT(PETSC_COMM_WORLD, ierr);
-    ierr = MatSetSizes(I, m[1] - m[0], n[1] - n[0], M, N);
-    CHKERRABORT(PETSC_COMM_WORLD, ierr);
-    ierr = MatMPIAIJSetPreallocation(I, PETSC_DEFAULT, dnnz.data(),
-                                     PETSC_DEFAULT, onnz.data());
+    ierr = MatMPIAIJSetPreallocationCSR(I, row_ptr.data(), columns.data(),
+                                        values.data());
     CHKERRABORT(PETSC_COMM_WORLD, ierr);
   }
   else
   {
     ierr = MatSetType(I, MATSEQAIJ);
     CHKERRABORT(PETSC_COMM_WORLD, ierr);
-    ierr = MatSetSizes(I, m[1] - m[0], n[1] - n[0], M, N);
-    CHKERRABORT(PETSC_COMM_WORLD, ierr);
-    ierr = MatSeqAIJSetPreallocation(I, PETSC_DEFAULT, dnnz.data());
-    CHKERRABORT(PETSC_COMM_WORLD, ierr);
-  }
-
-  // Setting transfer matrix values row by row
-  for (unsigned int fine_row = 0; fine_row < m_owned; ++fine_row)
-  {
-    PetscInt fine_dof = global_row_indices[fine_row];
-    ierr
-        = MatSetValues(I, 1, &fine_dof, eldim, col_indices.row(fine_row).data(),
-                       values.row(fine_row).data(), INSERT_VALUES);
+    ierr = MatSeqAIJSetPreallocationCSR(I, row_ptr.data(), columns.data(),
+                                        values.data());
     CHKERRABORT(PETSC_COMM_WORLD, ierr);
   }
 
-  // Assemble the transfer matrix
-  ierr = MatAssemblyBegin(I, MAT_FINAL_ASSEMBLY);
-  CHKERRABORT(PETSC_COMM_WORLD, ierr);
-  ierr = MatAssemblyEnd(I, MAT_FINAL_ASSEMBLY);
-  CHKERRABORT(PETSC_COMM_WORLD, ierr);
-
   return la::PETScMatrix(I, false);
 }
 //-----------------------------------------------------------------------------
@@ -788,6 +840,17 @@ PetscErrorCode PETScDMCollection::create_interpolation(DM dmc, DM dmf, Mat* mat,
   DMShellGetContext(dmc, (void**)&V0);
   DMShellGetContext(dmf, (void**)&V1);
 
+  // Use the prolongation matrix attached to the fine DM, if any
+  PetscObject P0 = nullptr;
+  PetscObjectQuery((PetscObject)dmf, "dolfin_prolongation", &P0);
+  if (P0)
+  {
+    *mat = (Mat)P0;
+    PetscObjectReference(P0);
+    *vec = nullptr;
+    return 0;
+  }
+
   // Build interpolation matrix (V0 to V1)
   assert(V0);
   assert(V1);
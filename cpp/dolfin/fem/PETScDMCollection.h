@@ -50,6 +50,16 @@ public:
   PETScDMCollection(std::vector<std::shared_ptr<const function::FunctionSpace>>
                         function_spaces);
 
+  /// Construct PETScDMCollection from a vector of
+  /// function::FunctionSpaces (coarse to fine), and the prolongation
+  /// matrices from each space to the next finer space. The matrices
+  /// are attached to the DM objects and returned by the interpolation
+  /// call-back, instead of being computed with create_transfer_matrix.
+  PETScDMCollection(
+      std::vector<std::shared_ptr<const function::FunctionSpace>>
+          function_spaces,
+      const std::vector<la::PETScMatrix>& prolongations);
+
   /// Destructor
   ~PETScDMCollection();
 
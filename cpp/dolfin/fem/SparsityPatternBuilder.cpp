@@ -9,10 +9,9 @@
 #include <dolfin/common/MPI.h>
 #include <dolfin/fem/GenericDofMap.h>
 #include <dolfin/la/SparsityPattern.h>
-#include <dolfin/mesh/Cell.h>
-#include <dolfin/mesh/Facet.h>
+#include <dolfin/mesh/Connectivity.h>
 #include <dolfin/mesh/Mesh.h>
-#include <dolfin/mesh/MeshIterator.h>
+#include <dolfin/mesh/Topology.h>
 
 using namespace dolfin;
 using namespace dolfin::fem;
@@ -24,11 +23,10 @@ void SparsityPatternBuilder::cells(
 {
   assert(dofmaps[0]);
   assert(dofmaps[1]);
-  for (auto& cell : mesh::MeshRange<mesh::Cell>(mesh))
-  {
-    pattern.insert_local(dofmaps[0]->cell_dofs(cell.index()),
-                         dofmaps[1]->cell_dofs(cell.index()));
-  }
+  const int D = mesh.topology().dim();
+  const std::int32_t num_cells = mesh.topology().ghost_offset(D);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+    pattern.insert_local(dofmaps[0]->cell_dofs(c), dofmaps[1]->cell_dofs(c));
 }
 //-----------------------------------------------------------------------------
 void SparsityPatternBuilder::interior_facets(
@@ -38,31 +36,33 @@ void SparsityPatternBuilder::interior_facets(
   assert(dofmaps[0]);
   assert(dofmaps[1]);
 
-  const std::size_t D = mesh.topology().dim();
+  const int D = mesh.topology().dim();
   mesh.create_entities(D - 1);
   mesh.create_connectivity(D - 1, D);
+  const mesh::ConnectivityView facet_cell
+      = mesh.topology().connectivity_view(D - 1, D);
 
   // Array to store macro-dofs, if required (for interior facets)
   std::array<Eigen::Array<PetscInt, Eigen::Dynamic, 1>, 2> macro_dofs;
 
-  for (auto& facet : mesh::MeshRange<mesh::Facet>(mesh))
+  const std::int32_t num_facets = mesh.topology().ghost_offset(D - 1);
+  for (std::int32_t f = 0; f < num_facets; ++f)
   {
     // Continue if facet is exterior facet
-    if (facet.num_global_entities(D) == 1)
+    if (facet_cell.size_global(f) == 1)
       continue;
 
     // FIXME: sort out ghosting
 
     // Get cells incident with facet
-    assert(facet.num_entities(D) == 2);
-    const mesh::Cell cell0(mesh, facet.entities(D)[0]);
-    const mesh::Cell cell1(mesh, facet.entities(D)[1]);
+    assert(facet_cell.size(f) == 2);
+    const std::int32_t* cells = facet_cell.connections(f);
 
     // Tabulate dofs for each dimension on macro element
     for (std::size_t i = 0; i < 2; i++)
     {
-      const auto cell_dofs0 = dofmaps[i]->cell_dofs(cell0.index());
-      const auto cell_dofs1 = dofmaps[i]->cell_dofs(cell1.index());
+      const auto cell_dofs0 = dofmaps[i]->cell_dofs(cells[0]);
+      const auto cell_dofs1 = dofmaps[i]->cell_dofs(cells[1]);
       macro_dofs[i].resize(cell_dofs0.size() + cell_dofs1.size());
       std::copy(cell_dofs0.data(), cell_dofs0.data() + cell_dofs0.size(),
                 macro_dofs[i].data());
@@ -78,22 +78,25 @@ void SparsityPatternBuilder::exterior_facets(
     la::SparsityPattern& pattern, const mesh::Mesh& mesh,
     const std::array<const fem::GenericDofMap*, 2> dofmaps)
 {
-  const std::size_t D = mesh.topology().dim();
+  const int D = mesh.topology().dim();
   mesh.create_entities(D - 1);
   mesh.create_connectivity(D - 1, D);
+  const mesh::ConnectivityView facet_cell
+      = mesh.topology().connectivity_view(D - 1, D);
 
-  for (auto& facet : mesh::MeshRange<mesh::Facet>(mesh))
+  const std::int32_t num_facets = mesh.topology().ghost_offset(D - 1);
+  for (std::int32_t f = 0; f < num_facets; ++f)
   {
     // Skip interior facets
-    if (facet.num_global_entities(D) > 1)
+    if (facet_cell.size_global(f) > 1)
       continue;
 
     // FIXME: sort out ghosting
 
-    assert(facet.num_entities(D) == 1);
-    mesh::Cell cell(mesh, facet.entities(D)[0]);
-    pattern.insert_local(dofmaps[0]->cell_dofs(cell.index()),
-                         dofmaps[1]->cell_dofs(cell.index()));
+    assert(facet_cell.size(f) == 1);
+    const std::int32_t cell = facet_cell.connections(f)[0];
+    pattern.insert_local(dofmaps[0]->cell_dofs(cell),
+                         dofmaps[1]->cell_dofs(cell));
   }
 }
 //-----------------------------------------------------------------------------
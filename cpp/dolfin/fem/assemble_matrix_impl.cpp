@@ -5,13 +5,14 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "assemble_matrix_impl.h"
+#include "CellCostRecorder.h"
 #include "Form.h"
 #include "GenericDofMap.h"
 #include <dolfin/function/Function.h>
 #include <dolfin/function/FunctionSpace.h>
 #include <dolfin/la/utils.h>
 #include <dolfin/mesh/Cell.h>
-#include <dolfin/mesh/Facet.h>
+#include <dolfin/mesh/Connectivity.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshIterator.h>
 #include <petscsys.h>
@@ -44,6 +45,9 @@ void fem::impl::assemble_matrix(Mat A, const Form& a,
     coeff_fn[i] = coefficients.get(i).get();
   std::vector<int> c_offsets = coefficients.offsets();
 
+  // Recorder for kernel times (if any)
+  CellCostRecorder* recorder = a.cell_cost_recorder().get();
+
   const FormIntegrals& integrals = a.integrals();
   using type = fem::FormIntegrals::Type;
   for (int i = 0; i < integrals.num_integrals(type::cell); ++i)
@@ -53,7 +57,7 @@ void fem::impl::assemble_matrix(Mat A, const Form& a,
         = integrals.integral_domains(type::cell, i);
     fem::impl::assemble_cells(
         A, mesh, active_cells, dof_array0, num_dofs_per_cell0, dof_array1,
-        num_dofs_per_cell1, bc0, bc1, fn, coeff_fn, c_offsets);
+        num_dofs_per_cell1, bc0, bc1, fn, coeff_fn, c_offsets, recorder);
   }
 
   for (int i = 0; i < integrals.num_integrals(type::exterior_facet); ++i)
@@ -63,7 +67,7 @@ void fem::impl::assemble_matrix(Mat A, const Form& a,
         = integrals.integral_domains(type::exterior_facet, i);
     fem::impl::assemble_exterior_facets(A, mesh, active_facets, dofmap0,
                                         dofmap1, bc0, bc1, fn, coeff_fn,
-                                        c_offsets);
+                                        c_offsets, recorder);
   }
 
   for (int i = 0; i < integrals.num_integrals(type::interior_facet); ++i)
@@ -73,7 +77,7 @@ void fem::impl::assemble_matrix(Mat A, const Form& a,
         = integrals.integral_domains(type::interior_facet, i);
     fem::impl::assemble_interior_facets(A, mesh, active_facets, dofmap0,
                                         dofmap1, bc0, bc1, fn, coeff_fn,
-                                        c_offsets);
+                                        c_offsets, recorder);
   }
 }
 //-----------------------------------------------------------------------------
@@ -88,7 +92,7 @@ void fem::impl::assemble_cells(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& kernel,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets)
+    const std::vector<int>& offsets, CellCostRecorder* recorder)
 {
   assert(A);
 
@@ -97,10 +101,7 @@ void fem::impl::assemble_cells(
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
@@ -126,7 +127,7 @@ void fem::impl::assemble_cells(
     // Get cell coordinates/geometry
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g.connections(cell_index)[i], j);
 
     // Update coefficients
     for (std::size_t i = 0; i < coefficients.size(); ++i)
@@ -137,8 +138,11 @@ void fem::impl::assemble_cells(
 
     // Tabulate tensor
     Ae.setZero(num_dofs_per_cell0, num_dofs_per_cell1);
+    const double t0 = recorder ? CellCostRecorder::now() : 0.0;
     kernel(Ae.data(), coeff_array.data(), coordinate_dofs.data(), nullptr,
            &orientation);
+    if (recorder)
+      recorder->add(cell_index, CellCostRecorder::now() - t0);
 
     // Zero rows/columns for essential bcs
     if (!bc0.empty())
@@ -179,20 +183,21 @@ void fem::impl::assemble_exterior_facets(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& fn,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets)
+    const std::vector<int>& offsets, CellCostRecorder* recorder)
 {
   const int gdim = mesh.geometry().dim();
   const int tdim = mesh.topology().dim();
   mesh.create_entities(tdim - 1);
   mesh.create_connectivity(tdim - 1, tdim);
+  const mesh::ConnectivityView facet_cell
+      = mesh.topology().connectivity_view(tdim - 1, tdim);
+  const mesh::ConnectivityView cell_facet
+      = mesh.topology().connectivity_view(tdim, tdim - 1);
 
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
@@ -209,23 +214,23 @@ void fem::impl::assemble_exterior_facets(
   PetscErrorCode ierr;
   for (const auto& facet_index : active_facets)
   {
-    const mesh::Facet facet(mesh, facet_index);
-    assert(facet.num_global_entities(tdim) == 1);
+    assert(facet_cell.size_global(facet_index) == 1);
 
     // TODO: check ghosting sanity?
 
     // Create attached cell
-    const mesh::Cell cell(mesh, facet.entities(tdim)[0]);
+    const std::int32_t cell_index = facet_cell.connections(facet_index)[0];
+    const mesh::Cell cell(mesh, cell_index);
 
     // Get local index of facet with respect to the cell
-    const int local_facet = cell.index(facet);
+    const int local_facet = cell_facet.local_index(cell_index, facet_index);
+    assert(local_facet >= 0);
     const int orient = 0;
 
     // Get cell vertex coordinates
-    const int cell_index = cell.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g.connections(cell_index)[i], j);
 
     // Get dof maps for cell
     Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap0
@@ -242,8 +247,11 @@ void fem::impl::assemble_exterior_facets(
 
     // Tabulate tensor
     Ae.setZero(dmap0.size(), dmap1.size());
+    const double t0 = recorder ? CellCostRecorder::now() : 0.0;
     fn(Ae.data(), coeff_array.data(), coordinate_dofs.data(), &local_facet,
        &orient);
+    if (recorder)
+      recorder->add(cell_index, CellCostRecorder::now() - t0);
 
     // Zero rows/columns for essential bcs
     if (!bc0.empty())
@@ -280,20 +288,21 @@ void fem::impl::assemble_interior_facets(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& fn,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets)
+    const std::vector<int>& offsets, CellCostRecorder* recorder)
 {
   const int gdim = mesh.geometry().dim();
   const int tdim = mesh.topology().dim();
   mesh.create_entities(tdim - 1);
   mesh.create_connectivity(tdim - 1, tdim);
+  const mesh::ConnectivityView facet_cell
+      = mesh.topology().connectivity_view(tdim - 1, tdim);
+  const mesh::ConnectivityView cell_facet
+      = mesh.topology().connectivity_view(tdim, tdim - 1);
 
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
@@ -313,28 +322,30 @@ void fem::impl::assemble_interior_facets(
   PetscErrorCode ierr;
   for (const auto& facet_index : active_facets)
   {
-    const mesh::Facet facet(mesh, facet_index);
-    assert(facet.num_global_entities(tdim) == 2);
+    assert(facet_cell.size_global(facet_index) == 2);
 
     // TODO: check ghosting sanity?
 
     // Create attached cells
-    const mesh::Cell cell0(mesh, facet.entities(tdim)[0]);
-    const mesh::Cell cell1(mesh, facet.entities(tdim)[1]);
+    const std::int32_t* cells = facet_cell.connections(facet_index);
+    const std::int32_t cell_index0 = cells[0];
+    const std::int32_t cell_index1 = cells[1];
+    const mesh::Cell cell0(mesh, cell_index0);
+    const mesh::Cell cell1(mesh, cell_index1);
 
     // Get local index of facet with respect to the cell
-    const int local_facet[2] = {cell0.index(facet), cell1.index(facet)};
+    const int local_facet[2]
+        = {cell_facet.local_index(cell_index0, facet_index),
+           cell_facet.local_index(cell_index1, facet_index)};
     const int orient[2] = {0, 0};
 
     // Get cell vertex coordinates
-    const int cell_index0 = cell0.index();
-    const int cell_index1 = cell1.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
       {
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index0] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g.connections(cell_index0)[i], j);
         coordinate_dofs(i + num_dofs_g, j)
-            = x_g(cell_g[pos_g[cell_index1] + i], j);
+            = x_g(cell_g.connections(cell_index1)[i], j);
       }
 
     // Get dof maps for cell
@@ -379,8 +390,16 @@ void fem::impl::assemble_interior_facets(
 
     // Tabulate tensor
     Ae.setZero(dmapjoint0.size(), dmapjoint1.size());
+    const double t0 = recorder ? CellCostRecorder::now() : 0.0;
     fn(Ae.data(), coeff_array.data(), coordinate_dofs.data(), local_facet,
        orient);
+    if (recorder)
+    {
+      // Split time between the two cells
+      const double t = 0.5 * (CellCostRecorder::now() - t0);
+      recorder->add(cell_index0, t);
+      recorder->add(cell_index1, t);
+    }
 
     // Zero rows/columns for essential bcs
     if (!bc0.empty())
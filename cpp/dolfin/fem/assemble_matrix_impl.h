@@ -27,6 +27,7 @@ class Mesh;
 
 namespace fem
 {
+class CellCostRecorder;
 class Form;
 class GenericDofMap;
 
@@ -53,7 +54,7 @@ void assemble_cells(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int *, const int*)>& kernel,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets);
+    const std::vector<int>& offsets, CellCostRecorder* recorder);
 
 /// Execute kernel over exterior facets and  accumulate result in Mat
 void assemble_exterior_facets(
@@ -64,7 +65,7 @@ void assemble_exterior_facets(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& fn,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets);
+    const std::vector<int>& offsets, CellCostRecorder* recorder);
 
 void assemble_interior_facets(
     Mat A, const mesh::Mesh& mesh,
@@ -74,7 +75,7 @@ void assemble_interior_facets(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& fn,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets);
+    const std::vector<int>& offsets, CellCostRecorder* recorder);
 
 } // namespace impl
 } // namespace fem
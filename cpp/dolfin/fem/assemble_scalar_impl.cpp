@@ -5,13 +5,14 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "assemble_scalar_impl.h"
+#include "CellCostRecorder.h"
 #include "Form.h"
 #include <dolfin/common/IndexMap.h>
 #include <dolfin/common/types.h>
 #include <dolfin/function/Function.h>
 #include <dolfin/function/FunctionSpace.h>
 #include <dolfin/mesh/Cell.h>
-#include <dolfin/mesh/Facet.h>
+#include <dolfin/mesh/Connectivity.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshIterator.h>
 #include <petscsys.h>
@@ -32,6 +33,9 @@ PetscScalar dolfin::fem::impl::assemble_scalar(const dolfin::fem::Form& M)
     coeff_fn[i] = coefficients.get(i).get();
   std::vector<int> c_offsets = coefficients.offsets();
 
+  // Recorder for kernel times (if any)
+  CellCostRecorder* recorder = M.cell_cost_recorder().get();
+
   const FormIntegrals& integrals = M.integrals();
   using type = fem::FormIntegrals::Type;
   PetscScalar value = 0.0;
@@ -41,7 +45,7 @@ PetscScalar dolfin::fem::impl::assemble_scalar(const dolfin::fem::Form& M)
     const std::vector<std::int32_t>& active_cells
         = integrals.integral_domains(type::cell, i);
     value += fem::impl::assemble_cells(mesh, active_cells, fn, coeff_fn,
-                                       c_offsets);
+                                       c_offsets, recorder);
   }
 
   for (int i = 0; i < integrals.num_integrals(type::exterior_facet); ++i)
@@ -49,8 +53,8 @@ PetscScalar dolfin::fem::impl::assemble_scalar(const dolfin::fem::Form& M)
     auto& fn = integrals.get_tabulate_tensor_function(type::exterior_facet, i);
     const std::vector<std::int32_t>& active_facets
         = integrals.integral_domains(type::exterior_facet, i);
-    value += fem::impl::assemble_exterior_facets(mesh, active_facets, fn,
-                                                 coeff_fn, c_offsets);
+    value += fem::impl::assemble_exterior_facets(
+        mesh, active_facets, fn, coeff_fn, c_offsets, recorder);
   }
 
   for (int i = 0; i < integrals.num_integrals(type::interior_facet); ++i)
@@ -58,8 +62,8 @@ PetscScalar dolfin::fem::impl::assemble_scalar(const dolfin::fem::Form& M)
     auto& fn = integrals.get_tabulate_tensor_function(type::interior_facet, i);
     const std::vector<std::int32_t>& active_facets
         = integrals.integral_domains(type::interior_facet, i);
-    value += fem::impl::assemble_interior_facets(mesh, active_facets, fn,
-                                                 coeff_fn, c_offsets);
+    value += fem::impl::assemble_interior_facets(
+        mesh, active_facets, fn, coeff_fn, c_offsets, recorder);
   }
 
   return value;
@@ -70,7 +74,7 @@ PetscScalar fem::impl::assemble_cells(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& fn,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets)
+    const std::vector<int>& offsets, CellCostRecorder* recorder)
 {
   const int gdim = mesh.geometry().dim();
   const int tdim = mesh.topology().dim();
@@ -79,10 +83,7 @@ PetscScalar fem::impl::assemble_cells(
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
@@ -106,7 +107,7 @@ PetscScalar fem::impl::assemble_cells(
     // Get cell coordinates/geometry
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g.connections(cell_index)[i], j);
 
     // Update coefficients
     for (std::size_t i = 0; i < coefficients.size(); ++i)
@@ -115,8 +116,11 @@ PetscScalar fem::impl::assemble_cells(
                                 coordinate_dofs);
     }
 
+    const double t0 = recorder ? CellCostRecorder::now() : 0.0;
     fn(&cell_value, coeff_array.data(), coordinate_dofs.data(), nullptr,
        &orientation);
+    if (recorder)
+      recorder->add(cell_index, CellCostRecorder::now() - t0);
     value += cell_value;
   }
 
@@ -128,20 +132,21 @@ PetscScalar fem::impl::assemble_exterior_facets(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& fn,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets)
+    const std::vector<int>& offsets, CellCostRecorder* recorder)
 {
   const int gdim = mesh.geometry().dim();
   const int tdim = mesh.topology().dim();
   mesh.create_entities(tdim - 1);
   mesh.create_connectivity(tdim - 1, tdim);
+  const mesh::ConnectivityView facet_cell
+      = mesh.topology().connectivity_view(tdim - 1, tdim);
+  const mesh::ConnectivityView cell_facet
+      = mesh.topology().connectivity_view(tdim, tdim - 1);
 
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
@@ -156,24 +161,23 @@ PetscScalar fem::impl::assemble_exterior_facets(
   PetscScalar cell_value, value(0);
   for (const auto& facet_index : active_facets)
   {
-    const mesh::Facet facet(mesh, facet_index);
-
-    assert(facet.num_global_entities(tdim) == 1);
+    assert(facet_cell.size_global(facet_index) == 1);
 
     // TODO: check ghosting sanity?
 
     // Create attached cell
-    const mesh::Cell cell(mesh, facet.entities(tdim)[0]);
+    const std::int32_t cell_index = facet_cell.connections(facet_index)[0];
+    const mesh::Cell cell(mesh, cell_index);
 
     // Get local index of facet with respect to the cell
-    const int local_facet = cell.index(facet);
+    const int local_facet = cell_facet.local_index(cell_index, facet_index);
+    assert(local_facet >= 0);
     const int orient = 0;
 
     // Get cell vertex coordinates
-    const int cell_index = cell.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g.connections(cell_index)[i], j);
 
     // Update coefficients
     for (std::size_t i = 0; i < coefficients.size(); ++i)
@@ -182,8 +186,11 @@ PetscScalar fem::impl::assemble_exterior_facets(
                                 coordinate_dofs);
     }
 
+    const double t0 = recorder ? CellCostRecorder::now() : 0.0;
     fn(&cell_value, coeff_array.data(), coordinate_dofs.data(), &local_facet,
        &orient);
+    if (recorder)
+      recorder->add(cell_index, CellCostRecorder::now() - t0);
     value += cell_value;
   }
 
@@ -195,20 +202,21 @@ PetscScalar fem::impl::assemble_interior_facets(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& fn,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets)
+    const std::vector<int>& offsets, CellCostRecorder* recorder)
 {
   const int gdim = mesh.geometry().dim();
   const int tdim = mesh.topology().dim();
   mesh.create_entities(tdim - 1);
   mesh.create_connectivity(tdim - 1, tdim);
+  const mesh::ConnectivityView facet_cell
+      = mesh.topology().connectivity_view(tdim - 1, tdim);
+  const mesh::ConnectivityView cell_facet
+      = mesh.topology().connectivity_view(tdim, tdim - 1);
 
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
@@ -223,29 +231,30 @@ PetscScalar fem::impl::assemble_interior_facets(
   PetscScalar cell_value, value(0);
   for (const auto& facet_index : active_facets)
   {
-    const mesh::Facet facet(mesh, facet_index);
-
-    assert(facet.num_global_entities(tdim) == 2);
+    assert(facet_cell.size_global(facet_index) == 2);
 
     // TODO: check ghosting sanity?
 
-    // Create attached cell
-    const mesh::Cell cell0(mesh, facet.entities(tdim)[0]);
-    const mesh::Cell cell1(mesh, facet.entities(tdim)[1]);
+    // Create attached cells
+    const std::int32_t* cells = facet_cell.connections(facet_index);
+    const std::int32_t cell0_index = cells[0];
+    const std::int32_t cell1_index = cells[1];
+    const mesh::Cell cell0(mesh, cell0_index);
+    const mesh::Cell cell1(mesh, cell1_index);
 
     // Get local index of facet with respect to the cell
-    const int local_facet[2] = {cell0.index(facet), cell1.index(facet)};
+    const int local_facet[2]
+        = {cell_facet.local_index(cell0_index, facet_index),
+           cell_facet.local_index(cell1_index, facet_index)};
     const int orient[2] = {0, 0};
 
     // Get cell vertex coordinates
-    const int cell0_index = cell0.index();
-    const int cell1_index = cell1.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
       {
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell0_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g.connections(cell0_index)[i], j);
         coordinate_dofs(i + num_dofs_g, j)
-            = x_g(cell_g[pos_g[cell1_index] + i], j);
+            = x_g(cell_g.connections(cell1_index)[i], j);
       }
 
     // Update coefficients
@@ -266,8 +275,16 @@ PetscScalar fem::impl::assemble_interior_facets(
                                 cell1, coordinate_dofs1);
     }
 
+    const double t0 = recorder ? CellCostRecorder::now() : 0.0;
     fn(&cell_value, coeff_array.data(), coordinate_dofs.data(), local_facet,
        orient);
+    if (recorder)
+    {
+      // Split time between the two cells
+      const double t = 0.5 * (CellCostRecorder::now() - t0);
+      recorder->add(cell0_index, t);
+      recorder->add(cell1_index, t);
+    }
     value += cell_value;
   }
 
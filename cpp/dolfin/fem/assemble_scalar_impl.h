@@ -27,6 +27,7 @@ class Mesh;
 
 namespace fem
 {
+class CellCostRecorder;
 class DirichletBC;
 class Form;
 class GenericDofMap;
@@ -43,7 +44,7 @@ PetscScalar assemble_cells(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& fn,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets);
+    const std::vector<int>& offsets, CellCostRecorder* recorder);
 
 /// Execute kernel over exterior facets and accumulate result
 PetscScalar assemble_exterior_facets(
@@ -51,7 +52,7 @@ PetscScalar assemble_exterior_facets(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& fn,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets);
+    const std::vector<int>& offsets, CellCostRecorder* recorder);
 
 /// Assemble functional over interior facets
 PetscScalar assemble_interior_facets(
@@ -59,7 +60,7 @@ PetscScalar assemble_interior_facets(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& fn,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets);
+    const std::vector<int>& offsets, CellCostRecorder* recorder);
 
 } // namespace impl
 } // namespace fem
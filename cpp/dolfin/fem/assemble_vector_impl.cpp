@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "assemble_vector_impl.h"
+#include "CellCostRecorder.h"
 #include "DirichletBC.h"
 #include "Form.h"
 #include "GenericDofMap.h"
@@ -13,7 +14,7 @@
 #include <dolfin/function/Function.h>
 #include <dolfin/function/FunctionSpace.h>
 #include <dolfin/mesh/Cell.h>
-#include <dolfin/mesh/Facet.h>
+#include <dolfin/mesh/Connectivity.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshIterator.h>
 #include <petscsys.h>
@@ -69,10 +70,7 @@ void _lift_bc_cells(
   const int gdim = mesh.geometry().dim();
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
@@ -91,10 +89,11 @@ void _lift_bc_cells(
   {
     // Check that cell is not a ghost
     assert(!cell.is_ghost());
+    const int cell_index = cell.index();
 
     // Get dof maps for cell
     const Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap1
-        = dofmap1.cell_dofs(cell.index());
+        = dofmap1.cell_dofs(cell_index);
 
     // Check if bc is applied to cell
     bool has_bc = false;
@@ -111,14 +110,13 @@ void _lift_bc_cells(
       continue;
 
     // Get cell vertex coordinates
-    const int cell_index = cell.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g.connections(cell_index)[i], j);
 
     // Size data structure for assembly
     const Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap0
-        = dofmap0.cell_dofs(cell.index());
+        = dofmap0.cell_dofs(cell_index);
 
     // TODO: Move gathering of coefficients outside of main assembly
     // loop
@@ -170,6 +168,10 @@ void _lift_bc_exterior_facets(
   const int tdim = mesh.topology().dim();
   mesh.create_entities(tdim - 1);
   mesh.create_connectivity(tdim - 1, tdim);
+  const mesh::ConnectivityView facet_cell
+      = mesh.topology().connectivity_view(tdim - 1, tdim);
+  const mesh::ConnectivityView cell_facet
+      = mesh.topology().connectivity_view(tdim, tdim - 1);
 
   // Get dofmap for columns and rows of a
   assert(a.function_space(0));
@@ -201,10 +203,7 @@ void _lift_bc_exterior_facets(
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
@@ -217,24 +216,26 @@ void _lift_bc_exterior_facets(
       Ae;
   Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be;
 
-  // Iterate over all cells
-  for (const mesh::Facet& facet : mesh::MeshRange<mesh::Facet>(mesh))
+  // Iterate over all facets
+  const std::int32_t num_facets = mesh.topology().ghost_offset(tdim - 1);
+  for (std::int32_t f = 0; f < num_facets; ++f)
   {
-    if (facet.num_global_entities(tdim) != 1)
+    if (facet_cell.size_global(f) != 1)
       continue;
 
     // FIXME: sort out ghosts
 
     // Create attached cell
-    mesh::Cell cell(mesh, facet.entities(tdim)[0]);
+    const std::int32_t cell_index = facet_cell.connections(f)[0];
+    mesh::Cell cell(mesh, cell_index);
 
     // Get local index of facet with respect to the cell
-    const int local_facet = cell.index(facet);
+    const int local_facet = cell_facet.local_index(cell_index, f);
     const int orient = 0;
 
     // Get dof maps for cell
     const Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap1
-        = dofmap1.cell_dofs(cell.index());
+        = dofmap1.cell_dofs(cell_index);
 
     // Check if bc is applied to cell
     bool has_bc = false;
@@ -251,14 +252,13 @@ void _lift_bc_exterior_facets(
       continue;
 
     // Get cell vertex coordinates
-    const int cell_index = cell.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g.connections(cell_index)[i], j);
 
     // Size data structure for assembly
     const Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap0
-        = dofmap0.cell_dofs(cell.index());
+        = dofmap0.cell_dofs(cell_index);
 
     // TODO: Move gathering of coefficients outside of main assembly
     // loop
@@ -315,6 +315,9 @@ void fem::impl::assemble_vector(
     coeff_fn[i] = coefficients.get(i).get();
   std::vector<int> c_offsets = coefficients.offsets();
 
+  // Recorder for kernel times (if any)
+  CellCostRecorder* recorder = L.cell_cost_recorder().get();
+
   const FormIntegrals& integrals = L.integrals();
   using type = fem::FormIntegrals::Type;
   for (int i = 0; i < integrals.num_integrals(type::cell); ++i)
@@ -324,7 +327,8 @@ void fem::impl::assemble_vector(
     const std::vector<std::int32_t>& active_cells
         = integrals.integral_domains(type::cell, i);
     fem::impl::assemble_cells(b, mesh, active_cells, dof_array,
-                              num_dofs_per_cell, fn, coeff_fn, c_offsets);
+                              num_dofs_per_cell, fn, coeff_fn, c_offsets,
+                              recorder);
   }
 
   for (int i = 0; i < integrals.num_integrals(type::exterior_facet); ++i)
@@ -334,7 +338,7 @@ void fem::impl::assemble_vector(
     const std::vector<std::int32_t>& active_facets
         = integrals.integral_domains(type::exterior_facet, i);
     fem::impl::assemble_exterior_facets(b, mesh, active_facets, dofmap, fn,
-                                        coeff_fn, c_offsets);
+                                        coeff_fn, c_offsets, recorder);
   }
 
   for (int i = 0; i < integrals.num_integrals(type::interior_facet); ++i)
@@ -344,7 +348,7 @@ void fem::impl::assemble_vector(
     const std::vector<std::int32_t>& active_facets
         = integrals.integral_domains(type::interior_facet, i);
     fem::impl::assemble_interior_facets(b, mesh, active_facets, dofmap, fn,
-                                        coeff_fn, c_offsets);
+                                        coeff_fn, c_offsets, recorder);
   }
 }
 //-----------------------------------------------------------------------------
@@ -356,17 +360,14 @@ void fem::impl::assemble_cells(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& kernel,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets)
+    const std::vector<int>& offsets, CellCostRecorder* recorder)
 {
   const int gdim = mesh.geometry().dim();
 
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
@@ -388,7 +389,7 @@ void fem::impl::assemble_cells(
     // Get cell coordinates/geometry
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g.connections(cell_index)[i], j);
 
     // FIXME: Move this outside of inner assembly loop
     // Update coefficients
@@ -399,8 +400,11 @@ void fem::impl::assemble_cells(
     }
 
     // Tabulate vector for cell
+    const double t0 = recorder ? CellCostRecorder::now() : 0.0;
     kernel(be.data(), coeff_array.data(), coordinate_dofs.data(), nullptr,
            &orientation);
+    if (recorder)
+      recorder->add(cell_index, CellCostRecorder::now() - t0);
 
     // Add local cell vector to global vector
     for (Eigen::Index i = 0; i < num_dofs_per_cell; ++i)
@@ -415,20 +419,21 @@ void fem::impl::assemble_exterior_facets(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& fn,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets)
+    const std::vector<int>& offsets, CellCostRecorder* recorder)
 {
   const int gdim = mesh.geometry().dim();
   const int tdim = mesh.topology().dim();
   mesh.create_entities(tdim - 1);
   mesh.create_connectivity(tdim - 1, tdim);
+  const mesh::ConnectivityView facet_cell
+      = mesh.topology().connectivity_view(tdim - 1, tdim);
+  const mesh::ConnectivityView cell_facet
+      = mesh.topology().connectivity_view(tdim, tdim - 1);
 
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
@@ -442,24 +447,23 @@ void fem::impl::assemble_exterior_facets(
 
   for (const auto& facet_index : active_facets)
   {
-    const mesh::Facet facet(mesh, facet_index);
-
-    assert(facet.num_global_entities(tdim) == 1);
+    assert(facet_cell.size_global(facet_index) == 1);
 
     // TODO: check ghosting sanity?
 
     // Create attached cell
-    const mesh::Cell cell(mesh, facet.entities(tdim)[0]);
+    const std::int32_t cell_index = facet_cell.connections(facet_index)[0];
+    const mesh::Cell cell(mesh, cell_index);
 
     // Get local index of facet with respect to the cell
-    const int local_facet = cell.index(facet);
+    const int local_facet = cell_facet.local_index(cell_index, facet_index);
+    assert(local_facet >= 0);
     const int orient = 0;
 
     // Get cell vertex coordinates
-    const int cell_index = cell.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g.connections(cell_index)[i], j);
 
     // Get dof map for cell
     const Eigen::Map<const Eigen::Array<PetscInt, Eigen::Dynamic, 1>> dmap
@@ -476,8 +480,11 @@ void fem::impl::assemble_exterior_facets(
 
     // Tabulate element vector
     be.setZero(dmap.size());
+    const double t0 = recorder ? CellCostRecorder::now() : 0.0;
     fn(be.data(), coeff_array.data(), coordinate_dofs.data(), &local_facet,
        &orient);
+    if (recorder)
+      recorder->add(cell_index, CellCostRecorder::now() - t0);
 
     // Add element vector to global vector
     for (Eigen::Index i = 0; i < dmap.size(); ++i)
@@ -492,20 +499,21 @@ void fem::impl::assemble_interior_facets(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& fn,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets)
+    const std::vector<int>& offsets, CellCostRecorder* recorder)
 {
   const int gdim = mesh.geometry().dim();
   const int tdim = mesh.topology().dim();
   mesh.create_entities(tdim - 1);
   mesh.create_connectivity(tdim - 1, tdim);
+  const mesh::ConnectivityView facet_cell
+      = mesh.topology().connectivity_view(tdim - 1, tdim);
+  const mesh::ConnectivityView cell_facet
+      = mesh.topology().connectivity_view(tdim, tdim - 1);
 
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
@@ -519,29 +527,30 @@ void fem::impl::assemble_interior_facets(
 
   for (const auto& facet_index : active_facets)
   {
-    const mesh::Facet facet(mesh, facet_index);
-
-    assert(facet.num_global_entities(tdim) == 2);
+    assert(facet_cell.size_global(facet_index) == 2);
 
     // TODO: check ghosting sanity?
 
     // Create attached cells
-    const mesh::Cell cell0(mesh, facet.entities(tdim)[0]);
-    const mesh::Cell cell1(mesh, facet.entities(tdim)[1]);
+    const std::int32_t* cells = facet_cell.connections(facet_index);
+    const std::int32_t cell_index0 = cells[0];
+    const std::int32_t cell_index1 = cells[1];
+    const mesh::Cell cell0(mesh, cell_index0);
+    const mesh::Cell cell1(mesh, cell_index1);
 
     // Get local index of facet with respect to the cell
-    const int local_facet[2] = {cell0.index(facet), cell1.index(facet)};
+    const int local_facet[2]
+        = {cell_facet.local_index(cell_index0, facet_index),
+           cell_facet.local_index(cell_index1, facet_index)};
     const int orient[2] = {0, 0};
 
     // Get cell vertex coordinates
-    const int cell_index0 = cell0.index();
-    const int cell_index1 = cell1.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
       {
-        coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index0] + i], j);
+        coordinate_dofs(i, j) = x_g(cell_g.connections(cell_index0)[i], j);
         coordinate_dofs(i + num_dofs_g, j)
-            = x_g(cell_g[pos_g[cell_index1] + i], j);
+            = x_g(cell_g.connections(cell_index1)[i], j);
       }
 
     // Get dofmaps for cell
@@ -572,8 +581,16 @@ void fem::impl::assemble_interior_facets(
 
     // Tabulate element vector
     be.setZero(dmap0.size() + dmap1.size());
+    const double t0 = recorder ? CellCostRecorder::now() : 0.0;
     fn(be.data(), coeff_array.data(), coordinate_dofs.data(), local_facet,
        orient);
+    if (recorder)
+    {
+      // Split time between the two cells
+      const double t = 0.5 * (CellCostRecorder::now() - t0);
+      recorder->add(cell_index0, t);
+      recorder->add(cell_index1, t);
+    }
 
     // Add element vector to global vector
     for (Eigen::Index i = 0; i < dmap0.size(); ++i)
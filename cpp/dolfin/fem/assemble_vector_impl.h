@@ -27,6 +27,7 @@ class Mesh;
 
 namespace fem
 {
+class CellCostRecorder;
 class DirichletBC;
 class Form;
 class GenericDofMap;
@@ -48,7 +49,7 @@ void assemble_cells(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& kernel,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets);
+    const std::vector<int>& offsets, CellCostRecorder* recorder);
 
 /// Execute kernel over cells and accumulate result in vector
 void assemble_exterior_facets(
@@ -58,7 +59,7 @@ void assemble_exterior_facets(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& fn,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets);
+    const std::vector<int>& offsets, CellCostRecorder* recorder);
 
 /// Assemble linear form interior facet integrals into an Eigen vector
 void assemble_interior_facets(
@@ -68,7 +69,7 @@ void assemble_interior_facets(
     const std::function<void(PetscScalar*, const PetscScalar*, const double*,
                              const int*, const int*)>& fn,
     const std::vector<const function::Function*>& coefficients,
-    const std::vector<int>& offsets);
+    const std::vector<int>& offsets, CellCostRecorder* recorder);
 
 
 /// Modify b such that:
@@ -11,6 +11,7 @@ namespace dolfin
 
 // DOLFIN fem interface
 
+#include <dolfin/fem/CellCostRecorder.h>
 #include <dolfin/fem/CoordinateMapping.h>
 #include <dolfin/fem/DirichletBC.h>
 #include <dolfin/fem/DiscreteOperators.h>
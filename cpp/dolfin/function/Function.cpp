@@ -18,8 +18,10 @@
 #include <dolfin/geometry/BoundingBoxTree.h>
 #include <dolfin/la/PETScVector.h>
 #include <dolfin/la/utils.h>
+#include <dolfin/mesh/Connectivity.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshIterator.h>
+#include <dolfin/mesh/MigrationPlan.h>
 #include <dolfin/mesh/Vertex.h>
 #include <unsupported/Eigen/CXX11/Tensor>
 #include <utility>
@@ -121,6 +123,67 @@ Function Function::collapse() const
   return Function(function_space_new, vector_new.vec());
 }
 //-----------------------------------------------------------------------------
+Function Function::migrate(const mesh::MigrationPlan& plan,
+                           std::shared_ptr<const FunctionSpace> V) const
+{
+  assert(V);
+  assert(V->element());
+  assert(_function_space->element());
+  if (V->element()->signature() != _function_space->element()->signature())
+  {
+    throw std::runtime_error(
+        "Cannot migrate Function to a space with a different element");
+  }
+
+  assert(_function_space->mesh());
+  assert(V->mesh());
+  const int tdim = V->mesh()->topology().dim();
+  if (_function_space->mesh()->num_entities(tdim) != plan.num_cells_old()
+      or V->mesh()->num_entities(tdim) != plan.num_cells_new())
+  {
+    throw std::runtime_error("Function spaces do not match migration plan");
+  }
+
+  // Tabulate expansion coefficients of each cell (including ghosts)
+  assert(_function_space->dofmap());
+  const fem::GenericDofMap& dofmap = *_function_space->dofmap();
+  const std::size_t num_cell_dofs = dofmap.max_element_dofs();
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coefficients(plan.num_cells_old(), num_cell_dofs);
+  {
+    la::VecReadWrapper v_wrap(_vector.vec());
+    Eigen::Map<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> x
+        = v_wrap.x;
+    for (std::int32_t c = 0; c < plan.num_cells_old(); ++c)
+    {
+      auto dofs = dofmap.cell_dofs(c);
+      for (Eigen::Index i = 0; i < dofs.size(); ++i)
+        coefficients(c, i) = x[dofs[i]];
+    }
+  }
+
+  // Move coefficients to the cells of the new mesh
+  coefficients = plan.migrate(coefficients);
+
+  // Set all local (owned and ghost) entries of the new vector from the
+  // cells that contain them
+  Function u(V);
+  assert(V->dofmap());
+  const fem::GenericDofMap& dofmap_new = *V->dofmap();
+  {
+    la::VecWrapper v_wrap(u.vector().vec());
+    Eigen::Map<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> x = v_wrap.x;
+    for (std::int32_t c = 0; c < plan.num_cells_new(); ++c)
+    {
+      auto dofs = dofmap_new.cell_dofs(c);
+      for (Eigen::Index i = 0; i < dofs.size(); ++i)
+        x[dofs[i]] = coefficients(c, i);
+    }
+  }
+
+  return u;
+}
+//-----------------------------------------------------------------------------
 std::shared_ptr<const FunctionSpace> Function::function_space() const
 {
   assert(_function_space);
@@ -224,10 +287,7 @@ void Function::eval(
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
@@ -237,7 +297,7 @@ void Function::eval(
   const int cell_index = cell.index();
   for (int i = 0; i < num_dofs_g; ++i)
     for (int j = 0; j < gdim; ++j)
-      coordinate_dofs(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+      coordinate_dofs(i, j) = x_g(cell_g.connections(cell_index)[i], j);
 
   restrict(coefficients.data(), cell, coordinate_dofs);
 
@@ -381,10 +441,7 @@ Function::compute_point_values(const mesh::Mesh& mesh) const
   // Prepare cell geometry
   const mesh::Connectivity& connectivity_g
       = mesh.coordinate_dofs().entity_points();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> pos_g
-      = connectivity_g.entity_positions();
-  const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> cell_g
-      = connectivity_g.connections();
+  const mesh::ConnectivityView cell_g(connectivity_g);
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = connectivity_g.size(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
@@ -401,7 +458,7 @@ Function::compute_point_values(const mesh::Mesh& mesh) const
     const int cell_index = cell.index();
     for (int i = 0; i < num_dofs_g; ++i)
       for (int j = 0; j < gdim; ++j)
-        x(i, j) = x_g(cell_g[pos_g[cell_index] + i], j);
+        x(i, j) = x_g(cell_g.connections(cell_index)[i], j);
 
     values.resize(x.rows(), value_size_loc);
 
@@ -26,6 +26,7 @@ namespace mesh
 {
 class Cell;
 class Mesh;
+class MigrationPlan;
 } // namespace mesh
 
 namespace function
@@ -85,6 +86,20 @@ public:
   /// Function
   Function collapse() const;
 
+  /// Move the function to a mesh that has been rebalanced (see
+  /// mesh::rebalance), without interpolation. The expansion
+  /// coefficients of each cell are copied from the process that owned
+  /// the cell. The ghost values of the vector must be up to date.
+  ///
+  /// @param plan (_mesh::MigrationPlan_)
+  ///         The plan for moving cell data to the new mesh.
+  /// @param V (_FunctionSpace_)
+  ///         Function space on the new mesh, with the same element.
+  /// @returns _Function_
+  ///         The function on the new mesh.
+  Function migrate(const mesh::MigrationPlan& plan,
+                   std::shared_ptr<const FunctionSpace> V) const;
+
   /// Return shared pointer to function space
   ///
   /// @returns _FunctionSpace_
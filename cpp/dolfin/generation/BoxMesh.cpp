@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "BoxMesh.h"
+#include "utils.h"
 #include <Eigen/Dense>
 #include <cfloat>
 #include <cmath>
@@ -18,24 +19,11 @@ using namespace dolfin::generation;
 namespace
 {
 //-----------------------------------------------------------------------------
-mesh::Mesh build_tet(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
-                     std::array<std::size_t, 3> n,
-                     const mesh::GhostMode ghost_mode)
+// Create the points of the planes [iz0, iz1) of the box spanned by p
+EigenRowArrayXXd create_tet_geometry(const std::array<Eigen::Vector3d, 2>& p,
+                                     std::array<std::size_t, 3> n,
+                                     std::size_t iz0, std::size_t iz1)
 {
-  common::Timer timer("Build BoxMesh");
-
-  // Receive mesh if not rank 0
-  if (dolfin::MPI::rank(comm) != 0)
-  {
-    Eigen::Array<double, 0, 3, Eigen::RowMajor> geom(
-        0, 3);
-    Eigen::Array<std::int64_t, 0, 4, Eigen::RowMajor>
-        topo(0, 4);
-
-    return mesh::Partitioning::build_distributed_mesh(
-        comm, mesh::CellType::Type::tetrahedron, geom, topo, {}, ghost_mode);
-  }
-
   // Extract data
   const Eigen::Vector3d& p0 = p[0];
   const Eigen::Vector3d& p1 = p[1];
@@ -61,25 +49,10 @@ mesh::Mesh build_tet(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
   const double f = z1;
   const double ef = (f - e) / static_cast<double>(nz);
 
-  if (std::abs(x0 - x1) < 2.0 * DBL_EPSILON
-      || std::abs(y0 - y1) < 2.0 * DBL_EPSILON
-      || std::abs(z0 - z1) < 2.0 * DBL_EPSILON)
-  {
-    throw std::runtime_error(
-        "Box seems to have zero width, height or depth. Check dimensions");
-  }
-
-  if (nx < 1 || ny < 1 || nz < 1)
-  {
-    throw std::runtime_error(
-        "BoxMesh has non-positive number of vertices in some dimension");
-  }
-
-  EigenRowArrayXXd geom((nx + 1) * (ny + 1) * (nz + 1), 3);
-  EigenRowArrayXXi64 topo(6 * nx * ny * nz, 4);
+  EigenRowArrayXXd geom((nx + 1) * (ny + 1) * (iz1 - iz0), 3);
 
   std::size_t vertex = 0;
-  for (std::size_t iz = 0; iz <= nz; ++iz)
+  for (std::size_t iz = iz0; iz < iz1; ++iz)
   {
     const double z = e + ef * static_cast<double>(iz);
     for (std::size_t iy = 0; iy <= ny; ++iy)
@@ -94,9 +67,21 @@ mesh::Mesh build_tet(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
     }
   }
 
+  return geom;
+}
+//-----------------------------------------------------------------------------
+// Create the tetrahedra of the layers [iz0, iz1)
+EigenRowArrayXXi64 create_tet_topology(std::array<std::size_t, 3> n,
+                                       std::size_t iz0, std::size_t iz1)
+{
+  const std::size_t nx = n[0];
+  const std::size_t ny = n[1];
+
+  EigenRowArrayXXi64 topo(6 * nx * ny * (iz1 - iz0), 4);
+
   // Create tetrahedra
   std::size_t cell = 0;
-  for (std::size_t iz = 0; iz < nz; ++iz)
+  for (std::size_t iz = iz0; iz < iz1; ++iz)
   {
     for (std::size_t iy = 0; iy < ny; ++iy)
     {
@@ -128,29 +113,18 @@ mesh::Mesh build_tet(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
     }
   }
 
-  return mesh::Partitioning::build_distributed_mesh(
-      comm, mesh::CellType::Type::tetrahedron, geom, topo, {}, ghost_mode);
+  return topo;
 }
 //-----------------------------------------------------------------------------
-mesh::Mesh build_hex(MPI_Comm comm, std::array<std::size_t, 3> n,
-                     const mesh::GhostMode ghost_mode)
+// Create the points of the planes [iz0, iz1) of the unit cube
+EigenRowArrayXXd create_hex_geometry(std::array<std::size_t, 3> n,
+                                     std::size_t iz0, std::size_t iz1)
 {
-  // Receive mesh if not rank 0
-  if (dolfin::MPI::rank(comm) != 0)
-  {
-    EigenRowArrayXXd geom(0, 3);
-    EigenRowArrayXXi64 topo(0, 8);
-
-    return mesh::Partitioning::build_distributed_mesh(
-        comm, mesh::CellType::Type::hexahedron, geom, topo, {}, ghost_mode);
-  }
-
   const std::size_t nx = n[0];
   const std::size_t ny = n[1];
   const std::size_t nz = n[2];
 
-  EigenRowArrayXXd geom((nx + 1) * (ny + 1) * (nz + 1), 3);
-  EigenRowArrayXXi64 topo(nx * ny * nz, 8);
+  EigenRowArrayXXd geom((nx + 1) * (ny + 1) * (iz1 - iz0), 3);
 
   const double a = 0.0;
   const double b = 1.0;
@@ -161,7 +135,7 @@ mesh::Mesh build_hex(MPI_Comm comm, std::array<std::size_t, 3> n,
 
   // Create main vertices:
   std::size_t vertex = 0;
-  for (std::size_t iz = 0; iz <= nz; ++iz)
+  for (std::size_t iz = iz0; iz < iz1; ++iz)
   {
     const double z
         = e + ((static_cast<double>(iz)) * (f - e) / static_cast<double>(nz));
@@ -180,9 +154,21 @@ mesh::Mesh build_hex(MPI_Comm comm, std::array<std::size_t, 3> n,
     }
   }
 
+  return geom;
+}
+//-----------------------------------------------------------------------------
+// Create the hexahedra of the layers [iz0, iz1)
+EigenRowArrayXXi64 create_hex_topology(std::array<std::size_t, 3> n,
+                                       std::size_t iz0, std::size_t iz1)
+{
+  const std::size_t nx = n[0];
+  const std::size_t ny = n[1];
+
+  EigenRowArrayXXi64 topo(nx * ny * (iz1 - iz0), 8);
+
   // Create cuboids
   std::size_t cell = 0;
-  for (std::size_t iz = 0; iz < nz; ++iz)
+  for (std::size_t iz = iz0; iz < iz1; ++iz)
   {
     for (std::size_t iy = 0; iy < ny; ++iy)
     {
@@ -202,8 +188,109 @@ mesh::Mesh build_hex(MPI_Comm comm, std::array<std::size_t, 3> n,
     }
   }
 
+  return topo;
+}
+//-----------------------------------------------------------------------------
+mesh::Mesh build_tet(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
+                     std::array<std::size_t, 3> n,
+                     const mesh::GhostMode ghost_mode, std::string partitioner)
+{
+  common::Timer timer("Build BoxMesh");
+
+  const Eigen::Vector3d& p0 = p[0];
+  const Eigen::Vector3d& p1 = p[1];
+  if (std::abs(p0[0] - p1[0]) < 2.0 * DBL_EPSILON
+      || std::abs(p0[1] - p1[1]) < 2.0 * DBL_EPSILON
+      || std::abs(p0[2] - p1[2]) < 2.0 * DBL_EPSILON)
+  {
+    throw std::runtime_error(
+        "Box seems to have zero width, height or depth. Check dimensions");
+  }
+
+  const std::size_t nx = n[0];
+  const std::size_t ny = n[1];
+  const std::size_t nz = n[2];
+  if (nx < 1 || ny < 1 || nz < 1)
+  {
+    throw std::runtime_error(
+        "BoxMesh has non-positive number of vertices in some dimension");
+  }
+
+  // Each process creates a block of layers of cells in the
+  // z-direction
+  if (partitioner == "block")
+  {
+    return generation::build_layered_mesh(
+        comm, mesh::CellType::Type::tetrahedron, nz, (nx + 1) * (ny + 1),
+        [&p, n](std::int64_t iz0, std::int64_t iz1) {
+          return create_tet_geometry(p, n, iz0, iz1);
+        },
+        [n](std::int64_t iz0, std::int64_t iz1) {
+          return create_tet_topology(n, iz0, iz1);
+        },
+        ghost_mode);
+  }
+
+  // Receive mesh if not rank 0
+  if (dolfin::MPI::rank(comm) != 0)
+  {
+    Eigen::Array<double, 0, 3, Eigen::RowMajor> geom(
+        0, 3);
+    Eigen::Array<std::int64_t, 0, 4, Eigen::RowMajor>
+        topo(0, 4);
+
+    return mesh::Partitioning::build_distributed_mesh(
+        comm, mesh::CellType::Type::tetrahedron, geom, topo, {}, ghost_mode,
+        partitioner);
+  }
+
+  const EigenRowArrayXXd geom = create_tet_geometry(p, n, 0, nz + 1);
+  const EigenRowArrayXXi64 topo = create_tet_topology(n, 0, nz);
+
+  return mesh::Partitioning::build_distributed_mesh(
+      comm, mesh::CellType::Type::tetrahedron, geom, topo, {}, ghost_mode,
+      partitioner);
+}
+//-----------------------------------------------------------------------------
+mesh::Mesh build_hex(MPI_Comm comm, std::array<std::size_t, 3> n,
+                     const mesh::GhostMode ghost_mode, std::string partitioner)
+{
+  const std::size_t nx = n[0];
+  const std::size_t ny = n[1];
+  const std::size_t nz = n[2];
+
+  // Each process creates a block of layers of cells in the
+  // z-direction
+  if (partitioner == "block")
+  {
+    return generation::build_layered_mesh(
+        comm, mesh::CellType::Type::hexahedron, nz, (nx + 1) * (ny + 1),
+        [n](std::int64_t iz0, std::int64_t iz1) {
+          return create_hex_geometry(n, iz0, iz1);
+        },
+        [n](std::int64_t iz0, std::int64_t iz1) {
+          return create_hex_topology(n, iz0, iz1);
+        },
+        ghost_mode);
+  }
+
+  // Receive mesh if not rank 0
+  if (dolfin::MPI::rank(comm) != 0)
+  {
+    EigenRowArrayXXd geom(0, 3);
+    EigenRowArrayXXi64 topo(0, 8);
+
+    return mesh::Partitioning::build_distributed_mesh(
+        comm, mesh::CellType::Type::hexahedron, geom, topo, {}, ghost_mode,
+        partitioner);
+  }
+
+  const EigenRowArrayXXd geom = create_hex_geometry(n, 0, nz + 1);
+  const EigenRowArrayXXi64 topo = create_hex_topology(n, 0, nz);
+
   return mesh::Partitioning::build_distributed_mesh(
-      comm, mesh::CellType::Type::hexahedron, geom, topo, {}, ghost_mode);
+      comm, mesh::CellType::Type::hexahedron, geom, topo, {}, ghost_mode,
+      partitioner);
 }
 //-----------------------------------------------------------------------------
 
@@ -214,16 +301,17 @@ mesh::Mesh BoxMesh::create(MPI_Comm comm,
                            const std::array<Eigen::Vector3d, 2>& p,
                            std::array<std::size_t, 3> n,
                            mesh::CellType::Type cell_type,
-                           const mesh::GhostMode ghost_mode)
+                           const mesh::GhostMode ghost_mode,
+                           std::string partitioner)
 {
   if (cell_type == mesh::CellType::Type::tetrahedron)
-    return build_tet(comm, p, n, ghost_mode);
+    return build_tet(comm, p, n, ghost_mode, partitioner);
   else if (cell_type == mesh::CellType::Type::hexahedron)
-    return build_hex(comm, n, ghost_mode);
+    return build_hex(comm, n, ghost_mode, partitioner);
   else
     throw std::runtime_error("Generate rectangle mesh. Wrong cell type");
 
   // Will never reach this point
-  return build_tet(comm, p, n, ghost_mode);
+  return build_tet(comm, p, n, ghost_mode, partitioner);
 }
 //-----------------------------------------------------------------------------
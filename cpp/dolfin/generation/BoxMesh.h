@@ -11,6 +11,7 @@
 #include <dolfin/common/MPI.h>
 #include <dolfin/mesh/CellType.h>
 #include <dolfin/mesh/Mesh.h>
+#include <string>
 
 namespace dolfin
 {
@@ -39,6 +40,14 @@ public:
   ///         Number of cells in each direction.
   /// @param cell_type
   ///         Tetrahedron or hexahedron
+  /// @param ghost_mode
+  ///         Ghost mode
+  /// @param partitioner
+  ///         Partitioner ("SCOTCH", "ParMETIS" or "Hilbert") for a mesh
+  ///         created on process 0, or "block" to create a block of
+  ///         layers of cells in the z-direction on each process without
+  ///         partitioning (requires at least as many layers as
+  ///         processes)
   ///
   /// @code{.cpp}
   ///         // Mesh with 8 cells in each direction on the
@@ -51,7 +60,8 @@ public:
                            const std::array<Eigen::Vector3d, 2>& p,
                            std::array<std::size_t, 3> n,
                            mesh::CellType::Type cell_type,
-                           const mesh::GhostMode ghost_mode);
+                           const mesh::GhostMode ghost_mode,
+                           std::string partitioner = "SCOTCH");
 };
 } // namespace generation
 } // namespace dolfin
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "RectangleMesh.h"
+#include "utils.h"
 #include <Eigen/Dense>
 #include <cfloat>
 #include <cmath>
@@ -17,19 +18,131 @@ using namespace dolfin::generation;
 namespace
 {
 //-----------------------------------------------------------------------------
-mesh::Mesh build_tri(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
-                     std::array<std::size_t, 2> n,
-                     const mesh::GhostMode ghost_mode, std::string diagonal)
+// Create the main vertices of the rows [iy0, iy1) of the rectangle
+// with lower-left corner p0 and upper-right corner p1
+EigenRowArrayXXd create_geometry(const Eigen::Vector3d& p0,
+                                 const Eigen::Vector3d& p1,
+                                 std::array<std::size_t, 2> n, std::size_t iy0,
+                                 std::size_t iy1)
 {
-  // Receive mesh if not rank 0
-  if (dolfin::MPI::rank(comm) != 0)
+  const std::size_t nx = n[0];
+  const std::size_t ny = n[1];
+
+  const double a = p0[0];
+  const double b = p1[0];
+  const double ab = (b - a) / static_cast<double>(nx);
+  const double c = p0[1];
+  const double d = p1[1];
+  const double cd = (d - c) / static_cast<double>(ny);
+
+  EigenRowArrayXXd geom((nx + 1) * (iy1 - iy0), 2);
+
+  // Create main vertices
+  std::size_t vertex = 0;
+  for (std::size_t iy = iy0; iy < iy1; iy++)
   {
-    EigenRowArrayXXd geom(0, 2);
-    EigenRowArrayXXi64 topo(0, 3);
-    return mesh::Partitioning::build_distributed_mesh(
-        comm, mesh::CellType::Type::triangle, geom, topo, {}, ghost_mode);
+    const double x1 = c + cd * static_cast<double>(iy);
+    for (std::size_t ix = 0; ix <= nx; ix++)
+    {
+      geom(vertex, 0) = a + ab * static_cast<double>(ix);
+      geom(vertex, 1) = x1;
+      ++vertex;
+    }
   }
 
+  return geom;
+}
+//-----------------------------------------------------------------------------
+// Create the triangles of the rows [iy0, iy1), for all diagonals
+// except "crossed"
+EigenRowArrayXXi64 create_tri_topology(std::array<std::size_t, 2> n,
+                                       std::size_t iy0, std::size_t iy1,
+                                       std::string diagonal)
+{
+  const std::size_t nx = n[0];
+
+  EigenRowArrayXXi64 topo(2 * nx * (iy1 - iy0), 3);
+
+  std::size_t cell = 0;
+  std::string local_diagonal = diagonal;
+  for (std::size_t iy = iy0; iy < iy1; iy++)
+  {
+    // Set up alternating diagonal
+    if (diagonal == "right/left")
+    {
+      if (iy % 2)
+        local_diagonal = "right";
+      else
+        local_diagonal = "left";
+    }
+    if (diagonal == "left/right")
+    {
+      if (iy % 2)
+        local_diagonal = "left";
+      else
+        local_diagonal = "right";
+    }
+
+    for (std::size_t ix = 0; ix < nx; ix++)
+    {
+      const std::size_t v0 = iy * (nx + 1) + ix;
+      const std::size_t v1 = v0 + 1;
+      const std::size_t v2 = v0 + (nx + 1);
+      const std::size_t v3 = v1 + (nx + 1);
+
+      if (local_diagonal == "left")
+      {
+        topo.row(cell) << v0, v1, v2;
+        ++cell;
+        topo.row(cell) << v1, v2, v3;
+        ++cell;
+        if (diagonal == "right/left" || diagonal == "left/right")
+          local_diagonal = "right";
+      }
+      else
+      {
+        topo.row(cell) << v0, v1, v3;
+        ++cell;
+        topo.row(cell) << v0, v2, v3;
+        ++cell;
+        if (diagonal == "right/left" || diagonal == "left/right")
+          local_diagonal = "left";
+      }
+    }
+  }
+
+  return topo;
+}
+//-----------------------------------------------------------------------------
+// Create the quadrilaterals of the rows [iy0, iy1)
+EigenRowArrayXXi64 create_quad_topology(std::array<std::size_t, 2> n,
+                                        std::size_t iy0, std::size_t iy1)
+{
+  const std::size_t nx = n[0];
+
+  EigenRowArrayXXi64 topo(nx * (iy1 - iy0), 4);
+
+  // Create rectangles
+  std::size_t cell = 0;
+  for (std::size_t iy = iy0; iy < iy1; iy++)
+    for (std::size_t ix = 0; ix < nx; ix++)
+    {
+      const std::size_t i0 = iy * (nx + 1);
+      topo(cell, 0) = i0 + ix;
+      topo(cell, 1) = i0 + ix + 1;
+      topo(cell, 2) = i0 + ix + nx + 1;
+      topo(cell, 3) = i0 + ix + nx + 2;
+      ++cell;
+    }
+
+  return topo;
+}
+//-----------------------------------------------------------------------------
+mesh::Mesh build_tri(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
+                     std::array<std::size_t, 2> n,
+                     const mesh::GhostMode ghost_mode, std::string diagonal,
+                     std::string partitioner)
+{
   // Check options
   if (diagonal != "left" && diagonal != "right" && diagonal != "right/left"
       && diagonal != "left/right" && diagonal != "crossed")
@@ -44,19 +157,11 @@ mesh::Mesh build_tri(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
   const std::size_t ny = n[1];
 
   // Extract minimum and maximum coordinates
-  const double x0 = std::min(p0[0], p1[0]);
-  const double x1 = std::max(p0[0], p1[0]);
-  const double y0 = std::min(p0[1], p1[1]);
-  const double y1 = std::max(p0[1], p1[1]);
-
-  const double a = x0;
-  const double b = x1;
-  const double ab = (b - a) / static_cast<double>(nx);
-  const double c = y0;
-  const double d = y1;
-  const double cd = (d - c) / static_cast<double>(ny);
+  const Eigen::Vector3d x0 = p0.cwiseMin(p1);
+  const Eigen::Vector3d x1 = p0.cwiseMax(p1);
 
-  if (std::abs(x0 - x1) < DBL_EPSILON || std::abs(y0 - y1) < DBL_EPSILON)
+  if (std::abs(x0[0] - x1[0]) < DBL_EPSILON
+      || std::abs(x0[1] - x1[1]) < DBL_EPSILON)
   {
     throw std::runtime_error("Rectangle seems to have zero width, height or "
                              "depth. Check dimensions");
@@ -69,187 +174,131 @@ mesh::Mesh build_tri(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
         "number of vertices must be at least 1 in each dimension");
   }
 
-  // Create vertices and cells
-  std::size_t nv, nc;
-  if (diagonal == "crossed")
+  // Each process creates a block of rows of cells in the y-direction
+  if (partitioner == "block")
   {
-    nv = (nx + 1) * (ny + 1) + nx * ny;
-    nc = 4 * nx * ny;
+    // The midpoint vertices are numbered after all main vertices, so
+    // the vertices cannot be split by rows
+    if (diagonal == "crossed")
+    {
+      throw std::runtime_error(
+          "Crossed diagonals not supported by block partitioner");
+    }
+
+    return generation::build_layered_mesh(
+        comm, mesh::CellType::Type::triangle, ny, nx + 1,
+        [&x0, &x1, n](std::int64_t iy0, std::int64_t iy1) {
+          return create_geometry(x0, x1, n, iy0, iy1);
+        },
+        [n, diagonal](std::int64_t iy0, std::int64_t iy1) {
+          return create_tri_topology(n, iy0, iy1, diagonal);
+        },
+        ghost_mode);
   }
-  else
+
+  // Receive mesh if not rank 0
+  if (dolfin::MPI::rank(comm) != 0)
   {
-    nv = (nx + 1) * (ny + 1);
-    nc = 2 * nx * ny;
+    EigenRowArrayXXd geom(0, 2);
+    EigenRowArrayXXi64 topo(0, 3);
+    return mesh::Partitioning::build_distributed_mesh(
+        comm, mesh::CellType::Type::triangle, geom, topo, {}, ghost_mode,
+        partitioner);
   }
 
-  EigenRowArrayXXd geom(nv, 2);
-  EigenRowArrayXXi64 topo(nc, 3);
-
-  // Create main vertices
-  std::size_t vertex = 0;
-  for (std::size_t iy = 0; iy <= ny; iy++)
+  if (diagonal != "crossed")
   {
-    const double x1 = c + cd * static_cast<double>(iy);
-    for (std::size_t ix = 0; ix <= nx; ix++)
-    {
-      geom(vertex, 0) = a + ab * static_cast<double>(ix);
-      geom(vertex, 1) = x1;
-      ++vertex;
-    }
+    const EigenRowArrayXXd geom = create_geometry(x0, x1, n, 0, ny + 1);
+    const EigenRowArrayXXi64 topo = create_tri_topology(n, 0, ny, diagonal);
+    return mesh::Partitioning::build_distributed_mesh(
+        comm, mesh::CellType::Type::triangle, geom, topo, {}, ghost_mode,
+        partitioner);
   }
 
-  // Create midpoint vertices if the mesh type is crossed
-  if (diagonal == "crossed")
+  // Create main vertices and midpoint vertices
+  EigenRowArrayXXd geom((nx + 1) * (ny + 1) + nx * ny, 2);
+  geom.topRows((nx + 1) * (ny + 1)) = create_geometry(x0, x1, n, 0, ny + 1);
+  const double ab = (x1[0] - x0[0]) / static_cast<double>(nx);
+  const double cd = (x1[1] - x0[1]) / static_cast<double>(ny);
+  std::size_t vertex = (nx + 1) * (ny + 1);
+  for (std::size_t iy = 0; iy < ny; iy++)
   {
-    for (std::size_t iy = 0; iy < ny; iy++)
+    const double y = x0[1] + cd * (static_cast<double>(iy) + 0.5);
+    for (std::size_t ix = 0; ix < nx; ix++)
     {
-      const double x1 = c + cd * (static_cast<double>(iy) + 0.5);
-      for (std::size_t ix = 0; ix < nx; ix++)
-      {
-        geom(vertex, 0) = a + ab * (static_cast<double>(ix) + 0.5);
-        geom(vertex, 1) = x1;
-        ++vertex;
-      }
+      geom(vertex, 0) = x0[0] + ab * (static_cast<double>(ix) + 0.5);
+      geom(vertex, 1) = y;
+      ++vertex;
     }
   }
 
   // Create triangles
+  EigenRowArrayXXi64 topo(4 * nx * ny, 3);
   std::size_t cell = 0;
-  if (diagonal == "crossed")
-  {
-    for (std::size_t iy = 0; iy < ny; iy++)
-    {
-      for (std::size_t ix = 0; ix < nx; ix++)
-      {
-        const std::size_t v0 = iy * (nx + 1) + ix;
-        const std::size_t v1 = v0 + 1;
-        const std::size_t v2 = v0 + (nx + 1);
-        const std::size_t v3 = v1 + (nx + 1);
-        const std::size_t vmid = (nx + 1) * (ny + 1) + iy * nx + ix;
-
-        // Note that v0 < v1 < v2 < v3 < vmid.
-        topo.row(cell) << v0, v1, vmid;
-        ++cell;
-        topo.row(cell) << v0, v2, vmid;
-        ++cell;
-        topo.row(cell) << v1, v3, vmid;
-        ++cell;
-        topo.row(cell) << v2, v3, vmid;
-        ++cell;
-      }
-    }
-  }
-  else if (diagonal == "left" || diagonal == "right" || diagonal == "right/left"
-           || diagonal == "left/right")
+  for (std::size_t iy = 0; iy < ny; iy++)
   {
-    std::string local_diagonal = diagonal;
-    for (std::size_t iy = 0; iy < ny; iy++)
+    for (std::size_t ix = 0; ix < nx; ix++)
     {
-      // Set up alternating diagonal
-      if (diagonal == "right/left")
-      {
-        if (iy % 2)
-          local_diagonal = "right";
-        else
-          local_diagonal = "left";
-      }
-      if (diagonal == "left/right")
-      {
-        if (iy % 2)
-          local_diagonal = "left";
-        else
-          local_diagonal = "right";
-      }
+      const std::size_t v0 = iy * (nx + 1) + ix;
+      const std::size_t v1 = v0 + 1;
+      const std::size_t v2 = v0 + (nx + 1);
+      const std::size_t v3 = v1 + (nx + 1);
+      const std::size_t vmid = (nx + 1) * (ny + 1) + iy * nx + ix;
 
-      for (std::size_t ix = 0; ix < nx; ix++)
-      {
-        const std::size_t v0 = iy * (nx + 1) + ix;
-        const std::size_t v1 = v0 + 1;
-        const std::size_t v2 = v0 + (nx + 1);
-        const std::size_t v3 = v1 + (nx + 1);
-        std::vector<std::size_t> cell_data;
-
-        if (local_diagonal == "left")
-        {
-          topo.row(cell) << v0, v1, v2;
-          ++cell;
-          topo.row(cell) << v1, v2, v3;
-          ++cell;
-          if (diagonal == "right/left" || diagonal == "left/right")
-            local_diagonal = "right";
-        }
-        else
-        {
-          topo.row(cell) << v0, v1, v3;
-          ++cell;
-          topo.row(cell) << v0, v2, v3;
-          ++cell;
-          if (diagonal == "right/left" || diagonal == "left/right")
-            local_diagonal = "left";
-        }
-      }
+      // Note that v0 < v1 < v2 < v3 < vmid.
+      topo.row(cell) << v0, v1, vmid;
+      ++cell;
+      topo.row(cell) << v0, v2, vmid;
+      ++cell;
+      topo.row(cell) << v1, v3, vmid;
+      ++cell;
+      topo.row(cell) << v2, v3, vmid;
+      ++cell;
     }
   }
 
   return mesh::Partitioning::build_distributed_mesh(
-      comm, mesh::CellType::Type::triangle, geom, topo, {}, ghost_mode);
+      comm, mesh::CellType::Type::triangle, geom, topo, {}, ghost_mode,
+      partitioner);
 }
 //-----------------------------------------------------------------------------
 mesh::Mesh build_quad(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
                       std::array<std::size_t, 2> n,
-                      const mesh::GhostMode ghost_mode)
+                      const mesh::GhostMode ghost_mode, std::string partitioner)
 {
+  const std::size_t nx = n[0];
+  const std::size_t ny = n[1];
+
+  // Each process creates a block of rows of cells in the y-direction
+  if (partitioner == "block")
+  {
+    return generation::build_layered_mesh(
+        comm, mesh::CellType::Type::quadrilateral, ny, nx + 1,
+        [&p, n](std::int64_t iy0, std::int64_t iy1) {
+          return create_geometry(p[0], p[1], n, iy0, iy1);
+        },
+        [n](std::int64_t iy0, std::int64_t iy1) {
+          return create_quad_topology(n, iy0, iy1);
+        },
+        ghost_mode);
+  }
+
   // Receive mesh if not rank 0
   if (dolfin::MPI::rank(comm) != 0)
   {
     EigenRowArrayXXd geom(0, 2);
     EigenRowArrayXXi64 topo(0, 4);
     return mesh::Partitioning::build_distributed_mesh(
-        comm, mesh::CellType::Type::quadrilateral, geom, topo, {}, ghost_mode);
+        comm, mesh::CellType::Type::quadrilateral, geom, topo, {}, ghost_mode,
+        partitioner);
   }
 
-  const std::size_t nx = n[0];
-  const std::size_t ny = n[1];
-
-  EigenRowArrayXXd geom((nx + 1) * (ny + 1), 2);
-  EigenRowArrayXXi64 topo(nx * ny, 4);
-
-  const double a = p[0][0];
-  const double b = p[1][0];
-  const double ab = (b - a) / static_cast<double>(nx);
-
-  const double c = p[0][1];
-  const double d = p[1][1];
-  const double cd = (d - c) / static_cast<double>(ny);
-
-  // Create vertices
-  std::size_t vertex = 0;
-  for (std::size_t iy = 0; iy <= ny; iy++)
-  {
-    double x1 = c + cd * static_cast<double>(iy);
-    for (std::size_t ix = 0; ix <= nx; ix++)
-    {
-      geom(vertex, 0) = a + ab * static_cast<double>(ix);
-      geom(vertex, 1) = x1;
-      ++vertex;
-    }
-  }
-
-  // Create rectangles
-  std::size_t cell = 0;
-  for (std::size_t iy = 0; iy < ny; iy++)
-    for (std::size_t ix = 0; ix < nx; ix++)
-    {
-      const std::size_t i0 = iy * (nx + 1);
-      topo(cell, 0) = i0 + ix;
-      topo(cell, 1) = i0 + ix + 1;
-      topo(cell, 2) = i0 + ix + nx + 1;
-      topo(cell, 3) = i0 + ix + nx + 2;
-      ++cell;
-    }
+  const EigenRowArrayXXd geom = create_geometry(p[0], p[1], n, 0, ny + 1);
+  const EigenRowArrayXXi64 topo = create_quad_topology(n, 0, ny);
 
   return mesh::Partitioning::build_distributed_mesh(
-      comm, mesh::CellType::Type::quadrilateral, geom, topo, {}, ghost_mode);
+      comm, mesh::CellType::Type::quadrilateral, geom, topo, {}, ghost_mode,
+      partitioner);
 }
 //-----------------------------------------------------------------------------
 } // namespace
@@ -260,16 +309,17 @@ mesh::Mesh RectangleMesh::create(MPI_Comm comm,
                                  std::array<std::size_t, 2> n,
                                  mesh::CellType::Type cell_type,
                                  const mesh::GhostMode ghost_mode,
-                                 std::string diagonal)
+                                 std::string diagonal,
+                                 std::string partitioner)
 {
   if (cell_type == mesh::CellType::Type::triangle)
-    return build_tri(comm, p, n, ghost_mode, diagonal);
+    return build_tri(comm, p, n, ghost_mode, diagonal, partitioner);
   else if (cell_type == mesh::CellType::Type::quadrilateral)
-    return build_quad(comm, p, n, ghost_mode);
+    return build_quad(comm, p, n, ghost_mode, partitioner);
   else
     throw std::runtime_error("Generate rectangle mesh. Wrong cell type");
 
   // Will never reach this point
-  return build_quad(comm, p, n, ghost_mode);
+  return build_quad(comm, p, n, ghost_mode, partitioner);
 }
 //-----------------------------------------------------------------------------
@@ -36,6 +36,12 @@ public:
   ///         Cell type
   /// @param    diagonal (string)
   ///         Direction of diagonals: "left", "right", "left/right", "crossed"
+  /// @param    partitioner (string)
+  ///         Partitioner ("SCOTCH", "ParMETIS" or "Hilbert") for a mesh
+  ///         created on process 0, or "block" to create a block of rows
+  ///         of cells in the y-direction on each process without
+  ///         partitioning (requires at least as many rows as processes,
+  ///         and does not support "crossed" diagonals)
   ///
   /// @code{.cpp}
   ///
@@ -50,7 +56,8 @@ public:
   static mesh::Mesh
     create(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
          std::array<std::size_t, 2> n, mesh::CellType::Type cell_type,
-         const mesh::GhostMode ghost_mode, std::string diagonal = "right");
+         const mesh::GhostMode ghost_mode, std::string diagonal = "right",
+         std::string partitioner = "SCOTCH");
 };
 } // namespace generation
 } // namespace dolfin
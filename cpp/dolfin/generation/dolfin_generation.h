@@ -14,3 +14,4 @@ namespace dolfin
 #include <dolfin/generation/BoxMesh.h>
 #include <dolfin/generation/IntervalMesh.h>
 #include <dolfin/generation/RectangleMesh.h>
+#include <dolfin/generation/utils.h>
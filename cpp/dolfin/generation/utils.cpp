@@ -0,0 +1,153 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "utils.h"
+#include <algorithm>
+#include <dolfin/common/Timer.h>
+#include <dolfin/mesh/Partitioning.h>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace dolfin;
+
+//-----------------------------------------------------------------------------
+mesh::Mesh generation::build_layered_mesh(
+    MPI_Comm comm, mesh::CellType::Type type, std::int64_t num_layers,
+    std::int64_t num_plane_vertices,
+    const std::function<EigenRowArrayXXd(std::int64_t, std::int64_t)>&
+        create_points,
+    const std::function<EigenRowArrayXXi64(std::int64_t, std::int64_t)>&
+        create_cells,
+    const mesh::GhostMode ghost_mode)
+{
+  common::Timer timer("Build layered mesh");
+
+  const int mpi_size = MPI::size(comm);
+  const int mpi_rank = MPI::rank(comm);
+  if (num_layers < mpi_size)
+  {
+    throw std::runtime_error("Cannot distribute " + std::to_string(num_layers)
+                             + " layers of cells over "
+                             + std::to_string(mpi_size) + " processes.");
+  }
+
+  // Layers owned by process p
+  auto layer_range = [num_layers, mpi_size](int p) {
+    return MPI::compute_local_range(p, num_layers, mpi_size);
+  };
+  const std::array<std::int64_t, 2> layers = layer_range(mpi_rank);
+
+  // Create points of the planes below the owned layers (the last
+  // process also holds the top plane), so that the points are numbered
+  // from process 0 upwards
+  const std::int64_t plane_end
+      = (mpi_rank == mpi_size - 1) ? layers[1] + 1 : layers[1];
+  const EigenRowArrayXXd points = create_points(layers[0], plane_end);
+  assert(points.rows() == (plane_end - layers[0]) * num_plane_vertices);
+
+  // Number of vertices that a cell must have on the plane between two
+  // blocks of layers to be a ghost on the other side
+  std::unique_ptr<mesh::CellType> cell_type(mesh::CellType::create(type));
+  const int tdim = cell_type->dim();
+  const int num_ghost_vertices
+      = (ghost_mode == mesh::GhostMode::shared_facet)
+            ? cell_type->num_vertices(tdim - 1)
+            : 1;
+
+  // Create cells of the owned layers, and of the neighbouring layers
+  // which may hold ghost cells
+  const bool ghosted = (ghost_mode != mesh::GhostMode::none);
+  const std::int64_t l0
+      = ghosted ? std::max(layers[0] - 1, (std::int64_t)0) : layers[0];
+  const std::int64_t l1
+      = ghosted ? std::min(layers[1] + 1, num_layers) : layers[1];
+  const EigenRowArrayXXi64 layer_cells = create_cells(l0, l1);
+  const std::int64_t cells_per_layer = layer_cells.rows() / (l1 - l0);
+  assert(layer_cells.rows() == cells_per_layer * (l1 - l0));
+
+  // Check if cell c has enough vertices on a plane to be a ghost on
+  // the other side of the plane
+  auto on_plane = [&layer_cells, num_plane_vertices,
+                   num_ghost_vertices](std::int64_t c, std::int64_t plane) {
+    int count = 0;
+    for (Eigen::Index j = 0; j < layer_cells.cols(); ++j)
+      if (layer_cells(c, j) / num_plane_vertices == plane)
+        ++count;
+    return count >= num_ghost_vertices;
+  };
+
+  // Owned cells first, followed by ghost cells, with the owner and the
+  // set of processes that hold each cell
+  std::vector<std::int64_t> owned, ghosts;
+  std::vector<std::int32_t> ghost_owners;
+  std::vector<std::set<std::int32_t>> owned_procs, ghost_procs;
+  for (std::int64_t c = 0; c < layer_cells.rows(); ++c)
+  {
+    // Owner of layer holding cell
+    const std::int64_t layer = l0 + c / cells_per_layer;
+    int owner = mpi_rank;
+    if (layer < layers[0])
+      owner = mpi_rank - 1;
+    else if (layer >= layers[1])
+      owner = mpi_rank + 1;
+
+    // Processes holding the cell: the owner and the owners of the
+    // neighbouring blocks of layers when the cell is a ghost
+    std::set<std::int32_t> procs;
+    if (ghosted)
+    {
+      const std::array<std::int64_t, 2> range = layer_range(owner);
+      if (owner > 0 and layer == range[0] and on_plane(c, layer))
+        procs.insert(owner - 1);
+      if (owner < mpi_size - 1 and layer == range[1] - 1
+          and on_plane(c, layer + 1))
+      {
+        procs.insert(owner + 1);
+      }
+    }
+
+    if (owner == mpi_rank)
+    {
+      owned.push_back(c);
+      owned_procs.push_back(std::move(procs));
+    }
+    else if (procs.find(mpi_rank) != procs.end())
+    {
+      procs.erase(mpi_rank);
+      procs.insert(owner);
+      ghosts.push_back(c);
+      ghost_owners.push_back(owner);
+      ghost_procs.push_back(std::move(procs));
+    }
+  }
+
+  // Pack cells and sharing information
+  const std::size_t num_cells = owned.size() + ghosts.size();
+  EigenRowArrayXXi64 cells(num_cells, layer_cells.cols());
+  std::vector<std::int64_t> global_cell_indices(num_cells);
+  std::map<std::int32_t, std::set<std::int32_t>> shared_cells;
+  for (std::size_t i = 0; i < num_cells; ++i)
+  {
+    const bool is_owned = i < owned.size();
+    const std::int64_t c = is_owned ? owned[i] : ghosts[i - owned.size()];
+    std::set<std::int32_t>& procs
+        = is_owned ? owned_procs[i] : ghost_procs[i - owned.size()];
+    cells.row(i) = layer_cells.row(c);
+    global_cell_indices[i] = l0 * cells_per_layer + c;
+    if (!procs.empty())
+      shared_cells.insert({i, std::move(procs)});
+  }
+
+  timer.stop();
+
+  return mesh::Partitioning::build_from_distributed_cells(
+      comm, type, points, cells, global_cell_indices, ghost_mode,
+      ghost_owners, shared_cells);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,61 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <dolfin/common/MPI.h>
+#include <dolfin/common/types.h>
+#include <dolfin/mesh/CellType.h>
+#include <dolfin/mesh/Mesh.h>
+#include <functional>
+
+namespace dolfin
+{
+namespace generation
+{
+
+/// Build a distributed mesh of a structured grid with the cells
+/// arranged in layers, and the vertices arranged in the planes
+/// between layers. Vertices are numbered plane by plane and cells
+/// layer by layer, with the same number of vertices in each plane and
+/// the same number of cells in each layer.
+///
+/// Each process creates the points and cells for a contiguous block
+/// of layers only, so that no process holds the global mesh. The cell
+/// partition follows the blocks of layers, so no graph partitioning
+/// is performed, and the ghost cells are computed directly from the
+/// neighbouring layers.
+///
+/// @param comm (MPI_Comm)
+///   MPI communicator
+/// @param type (mesh::CellType::Type)
+///   Cell type
+/// @param num_layers (std::int64_t)
+///   Number of layers of cells (must be at least the number of
+///   processes)
+/// @param num_plane_vertices (std::int64_t)
+///   Number of vertices in each plane
+/// @param create_points (std::function)
+///   Returns the points of the planes [p0, p1)
+/// @param create_cells (std::function)
+///   Returns the cells (with global vertex indices) of the layers
+///   [l0, l1)
+/// @param ghost_mode (mesh::GhostMode)
+///   Ghost mode
+/// @return mesh::Mesh
+///   The distributed mesh
+mesh::Mesh build_layered_mesh(
+    MPI_Comm comm, mesh::CellType::Type type, std::int64_t num_layers,
+    std::int64_t num_plane_vertices,
+    const std::function<EigenRowArrayXXd(std::int64_t, std::int64_t)>&
+        create_points,
+    const std::function<EigenRowArrayXXi64(std::int64_t, std::int64_t)>&
+        create_cells,
+    const mesh::GhostMode ghost_mode);
+
+} // namespace generation
+} // namespace dolfin
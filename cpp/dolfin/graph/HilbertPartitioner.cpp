@@ -0,0 +1,363 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "HilbertPartitioner.h"
+#include <algorithm>
+#include <dolfin/common/Timer.h>
+#include <dolfin/common/log.h>
+#include <dolfin/common/sort.h>
+#include <dolfin/mesh/CellType.h>
+#include <limits>
+#include <numeric>
+#include <set>
+
+using namespace dolfin;
+
+//-----------------------------------------------------------------------------
+std::pair<std::vector<int>, std::map<std::int64_t, std::vector<int>>>
+graph::HilbertPartitioner::partition(
+    MPI_Comm mpi_comm, const Eigen::Ref<const EigenRowArrayXXi64> cell_vertices,
+    const Eigen::Ref<const EigenRowArrayXXd> centroids,
+    const mesh::CellType& cell_type,
+    const std::vector<std::size_t>& cell_weights)
+{
+  LOG(INFO) << "Compute partition along Hilbert curve through cell centroids";
+  common::Timer timer("Compute Hilbert curve partition");
+
+  const int num_processes = MPI::size(mpi_comm);
+  const std::int32_t num_cells = centroids.rows();
+  assert(cell_vertices.rows() == num_cells);
+  assert(cell_weights.empty() or (std::int32_t)cell_weights.size() == num_cells);
+
+  // Map centroids onto integer grid covering the global bounding box,
+  // and compute position along Hilbert curve
+  const int gdim = centroids.cols();
+  const int dim = std::min(gdim, 3);
+  const int bits = std::min(63 / dim, 31);
+  std::array<double, 3> x0, dx;
+  for (int i = 0; i < dim; ++i)
+  {
+    const double inf = std::numeric_limits<double>::max();
+    x0[i] = MPI::min(mpi_comm,
+                     num_cells > 0 ? centroids.col(i).minCoeff() : inf);
+    dx[i] = MPI::max(mpi_comm,
+                     num_cells > 0 ? centroids.col(i).maxCoeff() : -inf)
+            - x0[i];
+  }
+  const double scale = (double)((std::uint64_t(1) << bits) - 1);
+  std::vector<std::array<std::uint64_t, 1>> keys(num_cells);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    std::array<std::uint32_t, 3> p = {{0, 0, 0}};
+    for (int i = 0; i < dim; ++i)
+      if (dx[i] > 0.0)
+        p[i] = (centroids(c, i) - x0[i]) / dx[i] * scale;
+    keys[c][0] = index(p, dim, bits);
+  }
+
+  // Sort local cells along curve (the keys are sorted in place)
+  const std::vector<std::int32_t> perm = common::radix_argsort(keys);
+  auto weight = [&cell_weights, &perm](std::int32_t i) -> std::int64_t {
+    return cell_weights.empty() ? 1 : cell_weights[perm[i]];
+  };
+
+  // The position of each cell along the global curve is computed by a
+  // parallel sample sort. Splitters chosen from a regular sample of
+  // the local keys divide the curve into one bucket per process, and
+  // each process receives and orders the cells in its bucket.
+  const int num_samples = std::min(num_cells, 16);
+  std::vector<std::uint64_t> samples(num_samples);
+  for (int i = 0; i < num_samples; ++i)
+  {
+    const std::int64_t pos
+        = (2 * i + 1) * std::int64_t(num_cells) / (2 * num_samples);
+    samples[i] = keys[pos][0];
+  }
+  std::vector<std::uint64_t> all_samples, splitters;
+  MPI::gather(mpi_comm, samples, all_samples);
+  if (MPI::rank(mpi_comm) == 0)
+  {
+    std::sort(all_samples.begin(), all_samples.end());
+    splitters.resize(num_processes - 1, 0);
+    if (!all_samples.empty())
+    {
+      for (int p = 1; p < num_processes; ++p)
+      {
+        splitters[p - 1]
+            = all_samples[(p * all_samples.size()) / num_processes];
+      }
+    }
+  }
+  MPI::broadcast(mpi_comm, splitters);
+
+  // Send (key, weight) of each cell to the process that holds its
+  // bucket, in curve order
+  std::vector<std::vector<std::int64_t>> send_cells(num_processes);
+  std::vector<int> dest(num_cells);
+  for (std::int32_t i = 0; i < num_cells; ++i)
+  {
+    dest[i] = std::upper_bound(splitters.begin(), splitters.end(), keys[i][0])
+              - splitters.begin();
+    send_cells[dest[i]].insert(send_cells[dest[i]].end(),
+                               {(std::int64_t)keys[i][0], weight(i)});
+  }
+  std::vector<std::vector<std::int64_t>> recv_cells(num_processes);
+  MPI::all_to_all(mpi_comm, send_cells, recv_cells);
+
+  // Order the cells in the bucket by key, with cells with equal keys
+  // ordered by process and then by position along the local curve
+  std::vector<std::array<std::int64_t, 3>> bucket;
+  for (int p = 0; p < num_processes; ++p)
+    for (std::size_t pos = 0; pos < recv_cells[p].size() / 2; ++pos)
+      bucket.push_back({{recv_cells[p][2 * pos], p, (std::int64_t)pos}});
+  std::stable_sort(bucket.begin(), bucket.end(),
+                   [](const std::array<std::int64_t, 3>& a,
+                      const std::array<std::int64_t, 3>& b) {
+                     return a[0] < b[0];
+                   });
+
+  // Cut the curve into parts with equal weight. A cell is in the part
+  // that owns the weight of the cells before it along the curve.
+  std::int64_t bucket_weight = 0;
+  for (int p = 0; p < num_processes; ++p)
+    for (std::size_t i = 1; i < recv_cells[p].size(); i += 2)
+      bucket_weight += recv_cells[p][i];
+  const std::int64_t total_weight = MPI::sum(mpi_comm, bucket_weight);
+  std::int64_t position = MPI::global_offset(mpi_comm, bucket_weight, true);
+  std::vector<std::vector<std::int64_t>> send_parts(num_processes);
+  for (int p = 0; p < num_processes; ++p)
+    send_parts[p].resize(recv_cells[p].size() / 2);
+  std::map<int, std::int64_t> part_weight;
+  for (auto& c : bucket)
+  {
+    const std::int64_t w = recv_cells[c[1]][2 * c[2] + 1];
+    const int part = position < total_weight
+                         ? MPI::index_owner(mpi_comm, position, total_weight)
+                         : num_processes - 1;
+    send_parts[c[1]][c[2]] = part;
+    part_weight[part] += w;
+    position += w;
+  }
+
+  // Return parts to the processes that hold the cells
+  std::vector<std::vector<std::int64_t>> recv_parts(num_processes);
+  MPI::all_to_all(mpi_comm, send_parts, recv_parts);
+  std::vector<int> cell_partition(num_cells);
+  std::vector<std::size_t> recv_pos(num_processes, 0);
+  for (std::int32_t i = 0; i < num_cells; ++i)
+    cell_partition[perm[i]] = recv_parts[dest[i]][recv_pos[dest[i]]++];
+
+  // Imbalance (weight of largest part relative to average)
+  std::vector<std::vector<std::int64_t>> send_weights(num_processes);
+  for (auto& w : part_weight)
+    send_weights[w.first].push_back(w.second);
+  std::vector<std::int64_t> recv_weights;
+  MPI::all_to_all(mpi_comm, send_weights, recv_weights);
+  const std::int64_t max_part = MPI::max(
+      mpi_comm, std::accumulate(recv_weights.begin(), recv_weights.end(),
+                                std::int64_t(0)));
+  const double imbalance
+      = total_weight > 0 ? (double)max_part * num_processes / total_weight
+                         : 1.0;
+
+  // Compute processes holding ghost cells
+  std::map<std::int64_t, std::vector<int>> ghost_procs;
+  std::int64_t edge_cut;
+  std::tie(ghost_procs, edge_cut) = compute_ghost_procs(
+      mpi_comm, cell_vertices, cell_type, cell_partition);
+
+  LOG(INFO) << "Hilbert curve partition: edge cut " << edge_cut
+            << ", imbalance " << imbalance;
+
+  return std::make_pair(std::move(cell_partition), std::move(ghost_procs));
+}
+//-----------------------------------------------------------------------------
+std::pair<std::map<std::int64_t, std::vector<int>>, std::int64_t>
+graph::HilbertPartitioner::compute_ghost_procs(
+    MPI_Comm mpi_comm, const Eigen::Ref<const EigenRowArrayXXi64> cell_vertices,
+    const mesh::CellType& cell_type, const std::vector<int>& cell_partition)
+{
+  common::Timer timer("Compute ghost cells of partition");
+
+  const int num_processes = MPI::size(mpi_comm);
+  const int tdim = cell_type.dim();
+  const int num_facets = cell_type.num_entities(tdim - 1);
+  const int num_facet_vertices = cell_type.num_vertices(tdim - 1);
+  const std::int32_t num_cells = cell_vertices.rows();
+  assert(num_facet_vertices <= 4);
+  assert((std::int32_t)cell_partition.size() == num_cells);
+
+  // Local vertices of each facet of a cell
+  std::vector<std::int32_t> v(cell_type.num_vertices());
+  std::iota(v.begin(), v.end(), 0);
+  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      facet_vertices;
+  cell_type.create_entities(facet_vertices, tdim - 1, v.data());
+
+  // Facets of all cells as sorted global vertex indices, and sort
+  // facets so that matching facets are adjacent
+  typedef std::array<std::uint64_t, 4> FacetKey;
+  std::vector<FacetKey> facets(num_cells * num_facets);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    for (int f = 0; f < num_facets; ++f)
+    {
+      FacetKey& key = facets[c * num_facets + f];
+      key.fill(std::numeric_limits<std::uint64_t>::max());
+      for (int i = 0; i < num_facet_vertices; ++i)
+        key[i] = cell_vertices(c, facet_vertices(f, i));
+      std::sort(key.begin(), key.begin() + num_facet_vertices);
+    }
+  }
+  const std::vector<std::int32_t> perm = common::radix_argsort(facets);
+
+  // Global range of vertex indices
+  const std::int64_t num_global_vertices
+      = MPI::max(mpi_comm,
+                 (cell_vertices.rows() > 0) ? cell_vertices.maxCoeff() : 0)
+        + 1;
+
+  // Match facets on this process, and send unmatched facets (with the
+  // owner of the cell) to the process that matches them
+  std::map<std::int32_t, std::set<int>> neighbour_parts;
+  std::int64_t num_cut = 0;
+  std::vector<std::vector<std::int64_t>> send_facets(num_processes);
+  std::vector<std::vector<std::int32_t>> send_cells(num_processes);
+  for (std::size_t i = 0; i < facets.size(); ++i)
+  {
+    const std::int32_t c0 = perm[i] / num_facets;
+    if (i + 1 < facets.size() and facets[i] == facets[i + 1])
+    {
+      const std::int32_t c1 = perm[i + 1] / num_facets;
+      if (cell_partition[c0] != cell_partition[c1])
+      {
+        neighbour_parts[c0].insert(cell_partition[c1]);
+        neighbour_parts[c1].insert(cell_partition[c0]);
+        ++num_cut;
+      }
+      ++i;
+    }
+    else
+    {
+      const int dest
+          = MPI::index_owner(mpi_comm, facets[i][0], num_global_vertices);
+      send_facets[dest].insert(send_facets[dest].end(), facets[i].begin(),
+                               facets[i].begin() + num_facet_vertices);
+      send_facets[dest].push_back(cell_partition[c0]);
+      send_cells[dest].push_back(c0);
+    }
+  }
+
+  if (num_processes > 1)
+  {
+    std::vector<std::vector<std::int64_t>> recv_facets(num_processes);
+    MPI::all_to_all(mpi_comm, send_facets, recv_facets);
+
+    // Sort received facets, keeping their origin (process, position)
+    std::vector<FacetKey> recv_keys;
+    std::vector<std::array<std::int64_t, 3>> recv_data;
+    const int stride = num_facet_vertices + 1;
+    for (int p = 0; p < num_processes; ++p)
+    {
+      for (std::size_t pos = 0; pos < recv_facets[p].size() / stride; ++pos)
+      {
+        const std::int64_t* f = recv_facets[p].data() + pos * stride;
+        FacetKey key;
+        key.fill(std::numeric_limits<std::uint64_t>::max());
+        std::copy(f, f + num_facet_vertices, key.begin());
+        recv_keys.push_back(key);
+        recv_data.push_back({{p, (std::int64_t)pos, f[num_facet_vertices]}});
+      }
+    }
+    const std::vector<std::int32_t> recv_perm = common::radix_argsort(recv_keys);
+
+    // Send the part of the matching cell back to both processes
+    std::vector<std::vector<std::int64_t>> send_matches(num_processes);
+    for (std::size_t i = 0; i + 1 < recv_keys.size(); ++i)
+    {
+      if (recv_keys[i] == recv_keys[i + 1])
+      {
+        const std::array<std::int64_t, 3>& d0 = recv_data[recv_perm[i]];
+        const std::array<std::int64_t, 3>& d1 = recv_data[recv_perm[i + 1]];
+        if (d0[2] != d1[2])
+        {
+          send_matches[d0[0]].insert(send_matches[d0[0]].end(), {d0[1], d1[2]});
+          send_matches[d1[0]].insert(send_matches[d1[0]].end(), {d1[1], d0[2]});
+          ++num_cut;
+        }
+        ++i;
+      }
+    }
+
+    std::vector<std::vector<std::int64_t>> recv_matches(num_processes);
+    MPI::all_to_all(mpi_comm, send_matches, recv_matches);
+    for (int p = 0; p < num_processes; ++p)
+    {
+      for (std::size_t i = 0; i < recv_matches[p].size(); i += 2)
+      {
+        const std::int32_t c = send_cells[p][recv_matches[p][i]];
+        neighbour_parts[c].insert(recv_matches[p][i + 1]);
+      }
+    }
+  }
+
+  // Owning process goes first, followed by the other sharing
+  // processes
+  std::map<std::int64_t, std::vector<int>> ghost_procs;
+  for (auto& n : neighbour_parts)
+  {
+    std::vector<int>& procs = ghost_procs[n.first];
+    procs.push_back(cell_partition[n.first]);
+    procs.insert(procs.end(), n.second.begin(), n.second.end());
+  }
+
+  return std::make_pair(std::move(ghost_procs), MPI::sum(mpi_comm, num_cut));
+}
+//-----------------------------------------------------------------------------
+// Uses the transpose algorithm of J. Skilling, "Programming the Hilbert
+// curve", AIP Conference Proceedings 707 (2004).
+std::uint64_t graph::HilbertPartitioner::index(std::array<std::uint32_t, 3> x,
+                                               int dim, int bits)
+{
+  assert(dim * bits <= 64);
+  const std::uint32_t m = 1 << (bits - 1);
+
+  // Inverse undo
+  for (std::uint32_t q = m; q > 1; q >>= 1)
+  {
+    const std::uint32_t p = q - 1;
+    for (int i = 0; i < dim; ++i)
+    {
+      if (x[i] & q)
+        x[0] ^= p;
+      else
+      {
+        const std::uint32_t t = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for (int i = 1; i < dim; ++i)
+    x[i] ^= x[i - 1];
+  std::uint32_t t = 0;
+  for (std::uint32_t q = m; q > 1; q >>= 1)
+    if (x[dim - 1] & q)
+      t ^= q - 1;
+  for (int i = 0; i < dim; ++i)
+    x[i] ^= t;
+
+  // Interleave bits of the transposed index
+  std::uint64_t index = 0;
+  for (int b = bits - 1; b >= 0; --b)
+    for (int i = 0; i < dim; ++i)
+      index = (index << 1) | ((x[i] >> b) & 1);
+
+  return index;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,78 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <dolfin/common/MPI.h>
+#include <dolfin/common/types.h>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace dolfin
+{
+
+namespace mesh
+{
+class CellType;
+}
+
+namespace graph
+{
+
+/// This class provides a geometric partitioner, which cuts a Hilbert
+/// space-filling curve through the cell centroids into pieces with
+/// equal numbers of cells, or equal sums of cell weights. No dual
+/// graph is built. The cells are ordered along the curve by a parallel
+/// sample sort, so the cost is dominated by sorting the local cells and
+/// two all-to-all exchanges of the cells.
+
+class HilbertPartitioner
+{
+public:
+  /// Compute cell partition from cell centroids. Returns (partition,
+  /// ghost_procs), in the same format as SCOTCH::partition. The edge
+  /// cut and (weighted) imbalance of the partition are logged.
+  /// @param mpi_comm (MPI_Comm)
+  ///   MPI communicator
+  /// @param cell_vertices
+  ///   Cells on this process, with global vertex indices
+  /// @param centroids
+  ///   Centroid of each cell
+  /// @param cell_type (mesh::CellType)
+  ///   Cell type
+  /// @param cell_weights
+  ///   Weight of each cell. The curve is cut into pieces with equal
+  ///   sums of weights. If empty, all cells have weight one.
+  static std::pair<std::vector<int>, std::map<std::int64_t, std::vector<int>>>
+  partition(MPI_Comm mpi_comm,
+            const Eigen::Ref<const EigenRowArrayXXi64> cell_vertices,
+            const Eigen::Ref<const EigenRowArrayXXd> centroids,
+            const mesh::CellType& cell_type,
+            const std::vector<std::size_t>& cell_weights);
+
+  /// Compute the processes, in addition to the owner, that each cell
+  /// must be sent to for a layer of ghost cells connected by facets,
+  /// given a cell partition. Facets on the boundary of the local cells
+  /// are matched on the process that owns their first vertex. Returns
+  /// (ghost_procs, global number of facets between cells in different
+  /// parts).
+  static std::pair<std::map<std::int64_t, std::vector<int>>, std::int64_t>
+  compute_ghost_procs(MPI_Comm mpi_comm,
+                      const Eigen::Ref<const EigenRowArrayXXi64> cell_vertices,
+                      const mesh::CellType& cell_type,
+                      const std::vector<int>& cell_partition);
+
+  /// Compute the index of a point with integer coordinates x (each
+  /// with the given number of bits) along a Hilbert curve in dim
+  /// dimensions
+  static std::uint64_t index(std::array<std::uint32_t, 3> x, int dim,
+                             int bits);
+};
+} // namespace graph
+} // namespace dolfin
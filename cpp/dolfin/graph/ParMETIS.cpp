@@ -8,9 +8,13 @@
 #include "CSRGraph.h"
 #include "Graph.h"
 #include "GraphBuilder.h"
+#include <algorithm>
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/mesh/CellType.h>
+#include <stdexcept>
+#include <string>
+#include <tuple>
 
 #ifdef HAS_PARMETIS
 #include <parmetis.h>
@@ -101,55 +105,19 @@ using namespace dolfin;
 // }
 // } // namespace
 
+namespace
+{
 //-----------------------------------------------------------------------------
-std::pair<std::vector<int>, std::map<std::int64_t, std::vector<int>>>
-dolfin::graph::ParMETIS::partition(MPI_Comm mpi_comm,
-                                   const CSRGraph<idx_t>& csr_graph)
+// Compute the processes that each local node which is adjacent to a
+// node in another partition must be sent to, with the owning process
+// first
+std::map<std::int64_t, std::vector<int>>
+compute_ghost_procs(MPI_Comm mpi_comm,
+                    const dolfin::graph::CSRGraph<idx_t>& csr_graph,
+                    const std::vector<idx_t>& part)
 {
   std::map<std::int64_t, std::vector<int>> ghost_procs;
 
-  common::Timer timer("Compute graph partition (ParMETIS)");
-
-  // Options for ParMETIS
-  idx_t options[3];
-  options[0] = 1;
-  options[1] = 0;
-  options[2] = 15;
-
-  // Number of partitions (one for each process)
-  idx_t nparts = dolfin::MPI::size(mpi_comm);
-
-  // Strange weight arrays needed by ParMETIS
-  idx_t ncon = 1;
-
-  // Prepare remaining arguments for ParMETIS
-  idx_t* elmwgt = nullptr;
-  idx_t wgtflag = 0;
-  idx_t edgecut = 0;
-  idx_t numflag = 0;
-  std::vector<real_t> tpwgts(ncon * nparts, 1.0 / static_cast<real_t>(nparts));
-  std::vector<real_t> ubvec(ncon, 1.05);
-
-  // Note: ParMETIS is not const-correct, so we throw away const-ness
-  // and trust ParMETIS to not modify the data.
-
-  // Call ParMETIS to partition graph
-  common::Timer timer1("ParMETIS: call ParMETIS_V3_PartKway");
-  const std::int32_t num_local_cells = csr_graph.size();
-  std::vector<idx_t> part(num_local_cells);
-  assert(!part.empty());
-  int err = ParMETIS_V3_PartKway(
-      const_cast<idx_t*>(csr_graph.node_distribution().data()),
-      const_cast<idx_t*>(csr_graph.nodes().data()),
-      const_cast<idx_t*>(csr_graph.edges().data()), elmwgt, nullptr, &wgtflag,
-      &numflag, &ncon, &nparts, tpwgts.data(), ubvec.data(), options, &edgecut,
-      part.data(), &mpi_comm);
-  assert(err == METIS_OK);
-  timer1.stop();
-
-  common::Timer timer2("Compute graph halo data (ParMETIS)");
-
-  // Work out halo cells for current division of dual graph
   const auto& elmdist = csr_graph.node_distribution();
   const auto& xadj = csr_graph.nodes();
   const auto& adjncy = csr_graph.edges();
@@ -250,15 +218,102 @@ dolfin::graph::ParMETIS::partition(MPI_Comm mpi_comm,
     }
   }
 
+  return ghost_procs;
+}
+//-----------------------------------------------------------------------------
+// Return the node weights and weight flag for ParMETIS. The flag must
+// be the same on all processes, so weights are used if any process
+// has them, and processes without weights give their nodes unit
+// weight. The weight array always has at least one entry, so that a
+// process without nodes passes a valid array.
+std::pair<std::vector<idx_t>, idx_t>
+compute_node_weights(MPI_Comm mpi_comm, std::int32_t num_nodes,
+                     const std::vector<std::size_t>& node_weights)
+{
+  if (!node_weights.empty() and (int)node_weights.size() != num_nodes)
+  {
+    throw std::runtime_error("Number of node weights ("
+                             + std::to_string(node_weights.size())
+                             + ") does not match number of graph nodes ("
+                             + std::to_string(num_nodes) + ")");
+  }
+
+  const int has_weights
+      = dolfin::MPI::max(mpi_comm, (int)!node_weights.empty());
+  if (!has_weights)
+    return {std::vector<idx_t>(), 0};
+
+  std::vector<idx_t> vwgt(std::max(num_nodes, 1), 1);
+  std::copy(node_weights.begin(), node_weights.end(), vwgt.begin());
+  return {std::move(vwgt), 2};
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+//-----------------------------------------------------------------------------
+std::pair<std::vector<int>, std::map<std::int64_t, std::vector<int>>>
+dolfin::graph::ParMETIS::partition(MPI_Comm mpi_comm,
+                                   const CSRGraph<idx_t>& csr_graph,
+                                   const std::vector<std::size_t>& node_weights)
+{
+  common::Timer timer("Compute graph partition (ParMETIS)");
+
+  // Options for ParMETIS
+  idx_t options[3];
+  options[0] = 1;
+  options[1] = 0;
+  options[2] = 15;
+
+  // Number of partitions (one for each process)
+  idx_t nparts = dolfin::MPI::size(mpi_comm);
+
+  // Strange weight arrays needed by ParMETIS
+  idx_t ncon = 1;
+
+  // Handle cell weights (if any)
+  std::vector<idx_t> vwgt;
+  idx_t wgtflag;
+  std::tie(vwgt, wgtflag)
+      = compute_node_weights(mpi_comm, csr_graph.size(), node_weights);
+  idx_t* elmwgt = vwgt.empty() ? nullptr : vwgt.data();
+
+  // Prepare remaining arguments for ParMETIS
+  idx_t edgecut = 0;
+  idx_t numflag = 0;
+  std::vector<real_t> tpwgts(ncon * nparts, 1.0 / static_cast<real_t>(nparts));
+  std::vector<real_t> ubvec(ncon, 1.05);
+
+  // Note: ParMETIS is not const-correct, so we throw away const-ness
+  // and trust ParMETIS to not modify the data.
+
+  // Call ParMETIS to partition graph
+  common::Timer timer1("ParMETIS: call ParMETIS_V3_PartKway");
+  const std::int32_t num_local_cells = csr_graph.size();
+  std::vector<idx_t> part(num_local_cells);
+  assert(!part.empty());
+  int err = ParMETIS_V3_PartKway(
+      const_cast<idx_t*>(csr_graph.node_distribution().data()),
+      const_cast<idx_t*>(csr_graph.nodes().data()),
+      const_cast<idx_t*>(csr_graph.edges().data()), elmwgt, nullptr, &wgtflag,
+      &numflag, &ncon, &nparts, tpwgts.data(), ubvec.data(), options, &edgecut,
+      part.data(), &mpi_comm);
+  assert(err == METIS_OK);
+  timer1.stop();
+
+  // Work out halo cells for current division of dual graph
+  common::Timer timer2("Compute graph halo data (ParMETIS)");
+  std::map<std::int64_t, std::vector<int>> ghost_procs
+      = compute_ghost_procs(mpi_comm, csr_graph, part);
   timer2.stop();
 
   return std::make_pair(std::vector<int>(part.begin(), part.end()),
                         std::move(ghost_procs));
 }
 //-----------------------------------------------------------------------------
-template <typename T>
-std::vector<int> dolfin::graph::ParMETIS::adaptive_repartition(
-    MPI_Comm mpi_comm, const CSRGraph<T>& csr_graph, double weight)
+std::pair<std::vector<int>, std::map<std::int64_t, std::vector<int>>>
+dolfin::graph::ParMETIS::adaptive_repartition(
+    MPI_Comm mpi_comm, const CSRGraph<idx_t>& csr_graph,
+    const std::vector<std::size_t>& node_weights, double weight)
 {
   common::Timer timer(
       "Compute graph partition (ParMETIS Adaptive Repartition)");
@@ -273,35 +328,48 @@ std::vector<int> dolfin::graph::ParMETIS::adaptive_repartition(
   // migration if already balanced.  Try PARMETIS_PSR_UNCOUPLED for
   // better edge cut.
 
-  common::Timer timer1("ParMETIS: call ParMETIS_V3_AdaptiveRepart");
-  real_t _itr = weight;
-  std::vector<idx_t> part(csr_graph.size());
-  std::vector<idx_t> vsize(part.size(), 1);
-  assert(!part.empty());
-
   // Number of partitions (one for each process)
   idx_t nparts = dolfin::MPI::size(mpi_comm);
 
-  // Remaining ParMETIS parameters
+  // Handle node weights (if any). The redistribution cost of a node
+  // is taken to be the same for all nodes.
   idx_t ncon = 1;
-  idx_t* elmwgt = nullptr;
-  idx_t wgtflag = 0;
+  std::vector<idx_t> vwgt;
+  idx_t wgtflag;
+  std::tie(vwgt, wgtflag)
+      = compute_node_weights(mpi_comm, csr_graph.size(), node_weights);
+  idx_t* elmwgt = vwgt.empty() ? nullptr : vwgt.data();
+  std::vector<idx_t> vsize(csr_graph.size(), 1);
+
+  // Remaining ParMETIS parameters
+  real_t _itr = weight;
   idx_t edgecut = 0;
   idx_t numflag = 0;
   std::vector<real_t> tpwgts(ncon * nparts, 1.0 / static_cast<real_t>(nparts));
   std::vector<real_t> ubvec(ncon, 1.05);
 
-  // Call ParMETIS to repartition graph
+  // Call ParMETIS to repartition graph. The current partition is the
+  // distribution of the graph nodes over the processes.
+  common::Timer timer1("ParMETIS: call ParMETIS_V3_AdaptiveRepart");
+  std::vector<idx_t> part(csr_graph.size());
+  assert(!part.empty());
   int err = ParMETIS_V3_AdaptiveRepart(
-      csr_graph.node_distribution().data(), csr_graph.nodes().data(),
-      csr_graph.edges().data(), elmwgt, nullptr, vsize.data(), &wgtflag,
-      &numflag, &ncon, &nparts, tpwgts.data(), ubvec.data(), &_itr, options,
-      &edgecut, part.data(), &mpi_comm);
+      const_cast<idx_t*>(csr_graph.node_distribution().data()),
+      const_cast<idx_t*>(csr_graph.nodes().data()),
+      const_cast<idx_t*>(csr_graph.edges().data()), elmwgt, nullptr,
+      vsize.data(), &wgtflag, &numflag, &ncon, &nparts, tpwgts.data(),
+      ubvec.data(), &_itr, options, &edgecut, part.data(), &mpi_comm);
   assert(err == METIS_OK);
   timer1.stop();
 
-  // Copy cell partition data and return
-  return std::vector<int>(part.begin(), part.end());
+  // Work out halo cells for new division of dual graph
+  common::Timer timer2("Compute graph halo data (ParMETIS)");
+  std::map<std::int64_t, std::vector<int>> ghost_procs
+      = compute_ghost_procs(mpi_comm, csr_graph, part);
+  timer2.stop();
+
+  return std::make_pair(std::vector<int>(part.begin(), part.end()),
+                        std::move(ghost_procs));
 }
 //-----------------------------------------------------------------------------
 template <typename T>
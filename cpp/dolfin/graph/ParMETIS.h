@@ -41,17 +41,24 @@ class ParMETIS
 {
 #ifdef HAS_PARMETIS
 public:
-  // Standard ParMETIS partition
+  // Standard ParMETIS partition, with optional node weights
   static std::pair<std::vector<int>, std::map<std::int64_t, std::vector<int>>>
-  partition(MPI_Comm mpi_comm, const CSRGraph<idx_t>& csr_graph);
+  partition(MPI_Comm mpi_comm, const CSRGraph<idx_t>& csr_graph,
+            const std::vector<std::size_t>& node_weights);
 
-private:
-  // ParMETIS adaptive repartition, so has to be non-const here
-  template <typename T>
-  static std::vector<int> adaptive_repartition(MPI_Comm mpi_comm,
-                                               const CSRGraph<T>& csr_graph,
-                                               double weight = 1000);
+  /// ParMETIS adaptive repartition of a graph that is already
+  /// distributed, with optional node weights. The current distribution
+  /// of the nodes is the starting partition, and nodes are moved
+  /// between processes only where needed to balance the weights. The
+  /// parameter weight is the ratio of the inter-process communication
+  /// time to the data redistribution time (larger values favour a
+  /// smaller edge cut over less data movement).
+  static std::pair<std::vector<int>, std::map<std::int64_t, std::vector<int>>>
+  adaptive_repartition(MPI_Comm mpi_comm, const CSRGraph<idx_t>& csr_graph,
+                       const std::vector<std::size_t>& node_weights,
+                       double weight = 1000);
 
+private:
   // ParMETIS refine repartition
   template <typename T>
   static std::vector<int> refine(MPI_Comm mpi_comm,
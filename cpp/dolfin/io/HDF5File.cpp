@@ -322,7 +322,7 @@ void HDF5File::write(const mesh::Mesh& mesh, int cell_dim,
       // dimension
 
       const std::size_t mpi_rank = _mpi_comm.rank();
-      const std::map<std::int32_t, std::set<std::int32_t>>& shared_entities
+      const mesh::SharedEntities& shared_entities
           = mesh.topology().shared_entities(cell_dim);
 
       std::set<unsigned int> non_local_entities;
@@ -330,12 +330,11 @@ void HDF5File::write(const mesh::Mesh& mesh, int cell_dim,
       {
         // No ghost cells - exclude shared entities which are on lower
         // rank processes
-        for (auto sh = shared_entities.begin(); sh != shared_entities.end();
-             ++sh)
+        for (std::int32_t i = 0; i < shared_entities.size(); ++i)
         {
-          const unsigned int lowest_proc = *(sh->second.begin());
+          const unsigned int lowest_proc = shared_entities.processes(i)[0];
           if (lowest_proc < mpi_rank)
-            non_local_entities.insert(sh->first);
+            non_local_entities.insert(shared_entities.entities()[i]);
         }
       }
       else
@@ -716,7 +715,7 @@ void HDF5File::write_mesh_function(const mesh::MeshFunction<T>& meshfunction,
     // Drop duplicate data
     const std::size_t tdim = mesh.topology().dim();
     const std::size_t mpi_rank = _mpi_comm.rank();
-    const std::map<std::int32_t, std::set<std::int32_t>>& shared_entities
+    const mesh::SharedEntities& shared_entities
         = mesh.topology().shared_entities(cell_dim);
 
     std::set<unsigned int> non_local_entities;
@@ -724,11 +723,11 @@ void HDF5File::write_mesh_function(const mesh::MeshFunction<T>& meshfunction,
     {
       // No ghost cells
       // Exclude shared entities which are on lower rank processes
-      for (auto sh = shared_entities.begin(); sh != shared_entities.end(); ++sh)
+      for (std::int32_t i = 0; i < shared_entities.size(); ++i)
       {
-        const unsigned int lowest_proc = *(sh->second.begin());
+        const unsigned int lowest_proc = shared_entities.processes(i)[0];
         if (lowest_proc < mpi_rank)
-          non_local_entities.insert(sh->first);
+          non_local_entities.insert(shared_entities.entities()[i]);
       }
     }
     else
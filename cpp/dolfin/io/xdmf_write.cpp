@@ -422,7 +422,7 @@ xdmf_write::compute_nonlocal_entities(const mesh::Mesh& mesh, int cell_dim)
   mesh::DistributedMeshTools::number_entities(mesh, cell_dim);
 
   const int mpi_rank = dolfin::MPI::rank(mesh.mpi_comm());
-  const std::map<std::int32_t, std::set<std::int32_t>>& shared_entities
+  const mesh::SharedEntities& shared_entities
       = mesh.topology().shared_entities(cell_dim);
 
   std::set<std::uint32_t> non_local_entities;
@@ -435,11 +435,11 @@ xdmf_write::compute_nonlocal_entities(const mesh::Mesh& mesh, int cell_dim)
   {
     // No ghost cells - exclude shared entities which are on lower rank
     // processes
-    for (const auto& e : shared_entities)
+    for (std::int32_t i = 0; i < shared_entities.size(); ++i)
     {
-      const int lowest_rank_owner = *(e.second.begin());
+      const int lowest_rank_owner = shared_entities.processes(i)[0];
       if (lowest_rank_owner < mpi_rank)
-        non_local_entities.insert(e.first);
+        non_local_entities.insert(shared_entities.entities()[i]);
     }
   }
   else
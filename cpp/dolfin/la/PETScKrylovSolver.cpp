@@ -12,11 +12,78 @@
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/log.h>
 #include <dolfin/fem/PETScDMCollection.h>
+#include <algorithm>
 #include <petsclog.h>
+#include <petscversion.h>
+#include <vector>
 
 using namespace dolfin;
 using namespace dolfin::la;
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Relative true residual norm ||b_j - A x_j|| / ||b_j|| of each column
+// of the dense matrices X and B. The operator is applied to one
+// column at a time since MatMatMult is not supported by shell and
+// matrix-free operators.
+std::vector<PetscReal> relative_residual_norms(Mat A, Mat X, Mat B)
+{
+  PetscErrorCode ierr;
+  PetscInt M, N, m;
+  ierr = MatGetSize(B, &M, &N);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "MatGetSize");
+  ierr = MatGetLocalSize(B, &m, nullptr);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "MatGetLocalSize");
+
+  PetscScalar *b_array, *x_array;
+  ierr = MatDenseGetArray(B, &b_array);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "MatDenseGetArray");
+  ierr = MatDenseGetArray(X, &x_array);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "MatDenseGetArray");
+
+  MPI_Comm comm = MPI_COMM_NULL;
+  PetscObjectGetComm((PetscObject)B, &comm);
+  Vec b, x, r;
+  VecCreateMPIWithArray(comm, 1, m, M, nullptr, &b);
+  VecCreateMPIWithArray(comm, 1, m, M, nullptr, &x);
+  ierr = MatCreateVecs(A, nullptr, &r);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "MatCreateVecs");
+
+  std::vector<PetscReal> rel(N, 0.0);
+  for (PetscInt j = 0; j < N; ++j)
+  {
+    VecPlaceArray(b, b_array + j * m);
+    VecPlaceArray(x, x_array + j * m);
+    ierr = MatMult(A, x, r);
+    if (ierr != 0)
+      petsc_error(ierr, __FILE__, "MatMult");
+    VecAYPX(r, -1.0, b);
+    PetscReal r_norm, b_norm;
+    VecNorm(r, NORM_2, &r_norm);
+    VecNorm(b, NORM_2, &b_norm);
+    if (b_norm > 0.0)
+      rel[j] = r_norm / b_norm;
+    VecResetArray(b);
+    VecResetArray(x);
+  }
+
+  VecDestroy(&r);
+  VecDestroy(&b);
+  VecDestroy(&x);
+  MatDenseRestoreArray(B, &b_array);
+  MatDenseRestoreArray(X, &x_array);
+
+  return rel;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
 //-----------------------------------------------------------------------------
 PETScKrylovSolver::PETScKrylovSolver(MPI_Comm comm) : _ksp(nullptr)
 {
@@ -57,6 +124,24 @@ void PETScKrylovSolver::set_operators(const Mat A, const Mat P)
     petsc_error(ierr, __FILE__, "KSPSetOperators");
 }
 //-----------------------------------------------------------------------------
+void PETScKrylovSolver::set_reuse_preconditioner(bool reuse)
+{
+  assert(_ksp);
+  PetscErrorCode ierr
+      = KSPSetReusePreconditioner(_ksp, reuse ? PETSC_TRUE : PETSC_FALSE);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "KSPSetReusePreconditioner");
+}
+//-----------------------------------------------------------------------------
+void PETScKrylovSolver::set_up()
+{
+  common::Timer timer("PETSc Krylov solver setup");
+  assert(_ksp);
+  PetscErrorCode ierr = KSPSetUp(_ksp);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "KSPSetUp");
+}
+//-----------------------------------------------------------------------------
 int PETScKrylovSolver::solve(Vec x, const Vec b, bool transpose)
 {
   common::Timer timer("PETSc Krylov solver");
@@ -163,6 +248,117 @@ int PETScKrylovSolver::solve(Vec x, const Vec b, bool transpose)
   return num_iterations;
 }
 //-----------------------------------------------------------------------------
+int PETScKrylovSolver::solve(Mat X, const Mat B)
+{
+  common::Timer timer("PETSc Krylov solver (multiple right-hand sides)");
+  assert(X);
+  assert(B);
+
+  Mat A;
+  KSPGetOperators(_ksp, &A, nullptr);
+  assert(A);
+
+  PetscErrorCode ierr;
+  PetscInt M, N;
+  ierr = MatGetSize(B, &M, &N);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "MatGetSize");
+
+  if (dolfin::MPI::rank(this->mpi_comm()) == 0)
+  {
+    LOG(INFO) << "PETSc Krylov solver starting to solve system with " << N
+              << " right-hand sides.";
+  }
+
+  // Set up preconditioner once for all columns
+  ierr = KSPSetUp(_ksp);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "KSPSetUp");
+
+  // Number of iterations and converged reason for each column
+  std::vector<PetscInt> num_iterations(N, 0);
+  std::vector<KSPConvergedReason> reasons(N, KSP_CONVERGED_ITERATING);
+
+#if PETSC_VERSION_GE(3, 14, 0)
+  // PETSc reports a single iteration count and converged reason for
+  // KSPMatSolve, which are used for all columns
+  ierr = KSPMatSolve(_ksp, B, X);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "KSPMatSolve");
+
+  PetscInt its = 0;
+  KSPGetIterationNumber(_ksp, &its);
+  KSPConvergedReason reason;
+  KSPGetConvergedReason(_ksp, &reason);
+  std::fill(num_iterations.begin(), num_iterations.end(), its);
+  std::fill(reasons.begin(), reasons.end(), reason);
+#else
+  // Wrap the local column-major storage of B and X, one column at a
+  // time, as vectors
+  PetscInt m;
+  ierr = MatGetLocalSize(B, &m, nullptr);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "MatGetLocalSize");
+
+  PetscScalar *b_array, *x_array;
+  ierr = MatDenseGetArray(B, &b_array);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "MatDenseGetArray");
+  ierr = MatDenseGetArray(X, &x_array);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "MatDenseGetArray");
+
+  Vec b, x;
+  VecCreateMPIWithArray(this->mpi_comm(), 1, m, M, nullptr, &b);
+  VecCreateMPIWithArray(this->mpi_comm(), 1, m, M, nullptr, &x);
+  for (PetscInt j = 0; j < N; ++j)
+  {
+    VecPlaceArray(b, b_array + j * m);
+    VecPlaceArray(x, x_array + j * m);
+    ierr = KSPSolve(_ksp, b, x);
+    if (ierr != 0)
+      petsc_error(ierr, __FILE__, "KSPSolve");
+    KSPGetIterationNumber(_ksp, &num_iterations[j]);
+    KSPGetConvergedReason(_ksp, &reasons[j]);
+    VecResetArray(b);
+    VecResetArray(x);
+  }
+  VecDestroy(&b);
+  VecDestroy(&x);
+
+  MatDenseRestoreArray(B, &b_array);
+  MatDenseRestoreArray(X, &x_array);
+#endif
+
+  // Relative true residual norm of each column
+  const std::vector<PetscReal> rel = relative_residual_norms(A, X, B);
+
+  // Report convergence of each column
+  if (dolfin::MPI::rank(this->mpi_comm()) == 0)
+  {
+    for (PetscInt j = 0; j < N; ++j)
+    {
+      if (reasons[j] < 0)
+      {
+        LOG(WARNING) << "PETSc Krylov solver failed to converge for "
+                        "right-hand side "
+                     << j << " in " << num_iterations[j]
+                     << " iterations (PETSc reason "
+                     << KSPConvergedReasons[reasons[j]]
+                     << ", relative residual norm " << rel[j] << ").";
+      }
+      else
+      {
+        LOG(INFO) << "PETSc Krylov solver converged for right-hand side " << j
+                  << " in " << num_iterations[j]
+                  << " iterations (relative residual norm " << rel[j] << ").";
+      }
+    }
+  }
+
+  return *std::max_element(num_iterations.begin(), num_iterations.end());
+}
+//-----------------------------------------------------------------------------
 void PETScKrylovSolver::set_dm(DM dm)
 {
   assert(_ksp);
@@ -44,10 +44,33 @@ public:
   /// Set operator and preconditioner matrix (Mat)
   void set_operators(const Mat A, const Mat P);
 
+  /// Keep the current preconditioner when the operators are changed
+  /// or modified (reuse = true), or rebuild it on the next solve
+  /// (reuse = false)
+  void set_reuse_preconditioner(bool reuse);
+
+  /// Set up the solver (including the preconditioner) for the
+  /// current operators. This is otherwise done on the first call to
+  /// solve.
+  void set_up();
+
   /// Solve linear system Ax = b and return number of iterations (A^t x
   /// = b if transpose is true)
   int solve(Vec x, const Vec b, bool transpose = false);
 
+  /// Solve linear system AX = B for multiple right-hand sides, stored
+  /// as the columns of the dense matrices B and X (see
+  /// la::create_petsc_multivector). Uses KSPMatSolve when available
+  /// so that block Krylov methods and preconditioners applied to all
+  /// columns at once can be used; otherwise the columns are solved one
+  /// at a time with the same (set up once) preconditioner. The true
+  /// relative residual norm is reported for every column. With
+  /// KSPMatSolve the iteration count and converged reason are those
+  /// reported by PETSc for the whole solve, and are the same for all
+  /// columns. Returns the number of iterations (the maximum over
+  /// columns if the columns are solved separately).
+  int solve(Mat X, const Mat B);
+
   /// Sets the prefix used by PETSc when searching the PETSc options
   /// database
   void set_options_prefix(std::string options_prefix);
@@ -151,3 +151,14 @@ void PETScMatrix::set_near_nullspace(const la::VectorSpaceBasis& nullspace)
   MatNullSpaceDestroy(&petsc_ns);
 }
 //-----------------------------------------------------------------------------
+std::map<std::string, std::size_t> PETScMatrix::memory_usage() const
+{
+  assert(_matA);
+  MatInfo info;
+  PetscErrorCode ierr = MatGetInfo(_matA, MAT_LOCAL, &info);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "MatGetInfo");
+
+  return {{"matrix", static_cast<std::size_t>(info.memory)}};
+}
+//-----------------------------------------------------------------------------
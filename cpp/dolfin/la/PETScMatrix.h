@@ -10,6 +10,7 @@
 #include "PETScOperator.h"
 #include "utils.h"
 #include <array>
+#include <map>
 #include <petscmat.h>
 #include <string>
 
@@ -100,6 +101,10 @@ public:
   /// Attach 'near' nullspace to matrix (used by preconditioners,
   /// such as smoothed aggregation algerbraic multigrid)
   void set_near_nullspace(const la::VectorSpaceBasis& nullspace);
+
+  /// Return memory (bytes) allocated by PETSc for the local part of
+  /// the matrix, as reported by MatGetInfo
+  std::map<std::string, std::size_t> memory_usage() const;
 };
 } // namespace la
 } // namespace dolfin
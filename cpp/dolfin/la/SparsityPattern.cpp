@@ -9,6 +9,7 @@
 #include <dolfin/common/IndexMap.h>
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/log.h>
+#include <dolfin/common/memory.h>
 #include <dolfin/fem/utils.h>
 
 using namespace dolfin;
@@ -368,6 +369,9 @@ SparsityPattern::num_local_nonzeros() const
 //-----------------------------------------------------------------------------
 void SparsityPattern::assemble()
 {
+  common::MemoryTracker tracker("Assemble sparsity pattern");
+  const std::size_t bytes0 = common::total(memory_usage());
+
   std::size_t bs0 = _index_maps[0]->block_size();
   std::size_t bs1 = _index_maps[1]->block_size();
   const auto local_range0 = _index_maps[0]->local_range();
@@ -435,6 +439,9 @@ void SparsityPattern::assemble()
     // Communicate non-local entries to other processes
     std::vector<std::size_t> non_local_received;
     MPI::all_to_all(_mpi_comm.comm(), non_local_send, non_local_received);
+    common::ScopedMemory buffer_memory(
+        common::heap_memory(non_local_send)
+        + common::heap_memory(non_local_received));
 
     // Insert non-local entries received from other processes
     assert(non_local_received.size() % 2 == 0);
@@ -475,6 +482,18 @@ void SparsityPattern::assemble()
 
   // Clear non-local entries
   _non_local.clear();
+
+  // Growth of the pattern
+  const std::size_t bytes1 = common::total(memory_usage());
+  if (bytes1 > bytes0)
+    common::MemoryTracker::allocate(bytes1 - bytes0);
+}
+//-----------------------------------------------------------------------------
+std::map<std::string, std::size_t> SparsityPattern::memory_usage() const
+{
+  return {{"diagonal", common::heap_memory(_diagonal)},
+          {"off-diagonal", common::heap_memory(_off_diagonal)},
+          {"non-local", common::heap_memory(_non_local)}};
 }
 //-----------------------------------------------------------------------------
 std::string SparsityPattern::str(bool verbose) const
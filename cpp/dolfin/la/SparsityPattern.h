@@ -9,6 +9,7 @@
 #include <Eigen/Dense>
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/Set.h>
+#include <map>
 #include <memory>
 #include <petscsys.h>
 #include <string>
@@ -107,6 +108,10 @@ public:
   /// Return MPI communicator
   MPI_Comm mpi_comm() const { return _mpi_comm.comm(); }
 
+  /// Return memory (bytes) used by the diagonal and off-diagonal
+  /// patterns, and by the cache of non-local entries
+  std::map<std::string, std::size_t> memory_usage() const;
+
   /// Return informal string representation (pretty-print)
   std::string str(bool verbose) const;
 
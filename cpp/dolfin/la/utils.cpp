@@ -77,6 +77,21 @@ Vec dolfin::la::create_petsc_vector(
   return x;
 }
 //-----------------------------------------------------------------------------
+Mat dolfin::la::create_petsc_multivector(const dolfin::common::IndexMap& map,
+                                         int n)
+{
+  const PetscInt m = map.block_size() * map.size_local();
+  Mat X;
+  PetscErrorCode ierr = MatCreateDense(map.mpi_comm(), m, PETSC_DECIDE,
+                                       PETSC_DETERMINE, n, nullptr, &X);
+  CHECK_ERROR("MatCreateDense");
+  ierr = MatAssemblyBegin(X, MAT_FINAL_ASSEMBLY);
+  CHECK_ERROR("MatAssemblyBegin");
+  ierr = MatAssemblyEnd(X, MAT_FINAL_ASSEMBLY);
+  CHECK_ERROR("MatAssemblyEnd");
+  return X;
+}
+//-----------------------------------------------------------------------------
 Mat dolfin::la::create_petsc_matrix(
     MPI_Comm comm, const dolfin::la::SparsityPattern& sparsity_pattern)
 {
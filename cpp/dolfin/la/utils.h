@@ -50,6 +50,12 @@ Vec create_petsc_vector(
     const Eigen::Array<PetscInt, Eigen::Dynamic, 1>& ghost_indices,
     int block_size);
 
+/// Create a dense PETSc Mat with the row layout of an IndexMap (owned
+/// indices only) and n columns, e.g. to hold multiple right-hand sides
+/// or solutions. Caller is responsible for destroying the returned
+/// object.
+Mat create_petsc_multivector(const common::IndexMap& map, int n);
+
 /// Create a PETSc Mat. Caller is responsible for destroying the
 /// returned object.
 Mat create_petsc_matrix(MPI_Comm comm, const SparsityPattern& sparsity_pattern);
@@ -0,0 +1,68 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "CompressedConnectivity.h"
+#include "Connectivity.h"
+#include <limits>
+#include <stdexcept>
+
+using namespace dolfin;
+using namespace dolfin::mesh;
+
+//-----------------------------------------------------------------------------
+CompressedConnectivity::CompressedConnectivity(
+    const Connectivity& connectivity)
+    : _offsets(connectivity.num_entities() + 1, 0)
+{
+  const std::int32_t num_entities = connectivity.num_entities();
+  _data.reserve(connectivity.connections().size());
+  for (std::int32_t e = 0; e < num_entities; ++e)
+  {
+    const std::int32_t* c = connectivity.connections(e);
+    std::int32_t previous = 0;
+    for (std::size_t i = 0; i < connectivity.size(e); ++i)
+    {
+      // Zigzag encode difference to previous connection, so that small
+      // negative differences also give small unsigned values. The
+      // difference wraps around in 32 bits, so any two values can follow
+      // each other.
+      const std::uint32_t d = std::uint32_t(c[i]) - std::uint32_t(previous);
+      std::uint32_t v = (d << 1) ^ (0u - (d >> 31));
+      previous = c[i];
+
+      // Write 7 bits per byte, with the high bit set on all but the
+      // last byte
+      while (v >= 0x80)
+      {
+        _data.push_back(std::uint8_t(v | 0x80));
+        v >>= 7;
+      }
+      _data.push_back(std::uint8_t(v));
+    }
+
+    if (_data.size() > std::numeric_limits<std::uint32_t>::max())
+      throw std::runtime_error("Connectivity is too large to compress.");
+    _offsets[e + 1] = _data.size();
+  }
+
+  _data.shrink_to_fit();
+}
+//-----------------------------------------------------------------------------
+Connectivity CompressedConnectivity::decompress() const
+{
+  const std::int32_t num_entities = this->num_entities();
+  std::vector<std::int32_t> positions(num_entities + 1, 0);
+  std::vector<std::int32_t> connections;
+  connections.reserve(_data.size());
+  for (std::int32_t e = 0; e < num_entities; ++e)
+  {
+    connections.insert(connections.end(), begin(e), end(e));
+    positions[e + 1] = connections.size();
+  }
+
+  return Connectivity(connections, positions);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,175 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace dolfin
+{
+namespace mesh
+{
+class Connectivity;
+
+/// Read-only, compressed copy of a Connectivity. It is intended for
+/// large connectivities with a variable number of connections per
+/// entity, e.g. vertex - cell connectivity, which need to be kept for
+/// a long time but are traversed only occasionally.
+///
+/// The connections of each entity are stored as the difference to the
+/// previous connection, encoded as variable-length integers (7 bits
+/// per byte). The connections are decoded on the fly when traversed
+/// with an iterator.
+
+class CompressedConnectivity
+{
+public:
+  /// Iterator over the connections of an entity, decoding one
+  /// connection at a time
+  class const_iterator
+  {
+  public:
+    /// Iterator traits
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::int32_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const std::int32_t* pointer;
+    typedef const std::int32_t& reference;
+
+    /// Create iterator positioned at the encoded data p, with
+    /// connections ending at end
+    const_iterator(const std::uint8_t* p, const std::uint8_t* end)
+        : _p(p), _next(p), _end(end), _value(0)
+    {
+      if (_p != _end)
+        decode();
+    }
+
+    /// Current connection
+    const std::int32_t& operator*() const { return _value; }
+
+    /// Move to next connection
+    const_iterator& operator++()
+    {
+      _p = _next;
+      if (_p != _end)
+        decode();
+      return *this;
+    }
+
+    /// Move to next connection
+    const_iterator operator++(int)
+    {
+      const_iterator it = *this;
+      ++(*this);
+      return it;
+    }
+
+    /// Equality
+    bool operator==(const const_iterator& it) const { return _p == it._p; }
+
+    /// Inequality
+    bool operator!=(const const_iterator& it) const { return _p != it._p; }
+
+  private:
+    // Decode the connection starting at _p
+    void decode()
+    {
+      std::uint32_t v = 0;
+      int shift = 0;
+      _next = _p;
+      while (*_next & 0x80)
+      {
+        v |= std::uint32_t(*_next++ & 0x7f) << shift;
+        shift += 7;
+      }
+      v |= std::uint32_t(*_next++) << shift;
+
+      // Undo zigzag encoding of the difference, which wraps around in
+      // 32 bits
+      _value = std::int32_t(std::uint32_t(_value)
+                            + ((v >> 1) ^ (0u - (v & 1))));
+    }
+
+    // Start of current, and next, encoded connection
+    const std::uint8_t* _p;
+    const std::uint8_t* _next;
+
+    // End of encoded connections
+    const std::uint8_t* _end;
+
+    // Current connection
+    std::int32_t _value;
+  };
+
+  /// Create compressed copy of connectivity
+  explicit CompressedConnectivity(const Connectivity& connectivity);
+
+  /// Copy constructor
+  CompressedConnectivity(const CompressedConnectivity& connectivity) = default;
+
+  /// Move constructor
+  CompressedConnectivity(CompressedConnectivity&& connectivity) = default;
+
+  /// Destructor
+  ~CompressedConnectivity() = default;
+
+  /// Assignment
+  CompressedConnectivity& operator=(const CompressedConnectivity& connectivity)
+      = default;
+
+  /// Move assignment
+  CompressedConnectivity& operator=(CompressedConnectivity&& connectivity)
+      = default;
+
+  /// Return number of entities
+  std::int32_t num_entities() const { return _offsets.size() - 1; }
+
+  /// Return number of connections for given entity
+  std::size_t size(std::int32_t entity) const
+  {
+    // Count the final byte of each encoded connection
+    std::size_t n = 0;
+    for (std::uint32_t i = _offsets[entity]; i < _offsets[entity + 1]; ++i)
+      n += (_data[i] & 0x80) == 0;
+    return n;
+  }
+
+  /// Iterator to first connection of given entity
+  const_iterator begin(std::int32_t entity) const
+  {
+    return const_iterator(_data.data() + _offsets[entity],
+                          _data.data() + _offsets[entity + 1]);
+  }
+
+  /// Iterator to one past the last connection of given entity
+  const_iterator end(std::int32_t entity) const
+  {
+    return const_iterator(_data.data() + _offsets[entity + 1],
+                          _data.data() + _offsets[entity + 1]);
+  }
+
+  /// Decompress to a Connectivity
+  Connectivity decompress() const;
+
+  /// Return memory (bytes) used by the compressed data
+  std::size_t memory_usage() const
+  {
+    return _data.size() + sizeof(std::uint32_t) * _offsets.size();
+  }
+
+private:
+  // Encoded connections for all entities
+  std::vector<std::uint8_t> _data;
+
+  // Position of the encoded connections of each entity in _data
+  std::vector<std::uint32_t> _offsets;
+};
+} // namespace mesh
+} // namespace dolfin
@@ -14,21 +14,34 @@ using namespace dolfin::mesh;
 //-----------------------------------------------------------------------------
 Connectivity::Connectivity(const std::vector<std::int32_t>& connections,
                            const std::vector<std::int32_t>& positions)
-    : _connections(connections.size()), _index_to_position(positions.size())
+    : _num_entities(positions.size() - 1), _connections(connections.size())
 {
+  assert(!positions.empty());
   assert(positions.back() == (std::int32_t)connections.size());
   for (std::size_t i = 0; i < connections.size(); ++i)
     _connections[i] = connections[i];
-  for (std::size_t i = 0; i < positions.size(); ++i)
-    _index_to_position[i] = positions[i];
+
+  // Store offsets only if number of connections varies between entities
+  _num_connections = _num_entities > 0 ? positions[1] - positions[0] : 0;
+  for (std::int32_t e = 0; e < _num_entities; ++e)
+  {
+    if (positions[e + 1] - positions[e] != _num_connections)
+    {
+      _num_connections = -1;
+      _index_to_position.resize(positions.size());
+      for (std::size_t i = 0; i < positions.size(); ++i)
+        _index_to_position[i] = positions[i];
+      break;
+    }
+  }
 }
 //-----------------------------------------------------------------------------
 Connectivity::Connectivity(
     const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic,
                                         Eigen::Dynamic, Eigen::RowMajor>>
         connections)
-    : _connections(connections.rows() * connections.cols()),
-      _index_to_position(connections.rows() + 1)
+    : _num_entities(connections.rows()), _num_connections(connections.cols()),
+      _connections(connections.rows() * connections.cols())
 {
   // NOTE: cannot directly copy data from connections because it may be
   // a view into a larger array, e.g. for non-affine cells
@@ -36,17 +49,6 @@ Connectivity::Connectivity(
   for (Eigen::Index i = 0; i < connections.rows(); ++i)
     for (Eigen::Index j = 0; j < connections.cols(); ++j)
       _connections[k++] = connections(i, j);
-
-  const std::int32_t num_connections_per_entity = connections.cols();
-  for (Eigen::Index e = 0; e < _index_to_position.rows(); e++)
-    _index_to_position[e] = e * num_connections_per_entity;
-}
-//-----------------------------------------------------------------------------
-std::size_t Connectivity::size(std::int32_t entity) const
-{
-  return (entity + 1) < _index_to_position.size()
-             ? _index_to_position[entity + 1] - _index_to_position[entity]
-             : 0;
 }
 //-----------------------------------------------------------------------------
 std::size_t Connectivity::size_global(std::int32_t entity) const
@@ -60,20 +62,6 @@ std::size_t Connectivity::size_global(std::int32_t entity) const
   }
 }
 //-----------------------------------------------------------------------------
-std::int32_t* Connectivity::connections(int entity)
-{
-  return (entity + 1) < _index_to_position.size()
-             ? &_connections[_index_to_position[entity]]
-             : nullptr;
-}
-//-----------------------------------------------------------------------------
-const std::int32_t* Connectivity::connections(int entity) const
-{
-  return (entity + 1) < _index_to_position.size()
-             ? &_connections[_index_to_position[entity]]
-             : nullptr;
-}
-//-----------------------------------------------------------------------------
 Eigen::Ref<Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>
 Connectivity::connections()
 {
@@ -86,21 +74,23 @@ Connectivity::connections() const
   return _connections;
 }
 //-----------------------------------------------------------------------------
-Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& Connectivity::entity_positions()
-{
-  return _index_to_position;
-}
-//-----------------------------------------------------------------------------
 const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>&
 Connectivity::entity_positions() const
 {
+  if (_num_connections != -1 and _index_to_position.size() == 0)
+  {
+    _index_to_position
+        = Eigen::Array<std::int32_t, Eigen::Dynamic, 1>::LinSpaced(
+              _num_entities + 1, 0, _num_entities)
+          * _num_connections;
+  }
   return _index_to_position;
 }
 //-----------------------------------------------------------------------------
 void Connectivity::set_global_size(
     const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& num_global_connections)
 {
-  assert(num_global_connections.size() == _index_to_position.size() - 1);
+  assert(num_global_connections.size() == _num_entities);
   _num_global_connections = num_global_connections;
 }
 //-----------------------------------------------------------------------------
@@ -110,6 +100,13 @@ std::size_t Connectivity::hash() const
                            _connections.data() + _connections.size());
 }
 //-----------------------------------------------------------------------------
+std::size_t Connectivity::memory_usage() const
+{
+  return sizeof(std::int32_t)
+         * (_connections.size() + _index_to_position.size()
+            + _num_global_connections.size());
+}
+//-----------------------------------------------------------------------------
 std::string Connectivity::str(bool verbose) const
 {
   std::stringstream s;
@@ -117,14 +114,11 @@ std::string Connectivity::str(bool verbose) const
   if (verbose)
   {
     s << str(false) << std::endl << std::endl;
-    for (Eigen::Index e = 0; e < _index_to_position.size() - 1; e++)
+    for (std::int32_t e = 0; e < _num_entities; e++)
     {
       s << "  " << e << ":";
-      for (std::int32_t i = _index_to_position[e];
-           i < _index_to_position[e + 1]; i++)
-      {
-        s << " " << _connections[i];
-      }
+      for (std::size_t i = 0; i < size(e); i++)
+        s << " " << connections(e)[i];
       s << std::endl;
     }
   }
@@ -7,7 +7,9 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <numeric>
 #include <vector>
 
@@ -24,6 +26,10 @@ namespace mesh
 /// number of entities and the number of connections for each entity,
 /// which may either be equal for all entities or different, or by
 /// giving the entire (sparse) connectivity pattern.
+///
+/// If all entities have the same number of connections (e.g. cell -
+/// vertex connectivity), the array of offsets to the connections of
+/// each entity is not stored.
 
 class Connectivity
 {
@@ -45,24 +51,34 @@ public:
   /// std::vector<<std::set<std::size_t>>, etc)
   template <typename T>
   Connectivity(const std::vector<T>& connections)
-      : _index_to_position(connections.size() + 1)
+      : _num_entities(connections.size())
   {
-    // Initialize offsets and compute total size
+    // Compute total size, and check for constant number of connections
     std::int32_t size = 0;
+    _num_connections = connections.empty() ? 0 : connections[0].size();
     for (std::size_t e = 0; e < connections.size(); e++)
     {
-      _index_to_position[e] = size;
       size += connections[e].size();
+      if ((std::int32_t)connections[e].size() != _num_connections)
+        _num_connections = -1;
     }
-    _index_to_position[connections.size()] = size;
 
-    std::vector<std::int32_t> c;
-    c.reserve(size);
-    for (auto e = connections.begin(); e != connections.end(); ++e)
-      c.insert(c.end(), e->begin(), e->end());
+    // Initialize offsets
+    if (_num_connections == -1)
+    {
+      _index_to_position.resize(connections.size() + 1);
+      _index_to_position[0] = 0;
+      for (std::size_t e = 0; e < connections.size(); e++)
+      {
+        _index_to_position[e + 1]
+            = _index_to_position[e] + connections[e].size();
+      }
+    }
 
-    _connections = Eigen::Array<std::int32_t, Eigen::Dynamic, 1>(c.size());
-    std::copy(c.begin(), c.end(), _connections.data());
+    _connections.resize(size);
+    std::int32_t* c = _connections.data();
+    for (auto e = connections.begin(); e != connections.end(); ++e)
+      c = std::copy(e->begin(), e->end(), c);
   }
 
   /// Copy constructor
@@ -80,17 +96,36 @@ public:
   /// Move assignment
   Connectivity& operator=(Connectivity&& connectivity) = default;
 
+  /// Return number of entities
+  std::int32_t num_entities() const { return _num_entities; }
+
   /// Return number of connections for given entity
-  std::size_t size(std::int32_t entity) const;
+  std::size_t size(std::int32_t entity) const
+  {
+    if (entity >= _num_entities)
+      return 0;
+    else if (_num_connections != -1)
+      return _num_connections;
+    else
+      return _index_to_position[entity + 1] - _index_to_position[entity];
+  }
 
   /// Return global number of connections for given entity
   std::size_t size_global(std::int32_t entity) const;
 
   /// Return array of connections for given entity
-  std::int32_t* connections(int entity);
+  std::int32_t* connections(int entity)
+  {
+    return entity < _num_entities ? _connections.data() + position(entity)
+                                  : nullptr;
+  }
 
   /// Return array of connections for given entity (const version)
-  const std::int32_t* connections(int entity) const;
+  const std::int32_t* connections(int entity) const
+  {
+    return entity < _num_entities ? _connections.data() + position(entity)
+                                  : nullptr;
+  }
 
   /// Return contiguous array of connections for all entities
   Eigen::Ref<Eigen::Array<std::int32_t, Eigen::Dynamic, 1>> connections();
@@ -101,12 +136,15 @@ public:
   connections() const;
 
   /// Position of first connection in connections() for each entity
-  /// (using local index)
-  Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& entity_positions();
+  /// (using local index), with the total number of connections
+  /// appended. If all entities have the same number of connections,
+  /// the array is created on the first call and kept.
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>&
+  entity_positions() const;
 
-  /// Position of first connection in connections() for each entity
-  /// (using local index) (const version)
-  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& entity_positions() const;
+  /// Return number of connections for each entity if the number is the
+  /// same for all entities, otherwise -1
+  std::int32_t num_connections_per_entity() const { return _num_connections; }
 
   /// Set global number of connections for each local entities
   void set_global_size(const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>&
@@ -115,19 +153,138 @@ public:
   /// Hash of connections
   std::size_t hash() const;
 
+  /// Return memory (bytes) used by the connectivity data
+  std::size_t memory_usage() const;
+
   /// Return informal string representation (pretty-print)
   std::string str(bool verbose) const;
 
 private:
+  friend class ConnectivityView;
+
+  // Position of first connection for entity
+  std::int32_t position(std::int32_t entity) const
+  {
+    return _num_connections != -1 ? entity * _num_connections
+                                  : _index_to_position[entity];
+  }
+
+  // Number of entities
+  std::int32_t _num_entities;
+
+  // Number of connections per entity if constant for all entities,
+  // otherwise -1
+  std::int32_t _num_connections;
+
   // Connections for all entities stored as a contiguous array
   Eigen::Array<std::int32_t, Eigen::Dynamic, 1> _connections;
 
-  // Position of first connection for each entity (using local index)
-  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> _index_to_position;
+  // Position of first connection for each entity (using local index).
+  // If the number of connections is constant, it is empty until
+  // requested through entity_positions().
+  mutable Eigen::Array<std::int32_t, Eigen::Dynamic, 1> _index_to_position;
 
   // Global number of connections for each entity (possibly not
   // computed)
   Eigen::Array<std::int32_t, Eigen::Dynamic, 1> _num_global_connections;
 };
+
+/// Lightweight, index-based view of a Connectivity for loops over many
+/// entities. It holds raw pointers to the connectivity arrays, so it
+/// is cheap to copy and should be created once, outside of the loop,
+/// e.g.
+///
+///   const ConnectivityView facet_cell
+///       = mesh.topology().connectivity_view(tdim - 1, tdim);
+///   for (std::int32_t f = 0; f < facet_cell.num_entities(); ++f)
+///   {
+///     const std::int32_t* cells = facet_cell.connections(f);
+///     ...
+///   }
+///
+/// A view is valid while the Connectivity exists and is not modified.
+
+class ConnectivityView
+{
+public:
+  /// Create empty view
+  ConnectivityView()
+      : _connections(nullptr), _offsets(nullptr),
+        _num_global_connections(nullptr), _num_entities(0),
+        _num_connections(-1)
+  {
+  }
+
+  /// Create view of connectivity
+  explicit ConnectivityView(const Connectivity& connectivity)
+      : _connections(connectivity._connections.data()),
+        _offsets(connectivity._index_to_position.data()),
+        _num_global_connections(
+            connectivity._num_global_connections.size() > 0
+                ? connectivity._num_global_connections.data()
+                : nullptr),
+        _num_entities(connectivity._num_entities),
+        _num_connections(connectivity._num_connections)
+  {
+  }
+
+  /// Return number of entities
+  std::int32_t num_entities() const { return _num_entities; }
+
+  /// Return number of connections for given entity
+  std::int32_t size(std::int32_t entity) const
+  {
+    assert(entity < _num_entities);
+    return _num_connections != -1 ? _num_connections
+                                  : _offsets[entity + 1] - _offsets[entity];
+  }
+
+  /// Return global number of connections for given entity (equal to
+  /// the local number if the global number has not been set)
+  std::int32_t size_global(std::int32_t entity) const
+  {
+    return _num_global_connections ? _num_global_connections[entity]
+                                   : size(entity);
+  }
+
+  /// Return array of connections for given entity
+  const std::int32_t* connections(std::int32_t entity) const
+  {
+    assert(entity < _num_entities);
+    return _num_connections != -1 ? _connections + entity * _num_connections
+                                  : _connections + _offsets[entity];
+  }
+
+  /// Return position of connection in the connections of given entity,
+  /// e.g. the local index of a facet of a cell, or -1 if the entity is
+  /// not connected to it
+  int local_index(std::int32_t entity, std::int32_t connection) const
+  {
+    const std::int32_t* c = connections(entity);
+    const int n = size(entity);
+    for (int i = 0; i < n; ++i)
+      if (c[i] == connection)
+        return i;
+    return -1;
+  }
+
+private:
+  // Connections for all entities
+  const std::int32_t* _connections;
+
+  // Position of first connection for each entity (not used if the
+  // number of connections is constant)
+  const std::int32_t* _offsets;
+
+  // Global number of connections for each entity (null if not
+  // computed)
+  const std::int32_t* _num_global_connections;
+
+  // Number of entities
+  std::int32_t _num_entities;
+
+  // Number of connections per entity if constant, otherwise -1
+  std::int32_t _num_connections;
+};
 } // namespace mesh
 } // namespace dolfin
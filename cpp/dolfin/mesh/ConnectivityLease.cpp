@@ -0,0 +1,130 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "ConnectivityLease.h"
+#include "Connectivity.h"
+#include "Mesh.h"
+#include "Topology.h"
+#include <cassert>
+#include <stdexcept>
+
+using namespace dolfin;
+using namespace dolfin::mesh;
+
+//-----------------------------------------------------------------------------
+ConnectivityLease::ConnectivityLease(const Mesh& mesh, std::size_t d0,
+                                     std::size_t d1)
+    : _mesh(&mesh)
+{
+  // The topology is modified to register leases, in the same sense
+  // that connectivity is computed on a const mesh
+  Topology& topology = const_cast<Mesh&>(mesh).topology();
+  const std::size_t tdim = topology.dim();
+
+  // Record which connectivities exist before computing
+  std::vector<bool> existed((tdim + 1) * (tdim + 1));
+  for (std::size_t i = 0; i <= tdim; ++i)
+    for (std::size_t j = 0; j <= tdim; ++j)
+      existed[i * (tdim + 1) + j] = (bool)topology.connectivity(i, j);
+
+  // Compute entities and connectivity, if required
+  mesh.create_entities(d0);
+  mesh.create_entities(d1);
+  mesh.create_connectivity(d0, d1);
+
+  // Connectivities that the leased connectivity depends on: d0 - d1,
+  // and the entities of dimensions d0 and d1, which are defined by the
+  // entity-vertex and cell-entity connectivities
+  auto required = [d0, d1, tdim](std::size_t i, std::size_t j) {
+    return (i == d0 and j == d1) or ((i == d0 or i == d1) and j == 0)
+           or (i == tdim and (j == d0 or j == d1));
+  };
+
+  // Hold the connectivities that have been computed by this lease, and
+  // required connectivities that are held by other leases
+  for (std::size_t i = 0; i <= tdim; ++i)
+  {
+    for (std::size_t j = 0; j <= tdim; ++j)
+    {
+      std::shared_ptr<const Connectivity> c = topology.connectivity(i, j);
+      if (!c)
+        continue;
+
+      if (!existed[i * (tdim + 1) + j]
+          or (required(i, j) and topology.num_connectivity_leases(i, j) > 0))
+      {
+        topology.lease_connectivity(i, j);
+        _held.push_back(std::make_tuple(i, j, c));
+      }
+    }
+  }
+
+  _connectivity = topology.connectivity(d0, d1);
+  assert(_connectivity);
+}
+//-----------------------------------------------------------------------------
+ConnectivityLease::~ConnectivityLease() { release(); }
+//-----------------------------------------------------------------------------
+ConnectivityLease& ConnectivityLease::operator=(ConnectivityLease&& lease)
+{
+  release();
+  _mesh = lease._mesh;
+  _connectivity = std::move(lease._connectivity);
+  _held = std::move(lease._held);
+  lease._held.clear();
+  return *this;
+}
+//-----------------------------------------------------------------------------
+const Mesh& ConnectivityLease::mesh() const
+{
+  assert(_mesh);
+  return *_mesh;
+}
+//-----------------------------------------------------------------------------
+const Connectivity& ConnectivityLease::connectivity() const
+{
+  if (!_connectivity)
+    throw std::runtime_error("Connectivity lease has been released.");
+  return *_connectivity;
+}
+//-----------------------------------------------------------------------------
+void ConnectivityLease::pin()
+{
+  assert(_mesh);
+  Topology& topology = const_cast<Mesh*>(_mesh)->topology();
+  for (auto& held : _held)
+  {
+    // Skip connectivities that have been cleared or replaced since the
+    // lease was created
+    const std::size_t d0 = std::get<0>(held);
+    const std::size_t d1 = std::get<1>(held);
+    if (topology.connectivity(d0, d1) == std::get<2>(held))
+      topology.pin_connectivity(d0, d1);
+  }
+  _held.clear();
+}
+//-----------------------------------------------------------------------------
+void ConnectivityLease::release()
+{
+  if (!_held.empty())
+  {
+    assert(_mesh);
+    Topology& topology = const_cast<Mesh*>(_mesh)->topology();
+    for (auto& held : _held)
+    {
+      // Skip connectivities that have been cleared or replaced since
+      // the lease was created
+      const std::size_t d0 = std::get<0>(held);
+      const std::size_t d1 = std::get<1>(held);
+      if (topology.connectivity(d0, d1) == std::get<2>(held))
+        topology.release_connectivity(d0, d1);
+    }
+    _held.clear();
+  }
+
+  _connectivity.reset();
+}
+//-----------------------------------------------------------------------------
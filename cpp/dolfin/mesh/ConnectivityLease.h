@@ -0,0 +1,88 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace dolfin
+{
+namespace mesh
+{
+class Connectivity;
+class Mesh;
+
+/// A ConnectivityLease provides scoped access to the connectivity
+/// between entities of two topological dimensions of a mesh. The
+/// connectivity, and any entities and connectivities computed to
+/// create it, are computed if required and freed when the last lease
+/// on them is released, unless the lease is pinned. Connectivities
+/// that existed before the lease was created, and are not held by
+/// other leases, are not affected.
+///
+/// Leases are intended for one-off operations, e.g.
+///
+///   {
+///     mesh::ConnectivityLease facet_cell(mesh, tdim - 1, tdim);
+///     for (auto& facet : mesh::MeshRange<mesh::Facet>(mesh))
+///       ...
+///   } // Facets and facet-cell connectivity freed here
+///
+/// A lease must not outlive its mesh.
+
+class ConnectivityLease
+{
+public:
+  /// Create lease on connectivity d0 - d1 of mesh, computing the
+  /// entities of dimensions d0 and d1 and the connectivity if required
+  ConnectivityLease(const Mesh& mesh, std::size_t d0, std::size_t d1);
+
+  /// Copy constructor
+  ConnectivityLease(const ConnectivityLease& lease) = delete;
+
+  /// Move constructor
+  ConnectivityLease(ConnectivityLease&& lease) = default;
+
+  /// Destructor (releases the lease)
+  ~ConnectivityLease();
+
+  /// Assignment
+  ConnectivityLease& operator=(const ConnectivityLease& lease) = delete;
+
+  /// Move assignment (releases the current lease)
+  ConnectivityLease& operator=(ConnectivityLease&& lease);
+
+  /// Return the mesh
+  const Mesh& mesh() const;
+
+  /// Return the leased connectivity
+  const Connectivity& connectivity() const;
+
+  /// Keep the connectivities held by this lease for the lifetime of
+  /// the mesh
+  void pin();
+
+  /// Release the lease. Connectivities held by no other lease are
+  /// freed.
+  void release();
+
+private:
+  // The mesh
+  const Mesh* _mesh;
+
+  // The leased connectivity (null when released)
+  std::shared_ptr<const Connectivity> _connectivity;
+
+  // Connectivities (d0, d1, connectivity) held by this lease
+  std::vector<
+      std::tuple<std::size_t, std::size_t, std::shared_ptr<const Connectivity>>>
+      _held;
+};
+} // namespace mesh
+} // namespace dolfin
@@ -6,17 +6,21 @@
 
 #include "DistributedMeshTools.h"
 #include "Cell.h"
+#include "Connectivity.h"
 #include "Facet.h"
 #include "Mesh.h"
 #include "MeshFunction.h"
 #include "MeshIterator.h"
+#include "SharedEntities.h"
 #include "Vertex.h"
 #include "dolfin/common/MPI.h"
 #include "dolfin/common/Timer.h"
 #include "dolfin/graph/Graph.h"
 #include "dolfin/graph/SCOTCH.h"
 #include <Eigen/Dense>
+#include <algorithm>
 #include <complex>
+#include <iterator>
 #include <dolfin/common/log.h>
 
 using namespace dolfin;
@@ -25,43 +29,6 @@ using namespace dolfin::mesh;
 //-----------------------------------------------------------------------------
 namespace
 {
-typedef std::vector<std::size_t> Entity;
-
-// Data structure for mesh entity data
-struct EntityData
-{
-  // Constructor
-  EntityData() : local_index(0) {}
-
-  // Move constructor
-  EntityData(EntityData&&) = default;
-
-  // Move assignment
-  EntityData& operator=(EntityData&&) = default;
-
-  // Constructor  (index is local)
-  explicit EntityData(std::int32_t index) : local_index(index) {}
-
-  // Constructor (index is local)
-  EntityData(std::int32_t index, const std::vector<std::int32_t>& procs)
-      : local_index(index), processes(procs)
-  {
-    // Do nothing
-  }
-
-  // Constructor  (index is local)
-  EntityData(std::int32_t index, std::int32_t process)
-      : local_index(index), processes(1, process)
-  {
-    // Do nothing
-  }
-
-  // Local (this process) entity index
-  std::int32_t local_index;
-
-  // Processes on which entity resides
-  std::vector<std::int32_t> processes;
-};
 //-----------------------------------------------------------------------------
 template <typename T>
 Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
@@ -158,348 +125,244 @@ std::pair<std::size_t, std::size_t> compute_num_global_entities(
   return {num_global, offset};
 }
 //-----------------------------------------------------------------------------
-// Check if all entity vertices are the shared vertices in overlap
-bool is_shared(
-    const Entity& entity,
-    const std::map<std::size_t, std::set<std::int32_t>>& shared_vertices)
+// Ownership of a mesh entity on this process
+enum class Ownership : std::int8_t
 {
-  // Iterate over entity vertices
-  for (auto e = entity.cbegin(); e != entity.cend(); ++e)
-  {
-    // Return false if an entity vertex is not in the list (map) of
-    // shared entities
-    if (shared_vertices.find(*e) == shared_vertices.end())
-      return false;
-  }
-
-  return true;
-}
+  // Slave entity (numbered by its master)
+  excluded,
+  // Owned exclusively (numbered by this process)
+  owned,
+  // Owned and shared (numbered by this process, and number
+  // communicated to the other sharing processes)
+  owned_shared,
+  // Not owned but shared (numbered by another process, and number
+  // communicated to this process)
+  unowned
+};
 //-----------------------------------------------------------------------------
-// Build preliminary 'guess' of shared entities. This function does not
-// involve any inter-process communication. Returns (owned_entities,
-// entity_ownership).
-std::pair<std::vector<std::size_t>, std::array<std::map<Entity, EntityData>, 2>>
-compute_preliminary_entity_ownership(
-    const MPI_Comm mpi_comm,
-    const std::map<std::size_t, std::set<std::int32_t>>& shared_vertices,
-    const std::map<Entity, std::int32_t>& entities)
+// Ownership of the entities of a given dimension, and the key
+// exchange with the neighbouring processes, which is reused to
+// communicate the numbers of shared entities
+struct EntityOwnership
 {
-  // Create  maps
-  std::vector<std::size_t> owned_entities;
-  std::array<std::map<Entity, EntityData>, 2> shared_entities;
-
-  // Entities
-  std::map<Entity, EntityData>& owned_shared_entities = shared_entities[0];
-  std::map<Entity, EntityData>& unowned_shared_entities = shared_entities[1];
-
-  // Get my process number
-  const std::int32_t process_number = dolfin::MPI::rank(mpi_comm);
+  // Ownership of each entity
+  std::vector<Ownership> ownership;
 
-  // Iterate over all local entities
-  for (auto it = entities.cbegin(); it != entities.cend(); ++it)
-  {
-    const Entity& entity = it->first;
-    const std::size_t local_entity_index = it->second;
+  // (local entity index, sharing process) pairs
+  std::vector<std::pair<std::int32_t, std::int32_t>> sharing;
 
-    // Compute which processes entity is shared with
-    std::vector<std::int32_t> entity_processes;
-    if (is_shared(entity, shared_vertices))
-    {
-      // Processes sharing first vertex of entity
-      std::vector<std::size_t> intersection(
-          shared_vertices.find(entity[0])->second.begin(),
-          shared_vertices.find(entity[0])->second.end());
-      std::vector<std::size_t>::iterator intersection_end = intersection.end();
-
-      // Loop over entity vertices
-      for (std::size_t i = 1; i < entity.size(); ++i)
-      {
-        // Global vertex index
-        const std::size_t v = entity[i];
+  // Local indices of the entities whose keys were sent to each process
+  std::vector<std::vector<std::int32_t>> sent;
 
-        // Sharing processes
-        const std::set<std::int32_t>& shared_vertices_v
-            = shared_vertices.find(v)->second;
-
-        intersection_end = std::set_intersection(
-            intersection.begin(), intersection_end, shared_vertices_v.begin(),
-            shared_vertices_v.end(), intersection.begin());
-      }
-      entity_processes
-          = std::vector<std::int32_t>(intersection.begin(), intersection_end);
-    }
+  // Local index of the entity matching each key received from each
+  // process (-1 if there is no matching entity on this process)
+  std::vector<std::vector<std::int32_t>> matched;
 
-    // Check if entity is master, slave or shared but not owned (shared
-    // with lower ranked process)
-    bool shared_but_not_owned = false;
-    for (std::size_t i = 0; i < entity_processes.size(); ++i)
-    {
-      if (entity_processes[i] < process_number)
-      {
-        shared_but_not_owned = true;
-        break;
-      }
-    }
-
-    if (entity_processes.empty())
-    {
-      owned_entities.push_back(local_entity_index);
-    }
-    else if (shared_but_not_owned)
-    {
-      unowned_shared_entities[entity]
-          = EntityData(local_entity_index, entity_processes);
-    }
-    else
-    {
-      owned_shared_entities[entity]
-          = EntityData(local_entity_index, entity_processes);
-    }
-  }
-
-  return {std::move(owned_entities), std::move(shared_entities)};
-}
+  // Entities owned by this process, in the order they are numbered
+  std::vector<std::int32_t> numbering;
+};
 //-----------------------------------------------------------------------------
-// Communicate with other processes to finalise entity ownership
-void compute_final_entity_ownership(
-    const MPI_Comm mpi_comm, std::vector<std::size_t>& owned_entities,
-    std::array<std::map<Entity, EntityData>, 2>& shared_entities)
+// Compute ownership of the entities of dimension d. An entity is
+// identified across processes by its key, the sorted global indices of
+// its vertices. Keys are stored in a flat array. An entity can only be
+// shared with the processes that share all of its vertices (candidate
+// processes). The keys of these entities are sent to the candidate
+// processes, which look them up in their own sorted keys and report
+// back which they have. An entity is owned by the lowest ranked
+// process that has it.
+//
+// Owned entities are numbered in groups, and by key within each group:
+// entities that are not candidates for sharing, candidates that were
+// expected to be owned by a lower ranked process but are not shared,
+// candidates that were expected to be owned and shared but are not
+// shared, and finally the entities that are owned and shared. This is
+// the order of the map-based numbering used previously, so the global
+// entity indices do not depend on the implementation.
+EntityOwnership compute_entity_ownership(const Mesh& mesh, int d,
+                                         const std::vector<bool>& exclude)
 {
-  // Entities ([entity vertices], index) to be numbered
-  std::map<Entity, EntityData>& owned_shared_entities = shared_entities[0];
-  std::map<Entity, EntityData>& unowned_shared_entities = shared_entities[1];
+  LOG(INFO) << "Compute ownership for mesh entities of dimension " << d;
+  common::Timer timer("Compute mesh entity ownership");
 
-  // Get MPI number of processes and process number
+  const MPI_Comm mpi_comm = mesh.mpi_comm();
   const std::int32_t num_processes = dolfin::MPI::size(mpi_comm);
   const std::int32_t process_number = dolfin::MPI::rank(mpi_comm);
 
-  // Communicate common entities, starting with the entities we think
-  // are shared but not owned
-  std::vector<std::vector<std::size_t>> send_common_entity_values(
-      num_processes);
-  for (auto it = unowned_shared_entities.cbegin();
-       it != unowned_shared_entities.cend(); ++it)
-  {
-    // Get entity vertices (global vertex indices)
-    const Entity& entity = it->first;
+  const std::int32_t num_entities = mesh.num_entities(d);
+  const int num_entity_vertices = mesh.type().num_vertices(d);
 
-    // Get entity processes (processes that might share the entity)
-    const std::vector<std::int32_t>& entity_processes = it->second.processes;
+  // Position of each vertex in shared vertices (-1 if not shared)
+  const SharedEntities& shared_vertices = mesh.topology().shared_entities(0);
+  std::vector<std::int32_t> vertex_position(mesh.num_entities(0), -1);
+  for (std::int32_t i = 0; i < shared_vertices.size(); ++i)
+    vertex_position[shared_vertices.entities()[i]] = i;
 
-    // Prepare data for sending
-    for (std::size_t j = 0; j < entity_processes.size(); ++j)
+  // Compute entity keys, and candidate processes of the (non-slave)
+  // entities with only shared vertices (intersection of the sharing
+  // processes of the entity vertices)
+  const std::vector<std::int64_t>& global_vertex_indices
+      = mesh.topology().global_indices(0);
+  const ConnectivityView e_to_v = mesh.topology().connectivity_view(d, 0);
+  std::vector<std::int64_t> keys(num_entities * num_entity_vertices);
+  std::vector<std::int32_t> candidates, candidate_offsets(1, 0),
+      candidate_processes;
+  std::vector<std::int32_t> procs, intersection;
+  std::vector<std::int8_t> group(num_entities, 0);
+  for (std::int32_t e = 0; e < num_entities; ++e)
+  {
+    const std::int32_t* vertices = e_to_v.connections(e);
+    std::int64_t* key = keys.data() + e * num_entity_vertices;
+    for (int i = 0; i < num_entity_vertices; ++i)
+      key[i] = global_vertex_indices[vertices[i]];
+    std::sort(key, key + num_entity_vertices);
+
+    if (exclude[e])
+      continue;
+
+    procs.clear();
+    for (int i = 0; i < num_entity_vertices; ++i)
     {
-      const std::size_t p = entity_processes[j];
-      send_common_entity_values[p].push_back(entity.size());
-      send_common_entity_values[p].insert(send_common_entity_values[p].end(),
-                                          entity.begin(), entity.end());
-    }
-  }
+      const std::int32_t pos = vertex_position[vertices[i]];
+      if (pos == -1)
+      {
+        procs.clear();
+        break;
+      }
 
-  // Communicate common entities, add the entities we think are owned
-  // and shared
-  for (auto it = owned_shared_entities.cbegin();
-       it != owned_shared_entities.cend(); ++it)
-  {
-    // Get entity vertices (global vertex indices)
-    const Entity& entity = it->first;
+      const std::int32_t* p = shared_vertices.processes(pos);
+      const std::int32_t num_p = shared_vertices.num_processes(pos);
+      if (i == 0)
+        procs.assign(p, p + num_p);
+      else
+      {
+        intersection.clear();
+        std::set_intersection(procs.begin(), procs.end(), p, p + num_p,
+                              std::back_inserter(intersection));
+        std::swap(procs, intersection);
+      }
 
-    // Get entity processes (processes that might share the entity)
-    const std::vector<std::int32_t>& entity_processes = it->second.processes;
+      if (procs.empty())
+        break;
+    }
 
-    // Prepare data for sending
-    for (std::size_t j = 0; j < entity_processes.size(); ++j)
+    if (!procs.empty())
     {
-      const std::int32_t p = entity_processes[j];
-      assert(process_number < p);
-      send_common_entity_values[p].push_back(entity.size());
-      send_common_entity_values[p].insert(send_common_entity_values[p].end(),
-                                          entity.begin(), entity.end());
+      candidates.push_back(e);
+      candidate_processes.insert(candidate_processes.end(), procs.begin(),
+                                 procs.end());
+      candidate_offsets.push_back(candidate_processes.size());
+      group[e] = (procs[0] < process_number) ? 1 : 2;
     }
   }
 
-  // Communicate common entities
-  std::vector<std::vector<std::size_t>> received_common_entity_values;
-  dolfin::MPI::all_to_all(mpi_comm, send_common_entity_values,
-                          received_common_entity_values);
+  EntityOwnership ownership;
+  ownership.ownership.resize(num_entities, Ownership::owned);
+  for (std::int32_t e = 0; e < num_entities; ++e)
+    if (exclude[e])
+      ownership.ownership[e] = Ownership::excluded;
 
-  // Check if entities received are really entities
-  std::vector<std::vector<std::size_t>> send_is_entity_values(num_processes);
-  for (std::int32_t p = 0; p < num_processes; ++p)
+  // Send keys of candidate entities to candidate processes
+  std::vector<std::vector<std::int64_t>> send_keys(num_processes);
+  ownership.sent.resize(num_processes);
+  for (std::size_t i = 0; i < candidates.size(); ++i)
   {
-    for (std::size_t i = 0; i < received_common_entity_values[p].size();)
+    const std::int32_t e = candidates[i];
+    const std::int64_t* key = keys.data() + e * num_entity_vertices;
+    for (std::int32_t j = candidate_offsets[i]; j < candidate_offsets[i + 1];
+         ++j)
     {
-      // Get entity
-      const std::size_t entity_size = received_common_entity_values[p][i++];
-      Entity entity;
-      for (std::size_t j = 0; j < entity_size; ++j)
-        entity.push_back(received_common_entity_values[p][i++]);
-
-      // Check if received really is an entity on this process (in which
-      // case it will be in owned or unowned entities)
-      bool is_entity = false;
-      if (unowned_shared_entities.find(entity) != unowned_shared_entities.end()
-          || owned_shared_entities.find(entity) != owned_shared_entities.end())
-      {
-        is_entity = true;
-      }
-
-      // Add information about entity (whether it's actually an entity)
-      // to send to other processes
-      send_is_entity_values[p].push_back(entity_size);
-      for (std::size_t j = 0; j < entity_size; ++j)
-        send_is_entity_values[p].push_back(entity[j]);
-      send_is_entity_values[p].push_back(is_entity);
+      const std::int32_t p = candidate_processes[j];
+      send_keys[p].insert(send_keys[p].end(), key, key + num_entity_vertices);
+      ownership.sent[p].push_back(e);
     }
   }
-
-  // Send data back (list of requested entities that are really
-  // entities)
-  std::vector<std::vector<std::size_t>> received_is_entity_values;
-  dolfin::MPI::all_to_all(mpi_comm, send_is_entity_values,
-                          received_is_entity_values);
-
-  // Create map from entities to processes where it is an entity
-  std::map<Entity, std::vector<std::int32_t>> entity_processes;
+  std::vector<std::vector<std::int64_t>> recv_keys;
+  dolfin::MPI::all_to_all(mpi_comm, send_keys, recv_keys);
+
+  // Sort candidate entities by key
+  auto key_less = [num_entity_vertices](const std::int64_t* key0,
+                                        const std::int64_t* key1) {
+    return std::lexicographical_compare(key0, key0 + num_entity_vertices,
+                                        key1, key1 + num_entity_vertices);
+  };
+  std::vector<std::int32_t> sorted_candidates(candidates);
+  std::sort(sorted_candidates.begin(), sorted_candidates.end(),
+            [&keys, &key_less, num_entity_vertices](std::int32_t e0,
+                                                    std::int32_t e1) {
+              return key_less(keys.data() + e0 * num_entity_vertices,
+                              keys.data() + e1 * num_entity_vertices);
+            });
+
+  // Look up received keys, and report back which are entities on this
+  // process
+  std::vector<std::vector<std::int32_t>> send_is_entity(num_processes);
+  ownership.matched.resize(num_processes);
   for (std::int32_t p = 0; p < num_processes; ++p)
   {
-    for (std::size_t i = 0; i < received_is_entity_values[p].size();)
+    const std::size_t num_keys = recv_keys[p].size() / num_entity_vertices;
+    ownership.matched[p].resize(num_keys, -1);
+    send_is_entity[p].resize(num_keys, 0);
+    for (std::size_t j = 0; j < num_keys; ++j)
     {
-      const std::size_t entity_size = received_is_entity_values[p][i++];
-      Entity entity;
-      for (std::size_t j = 0; j < entity_size; ++j)
-        entity.push_back(received_is_entity_values[p][i++]);
-      const std::size_t is_entity = received_is_entity_values[p][i++];
-      if (is_entity == 1)
+      const std::int64_t* key = recv_keys[p].data() + j * num_entity_vertices;
+      auto it = std::lower_bound(
+          sorted_candidates.begin(), sorted_candidates.end(), key,
+          [&keys, &key_less, num_entity_vertices](std::int32_t e,
+                                                  const std::int64_t* k) {
+            return key_less(keys.data() + e * num_entity_vertices, k);
+          });
+      if (it != sorted_candidates.end()
+          and std::equal(key, key + num_entity_vertices,
+                         keys.data() + *it * num_entity_vertices))
       {
-        // Add entity since it is actually an entity for process p
-        entity_processes[entity].push_back(p);
+        ownership.matched[p][j] = *it;
+        send_is_entity[p][j] = 1;
       }
     }
   }
+  std::vector<std::vector<std::int32_t>> recv_is_entity;
+  dolfin::MPI::all_to_all(mpi_comm, send_is_entity, recv_is_entity);
 
-  // Fix the list of entities we do not own (numbered by lower ranked
-  // process)
-  std::vector<std::vector<std::size_t>> unignore_entities;
-  std::map<Entity, EntityData>::iterator entity;
-  for (entity = unowned_shared_entities.begin();
-       entity != unowned_shared_entities.end(); ++entity)
+  // Entities are shared with the processes on which they really are
+  // entities. Shared entities are owned by the lowest ranked process.
+  for (std::int32_t p = 0; p < num_processes; ++p)
   {
-    const Entity& entity_vertices = entity->first;
-    EntityData& entity_data = entity->second;
-    const std::int32_t local_entity_index = entity_data.local_index;
-    if (entity_processes.find(entity_vertices) != entity_processes.end())
+    assert(recv_is_entity[p].size() == ownership.sent[p].size());
+    for (std::size_t j = 0; j < recv_is_entity[p].size(); ++j)
     {
-      const std::vector<std::int32_t>& common_processes
-          = entity_processes[entity_vertices];
-      assert(!common_processes.empty());
-      const std::int32_t min_proc = *(
-          std::min_element(common_processes.begin(), common_processes.end()));
-
-      if (process_number < min_proc)
+      if (recv_is_entity[p][j] == 1)
       {
-        // Move from unowned to owned
-        owned_shared_entities[entity_vertices]
-            = EntityData(local_entity_index, common_processes);
-
-        // Add entity to list of entities that should be removed from
-        // the unowned entity list.
-        unignore_entities.push_back(entity_vertices);
+        const std::int32_t e = ownership.sent[p][j];
+        ownership.sharing.push_back({e, p});
+        if (p < process_number)
+          ownership.ownership[e] = Ownership::unowned;
+        else if (ownership.ownership[e] == Ownership::owned)
+          ownership.ownership[e] = Ownership::owned_shared;
       }
-      else
-        entity_data.processes = common_processes;
-    }
-    else
-    {
-      // Move from unowned to owned exclusively
-      owned_entities.push_back(local_entity_index);
-
-      // Add entity to list of entities that should be removed from the
-      // shared but not owned entity list
-      unignore_entities.push_back(entity_vertices);
     }
   }
 
-  // Remove unowned shared entities that should not be shared
-  for (std::size_t i = 0; i < unignore_entities.size(); ++i)
-    unowned_shared_entities.erase(unignore_entities[i]);
-
-  // Fix the list of entities we share
-  std::vector<std::vector<std::size_t>> unshare_entities;
-  for (std::map<Entity, EntityData>::iterator it
-       = owned_shared_entities.begin();
-       it != owned_shared_entities.end(); ++it)
+  // Order owned entities for numbering
+  for (std::int32_t e = 0; e < num_entities; ++e)
   {
-    const Entity& e = it->first;
-    const std::int32_t local_entity_index = it->second.local_index;
-    if (entity_processes.find(e) == entity_processes.end())
+    if (ownership.ownership[e] == Ownership::owned)
+      ownership.numbering.push_back(e);
+    else if (ownership.ownership[e] == Ownership::owned_shared)
     {
-      // Move from shared to owned elusively
-      owned_entities.push_back(local_entity_index);
-      unshare_entities.push_back(e);
+      group[e] = 3;
+      ownership.numbering.push_back(e);
     }
-    else
-    {
-      // Update processor list of shared entities
-      it->second.processes = entity_processes[e];
-    }
-  }
-
-  // Remove shared entities that should not be shared
-  for (std::size_t i = 0; i < unshare_entities.size(); ++i)
-    owned_shared_entities.erase(unshare_entities[i]);
-}
-//-----------------------------------------------------------------------------
-// Compute ownership of entities ([entity vertices], data)
-//  [0]: owned exclusively (will be numbered by this process)
-//  [1]: owned and shared (will be numbered by this process, and number
-//       communicated to other processes)
-//  [2]: not owned but shared (will be numbered by another process,
-//       and number communicated to this processes)
-//  Returns (owned_entities,  shared_entities)
-std::pair<std::vector<std::size_t>, std::array<std::map<Entity, EntityData>, 2>>
-compute_entity_ownership(
-    const MPI_Comm mpi_comm,
-    const std::map<std::vector<std::size_t>, std::int32_t>& entities,
-    const std::map<std::int32_t, std::set<std::int32_t>>& shared_vertices_local,
-    const std::vector<std::int64_t>& global_vertex_indices, std::size_t d)
-
-{
-  LOG(INFO) << "Compute ownership for mesh entities of dimension " << d;
-  common::Timer timer("Compute mesh entity ownership");
-
-  // Build global-to-local indices map for shared vertices
-  std::map<std::size_t, std::set<std::int32_t>> shared_vertices;
-  for (auto v = shared_vertices_local.cbegin();
-       v != shared_vertices_local.cend(); ++v)
-  {
-    //    assert(v->first < (int)global_vertex_indices.size());
-    shared_vertices.insert({global_vertex_indices[v->first], v->second});
   }
+  std::sort(ownership.numbering.begin(), ownership.numbering.end(),
+            [&group, &keys, &key_less, num_entity_vertices](std::int32_t e0,
+                                                            std::int32_t e1) {
+              if (group[e0] != group[e1])
+                return group[e0] < group[e1];
+              return key_less(keys.data() + e0 * num_entity_vertices,
+                              keys.data() + e1 * num_entity_vertices);
+            });
 
-  // Entity ownership list ([entity vertices], data):
-  //  [0]: owned and shared (will be numbered by this process, and number
-  //       communicated to other processes)
-  //  [1]: not owned but shared (will be numbered by another process, and number
-  //       communicated to this processes)
-
-  // Compute preliminary ownership lists (shared_entities) without
-  // communication
-  std::vector<std::size_t> owned_entities;
-  std::array<std::map<Entity, EntityData>, 2> shared_entities;
-  std::tie(owned_entities, shared_entities)
-      = compute_preliminary_entity_ownership(mpi_comm, shared_vertices,
-                                             entities);
-
-  // Qualify boundary entities. We need to find out if the shared
-  // (shared with lower ranked process) entities are entities of a
-  // lower ranked process.  If not, this process becomes the lower
-  // ranked process for the entity in question, and is therefore
-  // responsible for communicating values to the higher ranked
-  // processes (if any).
-  compute_final_entity_ownership(mpi_comm, owned_entities, shared_entities);
-
-  return {std::move(owned_entities), std::move(shared_entities)};
+  return ownership;
 }
 //-----------------------------------------------------------------------------
 
@@ -528,9 +391,8 @@ void DistributedMeshTools::number_entities(const Mesh& mesh, int d)
     return;
   }
 
-  // Get shared entities map
-  std::map<std::int32_t, std::set<std::int32_t>>& shared_entities
-      = _mesh.topology().shared_entities(d);
+  // Get shared entities
+  SharedEntities& shared_entities = _mesh.topology().shared_entities(d);
 
   // Number entities
   // std::vector<std::int64_t> global_entity_indices;
@@ -550,8 +412,7 @@ void DistributedMeshTools::number_entities(const Mesh& mesh, int d)
   _mesh.topology().set_global_indices(d, global_entity_indices);
 }
 //-----------------------------------------------------------------------------
-std::tuple<std::vector<std::int64_t>,
-           std::map<std::int32_t, std::set<std::int32_t>>, std::size_t>
+std::tuple<std::vector<std::int64_t>, SharedEntities, std::size_t>
 DistributedMeshTools::number_entities(
     const Mesh& mesh,
     const std::map<std::int32_t, std::pair<std::int32_t, std::int32_t>>&
@@ -571,7 +432,6 @@ DistributedMeshTools::number_entities(
       "Number mesh entities for distributed mesh (for specified vertex ids)");
 
   std::vector<std::int64_t> global_entity_indices;
-  std::map<std::int32_t, std::set<std::int32_t>> shared_entities;
 
   // Check that we're not re-numbering vertices (these are fixed at mesh
   // construction)
@@ -585,10 +445,8 @@ DistributedMeshTools::number_entities(
   // construction)
   if (d == mesh.topology().dim())
   {
-    shared_entities.clear();
     global_entity_indices = mesh.topology().global_indices(d);
-    return std::make_tuple(std::move(global_entity_indices),
-                           std::move(shared_entities),
+    return std::make_tuple(std::move(global_entity_indices), SharedEntities(),
                            mesh.num_entities_global(d));
   }
 
@@ -607,50 +465,12 @@ DistributedMeshTools::number_entities(
   for (auto s = slave_entities.cbegin(); s != slave_entities.cend(); ++s)
     exclude[s->first] = true;
 
-  // Build entity global [vertex list]-to-[local entity index] map.
-  // Exclude any slave entities.
-  std::map<std::vector<std::size_t>, std::int32_t> entities;
-  std::pair<std::vector<std::size_t>, std::int32_t> entity;
-  for (auto& e : mesh::MeshRange<MeshEntity>(mesh, d, mesh::MeshRangeType::ALL))
-  {
-    const std::size_t local_index = e.index();
-    if (!exclude[local_index])
-    {
-      entity.second = local_index;
-      entity.first = std::vector<std::size_t>();
-      for (auto& vertex : EntityRange<Vertex>(e))
-        entity.first.push_back(vertex.global_index());
-      std::sort(entity.first.begin(), entity.first.end());
-      entities.insert(entity);
-    }
-  }
-
-  // Get vertex global indices
-  const std::vector<std::int64_t>& global_vertex_indices
-      = mesh.topology().global_indices(0);
-
-  // Get shared vertices (local index, [sharing processes])
-  const std::map<std::int32_t, std::set<std::int32_t>>& shared_vertices_local
-      = mesh.topology().shared_entities(0);
-
-  // Compute ownership of entities of dimension d ([entity vertices], data):
-  //  [0]: owned and shared (will be numbered by this process, and number
-  //       communicated to other processes)
-  //  [1]: not owned but shared (will be numbered by another process, and number
-  //       communicated to this processes)
-  std::array<std::map<Entity, EntityData>, 2> entity_ownership;
-  std::vector<std::size_t> owned_entities;
-  std::tie(owned_entities, entity_ownership) = compute_entity_ownership(
-      mpi_comm, entities, shared_vertices_local, global_vertex_indices, d);
-
-  // Split shared entities for convenience
-  const std::map<Entity, EntityData>& owned_shared_entities
-      = entity_ownership[0];
-  std::map<Entity, EntityData>& unowned_shared_entities = entity_ownership[1];
+  // Compute ownership of entities of dimension d
+  EntityOwnership entity_ownership = compute_entity_ownership(mesh, d, exclude);
+  const std::vector<Ownership>& ownership = entity_ownership.ownership;
 
   // Number of entities 'owned' by this process
-  const std::size_t num_local_entities
-      = owned_entities.size() + owned_shared_entities.size();
+  const std::size_t num_local_entities = entity_ownership.numbering.size();
 
   // Compute global number of entities and local process offset
   const std::pair<std::size_t, std::size_t> num_global_entities
@@ -664,70 +484,48 @@ DistributedMeshTools::number_entities(
   // equal to -1
   global_entity_indices = std::vector<std::int64_t>(mesh.num_entities(d), -1);
 
-  // Number exclusively owned entities
-  for (std::size_t i = 0; i < owned_entities.size(); ++i)
-    global_entity_indices[owned_entities[i]] = offset++;
-
-  // Number shared entities that this process is responsible for
-  // numbering
-  for (auto it1 = owned_shared_entities.cbegin();
-       it1 != owned_shared_entities.cend(); ++it1)
-  {
-    global_entity_indices[it1->second.local_index] = offset++;
-  }
+  // Number exclusively owned entities, and then shared entities that
+  // this process is responsible for numbering
+  for (std::int32_t e : entity_ownership.numbering)
+    global_entity_indices[e] = offset++;
 
   // Communicate indices for shared entities (owned by this process) and
-  // get indices for shared but not owned entities
-  std::vector<std::vector<std::size_t>> send_values(num_processes);
-  std::vector<std::size_t> destinations;
-  for (auto it1 = owned_shared_entities.cbegin();
-       it1 != owned_shared_entities.cend(); ++it1)
+  // get indices for shared but not owned entities. Indices are sent in
+  // the order of the entity keys sent when computing ownership (-1 for
+  // entities not owned by this process), so that the receiving process
+  // can look up the entities from the keys it matched.
+  std::vector<std::vector<std::int64_t>> send_values(num_processes);
+  for (std::size_t p = 0; p < num_processes; ++p)
   {
-    // Get entity index
-    const std::int32_t local_entity_index = it1->second.local_index;
-    const std::int64_t global_entity_index
-        = global_entity_indices[local_entity_index];
-    assert(global_entity_index != -1);
-
-    // Get entity processes (processes sharing the entity)
-    const std::vector<std::int32_t>& entity_processes = it1->second.processes;
-
-    // Get entity vertices (global vertex indices)
-    const Entity& e = it1->first;
-
-    // Prepare data for sending
-    for (std::size_t j = 0; j < entity_processes.size(); ++j)
+    send_values[p].reserve(entity_ownership.sent[p].size());
+    for (std::int32_t e : entity_ownership.sent[p])
     {
-      // Store interleaved: entity index, number of vertices, global
-      // vertex indices
-      std::size_t p = entity_processes[j];
-      send_values[p].push_back(global_entity_index);
-      send_values[p].push_back(e.size());
-      send_values[p].insert(send_values[p].end(), e.begin(), e.end());
+      send_values[p].push_back(ownership[e] == Ownership::owned_shared
+                                   ? global_entity_indices[e]
+                                   : -1);
     }
   }
 
   // Send data
-  std::vector<std::vector<std::size_t>> received_values;
+  std::vector<std::vector<std::int64_t>> received_values;
   MPI::all_to_all(mpi_comm, send_values, received_values);
 
   // Fill in global entity indices received from lower ranked processes
   for (std::size_t p = 0; p < num_processes; ++p)
   {
-    for (std::size_t i = 0; i < received_values[p].size();)
+    const std::vector<std::int32_t>& matched = entity_ownership.matched[p];
+    assert(received_values[p].size() == matched.size());
+    for (std::size_t j = 0; j < received_values[p].size(); ++j)
     {
-      const std::size_t global_index = received_values[p][i++];
-      const std::size_t entity_size = received_values[p][i++];
-      Entity e;
-      for (std::size_t j = 0; j < entity_size; ++j)
-        e.push_back(received_values[p][i++]);
-
-      // Access unowned entity data
-      std::map<Entity, EntityData>::const_iterator recv_entity
-          = unowned_shared_entities.find(e);
+      // Skip entities not owned by process p, and entities that are
+      // not on this process
+      const std::int64_t global_index = received_values[p][j];
+      const std::int32_t local_entity_index = matched[j];
+      if (global_index == -1 or local_entity_index == -1)
+        continue;
 
       // Sanity check, should not receive an entity we don't need
-      if (recv_entity == unowned_shared_entities.end())
+      if (ownership[local_entity_index] != Ownership::unowned)
       {
         std::stringstream msg;
         msg << "Process " << MPI::rank(mpi_comm)
@@ -737,7 +535,6 @@ DistributedMeshTools::number_entities(
         throw std::runtime_error(msg.str());
       }
 
-      const std::size_t local_entity_index = recv_entity->second.local_index;
       assert(global_entity_indices[local_entity_index] == -1);
       global_entity_indices[local_entity_index] = global_index;
     }
@@ -789,22 +586,9 @@ DistributedMeshTools::number_entities(
     assert(global_entity_indices[i] != -1);
   }
 
-  // Build shared_entities (global index, [sharing processes])
-  shared_entities.clear();
-  for (auto e = owned_shared_entities.cbegin();
-       e != owned_shared_entities.cend(); ++e)
-  {
-    const EntityData& ed = e->second;
-    shared_entities[ed.local_index]
-        = std::set<std::int32_t>(ed.processes.begin(), ed.processes.end());
-  }
-  for (auto e = unowned_shared_entities.cbegin();
-       e != unowned_shared_entities.cend(); ++e)
-  {
-    const EntityData& ed = e->second;
-    shared_entities[ed.local_index]
-        = std::set<std::int32_t>(ed.processes.begin(), ed.processes.end());
-  }
+  // Build shared_entities (local index, [sharing processes])
+  SharedEntities shared_entities
+      = SharedEntities::create(std::move(entity_ownership.sharing));
 
   // Return
   return std::make_tuple(std::move(global_entity_indices),
@@ -867,7 +651,7 @@ DistributedMeshTools::locate_off_process_entities(
     std::set<std::size_t> set_of_my_entities(entity_indices.begin(),
                                              entity_indices.end());
 
-    const std::map<std::int32_t, std::set<std::int32_t>>& sharing_map
+    const SharedEntities& shared_entities
         = mesh.topology().shared_entities(D);
 
     // FIXME: This can be made more efficient by exploiting fact that
@@ -875,7 +659,7 @@ DistributedMeshTools::locate_off_process_entities(
     // Remove local cells from set_of_my_entities to reduce communication
     for (std::size_t j = 0; j < global_entity_indices.size(); ++j)
     {
-      if (sharing_map.find(j) == sharing_map.end())
+      if (!shared_entities.contains(j))
         set_of_my_entities.erase(global_entity_indices[j]);
     }
     // Copy entries from set_of_my_entities to my_entities
@@ -981,8 +765,7 @@ DistributedMeshTools::compute_shared_entities(const Mesh& mesh, std::size_t d)
   number_entities(mesh, d);
 
   // Get shared entities to processes map
-  const std::map<std::int32_t, std::set<std::int32_t>>& shared_entities
-      = mesh.topology().shared_entities(d);
+  const SharedEntities& shared_entities = mesh.topology().shared_entities(d);
 
   // Get local-to-global indices map
   const std::vector<std::int64_t>& global_indices_map
@@ -995,26 +778,25 @@ DistributedMeshTools::compute_shared_entities(const Mesh& mesh, std::size_t d)
   // Pack global indices for sending to sharing processes
   std::vector<std::vector<std::size_t>> send_indices(comm_size);
   std::vector<std::vector<std::size_t>> local_sent_indices(comm_size);
-  for (auto shared_entity = shared_entities.cbegin();
-       shared_entity != shared_entities.cend(); ++shared_entity)
+  for (std::int32_t i = 0; i < shared_entities.size(); ++i)
   {
     // Local index
-    const std::int32_t local_index = shared_entity->first;
+    const std::int32_t local_index = shared_entities.entities()[i];
 
     // Global index
     assert(local_index < (std::int32_t)global_indices_map.size());
     std::size_t global_index = global_indices_map[local_index];
 
     // Destination process
-    const std::set<std::int32_t>& sharing_processes = shared_entity->second;
+    const std::int32_t* sharing_processes = shared_entities.processes(i);
 
     // Pack data for sending and build global-to-local map
-    for (auto dest = sharing_processes.cbegin();
-         dest != sharing_processes.cend(); ++dest)
+    for (std::int32_t j = 0; j < shared_entities.num_processes(i); ++j)
     {
-      send_indices[*dest].push_back(global_index);
-      local_sent_indices[*dest].push_back(local_index);
-      global_to_local[*dest].insert({global_index, local_index});
+      const std::int32_t dest = sharing_processes[j];
+      send_indices[dest].push_back(global_index);
+      local_sent_indices[dest].push_back(local_index);
+      global_to_local[dest].insert({global_index, local_index});
     }
   }
 
@@ -1109,6 +891,13 @@ void DistributedMeshTools::init_facet_cell_connections(Mesh& mesh)
   // Initialise local facet-cell connections.
   mesh.create_connectivity(D - 1, D);
 
+  // The global number of cells attached to each facet is stored in
+  // the facet-cell connectivity, so keep it (and the facets) if they
+  // are held by a ConnectivityLease
+  mesh.topology().pin_connectivity(D - 1, 0);
+  mesh.topology().pin_connectivity(D, D - 1);
+  mesh.topology().pin_connectivity(D - 1, D);
+
   // Global numbering
   number_entities(mesh, D - 1);
 
@@ -1123,8 +912,7 @@ void DistributedMeshTools::init_facet_cell_connections(Mesh& mesh)
   Eigen::Array<std::int32_t, Eigen::Dynamic, 1> num_global_neighbors(
       mesh.num_entities(D - 1));
 
-  std::map<std::int32_t, std::set<std::int32_t>>& shared_facets
-      = mesh.topology().shared_entities(D - 1);
+  const SharedEntities& shared_facets = mesh.topology().shared_entities(D - 1);
 
   // Check if no ghost cells
   if (mesh.topology().ghost_offset(D) == mesh.topology().size(D))
@@ -1134,8 +922,8 @@ void DistributedMeshTools::init_facet_cell_connections(Mesh& mesh)
       num_global_neighbors[f.index()] = f.num_entities(D);
 
     // All shared facets must have two cells, if no ghost cells
-    for (auto f_it = shared_facets.begin(); f_it != shared_facets.end(); ++f_it)
-      num_global_neighbors[f_it->first] = 2;
+    for (std::int32_t f : shared_facets.entities())
+      num_global_neighbors[f] = 2;
   }
   else
   {
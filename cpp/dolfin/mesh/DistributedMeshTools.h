@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "SharedEntities.h"
 #include <array>
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/types.h>
@@ -34,10 +35,10 @@ public:
   static void number_entities(const Mesh& mesh, int d);
 
   /// Create global entity indices for entities of dimension d for given
-  /// global vertex indices. Returns  global_entity_indices,
-  /// shared_entities, and XXXX?
-  static std::tuple<std::vector<std::int64_t>,
-                    std::map<std::int32_t, std::set<std::int32_t>>, std::size_t>
+  /// global vertex indices. Returns global_entity_indices,
+  /// shared_entities and the global number of entities. Each process
+  /// numbers the entities it owns contiguously, in local entity order.
+  static std::tuple<std::vector<std::int64_t>, SharedEntities, std::size_t>
   number_entities(
       const Mesh& mesh,
       const std::map<std::int32_t, std::pair<std::int32_t, std::int32_t>>&
@@ -6,6 +6,7 @@
 
 #include "Geometry.h"
 #include <boost/functional/hash.hpp>
+#include <dolfin/common/memory.h>
 #include <sstream>
 
 using namespace dolfin;
@@ -17,7 +18,7 @@ Geometry::Geometry(std::int64_t num_points_global,
                                       Eigen::RowMajor>& coordinates,
                    const std::vector<std::int64_t>& global_indices)
     : _dim(coordinates.cols()), _global_indices(global_indices),
-      _num_points_global(num_points_global)
+      _num_points_global(num_points_global), _version(0)
 {
   // Make all geometry 3D
   if (_dim == 3)
@@ -45,6 +46,7 @@ Eigen::Ref<const Eigen::Vector3d> Geometry::x(std::size_t n) const
 //-----------------------------------------------------------------------------
 Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& Geometry::points()
 {
+  ++_version;
   return _coordinates;
 }
 //-----------------------------------------------------------------------------
@@ -61,13 +63,20 @@ const std::vector<std::int64_t>& Geometry::global_indices() const
 //-----------------------------------------------------------------------------
 std::size_t Geometry::hash() const
 {
-  // Compute local hash
-  boost::hash<std::vector<double>> dhash;
-
-  std::vector<double> _x(_coordinates.data(),
-                         _coordinates.data() + _coordinates.size());
-  const std::size_t local_hash = dhash(_x);
-  return local_hash;
+  // Compute local hash (equal to the hash of a std::vector holding
+  // the coordinates, without copying them)
+  return boost::hash_range(_coordinates.data(),
+                           _coordinates.data() + _coordinates.size());
+}
+//-----------------------------------------------------------------------------
+std::size_t Geometry::version() const { return _version; }
+//-----------------------------------------------------------------------------
+void Geometry::mark_modified() { ++_version; }
+//-----------------------------------------------------------------------------
+std::map<std::string, std::size_t> Geometry::memory_usage() const
+{
+  return {{"points", sizeof(double) * _coordinates.size()},
+          {"global indices", common::heap_memory(_global_indices)}};
 }
 //-----------------------------------------------------------------------------
 std::string Geometry::str(bool verbose) const
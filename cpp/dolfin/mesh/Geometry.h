@@ -7,6 +7,7 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -63,7 +64,10 @@ public:
   x(std::size_t n) const;
 
   // Should this return an Eigen::Ref?
-  /// Return array of coordinates for all points
+  /// Return array of coordinates for all points. The coordinates may
+  /// be modified through the returned reference, so each call
+  /// increments version(). After modifying the coordinates through a
+  /// reference (or view) that was kept, call mark_modified().
   Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>&
   points();
 
@@ -82,6 +86,21 @@ public:
   ///
   std::size_t hash() const;
 
+  /// Return counter that is incremented when the coordinates may have
+  /// changed (on each non-const call to points() and on
+  /// mark_modified()). Data computed from the coordinates can be
+  /// cached together with the version.
+  std::size_t version() const;
+
+  /// Mark the coordinates as modified, so that data cached from them
+  /// (e.g. Mesh::hmin) is recomputed. Call after writing through a
+  /// reference to points() that was kept.
+  void mark_modified();
+
+  /// Return memory (bytes) used by the point coordinates and global
+  /// indices
+  std::map<std::string, std::size_t> memory_usage() const;
+
   /// Return informal string representation (pretty-print)
   std::string str(bool verbose) const;
 
@@ -101,6 +120,10 @@ private:
 
   // Global number of points (taking account of shared points)
   std::uint64_t _num_points_global;
+
+  // Incremented on non-const access to the coordinates and on
+  // mark_modified()
+  std::size_t _version;
 };
 } // namespace mesh
 } // namespace dolfin
@@ -16,9 +16,12 @@
 #include "Topology.h"
 #include "TopologyComputation.h"
 #include "Vertex.h"
+#include "utils.h"
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/utils.h>
+#include <limits>
+#include <numeric>
 
 using namespace dolfin;
 using namespace dolfin::mesh;
@@ -197,7 +200,7 @@ Mesh::Mesh(MPI_Comm comm, mesh::CellType::Type type,
   _topology = std::make_unique<Topology>(tdim, num_vertices_local,
                                          num_vertices_global);
   _topology->set_global_indices(0, vertex_indices_global);
-  _topology->shared_entities(0) = shared_vertices;
+  _topology->shared_entities(0) = SharedEntities(shared_vertices);
 
   // Initialise cell topology
   _topology->set_num_entities_global(tdim, num_cells_global);
@@ -237,13 +240,84 @@ Mesh::Mesh(MPI_Comm comm, mesh::CellType::Type type,
     _topology->set_global_indices(tdim, global_cell_indices);
 }
 //-----------------------------------------------------------------------------
+Mesh::Mesh(MPI_Comm comm, mesh::CellType::Type type,
+           const Eigen::Ref<const EigenRowArrayXXd> points,
+           const std::vector<std::int64_t>& global_point_indices,
+           std::int64_t num_points_global, const SharedEntities& shared_points,
+           const Eigen::Ref<const EigenRowArrayXXi32> cells,
+           const std::vector<std::int64_t>& global_cell_indices,
+           const GhostMode ghost_mode, std::int32_t num_ghost_cells)
+    : _cell_type(mesh::CellType::create(type)), _degree(1), _mpi_comm(comm),
+      _ghost_mode(ghost_mode), _unique_id(common::UniqueIdGenerator::id())
+{
+  const std::size_t tdim = _cell_type->dim();
+  const std::int32_t num_vertices_per_cell = _cell_type->num_vertices();
+  if (cells.cols() != num_vertices_per_cell)
+  {
+    throw std::runtime_error(
+        "Mismatch between cell type and number of vertices per cell");
+  }
+  if (global_point_indices.size() != (std::size_t)points.rows())
+  {
+    throw std::runtime_error(
+        "Cannot create mesh. Wrong number of global point indices");
+  }
+  if (global_cell_indices.size() != (std::size_t)cells.rows())
+  {
+    throw std::runtime_error(
+        "Cannot create mesh. Wrong number of global cell indices");
+  }
+
+  // Number of local cells (not including ghosts)
+  const std::int32_t num_cells = cells.rows();
+  assert(num_ghost_cells <= num_cells);
+  const std::int32_t num_cells_local = num_cells - num_ghost_cells;
+
+  // Number of cells (global)
+  const std::int64_t num_cells_global = MPI::sum(comm, num_cells_local);
+
+  // Points are the cell vertices, in the order of the cell
+  std::vector<std::uint8_t> cell_permutation(num_vertices_per_cell);
+  std::iota(cell_permutation.begin(), cell_permutation.end(), 0);
+  _coordinate_dofs = std::make_unique<CoordinateDofs>(cells, cell_permutation);
+  _geometry = std::make_unique<Geometry>(num_points_global, points,
+                                         global_point_indices);
+
+  // Initialise vertex topology
+  _topology = std::make_unique<Topology>(tdim, points.rows(),
+                                         num_points_global);
+  _topology->set_global_indices(0, global_point_indices);
+  _topology->shared_entities(0) = shared_points;
+
+  // Initialise cell topology
+  _topology->set_num_entities_global(tdim, num_cells_global);
+  _topology->init_ghost(tdim, num_cells_local);
+
+  // Number of local non-ghost vertices
+  if (num_ghost_cells > 0)
+  {
+    const std::int32_t num_non_ghost_vertices
+        = (num_cells_local > 0)
+              ? cells.topRows(num_cells_local).maxCoeff() + 1
+              : 0;
+    _topology->init_ghost(0, num_non_ghost_vertices);
+  }
+  else
+    _topology->init_ghost(0, points.rows());
+
+  _topology->set_connectivity(std::make_shared<Connectivity>(cells), tdim, 0);
+  _topology->set_global_indices(tdim, global_cell_indices);
+}
+//-----------------------------------------------------------------------------
 Mesh::Mesh(const Mesh& mesh)
     : _cell_type(CellType::create(mesh._cell_type->cell_type())),
       _topology(new Topology(*mesh._topology)),
       _geometry(new Geometry(*mesh._geometry)),
       _coordinate_dofs(new CoordinateDofs(*mesh._coordinate_dofs)),
       _degree(mesh._degree), _mpi_comm(mesh.mpi_comm()),
-      _ghost_mode(mesh._ghost_mode), _unique_id(common::UniqueIdGenerator::id())
+      _ghost_mode(mesh._ghost_mode),
+      _unique_id(common::UniqueIdGenerator::id()),
+      _cell_metrics(mesh._cell_metrics)
 
 {
   // Do nothing
@@ -256,7 +330,8 @@ Mesh::Mesh(Mesh&& mesh)
       _coordinate_dofs(std::move(mesh._coordinate_dofs)), _degree(mesh._degree),
       _mpi_comm(std::move(mesh._mpi_comm)),
       _ghost_mode(std::move(mesh._ghost_mode)),
-      _unique_id(std::move(mesh._unique_id))
+      _unique_id(std::move(mesh._unique_id)),
+      _cell_metrics(std::move(mesh._cell_metrics))
 {
   // Do nothing
 }
@@ -282,6 +357,7 @@ Mesh& Mesh::operator=(const Mesh& mesh)
 
   _ghost_mode = mesh._ghost_mode;
   _unique_id = common::UniqueIdGenerator::id();
+  _cell_metrics = mesh._cell_metrics;
 
   return *this;
 }
@@ -405,34 +481,52 @@ void Mesh::clean()
 //-----------------------------------------------------------------------------
 double Mesh::hmin() const
 {
-  double h = std::numeric_limits<double>::max();
-  for (auto& cell : MeshRange<Cell>(*this))
-    h = std::min(h, cell.h());
-  return h;
+  const Eigen::ArrayXd& h = cell_metric(CellMetric::h);
+  const std::int32_t num_cells = _topology->ghost_offset(_topology->dim());
+  return std::accumulate(h.data(), h.data() + num_cells,
+                         std::numeric_limits<double>::max(),
+                         [](double a, double b) { return std::min(a, b); });
 }
 //-----------------------------------------------------------------------------
 double Mesh::hmax() const
 {
-  double h = 0.0;
-  for (auto& cell : MeshRange<Cell>(*this))
-    h = std::max(h, cell.h());
-  return h;
+  const Eigen::ArrayXd& h = cell_metric(CellMetric::h);
+  const std::int32_t num_cells = _topology->ghost_offset(_topology->dim());
+  return std::accumulate(h.data(), h.data() + num_cells, 0.0,
+                         [](double a, double b) { return std::max(a, b); });
 }
 //-----------------------------------------------------------------------------
 double Mesh::rmin() const
 {
-  double r = std::numeric_limits<double>::max();
-  for (auto& cell : MeshRange<Cell>(*this))
-    r = std::min(r, cell.inradius());
-  return r;
+  const Eigen::ArrayXd& r = cell_metric(CellMetric::inradius);
+  const std::int32_t num_cells = _topology->ghost_offset(_topology->dim());
+  return std::accumulate(r.data(), r.data() + num_cells,
+                         std::numeric_limits<double>::max(),
+                         [](double a, double b) { return std::min(a, b); });
 }
 //-----------------------------------------------------------------------------
 double Mesh::rmax() const
 {
-  double r = 0.0;
-  for (auto& cell : MeshRange<Cell>(*this))
-    r = std::max(r, cell.inradius());
-  return r;
+  const Eigen::ArrayXd& r = cell_metric(CellMetric::inradius);
+  const std::int32_t num_cells = _topology->ghost_offset(_topology->dim());
+  return std::accumulate(r.data(), r.data() + num_cells, 0.0,
+                         [](double a, double b) { return std::max(a, b); });
+}
+//-----------------------------------------------------------------------------
+const Eigen::ArrayXd& Mesh::cell_metric(CellMetric metric) const
+{
+  // Recompute if the geometry may have changed since the metric was
+  // cached
+  assert(_geometry);
+  const std::size_t version = _geometry->version();
+  auto it = _cell_metrics.find(metric);
+  if (it == _cell_metrics.end() or it->second.first != version)
+  {
+    _cell_metrics[metric] = {version, mesh::cell_metric(*this, metric)};
+    it = _cell_metrics.find(metric);
+  }
+
+  return it->second.second;
 }
 //-----------------------------------------------------------------------------
 std::size_t Mesh::hash() const
@@ -452,6 +546,21 @@ std::size_t Mesh::hash() const
   return (kt + kg) * (kt + kg + 1) / 2 + kg;
 }
 //-----------------------------------------------------------------------------
+std::map<std::string, std::size_t> Mesh::memory_usage() const
+{
+  std::map<std::string, std::size_t> usage;
+  assert(_topology);
+  for (auto& u : _topology->memory_usage())
+    usage["topology " + u.first] = u.second;
+  assert(_geometry);
+  for (auto& u : _geometry->memory_usage())
+    usage["geometry " + u.first] = u.second;
+  assert(_coordinate_dofs);
+  usage["coordinate dofs"] = _coordinate_dofs->entity_points().memory_usage();
+
+  return usage;
+}
+//-----------------------------------------------------------------------------
 std::string Mesh::str(bool verbose) const
 {
   assert(_geometry);
@@ -10,6 +10,7 @@
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/UniqueIdGenerator.h>
 #include <dolfin/common/types.h>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -25,9 +26,11 @@ class Function;
 namespace mesh
 {
 class CoordinateDofs;
+enum class CellMetric : int;
 class Geometry;
 enum class GhostMode : int;
 class MeshEntity;
+class SharedEntities;
 class Topology;
 
 /// A _Mesh_ consists of a set of connected and numbered mesh entities.
@@ -97,6 +100,41 @@ public:
        const std::vector<std::int64_t>& global_cell_indices,
        const GhostMode ghost_mode, std::int32_t num_ghost_cells = 0);
 
+  /// Construct a Mesh of degree 1 from data that is already local to
+  /// each process, without redistributing the points or computing
+  /// their sharing.
+  ///
+  /// The points are numbered locally, and the vertices of the
+  /// non-ghost cells must come first. Ghost cells, if present, must be
+  /// at the end of the list of cells.
+  ///
+  /// @param comm (MPI_Comm)
+  ///         MPI Communicator
+  /// @param type (CellType::Type)
+  ///         Cell type
+  /// @param points
+  ///         Array of geometric points on this process, in local order
+  /// @param global_point_indices
+  ///         Global index of each point
+  /// @param num_points_global
+  ///         Global number of points
+  /// @param shared_points
+  ///         Processes that share each shared point (local index)
+  /// @param cells
+  ///         Array of cells (containing the local point indices for
+  ///         each cell)
+  /// @param global_cell_indices
+  ///         Global index of each cell
+  /// @param num_ghost_cells
+  ///         Number of ghost cells on this process
+  Mesh(MPI_Comm comm, mesh::CellType::Type type,
+       const Eigen::Ref<const EigenRowArrayXXd> points,
+       const std::vector<std::int64_t>& global_point_indices,
+       std::int64_t num_points_global, const SharedEntities& shared_points,
+       const Eigen::Ref<const EigenRowArrayXXi32> cells,
+       const std::vector<std::int64_t>& global_cell_indices,
+       const GhostMode ghost_mode, std::int32_t num_ghost_cells = 0);
+
   /// Copy constructor.
   ///
   /// @param mesh (Mesh)
@@ -237,6 +275,21 @@ public:
   ///
   double rmax() const;
 
+  /// Return a geometric metric for all cells (including ghosts). The
+  /// values are computed on first use and cached until the mesh
+  /// geometry may have changed (see Geometry::version). Writes through
+  /// a kept reference to the coordinates must be followed by
+  /// Geometry::mark_modified. The returned reference is valid until
+  /// the metric is recomputed.
+  ///
+  /// @param metric (CellMetric)
+  ///         The metric
+  ///
+  /// @return Eigen::ArrayXd
+  ///         The metric for each cell
+  ///
+  const Eigen::ArrayXd& cell_metric(CellMetric metric) const;
+
   /// Compute hash of mesh, currently based on the has of the mesh
   /// geometry and mesh topology.
   ///
@@ -245,6 +298,14 @@ public:
   ///
   std::size_t hash() const;
 
+  /// Return memory (bytes) used by the mesh data, i.e. the topology
+  /// (connectivities, global indices, shared entities), geometry and
+  /// coordinate dofs.
+  ///
+  /// @return std::map<std::string, std::size_t>
+  ///         Memory usage for each component of the mesh
+  std::map<std::string, std::size_t> memory_usage() const;
+
   /// Get unique identifier.
   ///
   /// @returns _std::size_t_
@@ -307,6 +368,11 @@ private:
 
   // Unique identifier
   std::size_t _unique_id;
+
+  // Cached cell metrics, with the version of the geometry they were
+  // computed from
+  mutable std::map<CellMetric, std::pair<std::size_t, Eigen::ArrayXd>>
+      _cell_metrics;
 };
 } // namespace mesh
 } // namespace dolfin
@@ -207,13 +207,17 @@ public:
   ///   List of sharing processes
   std::set<std::int32_t> sharing_processes() const
   {
-    const std::map<std::int32_t, std::set<std::int32_t>>& sharing_map
+    const SharedEntities& shared_entities
         = _mesh->topology().shared_entities(_dim);
-    const auto map_it = sharing_map.find(_local_index);
-    if (map_it == sharing_map.end())
+    const std::int32_t i = shared_entities.find(_local_index);
+    if (i == -1)
       return std::set<std::int32_t>();
     else
-      return map_it->second;
+    {
+      return std::set<std::int32_t>(shared_entities.processes(i),
+                                    shared_entities.processes(i)
+                                        + shared_entities.num_processes(i));
+    }
   }
 
   /// Determine if an entity is shared or not
@@ -223,9 +227,7 @@ public:
   {
     if (_mesh->topology().have_shared_entities(_dim))
     {
-      const std::map<std::int32_t, std::set<std::int32_t>>& sharing_map
-          = _mesh->topology().shared_entities(_dim);
-      return (sharing_map.find(_local_index) != sharing_map.end());
+      return _mesh->topology().shared_entities(_dim).contains(_local_index);
     }
     return false;
   }
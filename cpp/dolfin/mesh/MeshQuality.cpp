@@ -9,7 +9,10 @@
 #include "Mesh.h"
 #include "MeshFunction.h"
 #include "MeshIterator.h"
+#include "Topology.h"
 #include "Vertex.h"
+#include "utils.h"
+#include <algorithm>
 #include <dolfin/common/MPI.h>
 #include <math.h>
 #include <sstream>
@@ -24,21 +27,26 @@ MeshQuality::radius_ratios(std::shared_ptr<const Mesh> mesh)
   // Create MeshFunction
   MeshFunction<double> cf(mesh, mesh->topology().dim(), 0.0);
 
-  // Compute radius ration
-  for (auto& cell : MeshRange<Cell>(*mesh))
-    cf[cell] = cell.radius_ratio();
+  // Compute radius ratio
+  const Eigen::ArrayXd& ratios = mesh->cell_metric(CellMetric::radius_ratio);
+  const std::int32_t num_cells
+      = mesh->topology().ghost_offset(mesh->topology().dim());
+  std::copy(ratios.data(), ratios.data() + num_cells, cf.values());
 
   return cf;
 }
 //-----------------------------------------------------------------------------
 std::array<double, 2> MeshQuality::radius_ratio_min_max(const Mesh& mesh)
 {
+  const Eigen::ArrayXd& ratios = mesh.cell_metric(CellMetric::radius_ratio);
+  const std::int32_t num_cells
+      = mesh.topology().ghost_offset(mesh.topology().dim());
   double qmin = std::numeric_limits<double>::max();
   double qmax = 0.0;
-  for (auto& cell : MeshRange<Cell>(mesh))
+  for (std::int32_t c = 0; c < num_cells; ++c)
   {
-    qmin = std::min(qmin, cell.radius_ratio());
-    qmax = std::max(qmax, cell.radius_ratio());
+    qmin = std::min(qmin, ratios[c]);
+    qmax = std::max(qmax, ratios[c]);
   }
 
   qmin = MPI::min(mesh.mpi_comm(), qmin);
@@ -55,13 +63,14 @@ MeshQuality::radius_ratio_histogram_data(const Mesh& mesh, std::size_t num_bins)
   for (std::size_t i = 0; i < num_bins; ++i)
     bins[i] = static_cast<double>(i) * interval + interval / 2.0;
 
-  for (auto& cell : MeshRange<Cell>(mesh))
+  const Eigen::ArrayXd& ratios = mesh.cell_metric(CellMetric::radius_ratio);
+  const std::int32_t num_cells
+      = mesh.topology().ghost_offset(mesh.topology().dim());
+  for (std::int32_t c = 0; c < num_cells; ++c)
   {
-    const double ratio = cell.radius_ratio();
-
     // Compute 'bin' index, and handle special case that ratio = 1.0
-    const std::size_t slot
-        = std::min(static_cast<std::size_t>(ratio / interval), num_bins - 1);
+    const std::size_t slot = std::min(
+        static_cast<std::size_t>(ratios[c] / interval), num_bins - 1);
 
     values[slot] += 1;
   }
@@ -0,0 +1,193 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "MigrationPlan.h"
+#include "CellType.h"
+#include "DistributedMeshTools.h"
+#include "Geometry.h"
+#include "Partitioning.h"
+#include <dolfin/common/Timer.h>
+#include <dolfin/common/log.h>
+
+using namespace dolfin;
+using namespace dolfin::mesh;
+
+//-----------------------------------------------------------------------------
+MigrationPlan::MigrationPlan(const Mesh& mesh0, const Mesh& mesh1)
+    : _mpi_comm(mesh0.mpi_comm())
+{
+  common::Timer timer("Compute mesh migration plan");
+
+  const MPI_Comm mpi_comm = mesh0.mpi_comm();
+  const std::size_t num_processes = MPI::size(mpi_comm);
+
+  const int tdim = mesh0.topology().dim();
+  if (mesh1.topology().dim() != tdim)
+    throw std::runtime_error("Meshes have different topological dimensions");
+  if (!mesh0.topology().have_global_indices(tdim)
+      or !mesh1.topology().have_global_indices(tdim))
+  {
+    throw std::runtime_error("Global cell indices are required to compute "
+                             "migration plan");
+  }
+
+  _num_cells_old = mesh0.num_entities(tdim);
+  _num_cells_new = mesh1.num_entities(tdim);
+  const std::vector<std::int64_t>& global_cells0
+      = mesh0.topology().global_indices(tdim);
+  const std::vector<std::int64_t>& global_cells1
+      = mesh1.topology().global_indices(tdim);
+  const std::int32_t num_owned0 = mesh0.topology().ghost_offset(tdim);
+
+  // Size of global cell index range
+  std::int64_t max_index = -1;
+  for (std::int32_t c = 0; c < num_owned0; ++c)
+    max_index = std::max(max_index, global_cells0[c]);
+  const std::int64_t num_global = MPI::max(mpi_comm, max_index) + 1;
+
+  // Post the location (process and local index) of each owned cell of
+  // the old mesh to the process that holds its global index, for an
+  // even distribution of the global index range
+  std::vector<std::vector<std::int64_t>> send_location(num_processes);
+  for (std::int32_t c = 0; c < num_owned0; ++c)
+  {
+    const std::int64_t index = global_cells0[c];
+    const std::uint32_t p = MPI::index_owner(mpi_comm, index, num_global);
+    send_location[p].push_back(index);
+    send_location[p].push_back(c);
+  }
+  std::vector<std::vector<std::int64_t>> recv_location;
+  MPI::all_to_all(mpi_comm, send_location, recv_location);
+
+  const std::array<std::int64_t, 2> range
+      = MPI::local_range(mpi_comm, num_global);
+  std::vector<std::int64_t> location(2 * (range[1] - range[0]), -1);
+  for (std::size_t p = 0; p < num_processes; ++p)
+  {
+    for (std::size_t i = 0; i < recv_location[p].size(); i += 2)
+    {
+      const std::int64_t pos = 2 * (recv_location[p][i] - range[0]);
+      location[pos] = p;
+      location[pos + 1] = recv_location[p][i + 1];
+    }
+  }
+
+  // Find old location of each cell of the new mesh
+  std::vector<std::vector<std::int64_t>> send_query(num_processes);
+  for (std::int32_t c = 0; c < _num_cells_new; ++c)
+  {
+    const std::int64_t index = global_cells1[c];
+    send_query[MPI::index_owner(mpi_comm, index, num_global)].push_back(
+        index);
+  }
+  std::vector<std::vector<std::int64_t>> recv_query;
+  MPI::all_to_all(mpi_comm, send_query, recv_query);
+
+  std::vector<std::vector<std::int64_t>> send_reply(num_processes);
+  for (std::size_t p = 0; p < num_processes; ++p)
+  {
+    for (std::int64_t index : recv_query[p])
+    {
+      const std::int64_t pos = 2 * (index - range[0]);
+      if (index >= range[1] or location[pos] < 0)
+      {
+        throw std::runtime_error("Cell with global index "
+                                 + std::to_string(index)
+                                 + " is not in the old mesh");
+      }
+      send_reply[p].push_back(location[pos]);
+      send_reply[p].push_back(location[pos + 1]);
+    }
+  }
+  std::vector<std::vector<std::int64_t>> recv_reply;
+  MPI::all_to_all(mpi_comm, send_reply, recv_reply);
+
+  // Request the data of each cell of the new mesh from the process
+  // that owned the cell in the old mesh
+  _recv_cells.resize(num_processes);
+  std::vector<std::vector<std::int32_t>> send_request(num_processes);
+  std::vector<std::size_t> pos(num_processes, 0);
+  for (std::int32_t c = 0; c < _num_cells_new; ++c)
+  {
+    const std::uint32_t p
+        = MPI::index_owner(mpi_comm, global_cells1[c], num_global);
+    const std::int64_t owner = recv_reply[p][pos[p]];
+    const std::int64_t local_index = recv_reply[p][pos[p] + 1];
+    pos[p] += 2;
+    send_request[owner].push_back(local_index);
+    _recv_cells[owner].push_back(c);
+  }
+  MPI::all_to_all(mpi_comm, send_request, _send_cells);
+}
+//-----------------------------------------------------------------------------
+std::int32_t MigrationPlan::num_received_cells() const
+{
+  const std::size_t rank = MPI::rank(_mpi_comm.comm());
+  std::int32_t num_cells = 0;
+  for (std::size_t p = 0; p < _recv_cells.size(); ++p)
+    if (p != rank)
+      num_cells += _recv_cells[p].size();
+  return num_cells;
+}
+//-----------------------------------------------------------------------------
+std::pair<Mesh, MigrationPlan>
+mesh::rebalance(const Mesh& mesh, const std::vector<std::size_t>& cell_weights,
+                std::string partitioner)
+{
+  common::Timer timer("Rebalance mesh");
+
+  if (mesh.degree() != 1)
+    throw std::runtime_error("Rebalancing requires a mesh of degree 1");
+
+  const MPI_Comm mpi_comm = mesh.mpi_comm();
+  const int tdim = mesh.topology().dim();
+  const std::int32_t num_owned = mesh.topology().ghost_offset(tdim);
+
+  // Owned cells, with global point indices. For a mesh of degree 1,
+  // the geometric points are the vertices.
+  const std::vector<std::int64_t>& global_points
+      = mesh.geometry().global_indices();
+  const ConnectivityView c_to_v = mesh.topology().connectivity_view(tdim, 0);
+  const int num_cell_vertices = mesh.type().num_vertices();
+  EigenRowArrayXXi64 cells(num_owned, num_cell_vertices);
+  for (std::int32_t c = 0; c < num_owned; ++c)
+  {
+    const std::int32_t* vertices = c_to_v.connections(c);
+    for (int i = 0; i < num_cell_vertices; ++i)
+      cells(c, i) = global_points[vertices[i]];
+  }
+
+  const std::vector<std::int64_t>& global_cells
+      = mesh.topology().global_indices(tdim);
+  const std::vector<std::int64_t> global_cell_indices(
+      global_cells.begin(), global_cells.begin() + num_owned);
+
+  // Points, numbered from process 0 upwards
+  const int gdim = mesh.geometry().dim();
+  const EigenRowArrayXXd points = DistributedMeshTools::reorder_by_global_indices(
+      mpi_comm, mesh.geometry().points().leftCols(gdim), global_points);
+
+  // Keep the number of ghost cell layers
+  const std::vector<std::int32_t>& layer_offsets
+      = mesh.topology().ghost_layer_offsets();
+  const int num_ghost_layers
+      = layer_offsets.empty() ? 1 : layer_offsets.size() - 1;
+
+  // Repartition the cells from their current distribution, and build
+  // new mesh
+  Mesh new_mesh = Partitioning::build_distributed_mesh(
+      mpi_comm, mesh.type().cell_type(), points, cells, global_cell_indices,
+      mesh.get_ghost_mode(), partitioner, CellReordering::none, cell_weights,
+      num_ghost_layers);
+
+  MigrationPlan plan(mesh, new_mesh);
+  LOG(INFO) << "Rebalanced mesh: "
+            << MPI::sum(mpi_comm, (std::int64_t)plan.num_received_cells())
+            << " cells (including ghosts) moved between processes";
+
+  return std::make_pair(std::move(new_mesh), std::move(plan));
+}
+//-----------------------------------------------------------------------------
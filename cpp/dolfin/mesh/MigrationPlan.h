@@ -0,0 +1,245 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "Connectivity.h"
+#include "Mesh.h"
+#include "MeshFunction.h"
+#include "Topology.h"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <dolfin/common/MPI.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dolfin
+{
+namespace mesh
+{
+
+/// This class describes how the cells of a distributed mesh move to
+/// the processes of another distributed mesh with the same cells
+/// (identified by their global index), e.g. when a mesh is rebalanced
+/// with mesh::rebalance. The plan can be applied to data that is
+/// associated with cells, such as MeshFunctions and the cell dofs of a
+/// Function (see function::Function::migrate), to move the data to the
+/// new mesh without interpolation.
+///
+/// Each cell of the new mesh (including ghost cells) receives its data
+/// from the process that owned the cell in the old mesh.
+
+class MigrationPlan
+{
+public:
+  /// Create plan for moving cell data from mesh0 to mesh1. The meshes
+  /// must have the same cells, with the same global cell indices, and
+  /// the same vertices in each cell. Collective.
+  MigrationPlan(const Mesh& mesh0, const Mesh& mesh1);
+
+  /// Copy constructor
+  MigrationPlan(const MigrationPlan& plan) = default;
+
+  /// Move constructor
+  MigrationPlan(MigrationPlan&& plan) = default;
+
+  /// Destructor
+  ~MigrationPlan() = default;
+
+  /// Return MPI communicator
+  MPI_Comm mpi_comm() const { return _mpi_comm.comm(); }
+
+  /// Number of cells (including ghosts) of the old mesh on this process
+  std::int32_t num_cells_old() const { return _num_cells_old; }
+
+  /// Number of cells (including ghosts) of the new mesh on this process
+  std::int32_t num_cells_new() const { return _num_cells_new; }
+
+  /// Local indices of the cells of the old mesh whose data is sent to
+  /// each process (including this process)
+  const std::vector<std::vector<std::int32_t>>& send_cells() const
+  {
+    return _send_cells;
+  }
+
+  /// Local indices of the cells of the new mesh whose data is received
+  /// from each process (including this process), in the order in which
+  /// the data is sent
+  const std::vector<std::vector<std::int32_t>>& recv_cells() const
+  {
+    return _recv_cells;
+  }
+
+  /// Number of cells of the new mesh on this process (including ghosts)
+  /// whose data is received from another process
+  std::int32_t num_received_cells() const;
+
+  /// Move cell data to the new mesh. Row c of values holds the data of
+  /// cell c of the old mesh. Rows of ghost cells are not used. Returns
+  /// the data of the cells of the new mesh (including ghosts).
+  /// Collective.
+  template <typename T>
+  Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+  migrate(const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,
+                             Eigen::RowMajor>& values) const;
+
+  /// Move a MeshFunction to the new mesh. Entities of dimension lower
+  /// than the cells take their values from the cells that contain
+  /// them. Collective.
+  template <typename T>
+  MeshFunction<T> migrate(const MeshFunction<T>& f,
+                          std::shared_ptr<const Mesh> mesh) const;
+
+private:
+  // MPI communicator
+  dolfin::MPI::Comm _mpi_comm;
+
+  // Number of cells of old and new mesh
+  std::int32_t _num_cells_old, _num_cells_new;
+
+  // Cells of old mesh to send to each process, and cells of new mesh
+  // received from each process
+  std::vector<std::vector<std::int32_t>> _send_cells, _recv_cells;
+};
+
+/// Rebalance a distributed mesh, e.g. after adaptive refinement, such
+/// that the sum of the cell weights is balanced over the processes.
+/// The cells are repartitioned starting from their current
+/// distribution, and cells, vertices and geometry are moved to their
+/// new processes. The global cell indices and the global indices of
+/// the geometry points (Geometry::global_indices) are preserved, as
+/// are the ghost mode and the number of ghost cell layers. The global
+/// numbering of the topology vertices, and of other mesh entities, is
+/// recomputed for the new distribution.
+///
+/// @param mesh (Mesh)
+///   The mesh (of degree 1)
+/// @param cell_weights (std::vector<std::size_t>)
+///   Weight of each owned cell, e.g. from fem::CellCostRecorder. If
+///   empty, all cells have the same weight.
+/// @param partitioner (std::string)
+///   Partitioner. "ParMETIS-adaptive" moves as few cells as possible
+///   to balance the weights. "Hilbert" partitions along a Hilbert
+///   curve through the cell centroids, so that cells move only
+///   between processes that are adjacent on the curve.
+/// @return std::pair<Mesh, MigrationPlan>
+///   The rebalanced mesh, and the plan for moving cell data to it
+std::pair<Mesh, MigrationPlan>
+rebalance(const Mesh& mesh, const std::vector<std::size_t>& cell_weights,
+          std::string partitioner = "ParMETIS-adaptive");
+
+//---------------------------------------------------------------------------
+// Implementation of MigrationPlan
+//---------------------------------------------------------------------------
+template <typename T>
+Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+MigrationPlan::migrate(const Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic,
+                                          Eigen::RowMajor>& values) const
+{
+  if (values.rows() != _num_cells_old)
+  {
+    throw std::runtime_error("Number of rows of cell data ("
+                             + std::to_string(values.rows())
+                             + ") does not match number of cells ("
+                             + std::to_string(_num_cells_old) + ").");
+  }
+
+  // Pack data of cells for each destination process
+  const std::size_t num_processes = _send_cells.size();
+  const Eigen::Index cols = values.cols();
+  std::vector<std::vector<T>> send_values(num_processes);
+  for (std::size_t p = 0; p < num_processes; ++p)
+  {
+    send_values[p].reserve(_send_cells[p].size() * cols);
+    for (std::int32_t c : _send_cells[p])
+    {
+      send_values[p].insert(send_values[p].end(), values.data() + c * cols,
+                            values.data() + (c + 1) * cols);
+    }
+  }
+
+  std::vector<std::vector<T>> recv_values;
+  MPI::all_to_all(_mpi_comm.comm(), send_values, recv_values);
+
+  // Unpack data into rows of cells of new mesh
+  Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      new_values(_num_cells_new, cols);
+  for (std::size_t p = 0; p < num_processes; ++p)
+  {
+    assert(recv_values[p].size() == _recv_cells[p].size() * cols);
+    for (std::size_t i = 0; i < _recv_cells[p].size(); ++i)
+    {
+      std::copy(recv_values[p].data() + i * cols,
+                recv_values[p].data() + (i + 1) * cols,
+                new_values.data() + _recv_cells[p][i] * cols);
+    }
+  }
+
+  return new_values;
+}
+//---------------------------------------------------------------------------
+template <typename T>
+MeshFunction<T> MigrationPlan::migrate(const MeshFunction<T>& f,
+                                       std::shared_ptr<const Mesh> mesh) const
+{
+  std::shared_ptr<const Mesh> mesh0 = f.mesh();
+  assert(mesh0);
+  assert(mesh);
+  const int tdim = mesh0->topology().dim();
+  const int dim = f.dim();
+  if (mesh->num_entities(tdim) != _num_cells_new)
+    throw std::runtime_error("Mesh does not match migration plan");
+
+  MeshFunction<T> g(mesh, dim, T());
+  if (dim == tdim)
+  {
+    // Cell values
+    Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> values
+        = Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>>(f.values(),
+                                                                f.size());
+    values = migrate(values);
+    std::copy(values.data(), values.data() + values.size(), g.values());
+    return g;
+  }
+
+  // Tabulate values of the entities of each cell, in the local entity
+  // order of the cell (which is the same for both meshes, since the
+  // cell vertices are the same)
+  mesh0->create_connectivity(tdim, dim);
+  const ConnectivityView c_to_e0 = mesh0->topology().connectivity_view(tdim, dim);
+  const int num_cell_entities = mesh0->type().num_entities(dim);
+  Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> values(
+      _num_cells_old, num_cell_entities);
+  const T* f_values = f.values();
+  for (std::int32_t c = 0; c < _num_cells_old; ++c)
+  {
+    const std::int32_t* entities = c_to_e0.connections(c);
+    for (int i = 0; i < num_cell_entities; ++i)
+      values(c, i) = f_values[entities[i]];
+  }
+
+  values = migrate(values);
+
+  // Assign values to the entities of the cells of the new mesh
+  mesh->create_connectivity(tdim, dim);
+  const ConnectivityView c_to_e1 = mesh->topology().connectivity_view(tdim, dim);
+  T* g_values = g.values();
+  for (std::int32_t c = 0; c < _num_cells_new; ++c)
+  {
+    const std::int32_t* entities = c_to_e1.connections(c);
+    for (int i = 0; i < num_cell_entities; ++i)
+      g_values[entities[i]] = values(c, i);
+  }
+
+  return g;
+}
+//---------------------------------------------------------------------------
+} // namespace mesh
+} // namespace dolfin
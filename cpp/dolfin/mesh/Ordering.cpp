@@ -5,9 +5,12 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "Ordering.h"
-#include "Cell.h"
+#include "CellType.h"
+#include "Connectivity.h"
+#include "CoordinateDofs.h"
 #include "Mesh.h"
-#include "MeshIterator.h"
+#include "Topology.h"
+#include <algorithm>
 #include <array>
 #include <vector>
 
@@ -53,12 +56,11 @@ bool increasing(const int n, const std::int32_t* v0, const std::int32_t* v1,
   return w0 < w1;
 }
 //-----------------------------------------------------------------------------
-void sort_1_0(mesh::Connectivity& connect_1_0, const mesh::Cell& cell,
+void sort_1_0(mesh::Connectivity& connect_1_0, const std::int32_t* cell_edges,
               const std::vector<std::int64_t>& global_vertex_indices,
               const int num_edges)
 {
   // Sort vertices on each edge
-  const std::int32_t* cell_edges = cell.entities(1);
   assert(cell_edges);
   for (int i = 0; i < num_edges; ++i)
   {
@@ -70,12 +72,11 @@ void sort_1_0(mesh::Connectivity& connect_1_0, const mesh::Cell& cell,
   }
 }
 //-----------------------------------------------------------------------------
-void sort_2_0(mesh::Connectivity& connect_2_0, const mesh::Cell& cell,
+void sort_2_0(mesh::Connectivity& connect_2_0, const std::int32_t* cell_faces,
               const std::vector<std::int64_t>& global_vertex_indices,
               const int num_faces)
 {
   // Sort vertices on each facet
-  const std::int32_t* cell_faces = cell.entities(2);
   assert(cell_faces);
   for (int i = 0; i < num_faces; ++i)
   {
@@ -89,12 +90,12 @@ void sort_2_0(mesh::Connectivity& connect_2_0, const mesh::Cell& cell,
 //-----------------------------------------------------------------------------
 void sort_2_1(mesh::Connectivity& connect_2_1,
               const mesh::Connectivity& connect_2_0,
-              const mesh::Connectivity& connect_1_0, const mesh::Cell& cell,
+              const mesh::Connectivity& connect_1_0,
+              const std::int32_t* cell_faces,
               const std::vector<std::int64_t>& global_vertex_indices,
               const int num_faces)
 {
   // Loop over faces on cell
-  const std::int32_t* cell_faces = cell.entities(2);
   assert(cell_faces);
   for (int i = 0; i < num_faces; ++i)
   {
@@ -131,10 +132,10 @@ void sort_2_1(mesh::Connectivity& connect_2_1,
   }
 }
 //-----------------------------------------------------------------------------
-void sort_3_0(mesh::Connectivity& connect_3_0, const mesh::Cell& cell,
+void sort_3_0(mesh::Connectivity& connect_3_0, std::int32_t c,
               const std::vector<std::int64_t>& global_vertex_indices)
 {
-  std::int32_t* cell_vertices = connect_3_0.connections(cell.index());
+  std::int32_t* cell_vertices = connect_3_0.connections(c);
   assert(cell_vertices);
   std::sort(cell_vertices, cell_vertices + 4, [&](auto& a, auto& b) {
     return global_vertex_indices[a] < global_vertex_indices[b];
@@ -142,13 +143,13 @@ void sort_3_0(mesh::Connectivity& connect_3_0, const mesh::Cell& cell,
 }
 //-----------------------------------------------------------------------------
 void sort_3_1(mesh::Connectivity& connect_3_1,
-              const mesh::Connectivity& connect_1_0, const mesh::Cell& cell,
+              const mesh::Connectivity& connect_1_0,
+              const std::int32_t* cell_vertices, std::int32_t c,
               const std::vector<std::int64_t>& global_vertex_indices)
 {
   // Get cell vertices and edge numbers
-  const std::int32_t* cell_vertices = cell.entities(0);
   assert(cell_vertices);
-  std::int32_t* cell_edges = connect_3_1.connections(cell.index());
+  std::int32_t* cell_edges = connect_3_1.connections(c);
   assert(cell_edges);
 
   // Loop two vertices on cell as a lexicographical tuple
@@ -182,13 +183,13 @@ void sort_3_1(mesh::Connectivity& connect_3_1,
 }
 //-----------------------------------------------------------------------------
 void sort_3_2(mesh::Connectivity& connect_3_2,
-              const mesh::Connectivity& connect_2_0, const mesh::Cell& cell,
+              const mesh::Connectivity& connect_2_0,
+              const std::int32_t* cell_vertices, std::int32_t c,
               const std::vector<std::int64_t>& global_vertex_indices)
 {
   // Get cell vertices and facet numbers
-  const std::int32_t* cell_vertices = cell.entities(0);
   assert(cell_vertices);
-  std::int32_t* cell_faces = connect_3_2.connections(cell.index());
+  std::int32_t* cell_faces = connect_3_2.connections(c);
   assert(cell_faces);
 
   // Loop vertices on cell
@@ -214,20 +215,14 @@ void sort_3_2(mesh::Connectivity& connect_3_2,
 //-----------------------------------------------------------------------------
 bool ordered_cell_simplex(
     const std::vector<std::int64_t>& global_vertex_indices,
-    const mesh::Cell& cell)
+    const mesh::Connectivity& connect_tdim_0,
+    const std::vector<std::pair<const mesh::Connectivity*,
+                                const mesh::Connectivity*>>& connect_d,
+    std::int32_t c)
 {
-  // Get mesh topology
-  const mesh::Topology& topology = cell.mesh().topology();
-  const int tdim = topology.dim();
-  const int c = cell.index();
-
   // Get vertices
-  std::shared_ptr<const mesh::Connectivity> connect_tdim_0
-      = topology.connectivity(tdim, 0);
-  assert(connect_tdim_0);
-
-  const int num_vertices = connect_tdim_0->size(c);
-  const std::int32_t* vertices = connect_tdim_0->connections(c);
+  const int num_vertices = connect_tdim_0.size(c);
+  const std::int32_t* vertices = connect_tdim_0.connections(c);
   assert(vertices);
 
   // Check that vertices are in ascending order
@@ -237,37 +232,30 @@ bool ordered_cell_simplex(
   {
     return false;
   }
-  // Note the comparison below: d + 1 < dim, not d < dim - 1
-  // Otherwise, d < dim - 1 will evaluate to true for dim = 0 with std::size_t
 
   // Check numbering of entities of positive dimension and codimension
-  for (int d = 1; d + 1 < tdim; ++d)
+  // (connectivities (d - 0, tdim - d) for 0 < d < tdim - 1)
+  for (auto& connect : connect_d)
   {
-    // Check if entities exist, otherwise skip
-    std::shared_ptr<const mesh::Connectivity> connect_d_0
-        = topology.connectivity(d, 0);
-    if (!connect_d_0)
-      continue;
+    const mesh::Connectivity& connect_d_0 = *connect.first;
+    const mesh::Connectivity& connect_tdim_d = *connect.second;
 
     // Get entities
-    std::shared_ptr<const mesh::Connectivity> connect_tdim_d
-        = topology.connectivity(tdim, d);
-    assert(connect_tdim_d);
-    const int num_entities = connect_tdim_d->size(c);
-    const std::int32_t* entities = connect_tdim_d->connections(c);
+    const int num_entities = connect_tdim_d.size(c);
+    const std::int32_t* entities = connect_tdim_d.connections(c);
 
     // Iterate over entities
     for (int e = 1; e < num_entities; ++e)
     {
       // Get vertices for first entity
       const int e0 = entities[e - 1];
-      const int n0 = connect_d_0->size(e0);
-      const std::int32_t* v0 = connect_d_0->connections(e0);
+      const int n0 = connect_d_0.size(e0);
+      const std::int32_t* v0 = connect_d_0.connections(e0);
 
       // Get vertices for second entity
       const int e1 = entities[e];
-      const int n1 = connect_d_0->size(e1);
-      const std::int32_t* v1 = connect_d_0->connections(e1);
+      const int n1 = connect_d_0.size(e1);
+      const std::int32_t* v1 = connect_d_0.connections(e1);
 
       // Check ordering of entities
       assert(n0 == n1);
@@ -332,48 +320,72 @@ void mesh::Ordering::order_simplex(mesh::Mesh& mesh)
     connect_3_2 = topology.connectivity(3, 2);
   }
 
+  // Cell - entity connectivities used to find the entities of each
+  // cell. The entity of dimension tdim of a cell is the cell itself.
+  std::shared_ptr<const mesh::Connectivity> connect_tdim_0
+      = topology.connectivity(tdim, 0);
+  std::shared_ptr<const mesh::Connectivity> connect_tdim_1
+      = (tdim > 1) ? topology.connectivity(tdim, 1) : nullptr;
+  std::shared_ptr<const mesh::Connectivity> connect_tdim_2
+      = (tdim > 2) ? topology.connectivity(tdim, 2) : nullptr;
+  assert(connect_tdim_0);
+
   // Iterate over all cells
-  for (mesh::Cell& cell : mesh::MeshRange<mesh::Cell>(mesh))
+  const std::int32_t num_cells = mesh.num_entities(tdim);
+  for (std::int32_t c = 0; c < num_cells; ++c)
   {
     // Sort i - j for i > j: 1 - 0, 2 - 0, 2 - 1, 3 - 0, 3 - 1, 3 - 2
 
+    // Entities of cell (the connections are sorted in place below)
+    const std::int32_t* cell_vertices = connect_tdim_0->connections(c);
+    const std::int32_t* cell_edges
+        = connect_tdim_1 ? connect_tdim_1->connections(c) : &c;
+    const std::int32_t* cell_faces
+        = connect_tdim_2 ? connect_tdim_2->connections(c) : &c;
+
     // Order 'coordinate' connectivity
     if (tdim == 1)
-      sort_1_0(connect_g, cell, global_vertex_indices, num_edges);
+      sort_1_0(connect_g, cell_edges, global_vertex_indices, num_edges);
     else if (tdim == 2)
-      sort_2_0(connect_g, cell, global_vertex_indices, num_faces);
+      sort_2_0(connect_g, cell_faces, global_vertex_indices, num_faces);
     else if (tdim == 3)
-      sort_3_0(connect_g, cell, global_vertex_indices);
+      sort_3_0(connect_g, c, global_vertex_indices);
 
     // Sort local vertices on edges in ascending order, connectivity 1-0
     if (connect_1_0)
-      sort_1_0(*connect_1_0, cell, global_vertex_indices, num_edges);
+      sort_1_0(*connect_1_0, cell_edges, global_vertex_indices, num_edges);
 
     // Sort local vertices on faces in ascending order, connectivity 2-0
     if (connect_2_0)
-      sort_2_0(*connect_2_0, cell, global_vertex_indices, num_faces);
+      sort_2_0(*connect_2_0, cell_faces, global_vertex_indices, num_faces);
 
     // Sort local edges on local faces after non-incident vertex,
     // connectivity 2-1
     if (connect_2_1)
     {
-      sort_2_1(*connect_2_1, *connect_2_0, *connect_1_0, cell,
+      sort_2_1(*connect_2_1, *connect_2_0, *connect_1_0, cell_faces,
                global_vertex_indices, num_faces);
     }
 
     // Sort local vertices on cell in ascending order, connectivity 3-0
     if (connect_3_0)
-      sort_3_0(*connect_3_0, cell, global_vertex_indices);
+      sort_3_0(*connect_3_0, c, global_vertex_indices);
 
     // Sort local edges on cell after non-incident vertex tuple,
     // connectivity 3-1
     if (connect_3_1)
-      sort_3_1(*connect_3_1, *connect_1_0, cell, global_vertex_indices);
+    {
+      sort_3_1(*connect_3_1, *connect_1_0, cell_vertices, c,
+               global_vertex_indices);
+    }
 
     // Sort local facets on cell after non-incident vertex, connectivity
     // 3-2
     if (connect_3_2)
-      sort_3_2(*connect_3_2, *connect_2_0, cell, global_vertex_indices);
+    {
+      sort_3_2(*connect_3_2, *connect_2_0, cell_vertices, c,
+               global_vertex_indices);
+    }
   }
 }
 //-----------------------------------------------------------------------------
@@ -396,11 +408,41 @@ bool mesh::Ordering::is_ordered_simplex(const mesh::Mesh& mesh)
   const std::vector<std::int64_t>& global_vertex_indices
       = mesh.topology().global_indices(0);
 
+  // Get connectivities once, rather than for each cell
+  const mesh::Topology& topology = mesh.topology();
+  std::shared_ptr<const mesh::Connectivity> connect_tdim_0
+      = topology.connectivity(tdim, 0);
+  assert(connect_tdim_0);
+
+  // Note the comparison below: d + 1 < dim, not d < dim - 1
+  // Otherwise, d < dim - 1 will evaluate to true for dim = 0 with
+  // std::size_t
+  std::vector<
+      std::pair<const mesh::Connectivity*, const mesh::Connectivity*>>
+      connect_d;
+  for (int d = 1; d + 1 < tdim; ++d)
+  {
+    // Check if entities exist, otherwise skip
+    std::shared_ptr<const mesh::Connectivity> connect_d_0
+        = topology.connectivity(d, 0);
+    if (!connect_d_0)
+      continue;
+
+    std::shared_ptr<const mesh::Connectivity> connect_tdim_d
+        = topology.connectivity(tdim, d);
+    assert(connect_tdim_d);
+    connect_d.push_back({connect_d_0.get(), connect_tdim_d.get()});
+  }
+
   // Check if all cells are ordered
-  for (const mesh::Cell& cell : mesh::MeshRange<mesh::Cell>(mesh))
+  const std::int32_t num_cells = mesh.num_entities(tdim);
+  for (std::int32_t c = 0; c < num_cells; ++c)
   {
-    if (!ordered_cell_simplex(global_vertex_indices, cell))
+    if (!ordered_cell_simplex(global_vertex_indices, *connect_tdim_0,
+                              connect_d, c))
+    {
       return false;
+    }
   }
 
   return true;
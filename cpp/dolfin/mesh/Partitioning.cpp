@@ -16,13 +16,17 @@
 #include "Topology.h"
 #include "Vertex.h"
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/Set.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/log.h>
+#include <dolfin/common/sort.h>
+#include <dolfin/graph/BoostGraphOrdering.h>
 #include <dolfin/graph/CSRGraph.h>
 #include <dolfin/graph/GraphBuilder.h>
+#include <dolfin/graph/HilbertPartitioner.h>
 #include <dolfin/graph/ParMETIS.h>
 #include <dolfin/graph/SCOTCH.h>
 #include <iterator>
@@ -365,16 +369,15 @@ void distribute_cell_layer(
 
     std::vector<std::int64_t>& sendv = send_vertcells[dest];
 
-    // Pack as [cell_global_index, this_vertex, [other_vertices]]
+    // Pack as [cell_global_index, this_vertex, [cell_vertices]]. The
+    // cell vertices are kept in order, which matters for quadrilateral
+    // and hexahedral cells.
     for (const auto& q : vc_it.second)
     {
       sendv.push_back(global_cell_indices[q]);
       sendv.push_back(vc_it.first);
       for (Eigen::Index v = 0; v < cell_vertices.cols(); ++v)
-      {
-        if (cell_vertices(q, v) != vc_it.first)
-          sendv.push_back(cell_vertices(q, v));
-      }
+        sendv.push_back(cell_vertices(q, v));
     }
   }
 
@@ -390,12 +393,12 @@ void distribute_cell_layer(
   for (int i = 0; i < mpi_size; ++i)
   {
     const std::vector<std::int64_t>& recv_i = recv_vertcells[i];
-    for (auto q = recv_i.begin(); q != recv_i.end(); q += num_cell_vertices + 1)
+    for (auto q = recv_i.begin(); q != recv_i.end(); q += num_cell_vertices + 2)
     {
       const std::size_t vertex_index = *(q + 1);
-      // Packing: [owner, cell_index, this_vertex, [other_vertices]]
+      // Packing: [owner, cell_index, this_vertex, [cell_vertices]]
       cell_set = {i};
-      cell_set.insert(cell_set.end(), q, q + num_cell_vertices + 1);
+      cell_set.insert(cell_set.end(), q, q + num_cell_vertices + 2);
 
       // Look for vertex in map, and add the attached cell
       auto it = sh_vert_to_cell.insert({vertex_index, cell_set});
@@ -412,7 +415,7 @@ void distribute_cell_layer(
   for (const auto& p : sh_vert_to_cell)
   {
     for (auto q = p.second.begin(); q != p.second.end();
-         q += (num_cell_vertices + 2))
+         q += (num_cell_vertices + 3))
     {
       send_vertcells[*q].insert(send_vertcells[*q].end(), p.second.begin(),
                                 p.second.end());
@@ -429,7 +432,7 @@ void distribute_cell_layer(
 
   for (const auto& p : recv_vertcells)
   {
-    for (auto q = p.begin(); q != p.end(); q += num_cell_vertices + 2)
+    for (auto q = p.begin(); q != p.end(); q += num_cell_vertices + 3)
     {
       const std::int64_t owner = *q;
       const std::int64_t cell_index = *(q + 1);
@@ -455,7 +458,7 @@ void distribute_cell_layer(
   std::size_t last_vertex = std::numeric_limits<std::size_t>::max();
   for (const auto& p : recv_vertcells)
   {
-    for (auto q = p.begin(); q != p.end(); q += num_cell_vertices + 2)
+    for (auto q = p.begin(); q != p.end(); q += num_cell_vertices + 3)
     {
       const int owner = *q;
       const std::size_t cell_index = *(q + 1);
@@ -467,7 +470,7 @@ void distribute_cell_layer(
       if (local_index >= num_cells)
       {
         for (std::int32_t j = 0; j != num_cell_vertices; ++j)
-          cell_vertices(local_index, j) = *(q + j + 2);
+          cell_vertices(local_index, j) = *(q + j + 3);
       }
 
       // If starting on a new shared vertex, dump old data into
@@ -501,13 +504,384 @@ void distribute_cell_layer(
   }
 }
 //-----------------------------------------------------------------------------
+// Distribute further layers of ghost cells, so that there are
+// num_layers layers in total. The input cell_vertices, shared_cells,
+// global_cell_indices and cell_partition must already be distributed
+// with one ghost layer. Ghost layer i + 1 holds the cells that are
+// connected to a cell in layer i (via a facet for
+// GhostMode::shared_facet, or a vertex for GhostMode::shared_vertex)
+// and are not in an inner layer. These are requested from the owners
+// of the cells in layer i, which have all connected cells of their
+// owned cells in their first ghost layer. New cells are appended, so
+// that the ghost cells are ordered by layer, and shared_cells is
+// recomputed. Returns the offsets of the ghost layers.
+// FIXME: shared_cells, cell_vertices, global_cell_indices and
+// cell_partition are all modified by this function.
+std::vector<std::int32_t> distribute_ghost_layers(
+    MPI_Comm mpi_comm, const mesh::CellType& cell_type,
+    const mesh::GhostMode ghost_mode, const int num_layers,
+    const std::int32_t num_regular_cells,
+    std::map<std::int32_t, std::set<std::int32_t>>& shared_cells,
+    EigenRowArrayXXi64& cell_vertices,
+    std::vector<std::int64_t>& global_cell_indices,
+    std::vector<int>& cell_partition)
+{
+  std::vector<std::int32_t> layer_offsets
+      = {num_regular_cells, (std::int32_t)cell_vertices.rows()};
+  if (num_layers == 1)
+    return layer_offsets;
+
+  common::Timer timer("Distribute ghost cell layers");
+
+  const int mpi_size = dolfin::MPI::size(mpi_comm);
+  const int mpi_rank = dolfin::MPI::rank(mpi_comm);
+  const int num_cell_vertices = cell_vertices.cols();
+
+  // Number of common vertices of connected cells
+  const int num_common_vertices
+      = (ghost_mode == mesh::GhostMode::shared_facet)
+            ? cell_type.num_vertices(cell_type.dim() - 1)
+            : 1;
+
+  // Find the cells of each vertex from sorted (vertex, cell) pairs
+  const std::int32_t num_cells0 = cell_vertices.rows();
+  std::vector<std::pair<std::int64_t, std::int32_t>> vertex_cells;
+  vertex_cells.reserve(num_cells0 * num_cell_vertices);
+  for (std::int32_t c = 0; c < num_cells0; ++c)
+    for (int j = 0; j < num_cell_vertices; ++j)
+      vertex_cells.push_back({cell_vertices(c, j), c});
+  std::sort(vertex_cells.begin(), vertex_cells.end());
+
+  // Compute cells connected to each owned cell
+  std::vector<std::int32_t> neighbour_offsets(1, 0), neighbours, cells;
+  for (std::int32_t c = 0; c < num_regular_cells; ++c)
+  {
+    cells.clear();
+    for (int j = 0; j < num_cell_vertices; ++j)
+    {
+      const std::int64_t v = cell_vertices(c, j);
+      auto it = std::lower_bound(
+          vertex_cells.begin(), vertex_cells.end(),
+          std::pair<std::int64_t, std::int32_t>(v, 0));
+      for (; it != vertex_cells.end() and it->first == v; ++it)
+        if (it->second != c)
+          cells.push_back(it->second);
+    }
+
+    // Keep cells with enough common vertices
+    std::sort(cells.begin(), cells.end());
+    for (auto it = cells.begin(); it != cells.end();)
+    {
+      auto next = std::upper_bound(it, cells.end(), *it);
+      if (next - it >= num_common_vertices)
+        neighbours.push_back(*it);
+      it = next;
+    }
+    neighbour_offsets.push_back(neighbours.size());
+  }
+
+  // Global to local mapping of cell indices
+  std::map<std::int64_t, std::int32_t> cell_global_to_local;
+  for (std::int32_t c = 0; c < num_cells0; ++c)
+    cell_global_to_local.insert({global_cell_indices[c], c});
+
+  for (int layer = 1; layer < num_layers; ++layer)
+  {
+    // Request the cells connected to the cells of the outermost layer
+    // from their owners
+    std::vector<std::vector<std::int64_t>> send_requests(mpi_size);
+    for (std::int32_t c = layer_offsets[layer - 1]; c < layer_offsets[layer];
+         ++c)
+    {
+      send_requests[cell_partition[c]].push_back(global_cell_indices[c]);
+    }
+    std::vector<std::vector<std::int64_t>> recv_requests;
+    dolfin::MPI::all_to_all(mpi_comm, send_requests, recv_requests);
+
+    // Send connected cells, packed as [number of cells, [cell global
+    // index, owner, [cell_vertices]] for each cell]
+    std::vector<std::vector<std::int64_t>> send_cells(mpi_size);
+    for (int p = 0; p < mpi_size; ++p)
+    {
+      for (std::int64_t index : recv_requests[p])
+      {
+        const std::int32_t c = cell_global_to_local.at(index);
+        assert(c < num_regular_cells);
+        send_cells[p].push_back(neighbour_offsets[c + 1]
+                                - neighbour_offsets[c]);
+        for (std::int32_t i = neighbour_offsets[c];
+             i < neighbour_offsets[c + 1]; ++i)
+        {
+          const std::int32_t n = neighbours[i];
+          send_cells[p].push_back(global_cell_indices[n]);
+          send_cells[p].push_back(cell_partition[n]);
+          for (int j = 0; j < num_cell_vertices; ++j)
+            send_cells[p].push_back(cell_vertices(n, j));
+        }
+      }
+    }
+    std::vector<std::vector<std::int64_t>> recv_cells;
+    dolfin::MPI::all_to_all(mpi_comm, send_cells, recv_cells);
+
+    // Add received cells that are not already on this process
+    std::vector<std::int64_t> new_cell_vertices;
+    for (int p = 0; p < mpi_size; ++p)
+    {
+      for (auto q = recv_cells[p].begin(); q != recv_cells[p].end();)
+      {
+        const std::int64_t num_cells = *q++;
+        for (std::int64_t i = 0; i < num_cells; ++i)
+        {
+          const std::int64_t index = *q;
+          const std::int32_t local_index = global_cell_indices.size();
+          if (cell_global_to_local.insert({index, local_index}).second)
+          {
+            global_cell_indices.push_back(index);
+            cell_partition.push_back(*(q + 1));
+            new_cell_vertices.insert(new_cell_vertices.end(), q + 2,
+                                     q + 2 + num_cell_vertices);
+          }
+          q += num_cell_vertices + 2;
+        }
+      }
+    }
+
+    const std::int32_t num_cells = cell_vertices.rows();
+    const std::int32_t num_new_cells
+        = new_cell_vertices.size() / num_cell_vertices;
+    cell_vertices.conservativeResize(num_cells + num_new_cells,
+                                     Eigen::NoChange);
+    cell_vertices.bottomRows(num_new_cells)
+        = Eigen::Map<EigenRowArrayXXi64>(new_cell_vertices.data(),
+                                         num_new_cells, num_cell_vertices);
+    layer_offsets.push_back(cell_vertices.rows());
+  }
+
+  // Recompute the processes that hold each cell. Each process sends
+  // its ghost cells to their owners, which send back the list of all
+  // processes that hold the cell.
+  std::vector<std::vector<std::int64_t>> send_ghosts(mpi_size);
+  for (std::int32_t c = num_regular_cells; c < cell_vertices.rows(); ++c)
+    send_ghosts[cell_partition[c]].push_back(global_cell_indices[c]);
+  std::vector<std::vector<std::int64_t>> recv_ghosts;
+  dolfin::MPI::all_to_all(mpi_comm, send_ghosts, recv_ghosts);
+
+  shared_cells.clear();
+  for (int p = 0; p < mpi_size; ++p)
+    for (std::int64_t index : recv_ghosts[p])
+      shared_cells[cell_global_to_local.at(index)].insert(p);
+
+  // Send [cell global index, number of processes, [processes]] to each
+  // process that holds the cell as a ghost
+  std::vector<std::vector<std::int64_t>> send_holders(mpi_size);
+  for (const auto& c : shared_cells)
+  {
+    for (std::int32_t p : c.second)
+    {
+      send_holders[p].push_back(global_cell_indices[c.first]);
+      send_holders[p].push_back(c.second.size() + 1);
+      send_holders[p].push_back(mpi_rank);
+      send_holders[p].insert(send_holders[p].end(), c.second.begin(),
+                             c.second.end());
+    }
+  }
+  std::vector<std::vector<std::int64_t>> recv_holders;
+  dolfin::MPI::all_to_all(mpi_comm, send_holders, recv_holders);
+
+  for (int p = 0; p < mpi_size; ++p)
+  {
+    for (auto q = recv_holders[p].begin(); q != recv_holders[p].end();)
+    {
+      const std::int32_t c = cell_global_to_local.at(*q++);
+      const std::int64_t num_procs = *q++;
+      std::set<std::int32_t>& procs = shared_cells[c];
+      for (std::int64_t i = 0; i < num_procs; ++i, ++q)
+        if (*q != mpi_rank)
+          procs.insert(*q);
+    }
+  }
+
+  return layer_offsets;
+}
+//-----------------------------------------------------------------------------
+// Compute the centroids of cells. Collective, since the vertex
+// coordinates of the cells are fetched from the processes that hold
+// them.
+EigenRowArrayXXd
+compute_cell_centroids(const MPI_Comm& comm, const mesh::CellType& cell_type,
+                       const Eigen::Ref<const EigenRowArrayXXi64> cell_vertices,
+                       const Eigen::Ref<const EigenRowArrayXXd> points)
+{
+  const std::int32_t num_cells = cell_vertices.rows();
+  const int num_vertices_per_cell = cell_type.num_vertices();
+  const int gdim = points.cols();
+
+  // Get coordinates of the vertices of the cells
+  std::vector<std::int64_t> vertices(num_cells * num_vertices_per_cell);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+    for (int v = 0; v < num_vertices_per_cell; ++v)
+      vertices[c * num_vertices_per_cell + v] = cell_vertices(c, v);
+  std::sort(vertices.begin(), vertices.end());
+  vertices.erase(std::unique(vertices.begin(), vertices.end()),
+                 vertices.end());
+  const EigenRowArrayXXd x
+      = Partitioning::distribute_points(comm, points, vertices).first;
+
+  // Compute cell centroids
+  EigenRowArrayXXd centroids = EigenRowArrayXXd::Zero(num_cells, gdim);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    for (int v = 0; v < num_vertices_per_cell; ++v)
+    {
+      const std::size_t pos
+          = std::lower_bound(vertices.begin(), vertices.end(),
+                             cell_vertices(c, v))
+            - vertices.begin();
+      centroids.row(c) += x.row(pos);
+    }
+  }
+  centroids /= num_vertices_per_cell;
+
+  return centroids;
+}
+//-----------------------------------------------------------------------------
+// Compute reordering (map[old] -> new) of cells along a Hilbert curve
+// through the cell centroids. Collective, since the vertex coordinates
+// of the cells are fetched from the processes that hold them.
+std::vector<std::int32_t> compute_cell_reordering_hilbert(
+    const MPI_Comm& comm, const mesh::CellType& cell_type,
+    const Eigen::Ref<const EigenRowArrayXXi64> cell_vertices,
+    const Eigen::Ref<const EigenRowArrayXXd> points)
+{
+  const std::int32_t num_cells = cell_vertices.rows();
+  const int gdim = points.cols();
+  const EigenRowArrayXXd centroids
+      = compute_cell_centroids(comm, cell_type, cell_vertices, points);
+
+  // Map centroids onto integer grid covering the local bounding box,
+  // and compute position along Hilbert curve
+  const int dim = std::min(gdim, 3);
+  const int bits = std::min(63 / dim, 31);
+  std::vector<std::array<std::uint64_t, 1>> keys(num_cells);
+  if (num_cells > 0)
+  {
+    const Eigen::Array<double, 1, Eigen::Dynamic> x0
+        = centroids.colwise().minCoeff();
+    const Eigen::Array<double, 1, Eigen::Dynamic> dx
+        = centroids.colwise().maxCoeff() - x0;
+    const double scale = (double)((std::uint64_t(1) << bits) - 1);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      std::array<std::uint32_t, 3> p = {{0, 0, 0}};
+      for (int i = 0; i < dim; ++i)
+        if (dx[i] > 0.0)
+          p[i] = (centroids(c, i) - x0[i]) / dx[i] * scale;
+      keys[c][0] = graph::HilbertPartitioner::index(p, dim, bits);
+    }
+  }
+
+  // Sort cells along curve
+  const std::vector<std::int32_t> perm = common::radix_argsort(keys);
+  std::vector<std::int32_t> remap(num_cells);
+  for (std::int32_t i = 0; i < num_cells; ++i)
+    remap[perm[i]] = i;
+
+  return remap;
+}
+//-----------------------------------------------------------------------------
+// Compute reordering (map[old] -> new) of cells by reverse
+// Cuthill-McKee ordering of the local dual graph
+std::vector<std::int32_t> compute_cell_reordering_rcm(
+    const MPI_Comm& comm, const mesh::CellType& cell_type,
+    const Eigen::Ref<const EigenRowArrayXXi64> cell_vertices)
+{
+  // Make dual graph from vertex indices, using GraphBuilder
+  std::vector<std::vector<std::size_t>> local_graph;
+  std::tie(local_graph, std::ignore, std::ignore)
+      = graph::GraphBuilder::compute_local_dual_graph(comm, cell_vertices,
+                                                      cell_type);
+
+  // Convert between graph types, removing offset
+  const std::int32_t num_cells = cell_vertices.rows();
+  const std::size_t cell_offset
+      = dolfin::MPI::global_offset(comm, num_cells, true);
+  graph::Graph g_dual(num_cells);
+  for (std::int32_t i = 0; i < num_cells; ++i)
+  {
+    for (std::size_t q : local_graph[i])
+    {
+      assert(q >= cell_offset);
+      g_dual[i].insert(q - cell_offset);
+    }
+  }
+
+  const std::vector<int> remap
+      = graph::BoostGraphOrdering::compute_cuthill_mckee(g_dual, true);
+  return std::vector<std::int32_t>(remap.begin(), remap.end());
+}
+//-----------------------------------------------------------------------------
+// Reorder the first num_cells cells (the non-ghost cells), and update
+// the cell data accordingly. Ghost cells are not reordered.
+void reorder_cells(
+    const MPI_Comm& comm, const mesh::CellType& cell_type,
+    const Eigen::Ref<const EigenRowArrayXXd> points, std::int32_t num_cells,
+    mesh::CellReordering cell_reordering,
+    std::map<std::int32_t, std::set<std::int32_t>>& shared_cells,
+    EigenRowArrayXXi64& cell_vertices,
+    std::vector<std::int64_t>& global_cell_indices,
+    std::vector<int>& cell_partition)
+{
+  LOG(INFO) << "Reorder cells during distributed mesh construction";
+  common::Timer timer("Reorder cells during distributed mesh construction");
+
+  std::vector<std::int32_t> remap;
+  switch (cell_reordering)
+  {
+  case mesh::CellReordering::hilbert:
+    remap = compute_cell_reordering_hilbert(
+        comm, cell_type, cell_vertices.topRows(num_cells), points);
+    break;
+  case mesh::CellReordering::reverse_cuthill_mckee:
+    remap = compute_cell_reordering_rcm(comm, cell_type,
+                                        cell_vertices.topRows(num_cells));
+    break;
+  default:
+    return;
+  }
+
+  // Remap data
+  const EigenRowArrayXXi64 old_cell_vertices = cell_vertices.topRows(num_cells);
+  const std::vector<std::int64_t> old_global_cell_indices(
+      global_cell_indices.begin(), global_cell_indices.begin() + num_cells);
+  const std::vector<int> old_cell_partition(
+      cell_partition.begin(), cell_partition.begin() + num_cells);
+  for (std::int32_t i = 0; i < num_cells; ++i)
+  {
+    const std::int32_t j = remap[i];
+    cell_vertices.row(j) = old_cell_vertices.row(i);
+    global_cell_indices[j] = old_global_cell_indices[i];
+    cell_partition[j] = old_cell_partition[i];
+  }
+
+  std::map<std::int32_t, std::set<std::int32_t>> reordered_shared_cells;
+  for (auto& p : shared_cells)
+  {
+    if (p.first < num_cells)
+      reordered_shared_cells.insert({remap[p.first], std::move(p.second)});
+    else
+      reordered_shared_cells.insert(std::move(p));
+  }
+  std::swap(shared_cells, reordered_shared_cells);
+}
+//-----------------------------------------------------------------------------
 // Build a distributed mesh from local mesh data with a computed
 // partition
 mesh::Mesh build(const MPI_Comm& comm, mesh::CellType::Type type,
                  const Eigen::Ref<const EigenRowArrayXXi64> cell_vertices,
                  const Eigen::Ref<const EigenRowArrayXXd> points,
                  const std::vector<std::int64_t>& global_cell_indices,
-                 const mesh::GhostMode ghost_mode, const PartitionData& mp)
+                 const mesh::GhostMode ghost_mode, const PartitionData& mp,
+                 mesh::CellReordering cell_reordering, int num_ghost_layers)
 {
   LOG(INFO) << "Distribute mesh cells";
 
@@ -549,28 +923,26 @@ mesh::Mesh build(const MPI_Comm& comm, mesh::CellType::Type type,
     shared_cells.clear();
   }
 
-  // if (parameter::parameters["reorder_cells_gps"])
-  // {
-  //   // Allocate objects to hold re-ordering
-  //   std::map<std::int32_t, std::set<std::int32_t>> reordered_shared_cells;
-  //   EigenRowArrayXXi64 reordered_cell_vertices;
-  //   std::vector<std::int64_t> reordered_global_cell_indices;
-
-  //   // Re-order cells
-  //   std::tie(reordered_shared_cells, reordered_cell_vertices,
-  //            reordered_global_cell_indices)
-  //       = reorder_cells_gps(comm, num_regular_cells, *cell_type,
-  //       shared_cells,
-  //                           new_cell_vertices, new_global_cell_indices);
-
-  //   // Update to re-ordered indices
-  //   std::swap(shared_cells, reordered_shared_cells);
-  //   new_cell_vertices = reordered_cell_vertices;
-  //   std::swap(new_global_cell_indices, reordered_global_cell_indices);
-  // }
+  // Send/receive further layers of ghost cells
+  std::vector<std::int32_t> ghost_layer_offsets;
+  if (ghost_mode != mesh::GhostMode::none)
+  {
+    ghost_layer_offsets = distribute_ghost_layers(
+        comm, *cell_type, ghost_mode, num_ghost_layers, num_regular_cells,
+        shared_cells, new_cell_vertices, new_global_cell_indices,
+        new_cell_partition);
+  }
 
   timer.stop();
 
+  // Reorder local cells to improve data locality
+  if (cell_reordering != mesh::CellReordering::none)
+  {
+    reorder_cells(comm, *cell_type, points, num_regular_cells,
+                  cell_reordering, shared_cells, new_cell_vertices,
+                  new_global_cell_indices, new_cell_partition);
+  }
+
   // Build mesh from points and distributed cells
   const std::int32_t num_ghosts = new_cell_vertices.rows() - num_regular_cells;
 
@@ -588,31 +960,31 @@ mesh::Mesh build(const MPI_Comm& comm, mesh::CellType::Type type,
                     new_cell_partition.end());
 
   // Assign map of shared cells (only needed for ghost cells)
-  mesh.topology().shared_entities(tdim) = shared_cells;
+  mesh.topology().shared_entities(tdim) = SharedEntities(shared_cells);
+
+  mesh.topology().ghost_layer_offsets() = std::move(ghost_layer_offsets);
 
   return mesh;
 }
 //-----------------------------------------------------------------------------
 // Compute cell partitioning from local mesh data. Returns a vector
 // 'cell -> process' vector for cells, and a map 'local cell index ->
-// processes' to which ghost cells must be sent
+// processes' to which ghost cells must be sent. The partition balances
+// the sum of the cell weights (if any) over the processes.
 PartitionData
 partition_cells(const MPI_Comm& mpi_comm, mesh::CellType::Type type,
                 const Eigen::Ref<const EigenRowArrayXXi64> cell_vertices,
-                const std::string partitioner)
+                const Eigen::Ref<const EigenRowArrayXXd> points,
+                const std::string partitioner,
+                const std::vector<std::size_t>& cell_weights)
 {
   LOG(INFO) << "Compute partition of cells across processes";
 
   std::unique_ptr<mesh::CellType> cell_type(mesh::CellType::create(type));
   assert(cell_type);
 
-  // Compute dual graph (for this partition)
-  std::vector<std::vector<std::size_t>> local_graph;
-  std::tuple<std::int32_t, std::int32_t, std::int32_t> graph_info;
-  std::tie(local_graph, graph_info) = graph::GraphBuilder::compute_dual_graph(
-      mpi_comm, cell_vertices, *cell_type);
-
-  const std::size_t global_graph_size = MPI::sum(mpi_comm, local_graph.size());
+  const std::size_t global_graph_size
+      = MPI::sum(mpi_comm, (std::size_t)cell_vertices.rows());
   const std::size_t num_processes = MPI::size(mpi_comm);
 
   // Require at least two cells per processor for mesh partitioning in
@@ -625,20 +997,55 @@ partition_cells(const MPI_Comm& mpi_comm, mesh::CellType::Type type,
                              + std::to_string(num_processes) + " parts.");
   }
 
+  if (!cell_weights.empty()
+      and (Eigen::Index)cell_weights.size() != cell_vertices.rows())
+  {
+    throw std::runtime_error("Number of cell weights ("
+                             + std::to_string(cell_weights.size())
+                             + ") does not match number of cells ("
+                             + std::to_string(cell_vertices.rows()) + ").");
+  }
+
+  // Geometric partition along Hilbert curve, which does not need the
+  // dual graph
+  if (partitioner == "Hilbert")
+  {
+    const EigenRowArrayXXd centroids
+        = compute_cell_centroids(mpi_comm, *cell_type, cell_vertices, points);
+    return PartitionData(graph::HilbertPartitioner::partition(
+        mpi_comm, cell_vertices, centroids, *cell_type, cell_weights));
+  }
+
+  // Compute dual graph (for this partition)
+  std::vector<std::vector<std::size_t>> local_graph;
+  std::tuple<std::int32_t, std::int32_t, std::int32_t> graph_info;
+  std::tie(local_graph, graph_info) = graph::GraphBuilder::compute_dual_graph(
+      mpi_comm, cell_vertices, *cell_type);
+
   // Compute cell partition using partitioner from parameter system
   if (partitioner == "SCOTCH")
   {
     graph::CSRGraph<SCOTCH_Num> csr_graph(mpi_comm, local_graph);
-    std::vector<std::size_t> weights;
     const std::int32_t num_ghost_nodes = std::get<0>(graph_info);
-    return PartitionData(graph::SCOTCH::partition(mpi_comm, csr_graph, weights,
-                                                  num_ghost_nodes));
+    return PartitionData(graph::SCOTCH::partition(
+        mpi_comm, csr_graph, cell_weights, num_ghost_nodes));
   }
   else if (partitioner == "ParMETIS")
   {
 #ifdef HAS_PARMETIS
     graph::CSRGraph<idx_t> csr_graph(mpi_comm, local_graph);
-    return PartitionData(graph::ParMETIS::partition(mpi_comm, csr_graph));
+    return PartitionData(
+        graph::ParMETIS::partition(mpi_comm, csr_graph, cell_weights));
+#else
+    throw std::runtime_error("ParMETIS not available");
+#endif
+  }
+  else if (partitioner == "ParMETIS-adaptive")
+  {
+#ifdef HAS_PARMETIS
+    graph::CSRGraph<idx_t> csr_graph(mpi_comm, local_graph);
+    return PartitionData(graph::ParMETIS::adaptive_repartition(
+        mpi_comm, csr_graph, cell_weights));
 #else
     throw std::runtime_error("ParMETIS not available");
 #endif
@@ -649,94 +1056,6 @@ partition_cells(const MPI_Comm& mpi_comm, mesh::CellType::Type type,
   return PartitionData({}, {});
 }
 //-----------------------------------------------------------------------------
-// // FIXME: make clearer what goes in and what comes out
-// // Reorder cells by Gibbs-Poole-Stockmeyer algorithm (via SCOTCH).
-// // Returns the tuple (reordered_shared_cells, reordered_cell_vertices,
-// // reordered_global_cell_indices)
-// std::tuple<std::map<std::int32_t, std::set<std::int32_t>>,
-// EigenRowArrayXXi64,
-//            std::vector<std::int64_t>>
-// reorder_cells_gps(
-//     MPI_Comm mpi_comm, const std::int32_t num_regular_cells,
-//     const CellType& cell_type,
-//     const std::map<std::int32_t, std::set<std::int32_t>>& shared_cells,
-//     const Eigen::Ref<const EigenRowArrayXXi64> global_cell_vertices,
-//     const std::vector<std::int64_t>& global_cell_indices)
-// {
-//   std::cout
-//       << "WARNING: this function is probably broken. It needs careful
-//       testing."
-//       << std::endl;
-
-//   LOG(INFO) << "Re-order cells during distributed mesh construction";
-
-//   common::Timer timer("Reorder cells using GPS ordering");
-
-//   // FIXME: Should not use Graph private methods
-//   // Make dual graph from vertex indices, using GraphBuilder
-//   // FIXME: this should be reused later to add the facet-cell topology
-//   std::vector<std::vector<std::size_t>> local_graph;
-//   dolfin::graph::GraphBuilder::FacetCellMap facet_cell_map;
-//   std::tie(local_graph, facet_cell_map, std::ignore)
-//       = dolfin::graph::GraphBuilder::compute_local_dual_graph(
-//           mpi_comm, global_cell_vertices, cell_type);
-
-//   const std::size_t num_all_cells = global_cell_vertices.rows();
-//   const std::size_t local_cell_offset
-//       = dolfin::MPI::global_offset(mpi_comm, num_all_cells, true);
-
-//   // Convert between graph types, removing offset
-//   // FIXME: make all graphs the same type
-
-//   dolfin::graph::Graph g_dual;
-//   // Ignore the ghost cells - they will not be reordered
-//   // FIXME: reorder ghost cells too
-//   for (std::int32_t i = 0; i < num_regular_cells; ++i)
-//   {
-//     dolfin::common::Set<int> conn_set;
-//     for (auto q = local_graph[i].begin(); q != local_graph[i].end(); ++q)
-//     {
-//       assert(*q >= local_cell_offset);
-//       const int local_index = *q - local_cell_offset;
-
-//       // Ignore ghost cells in connectivity
-//       if (local_index < (int)num_regular_cells)
-//         conn_set.insert(local_index);
-//     }
-//     g_dual.push_back(conn_set);
-//   }
-//   std::vector<int> remap;
-//   std::tie(remap, std::ignore) = dolfin::graph::SCOTCH::compute_gps(g_dual);
-
-//   // Add direct mapping for any ghost cells (not reordered)
-//   for (unsigned int j = remap.size(); j < global_cell_indices.size(); ++j)
-//     remap.push_back(j);
-
-//   EigenRowArrayXXi64 reordered_cell_vertices(global_cell_vertices.rows(),
-//                                              global_cell_vertices.cols());
-//   std::vector<std::int64_t> reordered_global_cell_indices(g_dual.size());
-//   for (std::size_t i = 0; i < g_dual.size(); ++i)
-//   {
-//     // Remap data
-//     const int j = remap[i];
-//     reordered_cell_vertices.row(j) = global_cell_vertices.row(i);
-//     reordered_global_cell_indices[j] = global_cell_indices[i];
-//   }
-
-//   std::map<std::int32_t, std::set<std::int32_t>> reordered_shared_cells;
-//   for (auto p = shared_cells.begin(); p != shared_cells.end(); ++p)
-//   {
-//     const std::int32_t cell_index = p->first;
-//     if (cell_index < num_regular_cells)
-//       reordered_shared_cells.insert({remap[cell_index], p->second});
-//     else
-//       reordered_shared_cells.insert(*p);
-//   }
-
-//   return std::make_tuple(std::move(reordered_shared_cells),
-//                          std::move(reordered_cell_vertices),
-//                          std::move(reordered_global_cell_indices));
-// }
 //-----------------------------------------------------------------------------
 
 } // namespace
@@ -747,10 +1066,19 @@ mesh::Mesh Partitioning::build_distributed_mesh(
     const Eigen::Ref<const EigenRowArrayXXd> points,
     const Eigen::Ref<const EigenRowArrayXXi64> cells,
     const std::vector<std::int64_t>& global_cell_indices,
-    const mesh::GhostMode ghost_mode, std::string graph_partitioner)
+    const mesh::GhostMode ghost_mode, std::string graph_partitioner,
+    mesh::CellReordering cell_reordering,
+    const std::vector<std::size_t>& cell_weights, int num_ghost_layers)
 {
+  if (num_ghost_layers < 1)
+  {
+    throw std::runtime_error("Number of ghost layers must be at least 1, not "
+                             + std::to_string(num_ghost_layers));
+  }
+
   // Compute the cell partition
-  PartitionData mp = partition_cells(comm, cell_type, cells, graph_partitioner);
+  PartitionData mp = partition_cells(comm, cell_type, cells, points,
+                                     graph_partitioner, cell_weights);
 
   // Check that we have some ghost information.
   int all_ghosts = dolfin::MPI::sum(comm, mp.num_ghosts());
@@ -759,7 +1087,7 @@ mesh::Mesh Partitioning::build_distributed_mesh(
 
   // Build mesh from local mesh data and provided cell partition
   mesh::Mesh mesh = build(comm, cell_type, cells, points, global_cell_indices,
-                          ghost_mode, mp);
+                          ghost_mode, mp, cell_reordering, num_ghost_layers);
 
   // Initialise number of globally connected cells to each facet. This
   // is necessary to distinguish between facets on an exterior boundary
@@ -771,6 +1099,35 @@ mesh::Mesh Partitioning::build_distributed_mesh(
   return mesh;
 }
 //-----------------------------------------------------------------------------
+mesh::Mesh Partitioning::build_from_distributed_cells(
+    const MPI_Comm& comm, mesh::CellType::Type cell_type,
+    const Eigen::Ref<const EigenRowArrayXXd> points,
+    const Eigen::Ref<const EigenRowArrayXXi64> cells,
+    const std::vector<std::int64_t>& global_cell_indices,
+    const mesh::GhostMode ghost_mode,
+    const std::vector<std::int32_t>& ghost_owners,
+    const std::map<std::int32_t, std::set<std::int32_t>>& shared_cells)
+{
+  if (ghost_mode == mesh::GhostMode::none and !ghost_owners.empty())
+    throw std::runtime_error("Ghost cells given for unghosted mesh");
+
+  mesh::Mesh mesh(comm, cell_type, points, cells, global_cell_indices,
+                  ghost_mode, ghost_owners.size());
+
+  if (ghost_mode != mesh::GhostMode::none)
+  {
+    // Copy cell ownership and map of shared cells
+    const int tdim = mesh.topology().dim();
+    mesh.topology().cell_owner() = ghost_owners;
+    mesh.topology().shared_entities(tdim) = SharedEntities(shared_cells);
+  }
+
+  // Initialise number of globally connected cells to each facet
+  DistributedMeshTools::init_facet_cell_connections(mesh);
+
+  return mesh;
+}
+//-----------------------------------------------------------------------------
 std::pair<EigenRowArrayXXd, std::map<std::int32_t, std::set<std::int32_t>>>
 Partitioning::distribute_points(
     const MPI_Comm mpi_comm, const Eigen::Ref<const EigenRowArrayXXd> points,
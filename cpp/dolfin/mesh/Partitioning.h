@@ -40,6 +40,17 @@ enum class GhostMode : int
   shared_vertex
 };
 
+/// Enum for reordering of the local (non-ghost) cells when building a
+/// distributed mesh. Vertices and geometry points are numbered in the
+/// order in which they first appear in the cells, so they follow the
+/// cell ordering.
+enum class CellReordering : int
+{
+  none,
+  hilbert,
+  reverse_cuthill_mckee
+};
+
 /// This class partitions and distributes a mesh based on partitioned
 /// local mesh data.The local mesh data will also be repartitioned and
 /// redistributed during the computation of the mesh partitioning.
@@ -65,13 +76,69 @@ public:
   ///     Global index for each cell
   /// @param ghost_mode
   ///     Ghost mode
+  /// @param graph_partitioner
+  ///     Graph partitioner ("SCOTCH" or "ParMETIS"), or "Hilbert" for a
+  ///     geometric partition along a Hilbert curve through the cell
+  ///     centroids, which does not need the dual graph. Use
+  ///     "ParMETIS-adaptive" for cells that are already distributed
+  ///     (see mesh::rebalance), to move as few cells as possible.
+  /// @param cell_reordering
+  ///     Reordering of local cells. Cells can be sorted along a Hilbert
+  ///     curve through the cell centroids, or by reverse Cuthill-McKee
+  ///     ordering of the local dual graph.
+  /// @param cell_weights
+  ///     Weight of each cell, e.g. the measured cost of assembling over
+  ///     the cell (see fem::CellCostRecorder). The partitioner balances
+  ///     the sum of the weights over the processes. If empty, all cells
+  ///     have the same weight.
+  /// @param num_ghost_layers
+  ///     Number of layers of ghost cells (ignored for
+  ///     GhostMode::none). Layer i + 1 holds the cells connected to
+  ///     layer i (via a facet or vertex, depending on ghost_mode), and
+  ///     ghost cells are numbered by layer (see
+  ///     Topology::ghost_layer_offsets). More layers allow several
+  ///     local steps between halo exchanges.
   static mesh::Mesh
   build_distributed_mesh(const MPI_Comm& comm, mesh::CellType::Type cell_type,
                          const Eigen::Ref<const EigenRowArrayXXd> points,
                          const Eigen::Ref<const EigenRowArrayXXi64> cells,
                          const std::vector<std::int64_t>& global_cell_indices,
                          const mesh::GhostMode ghost_mode,
-                         std::string graph_partitioner = "SCOTCH");
+                         std::string graph_partitioner = "SCOTCH",
+                         mesh::CellReordering cell_reordering
+                         = mesh::CellReordering::none,
+                         const std::vector<std::size_t>& cell_weights = {},
+                         int num_ghost_layers = 1);
+
+  /// Build distributed mesh from cells that are already distributed,
+  /// e.g. by a structured mesh generator that creates the cells of
+  /// each process directly. No partitioning is performed.
+  /// @param comm
+  ///     MPI Communicator
+  /// @param type
+  ///     Cell type
+  /// @param points
+  ///     Geometric points on each process, numbered from process 0 upwards.
+  /// @param cells
+  ///     Topological cells with global vertex indexing. The cells owned
+  ///     by this process come first, followed by the ghost cells.
+  /// @param global_cell_indices
+  ///     Global index for each cell
+  /// @param ghost_mode
+  ///     Ghost mode
+  /// @param ghost_owners
+  ///     Owning process of each ghost cell
+  /// @param shared_cells
+  ///     Map from local cell index to the other processes that hold
+  ///     the cell (for owned and ghost cells)
+  static mesh::Mesh build_from_distributed_cells(
+      const MPI_Comm& comm, mesh::CellType::Type cell_type,
+      const Eigen::Ref<const EigenRowArrayXXd> points,
+      const Eigen::Ref<const EigenRowArrayXXi64> cells,
+      const std::vector<std::int64_t>& global_cell_indices,
+      const mesh::GhostMode ghost_mode,
+      const std::vector<std::int32_t>& ghost_owners,
+      const std::map<std::int32_t, std::set<std::int32_t>>& shared_cells);
 
   /// Redistribute points to the processes that need them.
   /// @param mpi_comm
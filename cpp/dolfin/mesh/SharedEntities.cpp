@@ -0,0 +1,94 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "SharedEntities.h"
+#include <cassert>
+
+using namespace dolfin;
+using namespace dolfin::mesh;
+
+//-----------------------------------------------------------------------------
+SharedEntities::SharedEntities(
+    const std::map<std::int32_t, std::set<std::int32_t>>& shared_entities)
+    : _offsets(1, 0)
+{
+  _entities.reserve(shared_entities.size());
+  _offsets.reserve(shared_entities.size() + 1);
+  for (const auto& e : shared_entities)
+  {
+    _entities.push_back(e.first);
+    _processes.insert(_processes.end(), e.second.begin(), e.second.end());
+    _offsets.push_back(_processes.size());
+  }
+}
+//-----------------------------------------------------------------------------
+SharedEntities::SharedEntities(std::vector<std::int32_t> entities,
+                               std::vector<std::int32_t> offsets,
+                               std::vector<std::int32_t> processes)
+    : _entities(std::move(entities)), _offsets(std::move(offsets)),
+      _processes(std::move(processes))
+{
+  assert(_offsets.size() == _entities.size() + 1);
+  assert(std::is_sorted(_entities.begin(), _entities.end()));
+  assert(_offsets.back() == (std::int32_t)_processes.size());
+}
+//-----------------------------------------------------------------------------
+SharedEntities SharedEntities::create(
+    std::vector<std::pair<std::int32_t, std::int32_t>> entity_processes)
+{
+  std::sort(entity_processes.begin(), entity_processes.end());
+  entity_processes.erase(
+      std::unique(entity_processes.begin(), entity_processes.end()),
+      entity_processes.end());
+
+  std::vector<std::int32_t> entities, offsets(1, 0), processes;
+  processes.reserve(entity_processes.size());
+  for (const auto& ep : entity_processes)
+  {
+    if (entities.empty() or entities.back() != ep.first)
+    {
+      if (!entities.empty())
+        offsets.push_back(processes.size());
+      entities.push_back(ep.first);
+    }
+    processes.push_back(ep.second);
+  }
+  if (!entities.empty())
+    offsets.push_back(processes.size());
+
+  return SharedEntities(std::move(entities), std::move(offsets),
+                        std::move(processes));
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+SharedEntities::sharing_processes(std::int32_t entity) const
+{
+  const std::int32_t i = find(entity);
+  if (i == -1)
+    return std::vector<std::int32_t>();
+  return std::vector<std::int32_t>(processes(i),
+                                   processes(i) + num_processes(i));
+}
+//-----------------------------------------------------------------------------
+std::map<std::int32_t, std::set<std::int32_t>> SharedEntities::to_map() const
+{
+  std::map<std::int32_t, std::set<std::int32_t>> shared_entities;
+  for (std::int32_t i = 0; i < size(); ++i)
+  {
+    shared_entities.insert(
+        shared_entities.end(),
+        {_entities[i], std::set<std::int32_t>(
+                           processes(i), processes(i) + num_processes(i))});
+  }
+  return shared_entities;
+}
+//-----------------------------------------------------------------------------
+std::size_t SharedEntities::memory_usage() const
+{
+  return sizeof(std::int32_t)
+         * (_entities.size() + _offsets.size() + _processes.size());
+}
+//-----------------------------------------------------------------------------
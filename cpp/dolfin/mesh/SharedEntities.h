@@ -0,0 +1,127 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace dolfin
+{
+namespace mesh
+{
+
+/// This class stores the processes that share the shared entities of
+/// one topological dimension. The local indices of the shared entities
+/// are stored in a sorted array, and the sharing processes of the
+/// entities as a compressed sparse row (CSR) adjacency list, with the
+/// processes of each entity sorted. Entities that are not shared do
+/// not appear.
+
+class SharedEntities
+{
+public:
+  /// Create empty (no shared entities)
+  SharedEntities() : _offsets(1, 0) {}
+
+  /// Create from map from local entity index to sharing processes
+  explicit SharedEntities(
+      const std::map<std::int32_t, std::set<std::int32_t>>& shared_entities);
+
+  /// Create from sorted local indices of shared entities, offsets
+  /// into processes for each entity, and the sharing processes
+  /// (sorted for each entity)
+  SharedEntities(std::vector<std::int32_t> entities,
+                 std::vector<std::int32_t> offsets,
+                 std::vector<std::int32_t> processes);
+
+  /// Create from (local entity index, sharing process) pairs, in any
+  /// order and possibly with duplicates
+  static SharedEntities
+  create(std::vector<std::pair<std::int32_t, std::int32_t>> entity_processes);
+
+  /// Copy constructor
+  SharedEntities(const SharedEntities& shared_entities) = default;
+
+  /// Move constructor
+  SharedEntities(SharedEntities&& shared_entities) = default;
+
+  /// Destructor
+  ~SharedEntities() = default;
+
+  /// Assignment
+  SharedEntities& operator=(const SharedEntities& shared_entities) = default;
+
+  /// Move assignment
+  SharedEntities& operator=(SharedEntities&& shared_entities) = default;
+
+  /// Number of shared entities
+  std::int32_t size() const { return _entities.size(); }
+
+  /// Return true if there are no shared entities
+  bool empty() const { return _entities.empty(); }
+
+  /// Sorted local indices of the shared entities
+  const std::vector<std::int32_t>& entities() const { return _entities; }
+
+  /// Position of the sharing processes of each shared entity in
+  /// processes() (size is size() + 1)
+  const std::vector<std::int32_t>& offsets() const { return _offsets; }
+
+  /// Sharing processes of all shared entities
+  const std::vector<std::int32_t>& processes() const { return _processes; }
+
+  /// Return position of entity (local index) in entities(), or -1 if
+  /// the entity is not shared
+  std::int32_t find(std::int32_t entity) const
+  {
+    auto it = std::lower_bound(_entities.begin(), _entities.end(), entity);
+    return (it != _entities.end() and *it == entity) ? it - _entities.begin()
+                                                     : -1;
+  }
+
+  /// Return true if entity (local index) is shared
+  bool contains(std::int32_t entity) const { return find(entity) != -1; }
+
+  /// Number of sharing processes of shared entity at position i
+  std::int32_t num_processes(std::int32_t i) const
+  {
+    return _offsets[i + 1] - _offsets[i];
+  }
+
+  /// Sharing processes of shared entity at position i
+  const std::int32_t* processes(std::int32_t i) const
+  {
+    return _processes.data() + _offsets[i];
+  }
+
+  /// Sharing processes of entity (local index), empty if the entity
+  /// is not shared
+  std::vector<std::int32_t> sharing_processes(std::int32_t entity) const;
+
+  /// Return map from local entity index to sharing processes
+  std::map<std::int32_t, std::set<std::int32_t>> to_map() const;
+
+  /// Return memory used (bytes)
+  std::size_t memory_usage() const;
+
+private:
+  // Sorted local indices of shared entities
+  std::vector<std::int32_t> _entities;
+
+  // Position of sharing processes of each shared entity
+  std::vector<std::int32_t> _offsets;
+
+  // Sharing processes
+  std::vector<std::int32_t> _processes;
+};
+} // namespace mesh
+} // namespace dolfin
@@ -6,6 +6,7 @@
 
 #include "Topology.h"
 #include "Connectivity.h"
+#include <dolfin/common/memory.h>
 #include <dolfin/common/utils.h>
 #include <numeric>
 #include <sstream>
@@ -19,7 +20,8 @@ Topology::Topology(std::size_t dim, std::int32_t num_vertices,
     : _num_vertices(num_vertices), _ghost_offset_index(dim + 1, 0),
       _global_num_entities(dim + 1, -1), _global_indices(dim + 1),
       _connectivity(dim + 1,
-                    std::vector<std::shared_ptr<Connectivity>>(dim + 1))
+                    std::vector<std::shared_ptr<Connectivity>>(dim + 1)),
+      _num_leases(dim + 1, std::vector<std::int32_t>(dim + 1, 0))
 {
   assert(!_global_num_entities.empty());
   _global_num_entities[0] = num_vertices_global;
@@ -41,7 +43,7 @@ std::int32_t Topology::size(int dim) const
                              + " have not been created.");
   }
 
-  return c->entity_positions().rows() - 1;
+  return c->num_entities();
 }
 //-----------------------------------------------------------------------------
 std::int64_t Topology::size_global(int dim) const
@@ -71,6 +73,7 @@ void Topology::clear(int d0, int d1)
   assert(d0 < (int)_connectivity.size());
   assert(d1 < (int)_connectivity[d0].size());
   _connectivity[d0][d1].reset();
+  _num_leases[d0][d1] = 0;
 }
 //-----------------------------------------------------------------------------
 void Topology::set_num_entities_global(int dim, std::int64_t global_size)
@@ -118,8 +121,7 @@ bool Topology::have_shared_entities(int dim) const
   return (_shared_entities.find(dim) != _shared_entities.end());
 }
 //-----------------------------------------------------------------------------
-std::map<std::int32_t, std::set<std::int32_t>>&
-Topology::shared_entities(int dim)
+SharedEntities& Topology::shared_entities(int dim)
 {
   assert(dim <= this->dim());
   return _shared_entities[dim];
@@ -132,6 +134,16 @@ const std::vector<std::int32_t>& Topology::cell_owner() const
   return _cell_owner;
 }
 //-----------------------------------------------------------------------------
+std::vector<std::int32_t>& Topology::ghost_layer_offsets()
+{
+  return _ghost_layer_offsets;
+}
+//-----------------------------------------------------------------------------
+const std::vector<std::int32_t>& Topology::ghost_layer_offsets() const
+{
+  return _ghost_layer_offsets;
+}
+//-----------------------------------------------------------------------------
 std::shared_ptr<Connectivity> Topology::connectivity(std::size_t d0,
                                                      std::size_t d1)
 {
@@ -148,16 +160,29 @@ std::shared_ptr<const Connectivity> Topology::connectivity(std::size_t d0,
   return _connectivity[d0][d1];
 }
 //-----------------------------------------------------------------------------
+ConnectivityView Topology::connectivity_view(std::size_t d0,
+                                             std::size_t d1) const
+{
+  assert(d0 < _connectivity.size());
+  assert(d1 < _connectivity[d0].size());
+  if (!_connectivity[d0][d1])
+  {
+    throw std::runtime_error("Connectivity " + std::to_string(d0) + "-"
+                             + std::to_string(d1) + " has not been computed.");
+  }
+  return ConnectivityView(*_connectivity[d0][d1]);
+}
+//-----------------------------------------------------------------------------
 void Topology::set_connectivity(std::shared_ptr<Connectivity> c, std::size_t d0,
                                 std::size_t d1)
 {
   assert(d0 < _connectivity.size());
   assert(d1 < _connectivity[d0].size());
   _connectivity[d0][d1] = c;
+  _num_leases[d0][d1] = 0;
 }
 //-----------------------------------------------------------------------------
-const std::map<std::int32_t, std::set<std::int32_t>>&
-Topology::shared_entities(int dim) const
+const SharedEntities& Topology::shared_entities(int dim) const
 {
   auto e = _shared_entities.find(dim);
   if (e == _shared_entities.end())
@@ -169,6 +194,42 @@ Topology::shared_entities(int dim) const
   return e->second;
 }
 //-----------------------------------------------------------------------------
+void Topology::lease_connectivity(std::size_t d0, std::size_t d1)
+{
+  assert(d0 < _connectivity.size());
+  assert(d1 < _connectivity[d0].size());
+  assert(_connectivity[d0][d1]);
+  ++_num_leases[d0][d1];
+}
+//-----------------------------------------------------------------------------
+void Topology::release_connectivity(std::size_t d0, std::size_t d1)
+{
+  assert(d0 < _connectivity.size());
+  assert(d1 < _connectivity[d0].size());
+
+  // Nothing to do if the connectivity has been pinned
+  if (_num_leases[d0][d1] == 0)
+    return;
+
+  if (--_num_leases[d0][d1] == 0)
+    _connectivity[d0][d1].reset();
+}
+//-----------------------------------------------------------------------------
+void Topology::pin_connectivity(std::size_t d0, std::size_t d1)
+{
+  assert(d0 < _connectivity.size());
+  assert(d1 < _connectivity[d0].size());
+  _num_leases[d0][d1] = 0;
+}
+//-----------------------------------------------------------------------------
+std::int32_t Topology::num_connectivity_leases(std::size_t d0,
+                                               std::size_t d1) const
+{
+  assert(d0 < _connectivity.size());
+  assert(d1 < _connectivity[d0].size());
+  return _num_leases[d0][d1];
+}
+//-----------------------------------------------------------------------------
 size_t Topology::hash() const
 {
   if (!this->connectivity(dim(), 0))
@@ -176,6 +237,42 @@ size_t Topology::hash() const
   return this->connectivity(dim(), 0)->hash();
 }
 //-----------------------------------------------------------------------------
+std::map<std::string, std::size_t> Topology::memory_usage() const
+{
+  std::map<std::string, std::size_t> usage;
+  for (std::size_t d0 = 0; d0 < _connectivity.size(); ++d0)
+  {
+    for (std::size_t d1 = 0; d1 < _connectivity[d0].size(); ++d1)
+    {
+      if (_connectivity[d0][d1])
+      {
+        usage["connectivity " + std::to_string(d0) + "-" + std::to_string(d1)]
+            = _connectivity[d0][d1]->memory_usage();
+      }
+    }
+  }
+
+  for (std::size_t d = 0; d < _global_indices.size(); ++d)
+  {
+    if (!_global_indices[d].empty())
+    {
+      usage["global indices " + std::to_string(d)]
+          = common::heap_memory(_global_indices[d]);
+    }
+  }
+
+  for (auto& shared : _shared_entities)
+  {
+    usage["shared entities " + std::to_string(shared.first)]
+        = shared.second.memory_usage();
+  }
+
+  usage["cell owner"] = common::heap_memory(_cell_owner);
+  usage["ghost layer offsets"] = common::heap_memory(_ghost_layer_offsets);
+
+  return usage;
+}
+//-----------------------------------------------------------------------------
 std::string Topology::str(bool verbose) const
 {
   const std::size_t _dim = _connectivity.size() - 1;
@@ -6,10 +6,11 @@
 
 #pragma once
 
+#include "SharedEntities.h"
 #include <cstdint>
 #include <map>
 #include <memory>
-#include <set>
+#include <string>
 #include <vector>
 
 namespace dolfin
@@ -18,6 +19,7 @@ namespace mesh
 {
 
 class Connectivity;
+class ConnectivityView;
 
 /// Topology stores the topology of a mesh, consisting of mesh
 /// entities and connectivity (incidence relations for the mesh
@@ -90,14 +92,13 @@ public:
   /// dimension dim
   bool have_shared_entities(int dim) const;
 
-  /// Return map from shared entities (local index) to processes
-  /// that share the entity
-  std::map<std::int32_t, std::set<std::int32_t>>& shared_entities(int dim);
+  /// Return shared entities (local index) of dimension dim and the
+  /// processes that share each entity
+  SharedEntities& shared_entities(int dim);
 
-  /// Return map from shared entities (local index) to process that
-  /// share the entity (const version)
-  const std::map<std::int32_t, std::set<std::int32_t>>&
-  shared_entities(int dim) const;
+  /// Return shared entities (local index) of dimension dim and the
+  /// processes that share each entity (const version)
+  const SharedEntities& shared_entities(int dim) const;
 
   /// Return mapping from local ghost cell index to owning process Since
   /// ghost cells are at the end of the range, this is just a vector
@@ -109,6 +110,16 @@ public:
   /// this is just a vector over those cells
   const std::vector<std::int32_t>& cell_owner() const;
 
+  /// Return offsets of the layers of ghost cells. Ghost cells are
+  /// ordered by their distance from the owned cells, and the cells
+  /// [offsets[i], offsets[i + 1]) are in ghost layer i + 1, so that
+  /// offsets[0] is the ghost offset for cells. Empty if the ghost
+  /// layers are not known.
+  std::vector<std::int32_t>& ghost_layer_offsets();
+
+  /// Return offsets of the layers of ghost cells (const version)
+  const std::vector<std::int32_t>& ghost_layer_offsets() const;
+
   /// Return connectivity for given pair of topological dimensions
   std::shared_ptr<Connectivity> connectivity(std::size_t d0, std::size_t d1);
 
@@ -116,13 +127,40 @@ public:
   std::shared_ptr<const Connectivity> connectivity(std::size_t d0,
                                                    std::size_t d1) const;
 
+  /// Return lightweight view of the connectivity for given pair of
+  /// topological dimensions, for use in loops over entities. Throws if
+  /// the connectivity has not been computed.
+  ConnectivityView connectivity_view(std::size_t d0, std::size_t d1) const;
+
   /// Set connectivity for given pair of topological dimensions
   void set_connectivity(std::shared_ptr<Connectivity> c, std::size_t d0,
                         std::size_t d1);
 
+  /// Register a ConnectivityLease on the connectivity for given pair
+  /// of topological dimensions
+  void lease_connectivity(std::size_t d0, std::size_t d1);
+
+  /// Release a ConnectivityLease on the connectivity for given pair of
+  /// topological dimensions. The connectivity is cleared when the last
+  /// lease is released.
+  void release_connectivity(std::size_t d0, std::size_t d1);
+
+  /// Keep the connectivity for given pair of topological dimensions
+  /// when the leases on it are released
+  void pin_connectivity(std::size_t d0, std::size_t d1);
+
+  /// Return number of ConnectivityLeases on the connectivity for given
+  /// pair of topological dimensions. Connectivities with no leases are
+  /// kept for the lifetime of the topology (or until cleared).
+  std::int32_t num_connectivity_leases(std::size_t d0, std::size_t d1) const;
+
   /// Return hash based on the hash of cell-vertex connectivity
   size_t hash() const;
 
+  /// Return memory (bytes) used by the connectivities, global indices,
+  /// shared entities and cell owners
+  std::map<std::string, std::size_t> memory_usage() const;
+
   /// Return informal string representation (pretty-print)
   std::string str(bool verbose) const;
 
@@ -140,11 +178,9 @@ private:
   // Global indices for mesh entities (empty if not set)
   std::vector<std::vector<std::int64_t>> _global_indices;
 
-  // TODO: Could IndexMap be used here in place of std::map?
-  // For entities of a given dimension d, maps each shared entity
-  // (local index) to a list of the processes sharing the vertex
-  std::map<std::int32_t, std::map<std::int32_t, std::set<std::int32_t>>>
-      _shared_entities;
+  // For entities of a given dimension d, the shared entities (local
+  // index) and the processes sharing each entity
+  std::map<std::int32_t, SharedEntities> _shared_entities;
 
   // TODO: Could IndexMap be used here
   // For cells which are "ghosted", locate the owning process, using a
@@ -152,8 +188,15 @@ private:
   // of the range.
   std::vector<std::int32_t> _cell_owner;
 
+  // Offsets of the layers of ghost cells
+  std::vector<std::int32_t> _ghost_layer_offsets;
+
   // Connectivity for pairs of topological dimensions
   std::vector<std::vector<std::shared_ptr<Connectivity>>> _connectivity;
+
+  // Number of ConnectivityLeases on each connectivity (zero for
+  // resident connectivities)
+  std::vector<std::vector<std::int32_t>> _num_leases;
 }; // namespace mesh
 } // namespace mesh
 } // namespace dolfin
@@ -13,9 +13,11 @@
 #include "Topology.h"
 #include <Eigen/Dense>
 #include <algorithm>
-#include <boost/unordered_map.hpp>
 #include <cstdint>
+#include <dolfin/common/ArrayHashMap.h>
 #include <dolfin/common/Timer.h>
+#include <dolfin/common/memory.h>
+#include <dolfin/common/sort.h>
 #include <dolfin/common/utils.h>
 
 #include <dolfin/common/log.h>
@@ -32,17 +34,137 @@ using namespace dolfin::mesh;
 namespace
 {
 
-// cell-to-entity (tdim, dim). Ths functions builds a list of all
-// entities of Compute mesh entities of given topological dimension, and
-// connectivity dimension dim for every cell, keyed by the sorted lists
-// of vertex indices that make up the entity. Also attached is whether
-// or nor the entity is a ghost, the local entity index (relative to the
-// generating cell) and the generating cell index. This list is then
-// sorted, with matching keys corresponding to a single entity. The
-// entities are numbered such that ghost entities come after al regular
-// entities.
+// Number the entities of dimension dim, given for every cell (row) the
+// key (sorted vertex indices) of each of its entities packed into W
+// unsigned words. Keys are sorted with a radix sort and matching keys
+// correspond to a single entity. The entities are numbered in key
+// order, with ghost entities (entities that appear only in ghost cells)
+// after all regular entities. The entity-vertex connectivity is taken
+// from the first non-ghost cell (highest local index, then lowest cell
+// index) containing the entity, or from the first ghost cell (lowest
+// local index, then lowest cell index) for ghost entities.
 //
-// Returns the number of entities
+// Returns the number of non-ghost entities
+template <int N, int W>
+std::tuple<std::shared_ptr<Connectivity>, std::shared_ptr<Connectivity>,
+           std::int32_t>
+number_entities_by_key(
+    const Topology& topology, int num_entities,
+    const Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& e_vertices,
+    std::vector<std::array<std::uint64_t, W>>& keys)
+{
+  const int tdim = topology.dim();
+  const std::int32_t num_cells = topology.size(tdim);
+  const std::int32_t ghost_offset = topology.ghost_offset(tdim);
+  const Connectivity& cell_vertices = *topology.connectivity(tdim, 0);
+
+  // Sort keys. Index k in the sorted list refers to entity k %
+  // num_entities of cell k / num_entities.
+  const std::vector<std::int32_t> perm = common::radix_argsort(keys);
+  common::ScopedMemory perm_memory(common::heap_memory(perm));
+
+  // Rank used to pick the entity from which the entity-vertex
+  // connectivity is taken within a group of matching keys. Non-ghost
+  // cells have negative rank (ordered by descending local index), ghost
+  // cells have non-negative rank (ordered by ascending local index).
+  auto rank = [num_entities, ghost_offset](std::int32_t k) {
+    const std::int32_t cell = k / num_entities;
+    const std::int32_t i = k % num_entities;
+    return std::make_pair(cell < ghost_offset ? -i - 1 : i, cell);
+  };
+
+  // Compute entity indices (using -1, -2, -3, etc, for ghost entities)
+  // and the representative for each entity
+  std::vector<std::int32_t> entity_index(perm.size());
+  std::vector<std::int32_t> representative;
+  representative.reserve(perm.size() / 2);
+  std::int32_t nonghost_index(0), ghost_index(-1);
+  std::vector<std::int32_t> ghost_representative;
+  for (std::size_t p0 = 0; p0 < perm.size();)
+  {
+    // Find range [p0, p1) of matching keys, and its representative
+    std::size_t p1 = p0 + 1;
+    std::int32_t k_min = perm[p0];
+    auto rank_min = rank(k_min);
+    while (p1 < perm.size() and keys[p1] == keys[p0])
+    {
+      const auto r = rank(perm[p1]);
+      if (r < rank_min)
+      {
+        rank_min = r;
+        k_min = perm[p1];
+      }
+      ++p1;
+    }
+
+    // New entity, so give index (negative for ghosts)
+    std::int32_t index;
+    if (rank_min.first < 0)
+    {
+      index = nonghost_index++;
+      representative.push_back(k_min);
+    }
+    else
+    {
+      index = ghost_index--;
+      ghost_representative.push_back(k_min);
+    }
+    for (std::size_t p = p0; p < p1; ++p)
+      entity_index[perm[p]] = index;
+
+    p0 = p1;
+  }
+
+  // Total number of entities
+  const std::int32_t num_nonghost_entities = nonghost_index;
+  representative.insert(representative.end(), ghost_representative.begin(),
+                        ghost_representative.end());
+  const std::int32_t num_mesh_entities = representative.size();
+  common::ScopedMemory index_memory(
+      common::heap_memory(entity_index) + common::heap_memory(representative)
+      + common::heap_memory(ghost_representative));
+
+  // List of entity e indices connected to cell, remapping ghosts
+  // (negative entity index) to true index
+  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      connectivity_ce(num_cells, num_entities);
+  for (std::size_t k = 0; k < entity_index.size(); ++k)
+  {
+    const std::int32_t e_index = entity_index[k];
+    connectivity_ce.data()[k]
+        = e_index < 0 ? num_nonghost_entities - (e_index + 1) : e_index;
+  }
+
+  // List of vertex indices connected to entity e
+  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      connectivity_ev(num_mesh_entities, N);
+  for (std::int32_t e = 0; e < num_mesh_entities; ++e)
+  {
+    const std::int32_t k = representative[e];
+    const std::int32_t* vertices = cell_vertices.connections(k / num_entities);
+    const std::int32_t i = k % num_entities;
+    for (int j = 0; j < N; ++j)
+      connectivity_ev(e, j) = vertices[e_vertices(i, j)];
+  }
+
+  // FIXME: move this out some Mesh can be const
+
+  // Set cell-entity connectivity
+  common::ScopedMemory array_memory(common::heap_memory(connectivity_ce)
+                                    + common::heap_memory(connectivity_ev));
+  auto ce = std::make_shared<Connectivity>(connectivity_ce);
+  auto ev = std::make_shared<Connectivity>(connectivity_ev);
+  common::MemoryTracker::allocate(ce->memory_usage() + ev->memory_usage());
+
+  return {ce, ev, num_nonghost_entities};
+}
+//-----------------------------------------------------------------------------
+// Compute mesh entities of given topological dimension, and
+// cell-to-entity (tdim, dim) connectivity. Every entity of every cell
+// is keyed by its sorted vertex indices, packed into one 64-bit word
+// when the vertex indices are small enough and into two words
+// otherwise, and the keys are numbered by number_entities_by_key.
 //
 // The function is templated over the number of vertices that make up an
 // entity of dimension dim. This avoid dynamic memory allocations,
@@ -74,6 +196,8 @@ compute_entities_by_key_matching(const Mesh& mesh, int dim)
 
   // Start timer
   common::Timer timer("Compute entities of dim = " + std::to_string(dim));
+  common::MemoryTracker tracker("Compute entities of dim = "
+                                + std::to_string(dim));
 
   // Get cell type
   const CellType& cell_type = mesh.type();
@@ -92,130 +216,57 @@ compute_entities_by_key_matching(const Mesh& mesh, int dim)
 
   assert(N == num_vertices);
 
-  // Create data structure to hold entities ([vertices key],
-  // (cell_local_index, cell index), [entity vertices], entity index)
-  std::vector<std::tuple<std::array<std::int32_t, N>,
-                         std::pair<std::int8_t, std::int32_t>,
-                         std::array<std::int32_t, N>, std::int32_t>>
-      keyed_entities(num_entities * mesh.num_entities(tdim));
-
-  // Loop over cells to build list of keyed (by vertices) entities
-  int entity_counter = 0;
-  for (auto& c : MeshRange<Cell>(mesh, MeshRangeType::ALL))
-  {
-    // Get vertices from cell
-    const std::int32_t* vertices = c.entities(0);
-    assert(vertices);
-
-    // Iterate over entities of cell
-    const int cell_index = c.index();
-    for (std::int8_t i = 0; i < num_entities; ++i)
+  // Number of bits required to store a vertex index, and number of
+  // vertex indices packed in each word of a key
+  int bits = 1;
+  while ((std::int64_t(1) << bits) < topology.size(0))
+    ++bits;
+  const int W = (N * bits <= 64) ? 1 : 2;
+  const int n_per_word = (N + W - 1) / W;
+
+  // Build keys (sorted entity vertices) for every entity of every cell
+  const std::int32_t num_cells = mesh.num_entities(tdim);
+  const Connectivity& cell_vertices = *topology.connectivity(tdim, 0);
+  auto create_keys = [&](auto& keys) {
+    keys.resize(num_entities * num_cells);
+    std::array<std::int32_t, N> entity;
+    for (std::int32_t c = 0; c < num_cells; ++c)
     {
-      // Get entity vertices
-      auto& entity = std::get<2>(keyed_entities[entity_counter]);
-      for (std::int8_t j = 0; j < num_vertices; ++j)
-        entity[j] = vertices[e_vertices(i, j)];
-
-      // Sort entity vertices to create key
-      auto& entity_key = std::get<0>(keyed_entities[entity_counter]);
-      std::partial_sort_copy(entity.begin(), entity.end(), entity_key.begin(),
-                             entity_key.end());
-
-      // Attach (local index, cell index), making local_index negative
-      // if it is not a ghost cell. This ensures that non-ghosts come
-      // before ghosts when sorted. The index is corrected later.
-      if (!c.is_ghost())
-        std::get<1>(keyed_entities[entity_counter]) = {-i - 1, cell_index};
-      else
-        std::get<1>(keyed_entities[entity_counter]) = {i, cell_index};
-
-      // Increment entity counter
-      ++entity_counter;
+      const std::int32_t* vertices = cell_vertices.connections(c);
+      assert(vertices);
+      for (std::int8_t i = 0; i < num_entities; ++i)
+      {
+        for (int j = 0; j < N; ++j)
+          entity[j] = vertices[e_vertices(i, j)];
+        std::sort(entity.begin(), entity.end());
+
+        auto& key = keys[c * num_entities + i];
+        std::fill(key.begin(), key.end(), 0);
+        for (int j = 0; j < N; ++j)
+        {
+          auto& word = key[j / n_per_word];
+          word = (word << bits) | std::uint64_t(entity[j]);
+        }
+      }
     }
-  }
-
-  // Sort entities by key. For the same key, those belonging to
-  // non-ghost cells will appear before those belonging to ghost cells.
-  std::sort(keyed_entities.begin(), keyed_entities.end());
+  };
 
-  // Compute entity indices (using -1, -2, -3, etc, for ghost entities)
-  std::int32_t nonghost_index(0), ghost_index(-1);
-  std::array<std::int32_t, N> previous_key;
-  std::fill(previous_key.begin(), previous_key.end(), -1);
-  for (auto e = keyed_entities.begin(); e != keyed_entities.end(); ++e)
+  if (W == 1)
   {
-    const auto& key = std::get<0>(*e);
-    if (key == previous_key)
-    {
-      // Repeated entity, reuse entity index
-      std::get<3>(*e) = std::get<3>(*(e - 1));
-    }
-    else
-    {
-      // New entity, so give index (negative for ghosts)
-      const auto local_index = std::get<1>(*e).first;
-      if (local_index < 0)
-        std::get<3>(*e) = nonghost_index++;
-      else
-        std::get<3>(*e) = ghost_index--;
-
-      // Update key
-      previous_key = key;
-    }
-
-    // Re-map local index (make all positive)
-    auto& local_index = std::get<1>(*e).first;
-    local_index = (local_index < 0) ? (-local_index - 1) : local_index;
+    std::vector<std::array<std::uint64_t, 1>> keys;
+    create_keys(keys);
+    common::ScopedMemory keys_memory(common::heap_memory(keys));
+    return number_entities_by_key<N, 1>(topology, num_entities, e_vertices,
+                                        keys);
   }
-
-  // Total number of entities
-  const std::int32_t num_nonghost_entities = nonghost_index;
-  const std::int32_t num_ghost_entities = -(ghost_index + 1);
-  const std::int32_t num_mesh_entities
-      = num_nonghost_entities + num_ghost_entities;
-
-  // List of vertex indices connected to entity e
-  std::vector<std::array<int, N>> connectivity_ev(num_mesh_entities);
-
-  // List of entity e indices connected to cell
-  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      connectivity_ce(mesh.num_entities(tdim), num_entities);
-
-  // Build connectivity arrays (with ghost entities at the end)
-  // std::int32_t previous_index = -1;
-  std::int32_t previous_index = std::numeric_limits<std::int32_t>::min();
-  for (auto& entity : keyed_entities)
+  else
   {
-    // Get entity index, and remap for ghosts (negative entity index) to
-    // true index
-    auto& e_index = std::get<3>(entity);
-    if (e_index < 0)
-      e_index = num_nonghost_entities - (e_index + 1);
-
-    // Add to enity-to-vertex map if entity is new
-    if (e_index != previous_index)
-    {
-      assert(e_index < (std::int32_t)connectivity_ev.size());
-      connectivity_ev[e_index] = std::get<2>(entity);
-
-      // Update index
-      previous_index = e_index;
-    }
-
-    // Add to cell-to-entity map
-    const auto& cell = std::get<1>(entity);
-    const auto local_index = cell.first;
-    const auto cell_index = cell.second;
-    connectivity_ce(cell_index, local_index) = e_index;
+    std::vector<std::array<std::uint64_t, 2>> keys;
+    create_keys(keys);
+    common::ScopedMemory keys_memory(common::heap_memory(keys));
+    return number_entities_by_key<N, 2>(topology, num_entities, e_vertices,
+                                        keys);
   }
-
-  // FIXME: move this out some Mesh can be const
-
-  // Set cell-entity connectivity
-  auto ce = std::make_shared<Connectivity>(connectivity_ce);
-  auto ev = std::make_shared<Connectivity>(connectivity_ev);
-
-  return {ce, ev, num_nonghost_entities};
 }
 //-----------------------------------------------------------------------------
 // Compute connectivity from transpose
@@ -254,6 +305,9 @@ Connectivity compute_from_transpose(const Mesh& mesh, int d0, int d1)
 
   std::vector<std::int32_t> counter(num_connections.size(), 0);
   std::vector<std::int32_t> connections(offsets.back());
+  common::ScopedMemory work_memory(
+      common::heap_memory(num_connections) + common::heap_memory(offsets)
+      + common::heap_memory(counter) + common::heap_memory(connections));
   for (auto& e1 : MeshRange<MeshEntity>(mesh, d1, MeshRangeType::ALL))
     for (auto& e0 : EntityRange<MeshEntity>(e1, d0))
       connections[offsets[e0.index()] + counter[e0.index()]++] = e1.index();
@@ -262,54 +316,91 @@ Connectivity compute_from_transpose(const Mesh& mesh, int d0, int d1)
 }
 //-----------------------------------------------------------------------------
 // Direct lookup of entity from vertices in a map
-Connectivity compute_from_map(const Mesh& mesh, int d0, int d1)
+template <std::size_t N>
+Connectivity compute_from_map_by_key(const Mesh& mesh, int d0, int d1)
 {
-  assert(d1 > 0);
-  assert(d0 > d1);
-
-  // Get the type of entity d0
-  std::unique_ptr<CellType> cell_type(
-      CellType::create(mesh.type().entity_type(d0)));
-
-  // Make a map from the sorted d1 entity vertices to the d1 entity index
-  boost::unordered_map<std::vector<std::int32_t>, std::int32_t> entity_to_index;
-  entity_to_index.reserve(mesh.num_entities(d1));
-
-  const std::size_t num_verts_d1 = mesh.type().num_vertices(d1);
-  std::vector<std::int32_t> key(num_verts_d1);
-  for (auto& e : MeshRange<MeshEntity>(mesh, d1, MeshRangeType::ALL))
+  const Topology& topology = mesh.topology();
+  const Connectivity& c_d1_0 = *topology.connectivity(d1, 0);
+  const Connectivity& c_d0_0 = *topology.connectivity(d0, 0);
+
+  // Sorted vertices of each d1 entity, stored as an (n x N) row-major
+  // array
+  const std::int32_t num_entities_d1 = topology.size(d1);
+  std::vector<std::int32_t> keys(num_entities_d1 * N);
+  for (std::int32_t e = 0; e < num_entities_d1; ++e)
   {
-    std::partial_sort_copy(e.entities(0), e.entities(0) + num_verts_d1,
-                           key.begin(), key.end());
-    entity_to_index.insert({key, e.index()});
+    const std::int32_t* v = c_d1_0.connections(e);
+    std::partial_sort_copy(v, v + N, keys.data() + e * N,
+                           keys.data() + (e + 1) * N);
   }
 
-  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      connections(mesh.num_entities(d0), cell_type->num_entities(d1));
+  // Make a map from the sorted d1 entity vertices to the d1 entity index
+  std::vector<std::int32_t> indices(num_entities_d1);
+  std::iota(indices.begin(), indices.end(), 0);
+  common::ArrayHashMap<N> entity_to_index(num_entities_d1);
+  entity_to_index.insert(keys.data(), indices.data(), num_entities_d1);
 
-  // Search for d1 entities of d0 in map, and recover index
-  std::vector<std::int32_t> entities;
+  // Local vertices (relative to d0 entity) of each d1 entity of a d0
+  // entity
+  std::unique_ptr<CellType> cell_type(
+      CellType::create(mesh.type().entity_type(d0)));
+  const int num_vertices_d0 = cell_type->num_vertices();
+  std::vector<std::int32_t> local_vertices(num_vertices_d0);
+  std::iota(local_vertices.begin(), local_vertices.end(), 0);
   Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      keys;
-  for (auto& e : MeshRange<MeshEntity>(mesh, d0, MeshRangeType::ALL))
+      local_entities;
+  cell_type->create_entities(local_entities, d1, local_vertices.data());
+  assert(local_entities.cols() == (Eigen::Index)N);
+  const Eigen::Index num_entities_per_d0 = local_entities.rows();
+
+  // Sorted vertices of each d1 entity of each d0 entity
+  const std::int32_t num_entities_d0 = topology.size(d0);
+  keys.resize(num_entities_d0 * num_entities_per_d0 * N);
+  std::int32_t* key = keys.data();
+  for (std::int32_t e = 0; e < num_entities_d0; ++e)
   {
-    entities.clear();
-    cell_type->create_entities(keys, d1, e.entities(0));
-    for (Eigen::Index i = 0; i < keys.rows(); ++i)
+    const std::int32_t* v = c_d0_0.connections(e);
+    for (Eigen::Index i = 0; i < num_entities_per_d0; ++i)
     {
-      std::partial_sort_copy(keys.row(i).data(),
-                             keys.row(i).data() + keys.row(i).cols(),
-                             key.begin(), key.end());
-      const auto it = entity_to_index.find(key);
-      assert(it != entity_to_index.end());
-      entities.push_back(it->second);
+      for (std::size_t j = 0; j < N; ++j)
+        key[j] = v[local_entities(i, j)];
+      std::sort(key, key + N);
+      key += N;
     }
-    for (std::size_t k = 0; k < entities.size(); ++k)
-      connections(e.index(), k) = entities[k];
   }
 
+  // Search for d1 entities of d0 in map, and recover index
+  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      connections(num_entities_d0, num_entities_per_d0);
+  common::ScopedMemory work_memory(
+      common::heap_memory(keys) + common::heap_memory(indices)
+      + entity_to_index.memory_usage() + common::heap_memory(connections));
+  entity_to_index.find(keys.data(), connections.data(), connections.size());
+  assert((connections >= 0).all());
+
   return Connectivity(connections);
 }
+//-----------------------------------------------------------------------------
+Connectivity compute_from_map(const Mesh& mesh, int d0, int d1)
+{
+  assert(d1 > 0);
+  assert(d0 > d1);
+
+  switch (mesh.type().num_vertices(d1))
+  {
+  case 2:
+    return compute_from_map_by_key<2>(mesh, d0, d1);
+  case 3:
+    return compute_from_map_by_key<3>(mesh, d0, d1);
+  case 4:
+    return compute_from_map_by_key<4>(mesh, d0, d1);
+  default:
+    throw std::runtime_error(
+        "Cannot compute connectivity from map. Entities with "
+        + std::to_string(mesh.type().num_vertices(d1))
+        + " vertices not supported.");
+  }
+}
 } // namespace
 
 //-----------------------------------------------------------------------------
@@ -410,6 +501,8 @@ void TopologyComputation::compute_connectivity(Mesh& mesh, int d0, int d1)
   // Start timer
   common::Timer timer("Compute connectivity " + std::to_string(d0) + "-"
                       + std::to_string(d1));
+  common::MemoryTracker tracker("Compute connectivity " + std::to_string(d0)
+                                + "-" + std::to_string(d1));
 
   // Decide how to compute the connectivity
   if (d0 == d1)
@@ -420,6 +513,7 @@ void TopologyComputation::compute_connectivity(Mesh& mesh, int d0, int d1)
     for (auto& e : MeshRange<MeshEntity>(mesh, d0, MeshRangeType::ALL))
       connectivity_dd[e.index()][0] = e.index();
     auto connectivity = std::make_shared<Connectivity>(connectivity_dd);
+    common::MemoryTracker::allocate(connectivity->memory_usage());
     topology.set_connectivity(connectivity, d0, d1);
   }
   else if (d0 < d1)
@@ -428,6 +522,7 @@ void TopologyComputation::compute_connectivity(Mesh& mesh, int d0, int d1)
     compute_connectivity(mesh, d1, d0);
     auto c
         = std::make_shared<Connectivity>(compute_from_transpose(mesh, d0, d1));
+    common::MemoryTracker::allocate(c->memory_usage());
     topology.set_connectivity(c, d0, d1);
   }
   else if (d0 > d1)
@@ -435,6 +530,7 @@ void TopologyComputation::compute_connectivity(Mesh& mesh, int d0, int d1)
     // Compute by mapping vertices from a lower dimension entity to
     // those of a higher dimension entity
     auto c = std::make_shared<Connectivity>(compute_from_map(mesh, d0, d1));
+    common::MemoryTracker::allocate(c->memory_usage());
     topology.set_connectivity(c, d0, d1);
   }
   else
@@ -13,7 +13,9 @@ namespace dolfin
 
 #include <dolfin/mesh/Cell.h>
 #include <dolfin/mesh/CellType.h>
+#include <dolfin/mesh/CompressedConnectivity.h>
 #include <dolfin/mesh/Connectivity.h>
+#include <dolfin/mesh/ConnectivityLease.h>
 #include <dolfin/mesh/Edge.h>
 #include <dolfin/mesh/Face.h>
 #include <dolfin/mesh/Facet.h>
@@ -24,6 +26,9 @@ namespace dolfin
 #include <dolfin/mesh/MeshIterator.h>
 #include <dolfin/mesh/MeshQuality.h>
 #include <dolfin/mesh/MeshValueCollection.h>
+#include <dolfin/mesh/MigrationPlan.h>
 #include <dolfin/mesh/Partitioning.h>
+#include <dolfin/mesh/SharedEntities.h>
 #include <dolfin/mesh/Topology.h>
+#include <dolfin/mesh/utils.h>
 #include <dolfin/mesh/Vertex.h>
@@ -0,0 +1,475 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "utils.h"
+#include "CellType.h"
+#include "Connectivity.h"
+#include "Geometry.h"
+#include "Mesh.h"
+#include "Topology.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+using namespace dolfin;
+using namespace dolfin::mesh;
+
+namespace
+{
+// Number of cells processed together. The vertex coordinates of a
+// batch are stored with the cell index running fastest, so that the
+// loops over the cells of a batch in the kernels can be vectorised by
+// the compiler.
+constexpr int batch_size = 32;
+
+// Vertex coordinates X[vertex][component][cell] of a batch of cells
+template <int num_vertices>
+using Batch = std::array<std::array<std::array<double, batch_size>, 3>,
+                         num_vertices>;
+
+// Distance between vertices i and j of cell b
+template <typename X>
+inline double distance(const X& x, int i, int j, int b)
+{
+  const double d0 = x[j][0][b] - x[i][0][b];
+  const double d1 = x[j][1][b] - x[i][1][b];
+  const double d2 = x[j][2][b] - x[i][2][b];
+  return std::sqrt(d0 * d0 + d1 * d1 + d2 * d2);
+}
+
+// Norm of the cross product of (x_j - x_i) and (x_l - x_k) for cell b
+template <typename X>
+inline double cross_norm(const X& x, int i, int j, int k, int l, int b)
+{
+  const double u0 = x[j][0][b] - x[i][0][b];
+  const double u1 = x[j][1][b] - x[i][1][b];
+  const double u2 = x[j][2][b] - x[i][2][b];
+  const double v0 = x[l][0][b] - x[k][0][b];
+  const double v1 = x[l][1][b] - x[k][1][b];
+  const double v2 = x[l][2][b] - x[k][2][b];
+  const double n0 = u1 * v2 - u2 * v1;
+  const double n1 = u2 * v0 - u0 * v2;
+  const double n2 = u0 * v1 - u1 * v0;
+  return std::sqrt(n0 * n0 + n1 * n1 + n2 * n2);
+}
+
+// Area of triangle (i, j, k) of cell b
+template <typename X>
+inline double triangle_area(const X& x, int i, int j, int k, int b)
+{
+  return 0.5 * cross_norm(x, i, j, i, k, b);
+}
+
+// Kernels for each cell type, providing the volume, circumradius and
+// sum of the facet areas of a cell in a batch. Only the volume (if
+// has_volume) is defined for non-simplex cells.
+struct IntervalKernel
+{
+  static constexpr int num_vertices = 2;
+  static constexpr bool simplex = true;
+  static constexpr bool has_volume = true;
+
+  template <typename X>
+  static double volume(const X& x, int b)
+  {
+    return distance(x, 0, 1, b);
+  }
+
+  template <typename X>
+  static double circumradius(const X& x, int b)
+  {
+    return 0.5 * volume(x, b);
+  }
+
+  template <typename X>
+  static double facet_area_sum(const X&, int)
+  {
+    return 2.0;
+  }
+};
+
+struct TriangleKernel
+{
+  static constexpr int num_vertices = 3;
+  static constexpr bool simplex = true;
+  static constexpr bool has_volume = true;
+
+  template <typename X>
+  static double volume(const X& x, int b)
+  {
+    return triangle_area(x, 0, 1, 2, b);
+  }
+
+  template <typename X>
+  static double circumradius(const X& x, int b)
+  {
+    // Formula for circumradius from
+    // http://mathworld.wolfram.com/Triangle.html
+    return distance(x, 1, 2, b) * distance(x, 0, 2, b) * distance(x, 0, 1, b)
+           / (4.0 * volume(x, b));
+  }
+
+  template <typename X>
+  static double facet_area_sum(const X& x, int b)
+  {
+    return distance(x, 1, 2, b) + distance(x, 0, 2, b) + distance(x, 0, 1, b);
+  }
+};
+
+struct TetrahedronKernel
+{
+  static constexpr int num_vertices = 4;
+  static constexpr bool simplex = true;
+  static constexpr bool has_volume = true;
+
+  template <typename X>
+  static double volume(const X& x, int b)
+  {
+    // |(x1 - x0) . ((x2 - x0) x (x3 - x0))| / 6
+    double u[3][3];
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 3; ++j)
+        u[i][j] = x[i + 1][j][b] - x[0][j][b];
+    const double det = u[0][0] * (u[1][1] * u[2][2] - u[1][2] * u[2][1])
+                       - u[0][1] * (u[1][0] * u[2][2] - u[1][2] * u[2][0])
+                       + u[0][2] * (u[1][0] * u[2][1] - u[1][1] * u[2][0]);
+    return std::abs(det) / 6.0;
+  }
+
+  template <typename X>
+  static double circumradius(const X& x, int b)
+  {
+    // Products of the lengths of opposite edges
+    const double la = distance(x, 1, 2, b) * distance(x, 0, 3, b);
+    const double lb = distance(x, 0, 2, b) * distance(x, 1, 3, b);
+    const double lc = distance(x, 0, 1, b) * distance(x, 2, 3, b);
+
+    // Formula for circumradius from
+    // http://mathworld.wolfram.com/Tetrahedron.html
+    const double s = 0.5 * (la + lb + lc);
+    const double area = std::sqrt(s * (s - la) * (s - lb) * (s - lc));
+    return area / (6.0 * volume(x, b));
+  }
+
+  template <typename X>
+  static double facet_area_sum(const X& x, int b)
+  {
+    return triangle_area(x, 1, 2, 3, b) + triangle_area(x, 0, 2, 3, b)
+           + triangle_area(x, 0, 1, 3, b) + triangle_area(x, 0, 1, 2, b);
+  }
+};
+
+struct QuadrilateralKernel
+{
+  static constexpr int num_vertices = 4;
+  static constexpr bool simplex = false;
+  static constexpr bool has_volume = true;
+
+  // Coplanarity of the vertices is not checked
+  template <typename X>
+  static double volume(const X& x, int b)
+  {
+    return 0.5 * cross_norm(x, 3, 0, 2, 1, b);
+  }
+
+  template <typename X>
+  static double circumradius(const X&, int)
+  {
+    return 0.0;
+  }
+
+  template <typename X>
+  static double facet_area_sum(const X&, int)
+  {
+    return 0.0;
+  }
+};
+
+struct HexahedronKernel
+{
+  static constexpr int num_vertices = 8;
+  static constexpr bool simplex = false;
+  static constexpr bool has_volume = false;
+
+  template <typename X>
+  static double volume(const X&, int)
+  {
+    return 0.0;
+  }
+
+  template <typename X>
+  static double circumradius(const X&, int)
+  {
+    return 0.0;
+  }
+
+  template <typename X>
+  static double facet_area_sum(const X&, int)
+  {
+    return 0.0;
+  }
+};
+//-----------------------------------------------------------------------------
+// Compute f(x, b) for all cells, gathering the vertex coordinates of
+// each batch of cells
+template <int num_vertices, typename Function>
+Eigen::ArrayXd compute_batched(const Mesh& mesh, Function f)
+{
+  const int tdim = mesh.topology().dim();
+  const ConnectivityView cell_vertices
+      = mesh.topology().connectivity_view(tdim, 0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& points
+      = mesh.geometry().points();
+
+  const std::int32_t num_cells = cell_vertices.num_entities();
+  Eigen::ArrayXd values(num_cells);
+  Batch<num_vertices> x;
+  std::array<double, batch_size> v;
+  for (std::int32_t c0 = 0; c0 < num_cells; c0 += batch_size)
+  {
+    const int n = std::min(batch_size, num_cells - c0);
+
+    // Gather coordinates. Pad the last batch with copies of its first
+    // cell.
+    for (int b = 0; b < batch_size; ++b)
+    {
+      const std::int32_t* vertices
+          = cell_vertices.connections(c0 + (b < n ? b : 0));
+      for (int i = 0; i < num_vertices; ++i)
+        for (int j = 0; j < 3; ++j)
+          x[i][j][b] = points(vertices[i], j);
+    }
+
+    for (int b = 0; b < batch_size; ++b)
+      v[b] = f(x, b);
+    std::copy(v.begin(), v.begin() + n, values.data() + c0);
+  }
+
+  return values;
+}
+//-----------------------------------------------------------------------------
+template <typename Kernel>
+Eigen::ArrayXd compute_cell_metric(const Mesh& mesh, CellMetric metric)
+{
+  constexpr int nv = Kernel::num_vertices;
+  typedef Batch<nv> X;
+  const double d = mesh.topology().dim();
+
+  if (!Kernel::simplex and metric != CellMetric::h
+      and metric != CellMetric::volume)
+  {
+    throw std::runtime_error(
+        "Cell metric not implemented for non-simplicial cells");
+  }
+
+  switch (metric)
+  {
+  case CellMetric::volume:
+    if (!Kernel::has_volume)
+      throw std::runtime_error("Cell volume not implemented for cell type");
+    return compute_batched<nv>(
+        mesh, [](const X& x, int b) { return Kernel::volume(x, b); });
+  case CellMetric::h:
+    return compute_batched<nv>(mesh, [](const X& x, int b) {
+      // Greatest distance between two vertices
+      double h = 0.0;
+      for (int i = 0; i < nv; ++i)
+        for (int j = i + 1; j < nv; ++j)
+          h = std::max(h, distance(x, i, j, b));
+      return h;
+    });
+  case CellMetric::circumradius:
+    return compute_batched<nv>(
+        mesh, [](const X& x, int b) { return Kernel::circumradius(x, b); });
+  case CellMetric::inradius:
+    return compute_batched<nv>(mesh, [d](const X& x, int b) {
+      // See Jonathan Richard Shewchuk: What Is a Good Linear Finite
+      // Element?, online:
+      // http://www.cs.berkeley.edu/~jrs/papers/elemj.pdf
+      const double V = Kernel::volume(x, b);
+      return V == 0.0 ? 0.0 : d * V / Kernel::facet_area_sum(x, b);
+    });
+  case CellMetric::radius_ratio:
+    return compute_batched<nv>(mesh, [d](const X& x, int b) {
+      const double V = Kernel::volume(x, b);
+      if (V == 0.0)
+        return 0.0;
+      const double r = d * V / Kernel::facet_area_sum(x, b);
+      return d * r / Kernel::circumradius(x, b);
+    });
+  default:
+    throw std::runtime_error("Unknown cell metric");
+  }
+}
+//-----------------------------------------------------------------------------
+// Return local vertices of each facet of the cell type, in the local
+// facet order of the cell
+Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+facet_vertices(const CellType& cell_type)
+{
+  const int tdim = cell_type.dim();
+  if (tdim == 0)
+    throw std::runtime_error("Facets not defined for point cells");
+
+  std::vector<std::int32_t> v(cell_type.num_vertices(tdim));
+  std::iota(v.begin(), v.end(), 0);
+  Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      e;
+  if (tdim == 1)
+  {
+    e.resize(2, 1);
+    e << 0, 1;
+  }
+  else
+    cell_type.create_entities(e, tdim - 1, v.data());
+
+  return e;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+//-----------------------------------------------------------------------------
+Eigen::ArrayXd mesh::cell_metric(const Mesh& mesh, CellMetric metric)
+{
+  switch (mesh.type().cell_type())
+  {
+  case CellType::Type::interval:
+    return compute_cell_metric<IntervalKernel>(mesh, metric);
+  case CellType::Type::triangle:
+    return compute_cell_metric<TriangleKernel>(mesh, metric);
+  case CellType::Type::tetrahedron:
+    return compute_cell_metric<TetrahedronKernel>(mesh, metric);
+  case CellType::Type::quadrilateral:
+    return compute_cell_metric<QuadrilateralKernel>(mesh, metric);
+  case CellType::Type::hexahedron:
+    return compute_cell_metric<HexahedronKernel>(mesh, metric);
+  default:
+    throw std::runtime_error("Cell metrics not defined for cell type");
+  }
+}
+//-----------------------------------------------------------------------------
+Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+mesh::cell_facet_areas(const Mesh& mesh)
+{
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      e = facet_vertices(mesh.type());
+  const int num_facets = e.rows();
+  const int nfv = e.cols();
+
+  const int tdim = mesh.topology().dim();
+  const ConnectivityView cell_vertices
+      = mesh.topology().connectivity_view(tdim, 0);
+  const Geometry& geometry = mesh.geometry();
+
+  const std::int32_t num_cells = cell_vertices.num_entities();
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> areas(
+      num_cells, num_facets);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    const std::int32_t* v = cell_vertices.connections(c);
+    for (int i = 0; i < num_facets; ++i)
+    {
+      switch (nfv)
+      {
+      case 1:
+        areas(c, i) = 1.0;
+        break;
+      case 2:
+        areas(c, i) = (geometry.x(v[e(i, 1)]) - geometry.x(v[e(i, 0)])).norm();
+        break;
+      case 3:
+        areas(c, i) = 0.5
+                      * (geometry.x(v[e(i, 1)]) - geometry.x(v[e(i, 0)]))
+                            .cross(geometry.x(v[e(i, 2)])
+                                   - geometry.x(v[e(i, 0)]))
+                            .norm();
+        break;
+      default:
+        // Quadrilateral (area from the diagonals)
+        areas(c, i) = 0.5
+                      * (geometry.x(v[e(i, 0)]) - geometry.x(v[e(i, 3)]))
+                            .cross(geometry.x(v[e(i, 1)])
+                                   - geometry.x(v[e(i, 2)]))
+                            .norm();
+      }
+    }
+  }
+
+  return areas;
+}
+//-----------------------------------------------------------------------------
+Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>
+mesh::cell_facet_normals(const Mesh& mesh)
+{
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      e = facet_vertices(mesh.type());
+  const int num_facets = e.rows();
+  const int nfv = e.cols();
+
+  const int tdim = mesh.topology().dim();
+  const ConnectivityView cell_vertices
+      = mesh.topology().connectivity_view(tdim, 0);
+  const Geometry& geometry = mesh.geometry();
+
+  const std::int32_t num_cells = cell_vertices.num_entities();
+  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> normals(
+      num_cells * num_facets, 3);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    const std::int32_t* v = cell_vertices.connections(c);
+    const int nv = cell_vertices.size(c);
+
+    // Cell midpoint
+    Eigen::Vector3d xc = Eigen::Vector3d::Zero();
+    for (int i = 0; i < nv; ++i)
+      xc += geometry.x(v[i]);
+    xc /= nv;
+
+    for (int i = 0; i < num_facets; ++i)
+    {
+      // Vector from cell midpoint to facet midpoint, which points out
+      // of the cell
+      Eigen::Vector3d xf = Eigen::Vector3d::Zero();
+      for (int j = 0; j < nfv; ++j)
+        xf += geometry.x(v[e(i, j)]);
+      xf /= nfv;
+      const Eigen::Vector3d d = xf - xc;
+
+      Eigen::Vector3d n;
+      if (nfv == 1)
+        n = d;
+      else if (nfv == 2)
+      {
+        // Subtract projection onto the facet
+        Eigen::Vector3d t = geometry.x(v[e(i, 1)]) - geometry.x(v[e(i, 0)]);
+        t /= t.norm();
+        n = d - t * d.dot(t);
+      }
+      else
+      {
+        // Cross product of two edges (of the diagonals for
+        // quadrilaterals), oriented out of the cell
+        const Eigen::Vector3d x0 = geometry.x(v[e(i, 0)]);
+        n = (nfv == 3) ? (geometry.x(v[e(i, 1)]) - x0)
+                             .cross(geometry.x(v[e(i, 2)]) - x0)
+                       : (geometry.x(v[e(i, 3)]) - x0)
+                             .cross(geometry.x(v[e(i, 2)])
+                                    - geometry.x(v[e(i, 1)]));
+        if (n.dot(d) < 0.0)
+          n *= -1.0;
+      }
+
+      normals.row(c * num_facets + i) = n.normalized().transpose().array();
+    }
+  }
+
+  return normals;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,56 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+
+namespace dolfin
+{
+namespace mesh
+{
+class Mesh;
+
+/// Geometric metrics of cells
+enum class CellMetric : int
+{
+  volume,       // (Generalised) volume
+  h,            // Greatest distance between any two vertices
+  circumradius, // Radius of circumscribed sphere (simplices)
+  inradius,     // Radius of inscribed sphere (simplices)
+  radius_ratio  // tdim * inradius / circumradius (simplices)
+};
+
+/// Compute a geometric metric for all cells of a mesh (including
+/// ghosts). The cells are processed in batches, with a kernel for each
+/// cell type, rather than through the virtual functions of CellType.
+/// The values are not cached; use Mesh::cell_metric for cached
+/// values.
+///
+/// @param mesh (Mesh)
+///   The mesh
+/// @param metric (CellMetric)
+///   The metric to compute
+/// @return Eigen::ArrayXd
+///   The metric for each cell
+Eigen::ArrayXd cell_metric(const Mesh& mesh, CellMetric metric);
+
+/// Compute the (generalised) area of each facet of all cells of a
+/// mesh (including ghosts). Row c holds the areas of the facets of
+/// cell c, in the local facet order of the cell.
+Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+cell_facet_areas(const Mesh& mesh);
+
+/// Compute the outward unit normal of each facet of all cells of a
+/// mesh (including ghosts). Row c * num_facets + i holds the normal of
+/// local facet i of cell c. For cells of lower topological dimension
+/// than the geometric dimension, the normal lies in the tangent space
+/// of the cell.
+Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>
+cell_facet_normals(const Mesh& mesh);
+
+} // namespace mesh
+} // namespace dolfin
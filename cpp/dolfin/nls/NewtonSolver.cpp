@@ -6,20 +6,77 @@
 
 #include "NewtonSolver.h"
 #include "NonlinearProblem.h"
+#include <algorithm>
+#include <cmath>
 #include <dolfin/common/MPI.h>
+#include <dolfin/common/Timer.h>
 #include <dolfin/common/log.h>
 #include <dolfin/la/PETScKrylovSolver.h>
 #include <dolfin/la/PETScMatrix.h>
 #include <dolfin/la/PETScOptions.h>
 #include <dolfin/la/PETScVector.h>
+#include <dolfin/la/utils.h>
 #include <string>
 
 using namespace dolfin;
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Context of the residual function of the matrix-free Jacobian: the
+// problem, the Newton iterate x and storage for x while the residual
+// is evaluated at a trial point
+struct MFFDContext
+{
+  nls::NonlinearProblem* nonlinear_problem;
+  Vec x, x_saved;
+};
+//-----------------------------------------------------------------------------
+// Copy x to y, including the ghost values if the vectors are ghosted
+void copy_with_ghosts(Vec x, Vec y)
+{
+  Vec x_local, y_local;
+  VecGhostGetLocalForm(x, &x_local);
+  VecGhostGetLocalForm(y, &y_local);
+  if (x_local and y_local)
+    VecCopy(x_local, y_local);
+  else
+    VecCopy(x, y);
+  VecGhostRestoreLocalForm(x, &x_local);
+  VecGhostRestoreLocalForm(y, &y_local);
+}
+//-----------------------------------------------------------------------------
+// Residual function for the matrix-free (finite difference) Jacobian.
+// A NonlinearProblem may compute F from its own state (e.g. a Function
+// that wraps the Newton iterate) rather than from the vector it is
+// passed, so the trial point w is copied into the iterate, and the
+// iterate is restored afterwards.
+PetscErrorCode mffd_residual(void* ctx, Vec w, Vec f)
+{
+  common::Timer timer("Newton solver: matrix-free residual");
+  auto mffd = static_cast<MFFDContext*>(ctx);
+  assert(mffd);
+  assert(mffd->nonlinear_problem);
+  copy_with_ghosts(mffd->x, mffd->x_saved);
+  VecCopy(w, mffd->x);
+  mffd->nonlinear_problem->form(mffd->x);
+  Vec F = mffd->nonlinear_problem->F(mffd->x);
+  assert(F);
+  PetscErrorCode ierr = VecCopy(F, f);
+  copy_with_ghosts(mffd->x_saved, mffd->x);
+  return ierr;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
 //-----------------------------------------------------------------------------
 nls::NewtonSolver::NewtonSolver(MPI_Comm comm)
-    : _krylov_iterations(0), _residual(0.0), _residual0(0.0), _solver(comm),
-      _dx(nullptr), _mpi_comm(comm)
+    : _krylov_iterations(0), _jacobian_evaluations(0),
+      _preconditioner_setups(0), _line_search_evaluations(0),
+      _jacobian_age(-1), _preconditioner_age(-1),
+      _residual(0.0), _residual0(0.0), _forcing(0.0), _forcing_residual(0.0),
+      _forcing_lresidual(0.0), _solver(comm), _dx(nullptr), _x0(nullptr),
+      _J_mf(nullptr), _F_mf(nullptr), _x_mf(nullptr), _mpi_comm(comm)
 {
   // Create linear solver if not already created. Default to LU.
   _solver.set_options_prefix("nls_solve_");
@@ -35,6 +92,14 @@ nls::NewtonSolver::~NewtonSolver()
 {
   if (_dx)
     VecDestroy(&_dx);
+  if (_x0)
+    VecDestroy(&_x0);
+  if (_J_mf)
+    MatDestroy(&_J_mf);
+  if (_F_mf)
+    VecDestroy(&_F_mf);
+  if (_x_mf)
+    VecDestroy(&_x_mf);
 }
 //-----------------------------------------------------------------------------
 std::pair<int, bool>
@@ -43,6 +108,15 @@ dolfin::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
   // Reset iteration counts
   int newton_iteration = 0;
   _krylov_iterations = 0;
+  _jacobian_evaluations = 0;
+  _preconditioner_setups = 0;
+  _line_search_evaluations = 0;
+
+  // The Jacobian is always recomputed at the start of a solve, but the
+  // preconditioner may be kept from a previous solve
+  _jacobian_age = -1;
+  if (!lag_preconditioner_persists)
+    _preconditioner_age = -1;
 
   // Compute F(u) (assembled into _b)
   Mat A(nullptr), P(nullptr);
@@ -52,6 +126,44 @@ dolfin::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
   b = nonlinear_problem.F(x);
   assert(b);
 
+  // Store the linear solver tolerances so that they can be restored
+  // if the forcing term is adapted
+  KSP ksp = _solver.ksp();
+  PetscReal ksp_rtol, ksp_atol, ksp_dtol;
+  PetscInt ksp_max_it;
+  PetscErrorCode ierr
+      = KSPGetTolerances(ksp, &ksp_rtol, &ksp_atol, &ksp_dtol, &ksp_max_it);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "KSPGetTolerances");
+  _forcing = forcing_rtol0;
+
+  // Create the finite difference Jacobian operator, which evaluates
+  // the residual of this problem
+  MFFDContext mffd_context = {&nonlinear_problem, x, nullptr};
+  if (jacobian_free)
+  {
+    if (!_J_mf)
+    {
+      PetscInt m, M;
+      VecGetLocalSize(x, &m);
+      VecGetSize(x, &M);
+      ierr = MatCreateMFFD(_mpi_comm.comm(), m, m, M, M, &_J_mf);
+      if (ierr != 0)
+        la::petsc_error(ierr, __FILE__, "MatCreateMFFD");
+      MatSetOptionsPrefix(_J_mf, _solver.get_options_prefix().c_str());
+      MatSetFromOptions(_J_mf);
+    }
+    if (!_F_mf)
+      VecDuplicate(b, &_F_mf);
+    if (!_x_mf)
+      VecDuplicate(x, &_x_mf);
+    mffd_context.x_saved = _x_mf;
+
+    ierr = MatMFFDSetFunction(_J_mf, mffd_residual, &mffd_context);
+    if (ierr != 0)
+      la::petsc_error(ierr, __FILE__, "MatMFFDSetFunction");
+  }
+
   // Check convergence
   bool newton_converged = false;
   if (convergence_criterion == "residual")
@@ -71,22 +183,116 @@ dolfin::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
   // Start iterations
   while (!newton_converged and newton_iteration < max_it)
   {
-    // Compute Jacobian
-    A = nonlinear_problem.J(x);
-    assert(A);
-    P = nonlinear_problem.P(x);
-    if (!P)
-      P = A;
+    // The matrix-free Jacobian evaluates the residual at trial points,
+    // which overwrites F. Keep a copy of F(x) for the right-hand side
+    // and for the differencing base.
+    Vec rhs = b;
+    if (jacobian_free)
+    {
+      VecCopy(b, _F_mf);
+      rhs = _F_mf;
+      MatMFFDSetBase(_J_mf, x, _F_mf);
+      MatAssemblyBegin(_J_mf, MAT_FINAL_ASSEMBLY);
+      MatAssemblyEnd(_J_mf, MAT_FINAL_ASSEMBLY);
+    }
 
-    if (!_dx)
-      MatCreateVecs(A, &_dx, nullptr);
+    // Compute Jacobian if it does not exist or has expired
+    const bool update_jacobian
+        = _jacobian_age < 0
+          or (lag_jacobian > 0 and _jacobian_age >= lag_jacobian);
+    if (update_jacobian)
+    {
+      common::Timer timer1("Newton solver: compute Jacobian");
+      if (jacobian_free)
+      {
+        // The assembled Jacobian, if used at all, is only the
+        // preconditioner matrix
+        A = _J_mf;
+        P = nonlinear_problem.P(x);
+        if (!P)
+          P = nonlinear_problem.J(x);
+        assert(P);
+      }
+      else
+      {
+        A = nonlinear_problem.J(x);
+        assert(A);
+        P = nonlinear_problem.P(x);
+        if (!P)
+          P = A;
+      }
+      timer1.stop();
+      _jacobian_age = 0;
+      ++_jacobian_evaluations;
 
-    // FIXME: check that this is efficient if A and/or P are unchanged
-    // Set operators
-    _solver.set_operators(A, P);
+      if (!_dx)
+        MatCreateVecs(A, &_dx, nullptr);
+
+      // Rebuild preconditioner if it does not exist or has expired,
+      // otherwise keep the current preconditioner with the new
+      // operator
+      const bool update_preconditioner
+          = _preconditioner_age < 0
+            or (lag_preconditioner > 0
+                and _preconditioner_age >= lag_preconditioner);
+      _solver.set_reuse_preconditioner(!update_preconditioner);
+      _solver.set_operators(A, P);
+      if (update_preconditioner)
+      {
+        common::Timer timer2("Newton solver: set up preconditioner");
+        _solver.set_up();
+        _preconditioner_age = 0;
+        ++_preconditioner_setups;
+      }
+    }
+
+    // Set linear solver tolerance from the forcing term
+    if (forcing_term != ForcingTerm::fixed)
+    {
+      ierr = KSPSetTolerances(ksp, _forcing, PETSC_DEFAULT, PETSC_DEFAULT,
+                              PETSC_DEFAULT);
+      if (ierr != 0)
+        la::petsc_error(ierr, __FILE__, "KSPSetTolerances");
+      if (report and _mpi_comm.rank() == 0)
+      {
+        LOG(INFO) << "Newton iteration " << newton_iteration
+                  << ": linear solver rtol = " << _forcing;
+      }
+    }
 
     // Perform linear solve and update total number of Krylov iterations
-    _krylov_iterations += _solver.solve(_dx, b);
+    _krylov_iterations += _solver.solve(_dx, rhs);
+
+    // Compute the nonlinear residual norm ||F_k|| and, for choice 1,
+    // the linear residual norm ||F_k - J_k dx_k|| before F is
+    // overwritten by the next evaluation
+    if (forcing_term != ForcingTerm::fixed)
+    {
+      VecNorm(rhs, NORM_2, &_forcing_residual);
+      if (forcing_term == ForcingTerm::eisenstat_walker_1)
+      {
+        Vec r;
+        VecDuplicate(rhs, &r);
+        MatMult(A, _dx, r);
+        VecAYPX(r, -1.0, rhs);
+        VecNorm(r, NORM_2, &_forcing_lresidual);
+        VecDestroy(&r);
+      }
+    }
+
+    // Store the current point, and ||F|| and F.dx at the current point,
+    // for the line search
+    double ls_norm0 = 0.0, ls_slope0 = 0.0;
+    if (line_search != LineSearch::basic)
+    {
+      if (!_x0)
+        VecDuplicate(x, &_x0);
+      VecCopy(x, _x0);
+      VecNorm(rhs, NORM_2, &ls_norm0);
+      PetscScalar dot;
+      VecDot(rhs, _dx, &dot);
+      ls_slope0 = PetscRealPart(dot);
+    }
 
     // Update solution
     update_solution(x, _dx, relaxation_parameter, nonlinear_problem,
@@ -94,6 +300,8 @@ dolfin::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
 
     // Increment iteration count
     ++newton_iteration;
+    ++_jacobian_age;
+    ++_preconditioner_age;
 
     // FIXME: This step is not needed if residual is based on dx and
     //        this has converged.
@@ -102,18 +310,88 @@ dolfin::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
     nonlinear_problem.form(x);
     b = nonlinear_problem.F(x);
 
+    // Correct the step length. The full step residual computed above
+    // is the first trial point.
+    double lambda = 1.0;
+    if (line_search != LineSearch::basic)
+    {
+      lambda = apply_line_search(nonlinear_problem, x, b, ls_norm0,
+                                 ls_slope0, newton_iteration - 1);
+    }
+
     // Test for convergence
+    const double residual_prev = _residual;
     if (convergence_criterion == "residual")
       newton_converged = converged(b, nonlinear_problem, newton_iteration);
     else if (convergence_criterion == "incremental")
     {
-      // Subtract 1 to make sure that the initial residual0 is
-      // properly set.
+      // The increment is the accepted step lambda*dx. Subtract 1 to
+      // make sure that the initial residual0 is properly set.
+      if (lambda != 1.0)
+        VecScale(_dx, lambda);
       newton_converged
           = converged(_dx, nonlinear_problem, newton_iteration - 1);
     }
     else
       throw std::runtime_error("Unknown convergence criterion string.");
+
+    // Compute forcing term for the next iteration. The residual norm
+    // computed in converged() is reused when it is ||F||.
+    if (forcing_term != ForcingTerm::fixed and !newton_converged
+        and _forcing_residual > 0.0)
+    {
+      double residual_F = _residual;
+      if (convergence_criterion != "residual")
+        VecNorm(b, NORM_2, &residual_F);
+
+      const double forcing_prev = _forcing;
+      if (forcing_term == ForcingTerm::eisenstat_walker_1)
+      {
+        _forcing
+            = std::abs(residual_F - _forcing_lresidual) / _forcing_residual;
+        const double safeguard = std::pow(forcing_prev, forcing_alpha);
+        if (safeguard > forcing_threshold)
+          _forcing = std::max(_forcing, safeguard);
+      }
+      else
+      {
+        _forcing = forcing_gamma
+                   * std::pow(residual_F / _forcing_residual, forcing_alpha);
+        const double safeguard
+            = forcing_gamma * std::pow(forcing_prev, forcing_alpha);
+        if (safeguard > forcing_threshold)
+          _forcing = std::max(_forcing, safeguard);
+      }
+      _forcing = std::min(_forcing, forcing_rtol_max);
+    }
+
+    // If a lagged Jacobian or preconditioner has stopped reducing the
+    // residual, rebuild both at the next iteration. The first
+    // incremental residual has no predecessor.
+    const bool lagged = _jacobian_age > 1 or _preconditioner_age > 1;
+    const bool have_rate
+        = convergence_criterion == "residual" or newton_iteration > 1;
+    if (!newton_converged and lagged and have_rate
+        and _residual > lag_rebuild_rate * residual_prev)
+    {
+      if (_mpi_comm.rank() == 0)
+      {
+        LOG(INFO) << "Newton solver convergence rate "
+                  << _residual / residual_prev
+                  << " exceeds lag rebuild rate, rebuilding Jacobian and "
+                     "preconditioner.";
+      }
+      _jacobian_age = -1;
+      _preconditioner_age = -1;
+    }
+  }
+
+  // Restore linear solver tolerances
+  if (forcing_term != ForcingTerm::fixed)
+  {
+    ierr = KSPSetTolerances(ksp, ksp_rtol, ksp_atol, ksp_dtol, ksp_max_it);
+    if (ierr != 0)
+      la::petsc_error(ierr, __FILE__, "KSPSetTolerances");
   }
 
   if (newton_converged)
@@ -122,7 +400,10 @@ dolfin::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
     {
       LOG(INFO) << "Newton solver finished in " << newton_iteration
                 << " iterations and " << _krylov_iterations
-                << " linear solver iterations.";
+                << " linear solver iterations (" << _jacobian_evaluations
+                << " Jacobian evaluations, " << _preconditioner_setups
+                << " preconditioner setups, " << _line_search_evaluations
+                << " line search residual evaluations).";
     }
   }
   else
@@ -144,8 +425,33 @@ dolfin::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
   return std::make_pair(newton_iteration, newton_converged);
 }
 //-----------------------------------------------------------------------------
+const la::PETScKrylovSolver& nls::NewtonSolver::get_krylov_solver() const
+{
+  return _solver;
+}
+//-----------------------------------------------------------------------------
+la::PETScKrylovSolver& nls::NewtonSolver::get_krylov_solver()
+{
+  return _solver;
+}
+//-----------------------------------------------------------------------------
 int nls::NewtonSolver::krylov_iterations() const { return _krylov_iterations; }
 //-----------------------------------------------------------------------------
+int nls::NewtonSolver::jacobian_evaluations() const
+{
+  return _jacobian_evaluations;
+}
+//-----------------------------------------------------------------------------
+int nls::NewtonSolver::preconditioner_setups() const
+{
+  return _preconditioner_setups;
+}
+//-----------------------------------------------------------------------------
+int nls::NewtonSolver::line_search_evaluations() const
+{
+  return _line_search_evaluations;
+}
+//-----------------------------------------------------------------------------
 double nls::NewtonSolver::residual() const { return _residual; }
 //-----------------------------------------------------------------------------
 double nls::NewtonSolver::residual0() const { return _residual0; }
@@ -187,3 +493,93 @@ void nls::NewtonSolver::update_solution(
   VecAXPY(x, -relaxation, dx);
 }
 //-----------------------------------------------------------------------------
+double nls::NewtonSolver::apply_line_search(NonlinearProblem& nonlinear_problem,
+                                            Vec x, Vec& b, double norm0,
+                                            double slope0,
+                                            std::size_t iteration)
+{
+  common::Timer timer("Newton solver: line search");
+
+  // Move to the trial point x0 - lambda*relaxation*dx and evaluate F
+  // into the residual storage of the problem
+  int num_evaluations = 0;
+  auto evaluate = [&](double lambda) {
+    VecCopy(_x0, x);
+    update_solution(x, _dx, lambda * relaxation_parameter, nonlinear_problem,
+                    iteration);
+    nonlinear_problem.form(x);
+    b = nonlinear_problem.F(x);
+    ++num_evaluations;
+  };
+
+  double lambda = 1.0;
+  if (line_search == LineSearch::backtracking)
+  {
+    // Backtrack using quadratic interpolation of
+    // phi(lambda) = ||F(x0 - lambda dx)||^2, with phi'(0) = -2 phi(0)
+    // for the Newton direction, until the sufficient decrease
+    // condition phi(lambda) <= (1 - 2 alpha lambda) phi(0) holds
+    const double phi0 = norm0 * norm0;
+    double norm;
+    VecNorm(b, NORM_2, &norm);
+    for (int it = 0; it < line_search_max_it; ++it)
+    {
+      const double phi = norm * norm;
+      if (phi <= (1.0 - 2.0 * line_search_alpha * lambda) * phi0)
+        break;
+
+      if (lambda * 0.1 < line_search_min_step)
+      {
+        LOG(WARNING) << "Newton line search reached minimum step length.";
+        break;
+      }
+
+      const double denom = phi - phi0 + 2.0 * phi0 * lambda;
+      double lambda_q = denom > 0.0 ? phi0 * lambda * lambda / denom : 0.0;
+      lambda = std::min(std::max(lambda_q, 0.1 * lambda), 0.5 * lambda);
+      evaluate(lambda);
+      VecNorm(b, NORM_2, &norm);
+    }
+  }
+  else if (line_search == LineSearch::critical_point)
+  {
+    // Secant iteration for a root of s(lambda) = F(x0 - lambda dx).dx,
+    // the directional derivative of the merit function for problems
+    // with a symmetric Jacobian
+    double lambda_prev = 0.0;
+    double s_prev = slope0;
+    PetscScalar dot;
+    VecDot(b, _dx, &dot);
+    double s = PetscRealPart(dot);
+    for (int it = 0; it < line_search_max_it; ++it)
+    {
+      if (std::abs(s) <= line_search_rtol * std::abs(slope0) or s == s_prev)
+        break;
+
+      double lambda_new
+          = lambda - s * (lambda - lambda_prev) / (s - s_prev);
+      if (!(lambda_new > line_search_min_step))
+        lambda_new = line_search_min_step;
+      if (std::abs(lambda_new - lambda) <= line_search_rtol * lambda)
+        break;
+
+      lambda_prev = lambda;
+      s_prev = s;
+      lambda = lambda_new;
+      evaluate(lambda);
+      VecDot(b, _dx, &dot);
+      s = PetscRealPart(dot);
+    }
+  }
+
+  _line_search_evaluations += num_evaluations;
+  if (report and _mpi_comm.rank() == 0)
+  {
+    LOG(INFO) << "Newton iteration " << iteration
+              << ": line search step length = " << lambda << " ("
+              << num_evaluations << " extra residual evaluations)";
+  }
+
+  return lambda;
+}
+//-----------------------------------------------------------------------------
@@ -7,8 +7,10 @@
 #pragma once
 
 #include <dolfin/common/MPI.h>
+#include <cmath>
 #include <dolfin/la/PETScKrylovSolver.h>
 #include <memory>
+#include <petscmat.h>
 #include <petscvec.h>
 #include <utility>
 
@@ -31,6 +33,26 @@ class NonlinearProblem;
 class NewtonSolver
 {
 public:
+  /// Choice of relative tolerance (forcing term) for the linear
+  /// solver at each Newton iteration
+  enum class ForcingTerm
+  {
+    fixed,              // Tolerance set through the PETSc options
+    eisenstat_walker_1, // Eisenstat-Walker choice 1
+    eisenstat_walker_2  // Eisenstat-Walker choice 2
+  };
+
+  /// Globalisation of the Newton step. The line searches evaluate only
+  /// the residual F at trial points. With the "incremental"
+  /// convergence criterion the accepted step lambda*dx is tested.
+  enum class LineSearch
+  {
+    basic,         // Full step, scaled by the relaxation parameter
+    backtracking,  // Backtracking on ||F||^2 (sufficient decrease)
+    critical_point // Secant search for a critical point of the merit
+                   // function along the step
+  };
+
   /// Create nonlinear solver
   /// @param comm (MPI_Comm)
   explicit NewtonSolver(MPI_Comm comm);
@@ -51,6 +73,14 @@ public:
   ///         iteration converged)
   std::pair<int, bool> solve(NonlinearProblem& nonlinear_function, Vec x);
 
+  /// Return the Krylov solver used for the linear systems. It is
+  /// created with the options prefix "nls_solve_" and defaults to a
+  /// direct solver (preonly with LU).
+  const la::PETScKrylovSolver& get_krylov_solver() const;
+
+  /// Return the Krylov solver used for the linear systems
+  la::PETScKrylovSolver& get_krylov_solver();
+
   /// Return number of Krylov iterations elapsed since
   /// solve started
   ///
@@ -70,6 +100,25 @@ public:
   ///         Initial residual.
   double residual0() const;
 
+  /// Return number of Jacobian evaluations since solve started
+  ///
+  /// @returns    int
+  ///         The number of calls to NonlinearProblem::J.
+  int jacobian_evaluations() const;
+
+  /// Return number of preconditioner setups since solve started
+  ///
+  /// @returns    int
+  ///         The number of times the preconditioner was (re)built.
+  int preconditioner_setups() const;
+
+  /// Return number of additional residual evaluations performed by
+  /// the line search since solve started
+  ///
+  /// @returns    int
+  ///         The number of extra calls to NonlinearProblem::F.
+  int line_search_evaluations() const;
+
   /// Maximum number of iterations
   int max_it = 50;
 
@@ -92,6 +141,76 @@ public:
   /// Relaxation parameter
   double relaxation_parameter = 1.0;
 
+  /// Line search
+  LineSearch line_search = LineSearch::basic;
+
+  /// Maximum number of line search iterations
+  int line_search_max_it = 10;
+
+  /// Sufficient decrease parameter for the backtracking line search
+  double line_search_alpha = 1.0e-4;
+
+  /// Relative tolerance for the critical point line search
+  double line_search_rtol = 1.0e-2;
+
+  /// Minimum line search step length
+  double line_search_min_step = 1.0e-4;
+
+  /// Jacobian-free Newton-Krylov. The Jacobian operator is
+  /// approximated by finite differences of NonlinearProblem::F
+  /// (PETSc MatMFFD, configured through the solver options prefix).
+  /// F is evaluated at a trial point by copying it into the solution
+  /// vector x and calling NonlinearProblem::form and
+  /// NonlinearProblem::F, after which x is restored, so F may be
+  /// computed from a Function that wraps x. The assembled
+  /// NonlinearProblem::P, or NonlinearProblem::J if P is not
+  /// provided, is used only to build the preconditioner and may be
+  /// lagged (see lag_jacobian and lag_preconditioner).
+  bool jacobian_free = false;
+
+  /// Jacobian lag. The Jacobian is recomputed every lag_jacobian
+  /// Newton iterations (1: every iteration, -1: only at the first
+  /// iteration of each solve).
+  int lag_jacobian = 1;
+
+  /// Preconditioner lag. The preconditioner is rebuilt every
+  /// lag_preconditioner Newton iterations (1: every iteration, -1:
+  /// only when no preconditioner exists). A preconditioner is never
+  /// rebuilt from a Jacobian that has not been recomputed.
+  int lag_preconditioner = 1;
+
+  /// Keep the preconditioner across calls to solve
+  bool lag_preconditioner_persists = false;
+
+  /// Linear solver forcing term. With the Eisenstat-Walker choices
+  /// the relative tolerance of the Krylov solver is adapted to the
+  /// reduction of the nonlinear residual ||F|| (Eisenstat and Walker,
+  /// SIAM J. Sci. Comput. 17(1), 1996).
+  ForcingTerm forcing_term = ForcingTerm::fixed;
+
+  /// Forcing term at the first Newton iteration
+  double forcing_rtol0 = 0.3;
+
+  /// Upper bound on the forcing term
+  double forcing_rtol_max = 0.9;
+
+  /// Eisenstat-Walker parameter gamma (choice 2)
+  double forcing_gamma = 1.0;
+
+  /// Eisenstat-Walker exponent alpha (choice 2, and safeguard for
+  /// choice 1)
+  double forcing_alpha = 0.5 * (1.0 + std::sqrt(5.0));
+
+  /// Safeguard threshold. The forcing term is not allowed to
+  /// decrease quickly while the previous forcing term is above this
+  /// value.
+  double forcing_threshold = 0.1;
+
+  /// Force a Jacobian and preconditioner rebuild when a lagged
+  /// iteration reduces the residual by less than this factor
+  /// (||r_k|| > lag_rebuild_rate ||r_{k-1}||)
+  double lag_rebuild_rate = 0.5;
+
 protected:
   /// Convergence test. It may be overloaded using virtual inheritance and
   /// this base criterion may be called from derived, both in C++ and Python.
@@ -128,18 +247,49 @@ protected:
                                std::size_t iteration);
 
 private:
+  // Correct the step length along _dx, starting from the full step
+  // x = x0 - relaxation_parameter*dx with residual b. On return x is
+  // the accepted point and b its residual. Returns the step length
+  // (relative to the relaxation parameter).
+  double apply_line_search(NonlinearProblem& nonlinear_problem, Vec x, Vec& b,
+                           double norm0, double slope0, std::size_t iteration);
+
   // Accumulated number of Krylov iterations since solve began
   int _krylov_iterations;
 
+  // Number of Jacobian evaluations, preconditioner setups and line
+  // search residual evaluations since solve began
+  int _jacobian_evaluations, _preconditioner_setups, _line_search_evaluations;
+
+  // Number of Newton iterations since the Jacobian and preconditioner
+  // were last built. Negative if there is no preconditioner.
+  int _jacobian_age, _preconditioner_age;
+
   // Most recent residual and initial residual
   double _residual, _residual0;
 
+  // Current forcing term, and the nonlinear and linear residual norms
+  // of the previous Newton iteration used to compute the next one
+  double _forcing, _forcing_residual, _forcing_lresidual;
+
   // Solver
   la::PETScKrylovSolver _solver;
 
   // Solution vector
   Vec _dx;
 
+  // Point at the start of the Newton step (line search)
+  Vec _x0;
+
+  // Finite difference Jacobian operator and the residual at its base
+  // point (Jacobian-free mode)
+  Mat _J_mf;
+  Vec _F_mf;
+
+  // Copy of the solution vector while the residual is evaluated at a
+  // trial point (Jacobian-free mode)
+  Vec _x_mf;
+
   // MPI communicator
   dolfin::MPI::Comm _mpi_comm;
 };
@@ -0,0 +1,375 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "MeshHierarchy.h"
+#include "refine.h"
+#include <dolfin/common/IndexMap.h>
+#include <dolfin/common/Timer.h>
+#include <dolfin/fem/CoordinateMapping.h>
+#include <dolfin/fem/FiniteElement.h>
+#include <dolfin/fem/GenericDofMap.h>
+#include <dolfin/fem/PETScDMCollection.h>
+#include <dolfin/function/FunctionSpace.h>
+#include <dolfin/la/PETScMatrix.h>
+#include <dolfin/la/utils.h>
+#include <dolfin/mesh/Connectivity.h>
+#include <dolfin/mesh/CoordinateDofs.h>
+#include <dolfin/mesh/Geometry.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/Topology.h>
+#include <algorithm>
+#include <petscmat.h>
+#include <unsupported/Eigen/CXX11/Tensor>
+
+using namespace dolfin;
+using namespace dolfin::refinement;
+
+//-----------------------------------------------------------------------------
+MeshHierarchy::MeshHierarchy(std::shared_ptr<const mesh::Mesh> mesh,
+                             int num_refinements)
+    : _meshes({mesh}), _parent_cells(1)
+{
+  common::Timer timer("Build mesh hierarchy");
+
+  assert(mesh);
+  for (int i = 0; i < num_refinements; ++i)
+  {
+    // Refine in place, so that the parents of the cells are on this
+    // process
+    auto refined = refine_with_parents(*_meshes.back(), false);
+    _meshes.push_back(
+        std::make_shared<const mesh::Mesh>(std::move(std::get<0>(refined))));
+    _parent_cells.emplace_back();
+    set_parent_cells(i + 1, std::get<1>(refined));
+  }
+}
+//-----------------------------------------------------------------------------
+MeshHierarchy::MeshHierarchy(
+    std::vector<std::shared_ptr<const mesh::Mesh>> meshes,
+    const std::vector<std::vector<std::int64_t>>& parent_cells)
+    : _meshes(meshes), _parent_cells(meshes.size())
+{
+  if (_meshes.empty())
+    throw std::runtime_error("Mesh hierarchy requires at least one mesh");
+  if (parent_cells.size() + 1 != _meshes.size())
+  {
+    throw std::runtime_error("Number of parent cell arrays ("
+                             + std::to_string(parent_cells.size())
+                             + ") does not match number of meshes ("
+                             + std::to_string(_meshes.size()) + ")");
+  }
+
+  for (std::size_t i = 1; i < _meshes.size(); ++i)
+    set_parent_cells(i, parent_cells[i - 1]);
+}
+//-----------------------------------------------------------------------------
+std::size_t MeshHierarchy::num_levels() const { return _meshes.size(); }
+//-----------------------------------------------------------------------------
+std::shared_ptr<const mesh::Mesh> MeshHierarchy::mesh(int i) const
+{
+  assert(i >= -(int)_meshes.size() and i < (int)_meshes.size());
+  const int base = i < 0 ? _meshes.size() : 0;
+  return _meshes[base + i];
+}
+//-----------------------------------------------------------------------------
+const std::vector<std::int32_t>& MeshHierarchy::parent_cells(int i) const
+{
+  assert(i >= -(int)_meshes.size() and i < (int)_meshes.size());
+  const int base = i < 0 ? _meshes.size() : 0;
+  if (base + i == 0)
+    throw std::runtime_error("Coarsest mesh of hierarchy has no parents");
+  return _parent_cells[base + i];
+}
+//-----------------------------------------------------------------------------
+la::PETScMatrix MeshHierarchy::create_prolongation(
+    const function::FunctionSpace& coarse_space,
+    const function::FunctionSpace& fine_space) const
+{
+  common::Timer timer("Create prolongation matrix from mesh hierarchy");
+
+  assert(coarse_space.mesh());
+  assert(fine_space.mesh());
+  const int l = level(*fine_space.mesh());
+  if (l < 1 or _meshes[l - 1] != coarse_space.mesh())
+  {
+    throw std::runtime_error("Function spaces are not on consecutive levels "
+                             "of the mesh hierarchy");
+  }
+
+  assert(coarse_space.element());
+  assert(fine_space.element());
+  if (coarse_space.element()->signature()
+      != fine_space.element()->signature())
+  {
+    throw std::runtime_error(
+        "Cannot create prolongation between different elements");
+  }
+
+  const mesh::Mesh& mesh0 = *coarse_space.mesh();
+  const mesh::Mesh& mesh1 = *fine_space.mesh();
+  const int tdim = mesh1.topology().dim();
+  const int gdim = mesh1.geometry().dim();
+  if (!mesh0.geometry().coord_mapping or !mesh1.geometry().coord_mapping)
+  {
+    throw std::runtime_error(
+        "fem::CoordinateMapping has not been attached to mesh.");
+  }
+  const fem::CoordinateMapping& cmap0 = *mesh0.geometry().coord_mapping;
+  const fem::CoordinateMapping& cmap1 = *mesh1.geometry().coord_mapping;
+
+  // Geometry of both meshes
+  const mesh::Connectivity& connectivity_g0
+      = mesh0.coordinate_dofs().entity_points();
+  const mesh::ConnectivityView cell_g0(connectivity_g0);
+  const mesh::Connectivity& connectivity_g1
+      = mesh1.coordinate_dofs().entity_points();
+  const mesh::ConnectivityView cell_g1(connectivity_g1);
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = connectivity_g1.size(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g0
+      = mesh0.geometry().points();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g1
+      = mesh1.geometry().points();
+
+  // Dofmaps. The rows of the matrix are the dofs of the fine space and
+  // the columns the dofs of the coarse space.
+  assert(coarse_space.dofmap());
+  assert(fine_space.dofmap());
+  const fem::GenericDofMap& dofmap0 = *coarse_space.dofmap();
+  const fem::GenericDofMap& dofmap1 = *fine_space.dofmap();
+  const common::IndexMap& index_map0 = *dofmap0.index_map();
+  const common::IndexMap& index_map1 = *dofmap1.index_map();
+  const int bs0 = index_map0.block_size();
+  const int bs1 = index_map1.block_size();
+  const std::array<std::int64_t, 2> range0 = index_map0.local_range();
+  const std::int64_t n0 = bs0 * range0[0];
+  const std::int64_t n1 = bs0 * range0[1];
+  const std::int32_t num_owned_rows = bs1 * index_map1.size_local();
+  const Eigen::Array<std::size_t, Eigen::Dynamic, 1> local_to_global0
+      = dofmap0.tabulate_local_to_global_dofs();
+  const Eigen::Array<std::size_t, Eigen::Dynamic, 1> local_to_global1
+      = dofmap1.tabulate_local_to_global_dofs();
+
+  // Evaluate the coarse basis functions in the parent cell at the dof
+  // coordinates of each fine cell, and map each basis function to the
+  // expansion coefficients on the fine cell, which are the entries of
+  // the fine rows in the coarse columns
+  const fem::FiniteElement& element = *fine_space.element();
+  const int space_dimension = element.space_dimension();
+  const EigenRowArrayXXd& X = element.dof_reference_coordinates();
+  const int num_points = X.rows();
+  const int reference_value_size = element.reference_value_size();
+  const int value_size = element.value_size();
+  EigenRowArrayXXd coordinate_dofs0(num_dofs_g, gdim);
+  EigenRowArrayXXd coordinate_dofs1(num_dofs_g, gdim);
+  EigenRowArrayXXd x(num_points, gdim);
+  EigenRowArrayXXd X0(num_points, tdim);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> J(num_points, gdim, tdim);
+  EigenArrayXd detJ(num_points);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> K(num_points, tdim, gdim);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> basis_reference_values(
+      num_points, space_dimension, reference_value_size);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> basis_values(
+      num_points, space_dimension, value_size);
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      values(num_points, value_size);
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>
+      A(space_dimension, space_dimension);
+
+  // Nonzero columns and values of each owned row, with at most
+  // space_dimension entries per row. Each row is computed once, in the
+  // first cell that contains the dof.
+  std::vector<std::int32_t> row_size(num_owned_rows, -1);
+  std::vector<PetscInt> columns(num_owned_rows * space_dimension);
+  std::vector<PetscScalar> entries(num_owned_rows * space_dimension);
+  std::vector<PetscInt> nnz_diag(num_owned_rows, 0);
+  std::vector<PetscInt> nnz_offdiag(num_owned_rows, 0);
+
+  const std::vector<std::int32_t>& parents = _parent_cells[l];
+  const std::int32_t num_cells = mesh1.num_entities(tdim);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    auto dofs1 = dofmap1.cell_dofs(c);
+    bool new_rows = false;
+    for (Eigen::Index i = 0; i < dofs1.size(); ++i)
+    {
+      if (dofs1[i] < num_owned_rows and row_size[dofs1[i]] < 0)
+      {
+        new_rows = true;
+        break;
+      }
+    }
+    if (!new_rows)
+      continue;
+
+    const std::int32_t p = parents[c];
+    for (int i = 0; i < num_dofs_g; ++i)
+    {
+      for (int j = 0; j < gdim; ++j)
+      {
+        coordinate_dofs0(i, j) = x_g0(cell_g0.connections(p)[i], j);
+        coordinate_dofs1(i, j) = x_g1(cell_g1.connections(c)[i], j);
+      }
+    }
+
+    // Coarse basis functions at the dof coordinates of the fine cell
+    cmap1.compute_physical_coordinates(x, X, coordinate_dofs1);
+    cmap0.compute_reference_geometry(X0, J, detJ, K, x, coordinate_dofs0);
+    element.evaluate_reference_basis(basis_reference_values, X0);
+    element.transform_reference_basis(basis_values, basis_reference_values,
+                                      X0, J, detJ, K);
+    for (int j = 0; j < space_dimension; ++j)
+    {
+      for (int q = 0; q < num_points; ++q)
+        for (int k = 0; k < value_size; ++k)
+          values(q, k) = basis_values(q, j, k);
+      element.transform_values(A.col(j).data(), values, coordinate_dofs1);
+    }
+
+    auto dofs0 = dofmap0.cell_dofs(p);
+    for (Eigen::Index i = 0; i < dofs1.size(); ++i)
+    {
+      const PetscInt row = dofs1[i];
+      if (row >= num_owned_rows or row_size[row] >= 0)
+        continue;
+
+      row_size[row] = 0;
+      for (int j = 0; j < space_dimension; ++j)
+      {
+        // Skip zero entries, e.g. coarse vertex basis functions at
+        // fine vertices away from the coarse vertex
+        if (std::abs(A(i, j)) < 1.0e-12)
+          continue;
+
+        const std::int64_t col = local_to_global0[dofs0[j]];
+        const std::size_t pos = row * space_dimension + row_size[row]++;
+        columns[pos] = col;
+        entries[pos] = A(i, j);
+        if (col >= n0 and col < n1)
+          ++nnz_diag[row];
+        else
+          ++nnz_offdiag[row];
+      }
+    }
+  }
+
+  // Create matrix, with rows owned by the owners of the fine dofs and
+  // columns owned by the owners of the coarse dofs
+  const MPI_Comm mpi_comm = mesh1.mpi_comm();
+  PetscErrorCode ierr;
+  Mat P;
+  ierr = MatCreate(mpi_comm, &P);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "MatCreate");
+  ierr = MatSetSizes(P, num_owned_rows, n1 - n0,
+                     bs1 * index_map1.size_global(),
+                     bs0 * index_map0.size_global());
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "MatSetSizes");
+  ierr = MatSetType(P, MATAIJ);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "MatSetType");
+  ierr = MatXAIJSetPreallocation(P, 1, nnz_diag.data(), nnz_offdiag.data(),
+                                 nullptr, nullptr);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "MatXAIJSetPreallocation");
+
+  for (std::int32_t i = 0; i < num_owned_rows; ++i)
+  {
+    if (row_size[i] < 0)
+    {
+      throw std::runtime_error("Fine dof " + std::to_string(i)
+                               + " is not in a cell of this process");
+    }
+
+    const PetscInt row = local_to_global1[i];
+    ierr = MatSetValues(P, 1, &row, row_size[i],
+                        columns.data() + i * space_dimension,
+                        entries.data() + i * space_dimension, INSERT_VALUES);
+    if (ierr != 0)
+      la::petsc_error(ierr, __FILE__, "MatSetValues");
+  }
+
+  ierr = MatAssemblyBegin(P, MAT_FINAL_ASSEMBLY);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "MatAssemblyBegin");
+  ierr = MatAssemblyEnd(P, MAT_FINAL_ASSEMBLY);
+  if (ierr != 0)
+    la::petsc_error(ierr, __FILE__, "MatAssemblyEnd");
+
+  return la::PETScMatrix(P, false);
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<fem::PETScDMCollection> MeshHierarchy::create_dm_collection(
+    std::vector<std::shared_ptr<const function::FunctionSpace>>
+        function_spaces) const
+{
+  std::vector<la::PETScMatrix> prolongations;
+  for (std::size_t i = 1; i < function_spaces.size(); ++i)
+  {
+    assert(function_spaces[i - 1]);
+    assert(function_spaces[i]);
+    prolongations.push_back(
+        create_prolongation(*function_spaces[i - 1], *function_spaces[i]));
+  }
+
+  return std::make_shared<fem::PETScDMCollection>(function_spaces,
+                                                  prolongations);
+}
+//-----------------------------------------------------------------------------
+void MeshHierarchy::set_parent_cells(
+    std::size_t i, const std::vector<std::int64_t>& parent_cells)
+{
+  assert(i > 0 and i < _meshes.size());
+  assert(_meshes[i - 1]);
+  assert(_meshes[i]);
+  const mesh::Mesh& mesh0 = *_meshes[i - 1];
+  const int tdim = mesh0.topology().dim();
+  if ((std::int32_t)parent_cells.size() != _meshes[i]->num_entities(tdim))
+  {
+    throw std::runtime_error("Number of parent cells ("
+                             + std::to_string(parent_cells.size())
+                             + ") does not match number of cells ("
+                             + std::to_string(_meshes[i]->num_entities(tdim))
+                             + ")");
+  }
+
+  // Sort the cells of the coarse mesh (including ghosts) by global
+  // index, and look up the parents
+  const std::vector<std::int64_t>& global_cells0
+      = mesh0.topology().global_indices(tdim);
+  std::vector<std::pair<std::int64_t, std::int32_t>> cells0(
+      global_cells0.size());
+  for (std::size_t c = 0; c < global_cells0.size(); ++c)
+    cells0[c] = {global_cells0[c], c};
+  std::sort(cells0.begin(), cells0.end());
+
+  std::vector<std::int32_t>& parents = _parent_cells[i];
+  parents.resize(parent_cells.size());
+  for (std::size_t c = 0; c < parent_cells.size(); ++c)
+  {
+    auto it = std::lower_bound(
+        cells0.begin(), cells0.end(),
+        std::pair<std::int64_t, std::int32_t>(parent_cells[c], 0));
+    if (it == cells0.end() or it->first != parent_cells[c])
+    {
+      throw std::runtime_error(
+          "Parent cell with global index " + std::to_string(parent_cells[c])
+          + " is not on this process. Meshes of a hierarchy must be "
+            "refined without redistribution.");
+    }
+    parents[c] = it->second;
+  }
+}
+//-----------------------------------------------------------------------------
+int MeshHierarchy::level(const mesh::Mesh& mesh) const
+{
+  for (std::size_t i = 0; i < _meshes.size(); ++i)
+    if (_meshes[i].get() == &mesh)
+      return i;
+  return -1;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,111 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace dolfin
+{
+
+namespace fem
+{
+class PETScDMCollection;
+}
+
+namespace function
+{
+class FunctionSpace;
+}
+
+namespace la
+{
+class PETScMatrix;
+}
+
+namespace mesh
+{
+class Mesh;
+}
+
+namespace refinement
+{
+
+/// A sequence of nested meshes, from coarse to fine, in which each
+/// cell of a fine mesh is inside a parent cell of the next coarser
+/// mesh. The meshes are refined in place, so that the parent of each
+/// cell (including ghosts) is on the same process. The prolongation
+/// matrix between function spaces on consecutive levels is built
+/// directly from the parent cells, without searching for the coarse
+/// cells that contain the fine dofs.
+
+class MeshHierarchy
+{
+public:
+  /// Create hierarchy by uniform refinement of a mesh
+  ///
+  /// @param mesh (_mesh::Mesh_)
+  ///         The coarsest mesh
+  /// @param num_refinements (_int_)
+  ///         The number of times the mesh is refined
+  MeshHierarchy(std::shared_ptr<const mesh::Mesh> mesh, int num_refinements);
+
+  /// Create hierarchy from nested meshes, e.g. from
+  /// refine_with_parents(mesh, markers, false)
+  ///
+  /// @param meshes (_std::vector<mesh::Mesh>_)
+  ///         The meshes, from coarse to fine
+  /// @param parent_cells (_std::vector<std::vector<std::int64_t>>_)
+  ///         For each mesh except the coarsest, the global index of the
+  ///         parent of each cell (including ghosts) in the next coarser
+  ///         mesh
+  MeshHierarchy(std::vector<std::shared_ptr<const mesh::Mesh>> meshes,
+                const std::vector<std::vector<std::int64_t>>& parent_cells);
+
+  /// Number of levels, including the coarsest mesh
+  std::size_t num_levels() const;
+
+  /// Return the mesh of level i. The coarsest mesh has index 0. Use
+  /// i=-1 for the finest mesh, i=-2 for the second finest mesh, etc.
+  std::shared_ptr<const mesh::Mesh> mesh(int i) const;
+
+  /// Return the local index of the parent in level i - 1 of each cell
+  /// (including ghosts) of level i, for i > 0 (or i < 0, see mesh())
+  const std::vector<std::int32_t>& parent_cells(int i) const;
+
+  /// Create the interpolation matrix from a function space on one
+  /// level to the function space with the same element on the next
+  /// finer level (prolongation matrix)
+  la::PETScMatrix
+  create_prolongation(const function::FunctionSpace& coarse_space,
+                      const function::FunctionSpace& fine_space) const;
+
+  /// Create a PETScDMCollection for function spaces on the levels of
+  /// the hierarchy, from coarse to fine, with the prolongation
+  /// matrices between consecutive spaces
+  std::shared_ptr<fem::PETScDMCollection> create_dm_collection(
+      std::vector<std::shared_ptr<const function::FunctionSpace>>
+          function_spaces) const;
+
+private:
+  // Convert the global parent indices of level i to local indices
+  void set_parent_cells(std::size_t i,
+                        const std::vector<std::int64_t>& parent_cells);
+
+  // Level of a mesh in the hierarchy, or -1 if not in the hierarchy
+  int level(const mesh::Mesh& mesh) const;
+
+  // The meshes, from coarse to fine
+  std::vector<std::shared_ptr<const mesh::Mesh>> _meshes;
+
+  // Local parent index of each cell of each level (empty for the
+  // coarsest level)
+  std::vector<std::vector<std::int32_t>> _parent_cells;
+};
+} // namespace refinement
+} // namespace dolfin
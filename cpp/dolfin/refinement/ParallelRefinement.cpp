@@ -5,8 +5,11 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "ParallelRefinement.h"
+#include <algorithm>
 #include <dolfin/common/MPI.h>
+#include <dolfin/common/Timer.h>
 #include <dolfin/common/types.h>
+#include <dolfin/mesh/Connectivity.h>
 #include <dolfin/mesh/DistributedMeshTools.h>
 #include <dolfin/mesh/Edge.h>
 #include <dolfin/mesh/Geometry.h>
@@ -14,7 +17,11 @@
 #include <dolfin/mesh/MeshFunction.h>
 #include <dolfin/mesh/MeshIterator.h>
 #include <dolfin/mesh/Partitioning.h>
-#include <map>
+#include <dolfin/mesh/Topology.h>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 using namespace dolfin;
@@ -22,21 +29,69 @@ using namespace dolfin::refinement;
 
 //-----------------------------------------------------------------------------
 ParallelRefinement::ParallelRefinement(const mesh::Mesh& mesh)
-    : _mesh(mesh),
-      _shared_edges(
-          mesh::DistributedMeshTools::compute_shared_entities(_mesh, 1)),
-      _marked_edges(mesh.num_entities(1), false),
-      _marked_for_update(MPI::size(mesh.mpi_comm()))
+    : _mesh(mesh), _marked_edges((mesh.num_entities(1) + 63) / 64, 0)
 {
-  // Do nothing
+  // Processes sharing each edge
+  const std::unordered_map<std::int32_t,
+                           std::vector<std::pair<std::int32_t, std::int32_t>>>
+      shared_edges
+      = mesh::DistributedMeshTools::compute_shared_entities(_mesh, 1);
+  for (auto const& edge : shared_edges)
+    for (auto const& proc_edge : edge.second)
+      _neighbours.push_back(proc_edge.first);
+  std::sort(_neighbours.begin(), _neighbours.end());
+  _neighbours.erase(std::unique(_neighbours.begin(), _neighbours.end()),
+                    _neighbours.end());
+
+  // Store the sharing of the edges in flat arrays, with the position
+  // of each sharing process in the neighbours
+  const std::int32_t num_edges = _mesh.num_entities(1);
+  _shared_edge_offsets.assign(num_edges + 1, 0);
+  for (auto const& edge : shared_edges)
+    _shared_edge_offsets[edge.first + 1] = edge.second.size();
+  std::partial_sum(_shared_edge_offsets.begin(), _shared_edge_offsets.end(),
+                   _shared_edge_offsets.begin());
+  _shared_edges.resize(_shared_edge_offsets.back());
+  for (auto const& edge : shared_edges)
+  {
+    std::int32_t pos = _shared_edge_offsets[edge.first];
+    for (auto const& proc_edge : edge.second)
+    {
+      const std::int32_t neighbour
+          = std::lower_bound(_neighbours.begin(), _neighbours.end(),
+                             proc_edge.first)
+            - _neighbours.begin();
+      _shared_edges[pos++] = {neighbour, proc_edge.second};
+    }
+  }
+  _marked_for_update.resize(_neighbours.size());
+
+  // Create the neighbourhood communicator. Edge sharing is symmetric,
+  // so the sources and destinations are the same processes.
+  int err = MPI_Dist_graph_create_adjacent(
+      _mesh.mpi_comm(), _neighbours.size(), _neighbours.data(),
+      MPI_UNWEIGHTED, _neighbours.size(), _neighbours.data(), MPI_UNWEIGHTED,
+      MPI_INFO_NULL, false, &_neighbour_comm);
+  if (err != MPI_SUCCESS)
+  {
+    throw std::runtime_error("Creation of neighbourhood communicator failed "
+                             "(MPI_Dist_graph_create_adjacent)");
+  }
 }
 //-----------------------------------------------------------------------------
+ParallelRefinement::~ParallelRefinement() { MPI_Comm_free(&_neighbour_comm); }
+//-----------------------------------------------------------------------------
 const mesh::Mesh& ParallelRefinement::mesh() const { return _mesh; }
 //-----------------------------------------------------------------------------
 bool ParallelRefinement::is_marked(std::int32_t edge_index) const
 {
   assert(edge_index < _mesh.num_entities(1));
-  return _marked_edges[edge_index];
+  return (_marked_edges[edge_index / 64] >> (edge_index % 64)) & 1;
+}
+//-----------------------------------------------------------------------------
+const std::vector<std::uint64_t>& ParallelRefinement::marked_edges() const
+{
+  return _marked_edges;
 }
 //-----------------------------------------------------------------------------
 void ParallelRefinement::mark(std::int32_t edge_index)
@@ -44,29 +99,33 @@ void ParallelRefinement::mark(std::int32_t edge_index)
   assert(edge_index < _mesh.num_entities(1));
 
   // Already marked, so nothing to do
-  if (_marked_edges[edge_index])
+  std::uint64_t& word = _marked_edges[edge_index / 64];
+  const std::uint64_t bit = std::uint64_t(1) << (edge_index % 64);
+  if (word & bit)
     return;
 
-  _marked_edges[edge_index] = true;
-  auto map_it = _shared_edges.find(edge_index);
+  word |= bit;
 
   // If it is a shared edge, add all sharing procs to update set
-  if (map_it != _shared_edges.end())
+  for (std::int32_t i = _shared_edge_offsets[edge_index];
+       i < _shared_edge_offsets[edge_index + 1]; ++i)
   {
-    for (auto const& it : map_it->second)
-      _marked_for_update[it.first].push_back(it.second);
+    _marked_for_update[_shared_edges[i].first].push_back(
+        _shared_edges[i].second);
   }
 }
 //-----------------------------------------------------------------------------
 void ParallelRefinement::mark_all()
 {
-  _marked_edges.assign(_mesh.num_entities(1), true);
+  const std::int32_t num_edges = _mesh.num_entities(1);
+  _marked_edges.assign(_marked_edges.size(), ~std::uint64_t(0));
+  if (num_edges % 64 != 0)
+    _marked_edges.back() = (std::uint64_t(1) << (num_edges % 64)) - 1;
 }
 //-----------------------------------------------------------------------------
-const std::map<std::size_t, std::size_t>&
-ParallelRefinement::edge_to_new_vertex() const
+const std::vector<std::int64_t>& ParallelRefinement::edge_to_new_vertex() const
 {
-  return _local_edge_to_new_vertex;
+  return _edge_to_new_vertex;
 }
 //-----------------------------------------------------------------------------
 void ParallelRefinement::mark(const mesh::MeshEntity& entity)
@@ -97,7 +156,7 @@ ParallelRefinement::marked_edge_list(const mesh::MeshEntity& cell) const
   std::size_t i = 0;
   for (const auto& edge : mesh::EntityRange<mesh::Edge>(cell))
   {
-    if (_marked_edges[edge.index()])
+    if (is_marked(edge.index()))
       result.push_back(i);
     ++i;
   }
@@ -106,20 +165,40 @@ ParallelRefinement::marked_edge_list(const mesh::MeshEntity& cell) const
 //-----------------------------------------------------------------------------
 void ParallelRefinement::update_logical_edgefunction()
 {
-  const std::size_t mpi_size = MPI::size(_mesh.mpi_comm());
+  const std::size_t num_neighbours = _neighbours.size();
 
-  // Send all shared edges marked for update and receive from other
-  // processes
-  std::vector<std::size_t> received_values;
-  MPI::all_to_all(_mesh.mpi_comm(), _marked_for_update, received_values);
-
-  // Clear marked_for_update vectors
-  _marked_for_update = std::vector<std::vector<std::size_t>>(mpi_size);
-
-  // Flatten received values and set edges mesh::MeshFunction true at
-  // each index received
-  for (auto const& local_index : received_values)
-    _marked_edges[local_index] = true;
+  // Send the shared edges marked for update to the neighbours that
+  // share them, and receive from the neighbours
+  std::vector<int> send_sizes(num_neighbours), send_offsets(num_neighbours + 1, 0);
+  for (std::size_t i = 0; i < num_neighbours; ++i)
+  {
+    send_sizes[i] = _marked_for_update[i].size();
+    send_offsets[i + 1] = send_offsets[i] + send_sizes[i];
+  }
+  std::vector<int> recv_sizes(num_neighbours), recv_offsets(num_neighbours + 1, 0);
+  MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI_INT, recv_sizes.data(), 1,
+                        MPI_INT, _neighbour_comm);
+  for (std::size_t i = 0; i < num_neighbours; ++i)
+    recv_offsets[i + 1] = recv_offsets[i] + recv_sizes[i];
+
+  std::vector<std::int32_t> send_values(send_offsets.back());
+  for (std::size_t i = 0; i < num_neighbours; ++i)
+  {
+    std::copy(_marked_for_update[i].begin(), _marked_for_update[i].end(),
+              send_values.begin() + send_offsets[i]);
+    _marked_for_update[i].clear();
+  }
+  std::vector<std::int32_t> received_values(recv_offsets.back());
+  MPI_Neighbor_alltoallv(send_values.data(), send_sizes.data(),
+                         send_offsets.data(), MPI::mpi_type<std::int32_t>(),
+                         received_values.data(), recv_sizes.data(),
+                         recv_offsets.data(), MPI::mpi_type<std::int32_t>(),
+                         _neighbour_comm);
+
+  // Mark the received edges. They are marked on all sharing processes
+  // already, so are not sent on.
+  for (std::int32_t local_index : received_values)
+    _marked_edges[local_index / 64] |= std::uint64_t(1) << (local_index % 64);
 }
 //-----------------------------------------------------------------------------
 void ParallelRefinement::create_new_vertices()
@@ -136,24 +215,22 @@ void ParallelRefinement::create_new_vertices()
 
   // Tally up unshared marked edges, and shared marked edges which are
   // owned on this process.  Index them sequentially from zero.
-  std::size_t n = 0;
-  for (std::int32_t local_i = 0; local_i < _mesh.num_entities(1); ++local_i)
+  const std::int32_t num_edges = _mesh.num_entities(1);
+  _edge_to_new_vertex.assign(num_edges, -1);
+  std::int64_t n = 0;
+  for (std::int32_t local_i = 0; local_i < num_edges; ++local_i)
   {
-    if (_marked_edges[local_i] == true)
+    if (is_marked(local_i))
     {
       // Assume this edge is owned locally
       bool owner = true;
 
-      // If shared, check that this is true
-      auto shared_edge_i = _shared_edges.find(local_i);
-      if (shared_edge_i != _shared_edges.end())
+      // If shared, check if any other sharing process has a lower rank
+      for (std::int32_t i = _shared_edge_offsets[local_i];
+           i < _shared_edge_offsets[local_i + 1]; ++i)
       {
-        // check if any other sharing process has a lower rank
-        for (auto const& proc_edge : shared_edge_i->second)
-        {
-          if (proc_edge.first < mpi_rank)
-            owner = false;
-        }
+        if (_neighbours[_shared_edges[i].first] < mpi_rank)
+          owner = false;
       }
 
       // If it is still believed to be owned on this process, add to
@@ -163,7 +240,7 @@ void ParallelRefinement::create_new_vertices()
         const Eigen::Vector3d midpoint = mesh::Edge(_mesh, local_i).midpoint();
         for (std::size_t j = 0; j < 3; ++j)
           _new_vertex_coordinates.push_back(midpoint[j]);
-        _local_edge_to_new_vertex[local_i] = n++;
+        _edge_to_new_vertex[local_i] = n++;
       }
     }
   }
@@ -178,24 +255,24 @@ void ParallelRefinement::create_new_vertices()
   // sent off-process.  Add offset to map, and collect up any shared
   // new vertices that need to send the new index off-process
   std::vector<std::vector<std::size_t>> values_to_send(mpi_size);
-  for (auto& local_edge : _local_edge_to_new_vertex)
+  for (std::int32_t local_i = 0; local_i < num_edges; ++local_i)
   {
-    // Add global_offset to map, to get new global index of new
-    // vertices
-    local_edge.second += global_offset;
+    // Only locally owned edges have been numbered so far
+    std::int64_t& new_vertex = _edge_to_new_vertex[local_i];
+    if (new_vertex < 0)
+      continue;
+
+    // Add global_offset, to get new global index of new vertices
+    new_vertex += global_offset;
 
-    const std::size_t local_i = local_edge.first;
     // shared, but locally owned : remote owned are not in list.
-    auto shared_edge_i = _shared_edges.find(local_i);
-    if (shared_edge_i != _shared_edges.end())
+    for (std::int32_t i = _shared_edge_offsets[local_i];
+         i < _shared_edge_offsets[local_i + 1]; ++i)
     {
-      for (auto const& remote_process_edge : _shared_edges[local_i])
-      {
-        const std::size_t remote_proc_num = remote_process_edge.first;
-        // send mapping from remote local edge index to new global vertex index
-        values_to_send[remote_proc_num].push_back(remote_process_edge.second);
-        values_to_send[remote_proc_num].push_back(local_edge.second);
-      }
+      const std::size_t remote_proc_num = _neighbours[_shared_edges[i].first];
+      // send mapping from remote local edge index to new global vertex index
+      values_to_send[remote_proc_num].push_back(_shared_edges[i].second);
+      values_to_send[remote_proc_num].push_back(new_vertex);
     }
   }
 
@@ -203,38 +280,34 @@ void ParallelRefinement::create_new_vertices()
   std::vector<std::size_t> received_values;
   MPI::all_to_all(_mesh.mpi_comm(), values_to_send, received_values);
 
-  // Add received remote global vertex indices to map
+  // Add received remote global vertex indices
   for (auto q = received_values.begin(); q != received_values.end(); q += 2)
-    _local_edge_to_new_vertex[*q] = *(q + 1);
+    _edge_to_new_vertex[*q] = *(q + 1);
 
-  // Attach global indices to each vertex, old and new, and sort
-  // them across processes into this order
-
-  std::vector<std::int64_t> global_indices(_mesh.topology().global_indices(0));
+  // Attach global indices to each vertex, old and new
+  _new_vertex_global_indices = _mesh.topology().global_indices(0);
   for (std::size_t i = 0; i < num_new_vertices; i++)
-    global_indices.push_back(i + global_offset);
-
-  Eigen::Map<EigenRowArrayXXd> old_tmp(_new_vertex_coordinates.data(),
-                                       _new_vertex_coordinates.size() / 3, 3);
-  EigenRowArrayXXd tmp = mesh::DistributedMeshTools::reorder_by_global_indices(
-      _mesh.mpi_comm(), old_tmp, global_indices);
-
-  _new_vertex_coordinates
-      = std::vector<double>(tmp.data(), tmp.data() + tmp.size());
+    _new_vertex_global_indices.push_back(i + global_offset);
+}
+//-----------------------------------------------------------------------------
+EigenRowArrayXXd ParallelRefinement::ordered_vertex_coordinates() const
+{
+  // Sort vertices across processes into global index order
+  Eigen::Map<const EigenRowArrayXXd> coordinates(
+      _new_vertex_coordinates.data(), _new_vertex_coordinates.size() / 3, 3);
+  return mesh::DistributedMeshTools::reorder_by_global_indices(
+      _mesh.mpi_comm(), coordinates, _new_vertex_global_indices);
 }
 //-----------------------------------------------------------------------------
 mesh::Mesh ParallelRefinement::build_local() const
 {
   const std::size_t tdim = _mesh.topology().dim();
-  assert(_new_vertex_coordinates.size() % 3 == 0);
-  const std::size_t num_vertices = _new_vertex_coordinates.size() / 3;
+  const EigenRowArrayXXd geometry = ordered_vertex_coordinates();
 
   const std::size_t num_cell_vertices = tdim + 1;
   assert(_new_cell_topology.size() % num_cell_vertices == 0);
   const std::size_t num_cells = _new_cell_topology.size() / num_cell_vertices;
 
-  Eigen::Map<const EigenRowArrayXXd> geometry(_new_vertex_coordinates.data(),
-                                              num_vertices, 3);
   Eigen::Map<const EigenRowArrayXXi64> topology(_new_cell_topology.data(),
                                                 num_cells, num_cell_vertices);
 
@@ -260,9 +333,7 @@ mesh::Mesh ParallelRefinement::partition(bool redistribute) const
   Eigen::Map<const EigenRowArrayXXi64> cells(
       _new_cell_topology.data(), num_local_cells, num_vertices_per_cell);
 
-  const std::size_t num_local_vertices = _new_vertex_coordinates.size() / 3;
-  Eigen::Map<const EigenRowArrayXXd> points(_new_vertex_coordinates.data(),
-                                            num_local_vertices, 3);
+  const EigenRowArrayXXd points = ordered_vertex_coordinates();
 
   return mesh::Partitioning::build_distributed_mesh(
       _mesh.mpi_comm(), _mesh.type().cell_type(), points, cells,
@@ -274,3 +345,242 @@ void ParallelRefinement::new_cells(const std::vector<std::int64_t>& idx)
   _new_cell_topology.insert(_new_cell_topology.end(), idx.begin(), idx.end());
 }
 //-----------------------------------------------------------------------------
+void ParallelRefinement::set_new_cells(std::vector<std::int64_t> topology)
+{
+  _new_cell_topology = std::move(topology);
+}
+//-----------------------------------------------------------------------------
+void ParallelRefinement::number_local_vertices()
+{
+  const std::int32_t tdim = _mesh.topology().dim();
+  const std::int32_t num_vertices = _mesh.num_entities(0);
+  const std::int32_t num_owned_vertices = _mesh.topology().ghost_offset(0);
+  const std::int32_t num_edges = _mesh.num_entities(1);
+  assert((std::int32_t)_edge_to_new_vertex.size() == num_edges);
+
+  // Find edges of owned cells
+  std::vector<bool> owned_edge(num_edges, false);
+  const mesh::ConnectivityView c_to_e
+      = _mesh.topology().connectivity_view(tdim, 1);
+  for (std::int32_t c = 0; c < _mesh.topology().ghost_offset(tdim); ++c)
+  {
+    const std::int32_t* cell_edges = c_to_e.connections(c);
+    for (std::int32_t i = 0; i < c_to_e.size(c); ++i)
+      owned_edge[cell_edges[i]] = true;
+  }
+
+  std::int32_t num_owned_new_vertices = 0;
+  for (std::int32_t e = 0; e < num_edges; ++e)
+    if (owned_edge[e] and _edge_to_new_vertex[e] >= 0)
+      ++num_owned_new_vertices;
+
+  // Vertices of owned cells, new vertices of owned cells, vertices of
+  // ghost cells only, new vertices of ghost cells only
+  _local_vertex_indices.resize(num_vertices);
+  for (std::int32_t v = 0; v < num_vertices; ++v)
+  {
+    _local_vertex_indices[v]
+        = (v < num_owned_vertices) ? v : v + num_owned_new_vertices;
+  }
+
+  std::int64_t owned_index = num_owned_vertices;
+  std::int64_t ghost_index = num_vertices + num_owned_new_vertices;
+  _local_edge_to_new_vertex.assign(num_edges, -1);
+  for (std::int32_t e = 0; e < num_edges; ++e)
+  {
+    if (_edge_to_new_vertex[e] >= 0)
+    {
+      _local_edge_to_new_vertex[e]
+          = owned_edge[e] ? owned_index++ : ghost_index++;
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+const std::vector<std::int64_t>&
+ParallelRefinement::local_vertex_indices() const
+{
+  return _local_vertex_indices;
+}
+//-----------------------------------------------------------------------------
+const std::vector<std::int64_t>&
+ParallelRefinement::local_edge_to_new_vertex() const
+{
+  return _local_edge_to_new_vertex;
+}
+//-----------------------------------------------------------------------------
+mesh::Mesh
+ParallelRefinement::build_incremental(const std::vector<std::int64_t>& cells,
+                                      const std::vector<std::int64_t>& offsets) const
+{
+  common::Timer t0("PLAZA: Build refined mesh in place");
+
+  const MPI_Comm mpi_comm = _mesh.mpi_comm();
+  const std::int32_t mpi_size = MPI::size(mpi_comm);
+  const mesh::Topology& topology = _mesh.topology();
+  const std::int32_t tdim = topology.dim();
+  const std::int32_t num_cell_vertices = tdim + 1;
+  const std::int32_t num_cells = _mesh.num_entities(tdim);
+  const std::int32_t num_owned_cells = topology.ghost_offset(tdim);
+  assert((std::int32_t)offsets.size() == num_cells + 1);
+  const std::int32_t num_new_cells = offsets.back();
+  const std::int32_t num_new_owned_cells = offsets[num_owned_cells];
+  assert(_local_vertex_indices.size() == (std::size_t)_mesh.num_entities(0));
+
+  // Points: the old vertices, and the midpoint of each marked edge
+  const std::int32_t num_vertices = _mesh.num_entities(0);
+  const std::int32_t num_points
+      = num_vertices
+        + std::count_if(_local_edge_to_new_vertex.begin(),
+                        _local_edge_to_new_vertex.end(),
+                        [](std::int64_t v) { return v >= 0; });
+  const int gdim = _mesh.geometry().dim();
+  const auto& x = _mesh.geometry().points();
+  const std::vector<std::int64_t>& global_vertices = topology.global_indices(0);
+  EigenRowArrayXXd points(num_points, gdim);
+  std::vector<std::int64_t> global_points(num_points);
+  std::int64_t max_index = _mesh.num_entities_global(0) - 1;
+  for (std::int32_t v = 0; v < num_vertices; ++v)
+  {
+    const std::int64_t p = _local_vertex_indices[v];
+    points.row(p) = x.row(v).leftCols(gdim);
+    global_points[p] = global_vertices[v];
+  }
+  const mesh::ConnectivityView e_to_v = topology.connectivity_view(1, 0);
+  for (std::int32_t e = 0; e < _mesh.num_entities(1); ++e)
+  {
+    const std::int64_t p = _local_edge_to_new_vertex[e];
+    if (p < 0)
+      continue;
+    const std::int32_t* edge_vertices = e_to_v.connections(e);
+    points.row(p) = 0.5
+                    * (x.row(edge_vertices[0]) + x.row(edge_vertices[1]))
+                          .leftCols(gdim);
+    global_points[p] = _edge_to_new_vertex[e];
+    max_index = std::max(max_index, _edge_to_new_vertex[e]);
+  }
+  const std::int64_t num_points_global = MPI::max(mpi_comm, max_index) + 1;
+
+  // Old vertices keep their sharing processes, and the new vertex of
+  // an edge is shared by the processes that share the edge
+  std::vector<std::pair<std::int32_t, std::int32_t>> point_processes;
+  const mesh::SharedEntities& shared_vertices = topology.shared_entities(0);
+  for (std::int32_t i = 0; i < shared_vertices.size(); ++i)
+  {
+    const std::int32_t p = _local_vertex_indices[shared_vertices.entities()[i]];
+    for (std::int32_t j = 0; j < shared_vertices.num_processes(i); ++j)
+      point_processes.push_back({p, shared_vertices.processes(i)[j]});
+  }
+  // (Shared entities are not computed in serial or for unghosted
+  // cells)
+  const mesh::SharedEntities no_shared_entities;
+  const mesh::SharedEntities& shared_edges
+      = topology.have_shared_entities(1) ? topology.shared_entities(1)
+                                         : no_shared_entities;
+  for (std::int32_t i = 0; i < shared_edges.size(); ++i)
+  {
+    const std::int64_t p
+        = _local_edge_to_new_vertex[shared_edges.entities()[i]];
+    if (p < 0)
+      continue;
+    for (std::int32_t j = 0; j < shared_edges.num_processes(i); ++j)
+      point_processes.push_back({p, shared_edges.processes(i)[j]});
+  }
+  const mesh::SharedEntities shared_points
+      = mesh::SharedEntities::create(std::move(point_processes));
+
+  // Global indices of the children of owned cells, numbered from
+  // process 0 upwards
+  const std::int64_t cell_offset
+      = MPI::global_offset(mpi_comm, num_new_owned_cells, true);
+  std::vector<std::int64_t> global_cells(num_new_cells);
+  std::iota(global_cells.begin(), global_cells.begin() + num_new_owned_cells,
+            cell_offset);
+
+  // Send the global index of the first child of each shared owned cell
+  // to the processes that have it as a ghost
+  const mesh::SharedEntities& shared_cells
+      = topology.have_shared_entities(tdim) ? topology.shared_entities(tdim)
+                                            : no_shared_entities;
+  const std::vector<std::int64_t>& global_old_cells
+      = topology.global_indices(tdim);
+  std::vector<std::vector<std::int64_t>> send_children(mpi_size);
+  for (std::int32_t i = 0; i < shared_cells.size(); ++i)
+  {
+    const std::int32_t c = shared_cells.entities()[i];
+    if (c >= num_owned_cells)
+      break;
+    for (std::int32_t j = 0; j < shared_cells.num_processes(i); ++j)
+    {
+      const std::int32_t p = shared_cells.processes(i)[j];
+      send_children[p].push_back(global_old_cells[c]);
+      send_children[p].push_back(cell_offset + offsets[c]);
+    }
+  }
+  std::vector<std::int64_t> recv_children;
+  MPI::all_to_all(mpi_comm, send_children, recv_children);
+
+  // Children of ghost cells get the global indices given by the owner
+  std::vector<std::pair<std::int64_t, std::int64_t>> first_child;
+  first_child.reserve(recv_children.size() / 2);
+  for (std::size_t i = 0; i < recv_children.size(); i += 2)
+    first_child.push_back({recv_children[i], recv_children[i + 1]});
+  std::sort(first_child.begin(), first_child.end());
+  for (std::int32_t c = num_owned_cells; c < num_cells; ++c)
+  {
+    auto it = std::lower_bound(first_child.begin(), first_child.end(),
+                               std::make_pair(global_old_cells[c],
+                                              std::int64_t(-1)));
+    if (it == first_child.end() or it->first != global_old_cells[c])
+    {
+      throw std::runtime_error("Owner of ghost cell "
+                               + std::to_string(global_old_cells[c])
+                               + " did not send its children");
+    }
+    std::iota(global_cells.begin() + offsets[c],
+              global_cells.begin() + offsets[c + 1], it->second);
+  }
+
+  Eigen::Map<const EigenRowArrayXXi64> cell_points(
+      cells.data(), num_new_cells, num_cell_vertices);
+  const EigenRowArrayXXi32 local_cells = cell_points.cast<std::int32_t>();
+  mesh::Mesh mesh(mpi_comm, _mesh.type().cell_type(), points, global_points,
+                  num_points_global, shared_points, local_cells, global_cells,
+                  _mesh.get_ghost_mode(), num_new_cells - num_new_owned_cells);
+
+  if (_mesh.get_ghost_mode() != mesh::GhostMode::none)
+  {
+    // Children have the owner and sharing processes of their parent
+    const std::vector<std::int32_t>& old_cell_owner = topology.cell_owner();
+    std::vector<std::int32_t>& cell_owner = mesh.topology().cell_owner();
+    cell_owner.clear();
+    for (std::int32_t c = num_owned_cells; c < num_cells; ++c)
+    {
+      cell_owner.insert(cell_owner.end(), offsets[c + 1] - offsets[c],
+                        old_cell_owner[c - num_owned_cells]);
+    }
+
+    std::vector<std::pair<std::int32_t, std::int32_t>> cell_processes;
+    for (std::int32_t i = 0; i < shared_cells.size(); ++i)
+    {
+      const std::int32_t c = shared_cells.entities()[i];
+      for (std::int64_t child = offsets[c]; child < offsets[c + 1]; ++child)
+        for (std::int32_t j = 0; j < shared_cells.num_processes(i); ++j)
+          cell_processes.push_back({child, shared_cells.processes(i)[j]});
+    }
+    mesh.topology().shared_entities(tdim)
+        = mesh::SharedEntities::create(std::move(cell_processes));
+
+    std::vector<std::int32_t> layer_offsets = topology.ghost_layer_offsets();
+    for (auto& offset : layer_offsets)
+      offset = offsets[offset];
+    mesh.topology().ghost_layer_offsets() = std::move(layer_offsets);
+  }
+
+  // Initialise number of globally connected cells to each facet (not
+  // needed in serial, see build_local)
+  if (mpi_size > 1)
+    mesh::DistributedMeshTools::init_facet_cell_connections(mesh);
+
+  return mesh;
+}
+//-----------------------------------------------------------------------------
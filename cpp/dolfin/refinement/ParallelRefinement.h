@@ -7,8 +7,9 @@
 #pragma once
 
 #include <cstdint>
-#include <map>
-#include <unordered_map>
+#include <dolfin/common/MPI.h>
+#include <dolfin/common/types.h>
+#include <utility>
 #include <vector>
 
 namespace dolfin
@@ -37,8 +38,11 @@ public:
   /// Constructor
   ParallelRefinement(const mesh::Mesh& mesh);
 
+  /// Copy constructor (deleted)
+  ParallelRefinement(const ParallelRefinement& p) = delete;
+
   /// Destructor
-  ~ParallelRefinement() = default;
+  ~ParallelRefinement();
 
   /// Original mesh associated with this refinement
   const mesh::Mesh& mesh() const;
@@ -47,6 +51,10 @@ public:
   /// @param edge_index (std::int32_t)
   bool is_marked(std::int32_t edge_index) const;
 
+  /// Return marked status of all edges, packed with one bit per edge:
+  /// edge i is marked if bit i % 64 of word i / 64 is set
+  const std::vector<std::uint64_t>& marked_edges() const;
+
   /// Mark edge by index
   /// @param edge_index (std::int32_t)
   ///  Index of edge to mark
@@ -69,7 +77,8 @@ public:
   /// @param cell (const _mesh::MeshEntity_)
   std::vector<std::size_t> marked_edge_list(const mesh::MeshEntity& cell) const;
 
-  /// Transfer marked edges between processes
+  /// Transfer marked edges between processes. Edges marked since the
+  /// last update are sent only to the processes that share them.
   void update_logical_edgefunction();
 
   /// Add new vertex for each marked edge, and create
@@ -77,14 +86,21 @@ public:
   /// Communicate new vertices with MPI to all affected processes.
   void create_new_vertices();
 
-  /// Mapping of old edge (to be removed) to new global vertex number.
+  /// Global index of the new vertex on each edge of the old mesh
+  /// (indexed by local edge index), or -1 if the edge is not marked.
   /// Useful for forming new topology
-  const std::map<std::size_t, std::size_t>& edge_to_new_vertex() const;
+  const std::vector<std::int64_t>& edge_to_new_vertex() const;
 
   /// Add new cells with vertex indices
   /// @param idx (const std::vector<std::size_t>)
   void new_cells(const std::vector<std::int64_t>& idx);
 
+  /// Set the vertex indices of all new cells, replacing any cells
+  /// already added
+  /// @param topology (std::vector<std::int64_t>)
+  ///  Global vertex indices of the new cells, flattened row-wise
+  void set_new_cells(std::vector<std::int64_t> topology);
+
   /// Use vertex and topology data to partition new mesh across processes
   /// @param redistribute (bool)
   /// @returns mesh::Mesh
@@ -94,30 +110,82 @@ public:
   /// @returns mesh::Mesh
   mesh::Mesh build_local() const;
 
+  /// Number the vertices of the new mesh locally, for building it in
+  /// place with build_incremental(). Must be called after
+  /// create_new_vertices(). The existing vertices and the new vertices
+  /// of the edges of owned cells are numbered first.
+  void number_local_vertices();
+
+  /// Local index in the new mesh of each vertex of the old mesh (see
+  /// number_local_vertices)
+  const std::vector<std::int64_t>& local_vertex_indices() const;
+
+  /// Local index in the new mesh of the new vertex on each edge of the
+  /// old mesh (indexed by local edge index), or -1 if the edge is not
+  /// marked (see number_local_vertices)
+  const std::vector<std::int64_t>& local_edge_to_new_vertex() const;
+
+  /// Build the new mesh in place, keeping the cells of the old mesh on
+  /// the same processes. The children of the ghost cells of the old
+  /// mesh are the ghost cells of the new mesh, with the same owner
+  /// and sharing processes. Global vertex indices are kept, and
+  /// global cell indices are numbered from process 0 upwards.
+  /// @param cells (const std::vector<std::int64_t>)
+  ///  Local vertex indices (see number_local_vertices) of the new
+  ///  cells, flattened row-wise, with the children of each cell of the
+  ///  old mesh (including ghosts) contiguous and in cell order
+  /// @param offsets (const std::vector<std::int64_t>)
+  ///  Position of the children of each cell of the old mesh in cells,
+  ///  in units of cells (size is number of cells + 1)
+  /// @returns mesh::Mesh
+  mesh::Mesh build_incremental(const std::vector<std::int64_t>& cells,
+                               const std::vector<std::int64_t>& offsets) const;
+
 private:
+  // Coordinates of old and new vertices, in global index order across
+  // processes
+  EigenRowArrayXXd ordered_vertex_coordinates() const;
+
   // mesh::Mesh reference
   const mesh::Mesh& _mesh;
 
-  // Shared edges between processes. In R^2, vector size is 1
-  std::unordered_map<std::int32_t,
-                     std::vector<std::pair<std::int32_t, std::int32_t>>>
-      _shared_edges;
+  // Processes that share edges with this process (neighbours)
+  std::vector<std::int32_t> _neighbours;
+
+  // Distributed graph communicator of the neighbours, for exchanging
+  // marked edges
+  MPI_Comm _neighbour_comm;
+
+  // Sharing of each local edge e, in positions [_shared_edge_offsets[e],
+  // _shared_edge_offsets[e + 1]) of _shared_edges, as (neighbour, local
+  // index of the edge on the neighbour) pairs
+  std::vector<std::int32_t> _shared_edge_offsets;
+  std::vector<std::pair<std::int32_t, std::int32_t>> _shared_edges;
 
-  // Mapping from old local edge index to new global vertex, needed to
-  // create new topology
-  std::map<std::size_t, std::size_t> _local_edge_to_new_vertex;
+  // New global vertex of each old local edge (-1 if not marked),
+  // needed to create new topology
+  std::vector<std::int64_t> _edge_to_new_vertex;
 
-  // New storage for all coordinates when creating new vertices
+  // New storage for all coordinates when creating new vertices (old
+  // vertices, then new vertices owned by this process)
   std::vector<double> _new_vertex_coordinates;
 
+  // Global index of each point in _new_vertex_coordinates
+  std::vector<std::int64_t> _new_vertex_global_indices;
+
+  // Local numbering of vertices for building the new mesh in place
+  std::vector<std::int64_t> _local_vertex_indices;
+  std::vector<std::int64_t> _local_edge_to_new_vertex;
+
   // New storage for all cells when creating new topology
   std::vector<std::int64_t> _new_cell_topology;
 
-  // Management of marked edges
-  std::vector<bool> _marked_edges;
+  // Marked edges, one bit per edge
+  std::vector<std::uint64_t> _marked_edges;
 
-  // Temporary storage for edges that have been recently marked
-  std::vector<std::vector<std::size_t>> _marked_for_update;
+  // Local indices, on each neighbour, of the shared edges that have
+  // been marked since the last update
+  std::vector<std::vector<std::int32_t>> _marked_for_update;
 };
 } // namespace refinement
 } // namespace dolfin
@@ -6,15 +6,22 @@
 
 #include "PlazaRefinementND.h"
 #include "ParallelRefinement.h"
+#include <algorithm>
+#include <dolfin/common/MPI.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/Connectivity.h>
+#include <dolfin/mesh/DistributedMeshTools.h>
 #include <dolfin/mesh/Edge.h>
 #include <dolfin/mesh/Face.h>
+#include <dolfin/mesh/Geometry.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshIterator.h>
+#include <dolfin/mesh/Topology.h>
 #include <dolfin/mesh/Vertex.h>
 #include <limits>
-#include <map>
+#include <numeric>
+#include <tuple>
 #include <vector>
 
 using namespace dolfin;
@@ -30,7 +37,20 @@ void enforce_rules(ParallelRefinement& p_ref, const mesh::Mesh& mesh,
   common::Timer t0("PLAZA: Enforce rules");
 
   // Enforce rule, that if any edge of a face is marked, longest edge
-  // must also be marked
+  // must also be marked. Faces whose longest edge is marked are done,
+  // so only the remaining (active) faces are checked. The faces are
+  // swept until no more edges are marked locally, and then the marked
+  // shared edges are exchanged with the neighbouring processes.
+  const mesh::ConnectivityView f_to_e
+      = mesh.topology().connectivity_view(2, 1);
+  const std::int32_t num_faces = mesh.topology().ghost_offset(2);
+  std::vector<std::int32_t> active_faces(num_faces);
+  std::iota(active_faces.begin(), active_faces.end(), 0);
+
+  const std::vector<std::uint64_t>& marked = p_ref.marked_edges();
+  auto is_marked = [&marked](std::int32_t e) -> std::uint64_t {
+    return (marked[e / 64] >> (e % 64)) & 1;
+  };
 
   std::int32_t update_count = 1;
   while (update_count != 0)
@@ -38,121 +58,430 @@ void enforce_rules(ParallelRefinement& p_ref, const mesh::Mesh& mesh,
     update_count = 0;
     p_ref.update_logical_edgefunction();
 
-    for (const auto& f : mesh::MeshRange<mesh::Face>(mesh))
+    std::int32_t sweep_count = 1;
+    while (sweep_count != 0)
     {
-      const std::int32_t long_e = long_edge[f.index()];
-      if (p_ref.is_marked(long_e))
-        continue;
-      bool any_marked = false;
-      for (const auto& e : mesh::EntityRange<mesh::Edge>(f))
-        any_marked |= p_ref.is_marked(e.index());
-      if (any_marked)
+      sweep_count = 0;
+      std::size_t num_active = 0;
+      for (std::int32_t f : active_faces)
       {
-        p_ref.mark(long_e);
-        ++update_count;
+        const std::int32_t long_e = long_edge[f];
+        if (is_marked(long_e))
+          continue;
+
+        const std::int32_t* edges = f_to_e.connections(f);
+        if (is_marked(edges[0]) | is_marked(edges[1]) | is_marked(edges[2]))
+        {
+          p_ref.mark(long_e);
+          ++sweep_count;
+        }
+        else
+          active_faces[num_active++] = f;
       }
+      active_faces.resize(num_active);
+      update_count += sweep_count;
     }
+
     update_count = dolfin::MPI::sum(mesh.mpi_comm(), update_count);
   }
 }
 //-----------------------------------------------------------------------------
-// Convenient interface for both uniform and marker refinement
-mesh::Mesh compute_refinement(const mesh::Mesh& mesh, ParallelRefinement& p_ref,
-                              const std::vector<std::int32_t>& long_edge,
-                              const std::vector<bool>& edge_ratio_ok,
-                              bool redistribute)
+// Subdivisions of a cell, in cell-local point indices (see
+// PlazaRefinementND::get_simplices). A subdivision depends only on the
+// marked edges, the longest edge of each face and, in 2D, on the
+// uniform refinement flag, so there are few distinct subdivisions.
+// These are computed once and then shared by all cells with the same
+// key.
+class SubdivisionCache
+{
+public:
+  explicit SubdivisionCache(std::int32_t tdim)
+      : _tdim(tdim), _num_cell_edges(3 * tdim - 3)
+  {
+    // Key bits: marked edges, longest edge of each face (3 bits each)
+    // and the uniform flag
+    const std::int32_t num_faces = (tdim == 2) ? 1 : 4;
+    _index.resize(1 << (_num_cell_edges + 3 * num_faces + 1), -1);
+
+    // Subdivision 0 is the unrefined cell
+    _subdivisions.emplace_back(tdim + 1);
+    std::iota(_subdivisions[0].begin(), _subdivisions[0].end(), 0);
+  }
+
+  // Return index of subdivision, given a bit mask of the marked cell
+  // edges, and the cell-local index of the longest edge of each face
+  std::int32_t find(std::uint32_t marked,
+                    const std::vector<std::int32_t>& longest_edge,
+                    bool uniform)
+  {
+    if (marked == 0)
+      return 0;
+
+    std::uint32_t key = marked;
+    std::int32_t shift = _num_cell_edges;
+    for (std::int32_t e : longest_edge)
+    {
+      key |= e << shift;
+      shift += 3;
+    }
+    key |= (std::uint32_t)uniform << shift;
+
+    std::int32_t& index = _index[key];
+    if (index == -1)
+    {
+      std::vector<bool> markers(_num_cell_edges);
+      for (std::int32_t i = 0; i < _num_cell_edges; ++i)
+        markers[i] = marked & (1 << i);
+      index = _subdivisions.size();
+      _subdivisions.push_back(PlazaRefinementND::get_simplices(
+          markers, longest_edge, _tdim, uniform));
+    }
+    return index;
+  }
+
+  // Return subdivision (cell-local point indices of the new cells)
+  const std::vector<std::int32_t>& operator[](std::int32_t index) const
+  {
+    return _subdivisions[index];
+  }
+
+private:
+  std::int32_t _tdim, _num_cell_edges;
+
+  // Position in _subdivisions of each key (-1 if not yet computed)
+  std::vector<std::int32_t> _index;
+
+  std::vector<std::vector<std::int32_t>> _subdivisions;
+};
+//-----------------------------------------------------------------------------
+// Convenient interface for both uniform and marker refinement. Returns
+// the refined mesh, and, if compute_parents is true, the parent data
+// of each new cell in the order of creation: the global index of the
+// parent cell, and for each vertex of the new cell, the global vertex
+// index and the global index of the parent facet that contains the
+// facet opposite the vertex (-1 if the facet is inside the parent
+// cell).
+//
+// The cells are refined in two passes. The first finds the
+// subdivision of each cell, and so the number and position of its new
+// cells; the second fills the preallocated arrays of the new cells.
+// Each cell is independent in both passes.
+//
+// If redistribute is false, the refined mesh is built in place (see
+// ParallelRefinement::build_incremental), so ghost cells are refined
+// too and the new cells are numbered locally.
+std::tuple<mesh::Mesh, std::vector<std::int64_t>, std::vector<std::int64_t>>
+compute_refinement(const mesh::Mesh& mesh, ParallelRefinement& p_ref,
+                   const std::vector<std::int32_t>& long_edge,
+                   const std::vector<bool>& edge_ratio_ok, bool redistribute,
+                   bool compute_parents)
 {
   const std::int32_t tdim = mesh.topology().dim();
   const std::int32_t num_cell_edges = tdim * 3 - 3;
   const std::int32_t num_cell_vertices = tdim + 1;
+  const std::int32_t num_cell_faces = (tdim == 2) ? 1 : 4;
+
+  // Only owned cells are refined, unless the mesh is refined in place
+  const std::int32_t num_cells = redistribute
+                                     ? mesh.topology().ghost_offset(tdim)
+                                     : mesh.num_entities(tdim);
 
   // Make new vertices in parallel
   p_ref.create_new_vertices();
-  const std::map<std::size_t, std::size_t>& new_vertex_map
-      = p_ref.edge_to_new_vertex();
+  if (!redistribute)
+    p_ref.number_local_vertices();
+
+  // Index of each vertex, and of the new vertex of each edge, in the
+  // new cells (global, or local if refined in place)
+  const std::vector<std::int64_t>& vertex_index
+      = redistribute ? mesh.topology().global_indices(0)
+                     : p_ref.local_vertex_indices();
+  const std::vector<std::int64_t>& new_vertex
+      = redistribute ? p_ref.edge_to_new_vertex()
+                     : p_ref.local_edge_to_new_vertex();
+
+  // Cell vertices of each point in the order [vertices][edges], as a
+  // bit mask. Edge i of a triangle is opposite vertex i, and edge 5 - i
+  // of a tetrahedron is opposite edge i (see get_tetrahedra).
+  static const std::int32_t triangle_edges[3][2] = {{1, 2}, {0, 2}, {0, 1}};
+  static const std::int32_t tetrahedron_edges[6][2]
+      = {{2, 3}, {1, 3}, {1, 2}, {0, 3}, {0, 2}, {0, 1}};
+  std::vector<std::uint8_t> point_vertices(num_cell_vertices + num_cell_edges);
+  for (std::int32_t i = 0; i < num_cell_vertices; ++i)
+    point_vertices[i] = 1 << i;
+  for (std::int32_t i = 0; i < num_cell_edges; ++i)
+  {
+    const std::int32_t* e
+        = (tdim == 2) ? triangle_edges[i] : tetrahedron_edges[i];
+    point_vertices[num_cell_vertices + i] = (1 << e[0]) | (1 << e[1]);
+  }
 
-  std::vector<std::size_t> parent_cell;
-  std::vector<std::int64_t> indices(num_cell_vertices + num_cell_edges);
-  std::vector<std::size_t> marked_edge_list;
-  std::vector<std::int32_t> simplex_set;
+  // Parent facets need global indices
+  if (compute_parents)
+  {
+    mesh.create_entities(tdim - 1);
+    mesh::DistributedMeshTools::number_entities(mesh, tdim - 1);
+  }
 
-  for (const auto& cell : mesh::MeshRange<mesh::Cell>(mesh))
+  if (tdim == 3)
+    mesh.create_connectivity(3, 2);
+  const mesh::ConnectivityView c_to_v
+      = mesh.topology().connectivity_view(tdim, 0);
+  const mesh::ConnectivityView c_to_e
+      = mesh.topology().connectivity_view(tdim, 1);
+  const mesh::ConnectivityView c_to_f
+      = (tdim == 3) ? mesh.topology().connectivity_view(3, 2)
+                    : mesh::ConnectivityView();
+
+  // Pass 1: find subdivision of each cell, and count new cells
+  SubdivisionCache subdivisions(tdim);
+  std::vector<std::int32_t> cell_subdivision(num_cells);
+  std::vector<std::int64_t> offsets(num_cells + 1, 0);
   {
-    // Create vector of indices in the order [vertices][edges], 3+3 in
-    // 2D, 4+6 in 3D
-    std::int32_t j = 0;
-    for (const auto& v : mesh::EntityRange<mesh::Vertex>(cell))
-      indices[j++] = v.global_index();
-
-    marked_edge_list = p_ref.marked_edge_list(cell);
-    if (marked_edge_list.size() == 0)
-    {
-      // Copy over existing Cell to new topology
-      std::vector<std::int64_t> cell_topology;
-      for (const auto& v : mesh::EntityRange<mesh::Vertex>(cell))
-        cell_topology.push_back(v.global_index());
-      p_ref.new_cells(cell_topology);
-      parent_cell.push_back(cell.index());
-    }
-    else
+    common::Timer t0("PLAZA: Subdivide cells");
+    std::vector<std::int32_t> longest_edge(num_cell_faces);
+    for (std::int32_t c = 0; c < num_cells; ++c)
     {
-      // Get the marked edge indices for new vertices and make bool
-      // vector of marked edges
-      std::vector<bool> markers(num_cell_edges, false);
-      for (auto& p : marked_edge_list)
+      const std::int32_t* cell_edges = c_to_e.connections(c);
+      std::uint32_t marked = 0;
+      for (std::int32_t i = 0; i < num_cell_edges; ++i)
+        if (p_ref.is_marked(cell_edges[i]))
+          marked |= 1 << i;
+
+      // Longest edge of each face in cell local indexing. In 2D, the
+      // cell is the only face.
+      if (marked != 0)
       {
-        markers[p] = true;
-        const std::int32_t edge_index = cell.entities(1)[p];
-
-        auto it = new_vertex_map.find(edge_index);
-        assert(it != new_vertex_map.end());
-        indices[num_cell_vertices + p] = it->second;
+        for (std::int32_t j = 0; j < num_cell_faces; ++j)
+        {
+          const std::int32_t f = (tdim == 2) ? c : c_to_f.connections(c)[j];
+          longest_edge[j]
+              = std::find(cell_edges, cell_edges + num_cell_edges, long_edge[f])
+                - cell_edges;
+        }
       }
 
-      // Need longest edges of each facet in cell local indexing
-      std::vector<std::int32_t> longest_edge;
-      for (const auto& f : mesh::EntityRange<mesh::Face>(cell))
-        longest_edge.push_back(long_edge[f.index()]);
+      const bool uniform = (tdim == 2) ? edge_ratio_ok[c] : false;
+      const std::int32_t s = subdivisions.find(marked, longest_edge, uniform);
+      cell_subdivision[c] = s;
+      offsets[c + 1] = subdivisions[s].size() / num_cell_vertices;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  }
+
+  // Pass 2: create new cells, and their parent data
+  const std::int64_t num_new_cells = offsets.back();
+  std::vector<std::int64_t> topology(num_new_cells * num_cell_vertices);
+  std::vector<std::int64_t> parent_cell, parent_facets;
+  {
+    common::Timer t0("PLAZA: Create new cells");
+    const std::vector<std::int64_t>* global_facets = nullptr;
+    const std::vector<std::int64_t>* global_cells = nullptr;
+    mesh::ConnectivityView c_to_facet, facet_to_v;
+    if (compute_parents)
+    {
+      parent_cell.resize(num_new_cells);
+      parent_facets.resize(num_new_cells * 2 * num_cell_vertices);
+      global_facets = &mesh.topology().global_indices(tdim - 1);
+      global_cells = &mesh.topology().global_indices(tdim);
+      c_to_facet = mesh.topology().connectivity_view(tdim, tdim - 1);
+      facet_to_v = mesh.topology().connectivity_view(tdim - 1, 0);
+    }
+
+    std::vector<std::int64_t> indices(num_cell_vertices + num_cell_edges);
+    std::vector<std::int64_t> facet_opposite(num_cell_vertices);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      // Indices of points in the order [vertices][edges], 3+3 in 2D,
+      // 4+6 in 3D (-1 for unmarked edges)
+      const std::int32_t* cell_vertices = c_to_v.connections(c);
+      const std::int32_t* cell_edges = c_to_e.connections(c);
+      for (std::int32_t i = 0; i < num_cell_vertices; ++i)
+        indices[i] = vertex_index[cell_vertices[i]];
+      for (std::int32_t i = 0; i < num_cell_edges; ++i)
+        indices[num_cell_vertices + i] = new_vertex[cell_edges[i]];
+
+      // Convert from cell local index to global vertex index
+      const std::vector<std::int32_t>& simplex_set
+          = subdivisions[cell_subdivision[c]];
+      std::int64_t* cell_topology
+          = topology.data() + offsets[c] * num_cell_vertices;
+      for (std::size_t i = 0; i < simplex_set.size(); ++i)
+        cell_topology[i] = indices[simplex_set[i]];
+
+      if (!compute_parents)
+        continue;
 
-      // Convert to cell local index
-      for (auto& p : longest_edge)
+      // Global index of the facet of the cell opposite each vertex
+      const std::int32_t* cell_facets = c_to_facet.connections(c);
+      for (std::int32_t j = 0; j < num_cell_vertices; ++j)
       {
-        int i = 0;
-        for (const auto& ej : mesh::EntityRange<mesh::Edge>(cell))
+        const std::int32_t* facet_vertices
+            = facet_to_v.connections(cell_facets[j]);
+        for (std::int32_t i = 0; i < num_cell_vertices; ++i)
         {
-          if (p == ej.index())
+          if (std::find(facet_vertices, facet_vertices + tdim,
+                        cell_vertices[i])
+              == facet_vertices + tdim)
           {
-            p = i;
-            break;
+            facet_opposite[i] = (*global_facets)[cell_facets[j]];
           }
-          ++i;
         }
       }
 
-      const bool uniform = (tdim == 2) ? edge_ratio_ok[cell.index()] : false;
+      // Save parent cell, and the parent facet of the facet opposite
+      // each vertex of each new cell. A facet is in parent facet i if
+      // none of its points is in vertex i of the parent cell.
+      for (std::int64_t n = offsets[c]; n < offsets[c + 1]; ++n)
+      {
+        parent_cell[n] = (*global_cells)[c];
+        const std::int32_t* points
+            = simplex_set.data() + (n - offsets[c]) * num_cell_vertices;
+        std::int64_t* data = parent_facets.data() + n * 2 * num_cell_vertices;
+        for (std::int32_t i = 0; i < num_cell_vertices; ++i)
+        {
+          std::uint8_t facet_vertices = 0;
+          for (std::int32_t k = 0; k < num_cell_vertices; ++k)
+            if (k != i)
+              facet_vertices |= point_vertices[points[k]];
+
+          std::int64_t parent_facet = -1;
+          for (std::int32_t k = 0; k < num_cell_vertices; ++k)
+            if (!(facet_vertices & (1 << k)))
+              parent_facet = facet_opposite[k];
+
+          data[2 * i] = indices[points[i]];
+          data[2 * i + 1] = parent_facet;
+        }
+      }
+    }
+  }
 
-      // FIXME: this has an expensive dynamic memory allocation
-      simplex_set = PlazaRefinementND::get_simplices(markers, longest_edge,
-                                                     tdim, uniform);
+  if (!redistribute)
+  {
+    mesh::Mesh refined_mesh = p_ref.build_incremental(topology, offsets);
+    if (compute_parents)
+    {
+      // Keep parent data of the children of owned cells, with global
+      // vertex indices
+      const std::int64_t num_owned
+          = offsets[mesh.topology().ghost_offset(tdim)];
+      parent_cell.resize(num_owned);
+      parent_facets.resize(num_owned * 2 * num_cell_vertices);
+      const std::vector<std::int64_t>& global_points
+          = refined_mesh.geometry().global_indices();
+      for (std::size_t i = 0; i < parent_facets.size(); i += 2)
+        parent_facets[i] = global_points[parent_facets[i]];
+    }
+    return std::make_tuple(std::move(refined_mesh), std::move(parent_cell),
+                           std::move(parent_facets));
+  }
 
-      // Save parent index
-      const std::int32_t ncells = simplex_set.size() / num_cell_vertices;
-      for (std::int32_t i = 0; i != ncells; ++i)
-        parent_cell.push_back(cell.index());
+  p_ref.set_new_cells(std::move(topology));
+  const bool serial = (dolfin::MPI::size(mesh.mpi_comm()) == 1);
+  mesh::Mesh refined_mesh
+      = serial ? p_ref.build_local() : p_ref.partition(redistribute);
+  return std::make_tuple(std::move(refined_mesh), std::move(parent_cell),
+                         std::move(parent_facets));
+}
+//-----------------------------------------------------------------------------
+// Find the parent cell of each cell, and parent facet of each facet,
+// of the refined mesh from the parent data of the new cells (see
+// compute_refinement). The cells created by each process have
+// consecutive global indices, so the parent data of each cell is
+// requested from the process that created it.
+std::pair<std::vector<std::int64_t>, std::vector<std::int64_t>>
+distribute_parents(const mesh::Mesh& mesh,
+                   const std::vector<std::int64_t>& parent_cell,
+                   const std::vector<std::int64_t>& parent_facets)
+{
+  common::Timer t0("PLAZA: Distribute parents");
+
+  const MPI_Comm mpi_comm = mesh.mpi_comm();
+  const std::int32_t mpi_size = dolfin::MPI::size(mpi_comm);
+  const std::int32_t mpi_rank = dolfin::MPI::rank(mpi_comm);
+  const std::int32_t tdim = mesh.topology().dim();
+  const std::int32_t num_cell_vertices = tdim + 1;
+  const std::int32_t data_size = 1 + 2 * num_cell_vertices;
+
+  // Range of global indices of the cells created by each process
+  std::vector<std::int64_t> offsets;
+  dolfin::MPI::all_gather(mpi_comm, (std::int64_t)parent_cell.size(),
+                          offsets);
+  offsets.insert(offsets.begin(), 0);
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  // Request parent data of each cell (including ghosts)
+  const std::int32_t num_cells = mesh.num_entities(tdim);
+  const std::vector<std::int64_t>& global_cells
+      = mesh.topology().global_indices(tdim);
+  std::vector<std::int32_t> creator(num_cells);
+  std::vector<std::vector<std::int64_t>> send_requests(mpi_size);
+  for (std::int32_t c = 0; c < num_cells; ++c)
+  {
+    creator[c] = std::upper_bound(offsets.begin(), offsets.end(),
+                                  global_cells[c])
+                 - offsets.begin() - 1;
+    send_requests[creator[c]].push_back(global_cells[c]);
+  }
+  std::vector<std::vector<std::int64_t>> recv_requests;
+  dolfin::MPI::all_to_all(mpi_comm, send_requests, recv_requests);
 
-      // Convert from cell local index to mesh index and add to cells
-      std::vector<std::int64_t> simplex_set_global(simplex_set.size());
-      for (std::size_t i = 0; i < simplex_set_global.size(); ++i)
-        simplex_set_global[i] = indices[simplex_set[i]];
-      p_ref.new_cells(simplex_set_global);
+  std::vector<std::vector<std::int64_t>> send_parents(mpi_size);
+  for (std::int32_t p = 0; p < mpi_size; ++p)
+  {
+    send_parents[p].reserve(recv_requests[p].size() * data_size);
+    for (std::int64_t index : recv_requests[p])
+    {
+      const std::int64_t i = index - offsets[mpi_rank];
+      assert(i >= 0 and i < (std::int64_t)parent_cell.size());
+      send_parents[p].push_back(parent_cell[i]);
+      send_parents[p].insert(
+          send_parents[p].end(),
+          parent_facets.begin() + i * 2 * num_cell_vertices,
+          parent_facets.begin() + (i + 1) * 2 * num_cell_vertices);
     }
   }
+  std::vector<std::vector<std::int64_t>> recv_parents;
+  dolfin::MPI::all_to_all(mpi_comm, send_parents, recv_parents);
+
+  // Assign parents, identifying the facets of each cell by the
+  // opposite vertex
+  mesh.create_entities(tdim - 1);
+  const std::vector<std::int64_t>& global_vertices
+      = mesh.geometry().global_indices();
+  std::vector<std::int64_t> cell_parents(num_cells);
+  std::vector<std::int64_t> facet_parents(mesh.num_entities(tdim - 1), -1);
+  std::vector<std::size_t> pos(mpi_size, 0);
+  for (auto& cell : mesh::MeshRange<mesh::Cell>(mesh, mesh::MeshRangeType::ALL))
+  {
+    const std::int32_t p = creator[cell.index()];
+    const std::int64_t* data = recv_parents[p].data() + pos[p];
+    pos[p] += data_size;
+    cell_parents[cell.index()] = data[0];
 
-  const bool serial = (dolfin::MPI::size(mesh.mpi_comm()) == 1);
-  if (serial)
-    return p_ref.build_local();
-  else
-    return p_ref.partition(redistribute);
+    const std::int32_t* cell_vertices = cell.entities(0);
+    for (const auto& f : mesh::EntityRange<mesh::MeshEntity>(cell, tdim - 1))
+    {
+      // Find vertex opposite facet
+      const std::int32_t* facet_vertices = f.entities(0);
+      std::int64_t v = -1;
+      for (std::int32_t i = 0; i < num_cell_vertices; ++i)
+      {
+        if (std::find(facet_vertices, facet_vertices + tdim, cell_vertices[i])
+            == facet_vertices + tdim)
+        {
+          v = global_vertices[cell_vertices[i]];
+        }
+      }
+
+      for (std::int32_t i = 0; i < num_cell_vertices; ++i)
+        if (data[1 + 2 * i] == v)
+          facet_parents[f.index()] = data[2 + 2 * i];
+    }
+  }
+
+  return std::make_pair(std::move(cell_parents), std::move(facet_parents));
 }
 //-----------------------------------------------------------------------------
 // 2D version of subdivision allowing for uniform subdivision (flag)
@@ -316,11 +645,16 @@ face_long_edge(const mesh::Mesh& mesh)
 
   // Store all edge lengths in Mesh to save recalculating for each Face
   std::vector<double> edge_length(mesh.num_entities(1));
-  for (const auto& e : mesh::MeshRange<mesh::Edge>(mesh))
+  for (const auto& e :
+       mesh::MeshRange<mesh::Edge>(mesh, mesh::MeshRangeType::ALL))
+  {
     edge_length[e.index()] = e.length();
+  }
 
-  // Get longest edge of each face
-  for (const auto& f : mesh::MeshRange<mesh::Face>(mesh))
+  // Get longest edge of each face, including faces of ghost cells
+  // (needed when the mesh is refined in place)
+  for (const auto& f :
+       mesh::MeshRange<mesh::Face>(mesh, mesh::MeshRangeType::ALL))
   {
     const std::int32_t* face_edges = f.entities(1);
 
@@ -380,8 +714,8 @@ mesh::Mesh PlazaRefinementND::refine(const mesh::Mesh& mesh, bool redistribute)
   ParallelRefinement p_ref(mesh);
   p_ref.mark_all();
 
-  return compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok,
-                            redistribute);
+  return std::get<0>(compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok,
+                                        redistribute, false));
 }
 //-----------------------------------------------------------------------------
 mesh::Mesh
@@ -405,8 +739,69 @@ PlazaRefinementND::refine(const mesh::Mesh& mesh,
 
   enforce_rules(p_ref, mesh, long_edge);
 
-  return compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok,
-                            redistribute);
+  return std::get<0>(compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok,
+                                        redistribute, false));
+}
+//-----------------------------------------------------------------------------
+std::tuple<mesh::Mesh, std::vector<std::int64_t>, std::vector<std::int64_t>>
+PlazaRefinementND::refine_with_parents(const mesh::Mesh& mesh,
+                                       bool redistribute)
+{
+  if (mesh.type().cell_type() != mesh::CellType::Type::triangle
+      and mesh.type().cell_type() != mesh::CellType::Type::tetrahedron)
+  {
+    throw std::runtime_error("Cell type not supported");
+  }
+
+  common::Timer t0("PLAZA: refine");
+  std::vector<std::int32_t> long_edge;
+  std::vector<bool> edge_ratio_ok;
+  std::tie(long_edge, edge_ratio_ok) = face_long_edge(mesh);
+
+  ParallelRefinement p_ref(mesh);
+  p_ref.mark_all();
+
+  auto refinement = compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok,
+                                       redistribute, true);
+  mesh::Mesh& refined_mesh = std::get<0>(refinement);
+  std::vector<std::int64_t> parent_cell, parent_facet;
+  std::tie(parent_cell, parent_facet) = distribute_parents(
+      refined_mesh, std::get<1>(refinement), std::get<2>(refinement));
+
+  return std::make_tuple(std::move(refined_mesh), std::move(parent_cell),
+                         std::move(parent_facet));
+}
+//-----------------------------------------------------------------------------
+std::tuple<mesh::Mesh, std::vector<std::int64_t>, std::vector<std::int64_t>>
+PlazaRefinementND::refine_with_parents(
+    const mesh::Mesh& mesh, const mesh::MeshFunction<bool>& refinement_marker,
+    bool redistribute)
+{
+  if (mesh.type().cell_type() != mesh::CellType::Type::triangle
+      and mesh.type().cell_type() != mesh::CellType::Type::tetrahedron)
+  {
+    throw std::runtime_error("Cell type not supported");
+  }
+
+  common::Timer t0("PLAZA: refine");
+  std::vector<std::int32_t> long_edge;
+  std::vector<bool> edge_ratio_ok;
+  std::tie(long_edge, edge_ratio_ok) = face_long_edge(mesh);
+
+  ParallelRefinement p_ref(mesh);
+  p_ref.mark(refinement_marker);
+
+  enforce_rules(p_ref, mesh, long_edge);
+
+  auto refinement = compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok,
+                                       redistribute, true);
+  mesh::Mesh& refined_mesh = std::get<0>(refinement);
+  std::vector<std::int64_t> parent_cell, parent_facet;
+  std::tie(parent_cell, parent_facet) = distribute_parents(
+      refined_mesh, std::get<1>(refinement), std::get<2>(refinement));
+
+  return std::make_tuple(std::move(refined_mesh), std::move(parent_cell),
+                         std::move(parent_facet));
 }
 //-----------------------------------------------------------------------------
 std::vector<std::int32_t>
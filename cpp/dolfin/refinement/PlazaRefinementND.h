@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include <cstdint>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -37,7 +38,9 @@ public:
   ///  @param mesh
   ///     Input mesh to be refined
   ///  @param redistribute
-  ///     Flag to call the Mesh Partitioner to redistribute after refinement
+  ///     Flag to call the Mesh Partitioner to redistribute after
+  ///     refinement. If false, the mesh is refined in place: each
+  ///     process keeps the children of its cells.
   ///  @returns mesh::Mesh
   ///     New mesh
   ///
@@ -51,7 +54,9 @@ public:
   ///    MeshFunction listing MeshEntities which should be split by this
   ///    refinement
   /// @param redistribute
-  ///     Flag to call the Mesh Partitioner to redistribute after refinement
+  ///     Flag to call the Mesh Partitioner to redistribute after
+  ///     refinement. If false, the mesh is refined in place: each
+  ///     process keeps the children of its cells.
   /// @returns mesh::Mesh
   ///    New Mesh
   ///
@@ -59,6 +64,48 @@ public:
                            const mesh::MeshFunction<bool>& refinement_marker,
                            bool redistribute);
 
+  /// Uniform refine, optionally redistributing, and compute the
+  /// parent of each cell and facet of the new mesh
+  ///
+  ///  @param mesh
+  ///     Input mesh to be refined
+  ///  @param redistribute
+  ///     Flag to call the Mesh Partitioner to redistribute after
+  ///     refinement. If false, the mesh is refined in place: each
+  ///     process keeps the children of its cells.
+  ///  @returns std::tuple<mesh::Mesh, std::vector<std::int64_t>,
+  ///  std::vector<std::int64_t>>
+  ///     New mesh; global index (in the input mesh) of the parent cell
+  ///     of each cell (including ghosts); and global index of the
+  ///     parent facet of each facet, or -1 for facets inside a parent
+  ///     cell
+  ///
+  static std::tuple<mesh::Mesh, std::vector<std::int64_t>,
+                    std::vector<std::int64_t>>
+  refine_with_parents(const mesh::Mesh& mesh, bool redistribute);
+
+  /// Refine with markers, optionally redistributing, and compute the
+  /// parent of each cell and facet of the new mesh
+  ///
+  /// @param mesh
+  ///    Input mesh to be refined
+  /// @param refinement_marker
+  ///    MeshFunction listing MeshEntities which should be split by this
+  ///    refinement
+  /// @param redistribute
+  ///     Flag to call the Mesh Partitioner to redistribute after
+  ///     refinement. If false, the mesh is refined in place: each
+  ///     process keeps the children of its cells.
+  ///  @returns std::tuple<mesh::Mesh, std::vector<std::int64_t>,
+  ///  std::vector<std::int64_t>>
+  ///     New mesh, and parent cells and facets (see above)
+  ///
+  static std::tuple<mesh::Mesh, std::vector<std::int64_t>,
+                    std::vector<std::int64_t>>
+  refine_with_parents(const mesh::Mesh& mesh,
+                      const mesh::MeshFunction<bool>& refinement_marker,
+                      bool redistribute);
+
   /// Get the subdivision of an original simplex into smaller
   /// simplices, for a given set of marked edges, and the
   /// longest edge of each facet (cell local indexing).
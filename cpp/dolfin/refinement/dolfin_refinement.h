@@ -12,4 +12,5 @@ namespace dolfin
 
 // DOLFIN refinement interface
 
+#include <dolfin/refinement/MeshHierarchy.h>
 #include <dolfin/refinement/refine.h>
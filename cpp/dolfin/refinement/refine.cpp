@@ -6,12 +6,27 @@
 
 #include "refine.h"
 #include "PlazaRefinementND.h"
+#include <dolfin/common/MPI.h>
+#include <dolfin/common/Timer.h>
 #include <dolfin/common/log.h>
+#include <dolfin/fem/CoordinateMapping.h>
+#include <dolfin/fem/FiniteElement.h>
+#include <dolfin/fem/GenericDofMap.h>
+#include <dolfin/function/Function.h>
+#include <dolfin/function/FunctionSpace.h>
+#include <dolfin/la/PETScVector.h>
+#include <dolfin/la/utils.h>
 #include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/Connectivity.h>
+#include <dolfin/mesh/CoordinateDofs.h>
 #include <dolfin/mesh/Edge.h>
+#include <dolfin/mesh/Geometry.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshFunction.h>
+#include <dolfin/mesh/MeshIterator.h>
 #include <dolfin/mesh/Vertex.h>
+#include <map>
+#include <unsupported/Eigen/CXX11/Tensor>
 
 using namespace dolfin;
 using namespace refinement;
@@ -27,6 +42,9 @@ mesh::Mesh dolfin::refinement::refine(const mesh::Mesh& mesh, bool redistribute)
 
   mesh::Mesh refined_mesh = PlazaRefinementND::refine(mesh, redistribute);
 
+  // The cells of the refined mesh are of the same type and degree
+  refined_mesh.geometry().coord_mapping = mesh.geometry().coord_mapping;
+
   // Report the number of refined cells
   const std::size_t D = mesh.topology().dim();
   const std::size_t n0 = mesh.num_entities_global(D);
@@ -51,6 +69,7 @@ dolfin::refinement::refine(const mesh::Mesh& mesh,
 
   mesh::Mesh refined_mesh
       = PlazaRefinementND::refine(mesh, cell_markers, redistribute);
+  refined_mesh.geometry().coord_mapping = mesh.geometry().coord_mapping;
 
   // Report the number of refined cells
   const std::size_t D = mesh.topology().dim();
@@ -63,3 +82,308 @@ dolfin::refinement::refine(const mesh::Mesh& mesh,
   return refined_mesh;
 }
 //-----------------------------------------------------------------------------
+std::tuple<mesh::Mesh, std::vector<std::int64_t>, std::vector<std::int64_t>>
+dolfin::refinement::refine_with_parents(const mesh::Mesh& mesh,
+                                        bool redistribute)
+{
+  if (mesh.type().cell_type() != mesh::CellType::Type::triangle
+      and mesh.type().cell_type() != mesh::CellType::Type::tetrahedron)
+  {
+    throw std::runtime_error("Refinement only defined for simplices");
+  }
+
+  auto refined = PlazaRefinementND::refine_with_parents(mesh, redistribute);
+  std::get<0>(refined).geometry().coord_mapping
+      = mesh.geometry().coord_mapping;
+  return refined;
+}
+//-----------------------------------------------------------------------------
+std::tuple<mesh::Mesh, std::vector<std::int64_t>, std::vector<std::int64_t>>
+dolfin::refinement::refine_with_parents(
+    const mesh::Mesh& mesh, const mesh::MeshFunction<bool>& cell_markers,
+    bool redistribute)
+{
+  if (mesh.type().cell_type() != mesh::CellType::Type::triangle
+      and mesh.type().cell_type() != mesh::CellType::Type::tetrahedron)
+  {
+    throw std::runtime_error("Refinement only defined for simplices");
+  }
+
+  auto refined = PlazaRefinementND::refine_with_parents(mesh, cell_markers,
+                                                        redistribute);
+  std::get<0>(refined).geometry().coord_mapping
+      = mesh.geometry().coord_mapping;
+  return refined;
+}
+//-----------------------------------------------------------------------------
+function::Function dolfin::refinement::interpolate_to_refined(
+    const function::Function& u,
+    std::shared_ptr<const function::FunctionSpace> V,
+    const std::vector<std::int64_t>& parent_cells)
+{
+  common::Timer timer("Interpolate to refined mesh");
+
+  std::shared_ptr<const function::FunctionSpace> V0 = u.function_space();
+  assert(V0);
+  assert(V0->element());
+  assert(V);
+  assert(V->element());
+  if (V->element()->value_size() != V0->element()->value_size())
+  {
+    throw std::runtime_error("Cannot interpolate to refined mesh with a "
+                             "different value size");
+  }
+
+  assert(V0->mesh());
+  assert(V->mesh());
+  const mesh::Mesh& mesh0 = *V0->mesh();
+  const mesh::Mesh& mesh = *V->mesh();
+  const int tdim = mesh.topology().dim();
+  const int gdim = mesh.geometry().dim();
+  if ((std::int32_t)parent_cells.size() != mesh.num_entities(tdim))
+  {
+    throw std::runtime_error("Number of parent cells ("
+                             + std::to_string(parent_cells.size())
+                             + ") does not match number of cells ("
+                             + std::to_string(mesh.num_entities(tdim))
+                             + ").");
+  }
+
+  if (!mesh.geometry().coord_mapping)
+  {
+    throw std::runtime_error(
+        "fem::CoordinateMapping has not been attached to mesh.");
+  }
+  const fem::CoordinateMapping& cmap = *mesh.geometry().coord_mapping;
+
+  const MPI_Comm mpi_comm = mesh.mpi_comm();
+  const std::size_t num_processes = MPI::size(mpi_comm);
+
+  // Geometry and dofmap of the parent mesh
+  const mesh::Connectivity& connectivity_g0
+      = mesh0.coordinate_dofs().entity_points();
+  const mesh::ConnectivityView cell_g0(connectivity_g0);
+  const int num_dofs_g = connectivity_g0.size(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g0
+      = mesh0.geometry().points();
+  assert(V0->dofmap());
+  const fem::GenericDofMap& dofmap0 = *V0->dofmap();
+  const fem::FiniteElement& element0 = *V0->element();
+  const int space_dimension0 = element0.space_dimension();
+
+  // Local index of the parent cells on this process (including ghosts)
+  const std::vector<std::int64_t>& global_cells0
+      = mesh0.topology().global_indices(tdim);
+  std::map<std::int64_t, std::int32_t> local_cells0;
+  for (std::size_t c = 0; c < global_cells0.size(); ++c)
+    local_cells0.insert({global_cells0[c], c});
+
+  // Parent cells that are not on this process
+  std::vector<std::int64_t> remote_cells;
+  for (auto& cell : mesh::MeshRange<mesh::Cell>(mesh))
+  {
+    const std::int64_t parent = parent_cells[cell.index()];
+    if (local_cells0.find(parent) == local_cells0.end())
+      remote_cells.push_back(parent);
+  }
+  std::sort(remote_cells.begin(), remote_cells.end());
+  remote_cells.erase(std::unique(remote_cells.begin(), remote_cells.end()),
+                     remote_cells.end());
+
+  // Post the owner of each owned cell of the parent mesh to the process
+  // that holds its global index, and find the owners of the remote
+  // parent cells
+  const std::int32_t num_owned0 = mesh0.topology().ghost_offset(tdim);
+  std::int64_t max_index = -1;
+  for (std::int32_t c = 0; c < num_owned0; ++c)
+    max_index = std::max(max_index, global_cells0[c]);
+  const std::int64_t num_global = MPI::max(mpi_comm, max_index) + 1;
+
+  std::vector<std::vector<std::int64_t>> send_location(num_processes);
+  for (std::int32_t c = 0; c < num_owned0; ++c)
+  {
+    const std::int64_t index = global_cells0[c];
+    send_location[MPI::index_owner(mpi_comm, index, num_global)].push_back(
+        index);
+  }
+  std::vector<std::vector<std::int64_t>> recv_location;
+  MPI::all_to_all(mpi_comm, send_location, recv_location);
+
+  const std::array<std::int64_t, 2> range
+      = MPI::local_range(mpi_comm, num_global);
+  std::vector<std::int32_t> owner(range[1] - range[0], -1);
+  for (std::size_t p = 0; p < num_processes; ++p)
+    for (std::int64_t index : recv_location[p])
+      owner[index - range[0]] = p;
+
+  std::vector<std::vector<std::int64_t>> send_query(num_processes);
+  for (std::int64_t index : remote_cells)
+  {
+    send_query[MPI::index_owner(mpi_comm, index, num_global)].push_back(
+        index);
+  }
+  std::vector<std::vector<std::int64_t>> recv_query;
+  MPI::all_to_all(mpi_comm, send_query, recv_query);
+
+  std::vector<std::vector<std::int64_t>> send_owner(num_processes);
+  for (std::size_t p = 0; p < num_processes; ++p)
+  {
+    for (std::int64_t index : recv_query[p])
+    {
+      if (index >= range[1] or owner[index - range[0]] < 0)
+      {
+        throw std::runtime_error("Parent cell with global index "
+                                 + std::to_string(index)
+                                 + " is not in the mesh");
+      }
+      send_owner[p].push_back(owner[index - range[0]]);
+    }
+  }
+  std::vector<std::vector<std::int64_t>> recv_owner;
+  MPI::all_to_all(mpi_comm, send_owner, recv_owner);
+
+  // Request geometry and expansion coefficients of the remote parent
+  // cells from their owners
+  std::vector<std::vector<std::int64_t>> send_request(num_processes);
+  std::vector<std::size_t> pos(num_processes, 0);
+  for (std::int64_t index : remote_cells)
+  {
+    const std::size_t p = MPI::index_owner(mpi_comm, index, num_global);
+    send_request[recv_owner[p][pos[p]++]].push_back(index);
+  }
+  std::vector<std::vector<std::int64_t>> recv_request;
+  MPI::all_to_all(mpi_comm, send_request, recv_request);
+
+  std::vector<std::vector<double>> send_coordinates(num_processes);
+  std::vector<std::vector<PetscScalar>> send_coefficients(num_processes);
+  {
+    la::VecReadWrapper u_wrap(u.vector().vec());
+    Eigen::Map<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> x0
+        = u_wrap.x;
+    for (std::size_t p = 0; p < num_processes; ++p)
+    {
+      for (std::int64_t index : recv_request[p])
+      {
+        const std::int32_t c = local_cells0.at(index);
+        for (int i = 0; i < num_dofs_g; ++i)
+          for (int j = 0; j < gdim; ++j)
+            send_coordinates[p].push_back(x_g0(cell_g0.connections(c)[i], j));
+        auto dofs = dofmap0.cell_dofs(c);
+        for (Eigen::Index i = 0; i < dofs.size(); ++i)
+          send_coefficients[p].push_back(x0[dofs[i]]);
+      }
+    }
+  }
+  std::vector<std::vector<double>> recv_coordinates;
+  std::vector<std::vector<PetscScalar>> recv_coefficients;
+  MPI::all_to_all(mpi_comm, send_coordinates, recv_coordinates);
+  MPI::all_to_all(mpi_comm, send_coefficients, recv_coefficients);
+
+  // Position (process, cell) of each remote parent cell in the received
+  // data
+  std::map<std::int64_t, std::pair<std::size_t, std::size_t>> remote_data;
+  for (std::size_t p = 0; p < num_processes; ++p)
+    for (std::size_t i = 0; i < send_request[p].size(); ++i)
+      remote_data.insert({send_request[p][i], {p, i}});
+
+  // Geometry of the refined mesh
+  const mesh::Connectivity& connectivity_g
+      = mesh.coordinate_dofs().entity_points();
+  const mesh::ConnectivityView cell_g(connectivity_g);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().points();
+
+  // Evaluate the function in the parent cell at the dof coordinates of
+  // each cell
+  const fem::FiniteElement& element = *V->element();
+  const int space_dimension = element.space_dimension();
+  const EigenRowArrayXXd& X = element.dof_reference_coordinates();
+  const int num_points = X.rows();
+  const int reference_value_size0 = element0.reference_value_size();
+  const int value_size = element.value_size();
+  EigenRowArrayXXd coordinate_dofs(num_dofs_g, gdim);
+  EigenRowArrayXXd coordinate_dofs0(num_dofs_g, gdim);
+  EigenRowArrayXXd x(num_points, gdim);
+  EigenRowArrayXXd X0(num_points, tdim);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> J(num_points, gdim, tdim);
+  EigenArrayXd detJ(num_points);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> K(num_points, tdim, gdim);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> basis_reference_values(
+      num_points, space_dimension0, reference_value_size0);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> basis_values(
+      num_points, space_dimension0, value_size);
+  std::vector<PetscScalar> coefficients0(space_dimension0);
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      values(num_points, value_size);
+  std::vector<PetscScalar> cell_coefficients(space_dimension);
+
+  function::Function u1(V);
+  assert(V->dofmap());
+  const fem::GenericDofMap& dofmap = *V->dofmap();
+  {
+    la::VecReadWrapper u_wrap(u.vector().vec());
+    Eigen::Map<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> x0
+        = u_wrap.x;
+    la::VecWrapper u1_wrap(u1.vector().vec());
+    Eigen::Map<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> x1 = u1_wrap.x;
+    for (auto& cell : mesh::MeshRange<mesh::Cell>(mesh))
+    {
+      const int c = cell.index();
+      for (int i = 0; i < num_dofs_g; ++i)
+        for (int j = 0; j < gdim; ++j)
+          coordinate_dofs(i, j) = x_g(cell_g.connections(c)[i], j);
+
+      // Geometry and expansion coefficients of parent cell
+      const std::int64_t parent = parent_cells[c];
+      auto it = local_cells0.find(parent);
+      if (it != local_cells0.end())
+      {
+        const std::int32_t c0 = it->second;
+        for (int i = 0; i < num_dofs_g; ++i)
+          for (int j = 0; j < gdim; ++j)
+            coordinate_dofs0(i, j) = x_g0(cell_g0.connections(c0)[i], j);
+        auto dofs0 = dofmap0.cell_dofs(c0);
+        for (Eigen::Index i = 0; i < dofs0.size(); ++i)
+          coefficients0[i] = x0[dofs0[i]];
+      }
+      else
+      {
+        const std::pair<std::size_t, std::size_t>& data
+            = remote_data.at(parent);
+        std::copy_n(recv_coordinates[data.first].data()
+                        + data.second * num_dofs_g * gdim,
+                    num_dofs_g * gdim, coordinate_dofs0.data());
+        std::copy_n(recv_coefficients[data.first].data()
+                        + data.second * space_dimension0,
+                    space_dimension0, coefficients0.data());
+      }
+
+      // Evaluate function at the dof coordinates of the cell, which are
+      // inside the parent cell
+      cmap.compute_physical_coordinates(x, X, coordinate_dofs);
+      cmap.compute_reference_geometry(X0, J, detJ, K, x, coordinate_dofs0);
+      element0.evaluate_reference_basis(basis_reference_values, X0);
+      element0.transform_reference_basis(
+          basis_values, basis_reference_values, X0, J, detJ, K);
+      values.setZero();
+      for (int p = 0; p < num_points; ++p)
+        for (int i = 0; i < space_dimension0; ++i)
+          for (int j = 0; j < value_size; ++j)
+            values(p, j) += coefficients0[i] * basis_values(p, i, j);
+
+      element.transform_values(cell_coefficients.data(), values,
+                               coordinate_dofs);
+
+      auto dofs = dofmap.cell_dofs(c);
+      for (Eigen::Index i = 0; i < dofs.size(); ++i)
+        x1[dofs[i]] = cell_coefficients[i];
+    }
+  }
+
+  // Only the owned cells were visited, so fetch the ghost values from
+  // their owners
+  u1.vector().update_ghosts();
+
+  return u1;
+}
+//-----------------------------------------------------------------------------
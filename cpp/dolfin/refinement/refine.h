@@ -6,9 +6,20 @@
 
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
 namespace dolfin
 {
 
+namespace function
+{
+class Function;
+class FunctionSpace;
+} // namespace function
+
 namespace mesh
 {
 // Forward declarations
@@ -26,7 +37,9 @@ namespace refinement
 ///         The mesh to refine.
 /// @param    redistribute (_bool_)
 ///         Optional argument to redistribute the refined mesh if mesh is a
-///         distributed mesh.
+///         distributed mesh. If false, the mesh is refined in place:
+///         each process keeps the children of its cells, and the
+///         ghost cells are the children of the ghost cells.
 ///
 /// @return    _mesh::Mesh_
 ///         The refined mesh.
@@ -46,7 +59,9 @@ mesh::Mesh refine(const mesh::Mesh& mesh, bool redistribute = true);
 ///         that should be refined (and which should not).
 /// @param redistribute (_bool_)
 ///         Optional argument to redistribute the refined mesh if mesh is a
-///         distributed mesh.
+///         distributed mesh. If false, the mesh is refined in place:
+///         each process keeps the children of its cells, and the
+///         ghost cells are the children of the ghost cells.
 ///
 /// @return _mesh::Mesh_
 ///         The locally refined mesh.
@@ -68,5 +83,78 @@ mesh::Mesh refine(const mesh::Mesh& mesh,
                   const mesh::MeshFunction<bool>& cell_markers,
                   bool redistribute = true);
 
+/// Create uniformly refined mesh, and compute the parent of each cell
+/// and facet of the refined mesh. The parents are given by their
+/// global index in the input mesh, so they remain valid when the
+/// refined mesh is redistributed.
+///
+/// @param    mesh (_mesh::Mesh_)
+///         The mesh to refine.
+/// @param    redistribute (_bool_)
+///         Optional argument to redistribute the refined mesh if mesh is a
+///         distributed mesh. If false, the mesh is refined in place:
+///         each process keeps the children of its cells, and the
+///         ghost cells are the children of the ghost cells.
+///
+/// @return    std::tuple<mesh::Mesh, std::vector<std::int64_t>,
+///            std::vector<std::int64_t>>
+///         The refined mesh; the global index of the parent cell of
+///         each cell (including ghosts); and the global index of the
+///         parent facet of each facet, or -1 for facets inside a
+///         parent cell.
+///
+std::tuple<mesh::Mesh, std::vector<std::int64_t>, std::vector<std::int64_t>>
+refine_with_parents(const mesh::Mesh& mesh, bool redistribute = true);
+
+/// Create locally refined mesh, and compute the parent of each cell
+/// and facet of the refined mesh (see above)
+///
+/// @param  mesh (_mesh::Mesh_)
+///         The mesh to refine.
+/// @param cell_markers (_mesh::MeshFunction<bool>_)
+///         A mesh function over booleans specifying which cells
+///         that should be refined (and which should not).
+/// @param redistribute (_bool_)
+///         Optional argument to redistribute the refined mesh if mesh is a
+///         distributed mesh. If false, the mesh is refined in place:
+///         each process keeps the children of its cells, and the
+///         ghost cells are the children of the ghost cells.
+///
+/// @return    std::tuple<mesh::Mesh, std::vector<std::int64_t>,
+///            std::vector<std::int64_t>>
+///         The refined mesh, and the parent cells and facets.
+///
+std::tuple<mesh::Mesh, std::vector<std::int64_t>, std::vector<std::int64_t>>
+refine_with_parents(const mesh::Mesh& mesh,
+                    const mesh::MeshFunction<bool>& cell_markers,
+                    bool redistribute = true);
+
+/// Interpolate a function onto a function space on a refined mesh. The
+/// element of the space may differ from the element of the function
+/// (e.g. in degree), but must have the same value size. Each cell of
+/// the refined mesh is inside its parent cell, so the function is
+/// evaluated in the parent cell directly, without searching for the
+/// cells that contain the dof coordinates. Parent cells that are not on
+/// this process are requested from their owners. The ghost values of
+/// the vector of u must be up to date. The values are computed on the
+/// owned cells of the refined mesh, and the ghost values of the
+/// returned function are then updated from their owners.
+///
+/// @param  u (_function::Function_)
+///         The function on the mesh that was refined.
+/// @param  V (_function::FunctionSpace_)
+///         The function space on the refined mesh.
+/// @param  parent_cells (_std::vector<std::int64_t>_)
+///         Global index of the parent cell of each cell of the refined
+///         mesh, from refine_with_parents.
+///
+/// @return _function::Function_
+///         The interpolated function.
+///
+function::Function
+interpolate_to_refined(const function::Function& u,
+                       std::shared_ptr<const function::FunctionSpace> V,
+                       const std::vector<std::int64_t>& parent_cells);
+
 } // namespace refinement
 } // namespace dolfin
@@ -0,0 +1,57 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <array>
+#include <catch.hpp>
+#include <cstdint>
+#include <dolfin/common/ArrayHashMap.h>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace dolfin;
+
+TEST_CASE("Array hash map", "[array_hash_map]")
+{
+  // Random keys, with duplicates, and reference map
+  std::mt19937 engine(0);
+  std::uniform_int_distribution<std::int32_t> dist(0, 20);
+  const std::size_t n = 2000;
+  std::vector<std::int32_t> keys(3 * n), values(n);
+  std::map<std::array<std::int32_t, 3>, std::int32_t> map_ref;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    std::array<std::int32_t, 3> key;
+    for (std::size_t j = 0; j < 3; ++j)
+      key[j] = keys[3 * i + j] = dist(engine);
+    values[i] = i;
+    map_ref.insert({key, i});
+  }
+
+  // Start with small capacity to exercise rehashing
+  common::ArrayHashMap<3> map(4);
+  map.insert(keys.data(), values.data(), n / 2);
+  for (std::size_t i = n / 2; i < n; ++i)
+  {
+    map.insert({{keys[3 * i], keys[3 * i + 1], keys[3 * i + 2]}},
+               values[i]);
+  }
+  CHECK(map.size() == map_ref.size());
+
+  // First inserted value is kept for duplicate keys
+  std::vector<std::int32_t> found(n);
+  map.find(keys.data(), found.data(), n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    CHECK(found[i]
+          == map_ref.at({{keys[3 * i], keys[3 * i + 1], keys[3 * i + 2]}}));
+  }
+
+  CHECK(map.find({{-1, 0, 0}}) == -1);
+  map.clear();
+  CHECK(map.size() == 0);
+  CHECK(map.find({{keys[0], keys[1], keys[2]}}) == -1);
+}
@@ -0,0 +1,52 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <catch.hpp>
+#include <cstdint>
+#include <dolfin/common/sort.h>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace dolfin;
+
+namespace
+{
+template <typename T, std::size_t N>
+void test_radix_sort(T max_value)
+{
+  std::mt19937 engine(0);
+  std::uniform_int_distribution<T> dist(0, max_value);
+  std::vector<std::array<T, N>> keys(1000);
+  for (auto& key : keys)
+    for (auto& k : key)
+      k = dist(engine);
+
+  // Reference permutation from a stable sort
+  std::vector<std::int32_t> perm_ref(keys.size());
+  std::iota(perm_ref.begin(), perm_ref.end(), 0);
+  std::stable_sort(perm_ref.begin(), perm_ref.end(),
+                   [&keys](auto a, auto b) { return keys[a] < keys[b]; });
+
+  std::vector<std::array<T, N>> sorted_keys = keys;
+  std::vector<std::int32_t> perm = common::radix_argsort(sorted_keys);
+  CHECK(perm == perm_ref);
+  CHECK(std::is_sorted(sorted_keys.begin(), sorted_keys.end()));
+}
+} // namespace
+
+TEST_CASE("Radix sort", "[radix_sort]")
+{
+  // Few distinct values, to check stability
+  CHECK_NOTHROW(test_radix_sort<std::uint64_t, 1>(7));
+  CHECK_NOTHROW(test_radix_sort<std::uint64_t, 1>(1000000));
+  CHECK_NOTHROW(test_radix_sort<std::uint64_t, 2>(
+      std::numeric_limits<std::uint64_t>::max()));
+  CHECK_NOTHROW(test_radix_sort<std::uint32_t, 3>(100));
+}
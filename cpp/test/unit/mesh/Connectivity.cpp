@@ -0,0 +1,124 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <dolfin/mesh/CompressedConnectivity.h>
+#include <dolfin/mesh/Connectivity.h>
+#include <limits>
+#include <vector>
+
+using namespace dolfin;
+
+TEST_CASE("Connectivity with constant number of connections",
+          "[connectivity_constant]")
+{
+  const std::vector<std::vector<std::int32_t>> c0
+      = {{0, 1, 2}, {1, 2, 3}, {5, 2, 4}};
+  mesh::Connectivity c(c0);
+  CHECK(c.num_entities() == 3);
+  CHECK(c.num_connections_per_entity() == 3);
+  CHECK(c.size(2) == 3);
+  CHECK(c.size(3) == 0);
+  CHECK(c.connections(2)[0] == 5);
+  CHECK(c.connections(3) == nullptr);
+  CHECK((c.entity_positions() == Eigen::Array4i(0, 3, 6, 9)).all());
+  CHECK(&c.entity_positions() == &c.entity_positions());
+
+  // Variable number of connections
+  mesh::Connectivity c1(std::vector<std::int32_t>({0, 1, 2, 3, 4}),
+                        std::vector<std::int32_t>({0, 2, 2, 5}));
+  CHECK(c1.num_entities() == 3);
+  CHECK(c1.num_connections_per_entity() == -1);
+  CHECK(c1.size(1) == 0);
+  CHECK(c1.size(2) == 3);
+  CHECK(c1.connections(2)[0] == 2);
+}
+
+TEST_CASE("Compressed connectivity", "[connectivity_compressed]")
+{
+  // Round trip, including an entity without connections and the
+  // largest jumps between connections
+  const std::int32_t max = std::numeric_limits<std::int32_t>::max();
+  const std::vector<std::vector<std::int32_t>> c0
+      = {{0, 10, 200000}, {}, {7, 3, 1 << 30, 0}, {42}, {max, 0, max, 1}};
+  const mesh::Connectivity c(c0);
+  const mesh::CompressedConnectivity cc(c);
+  REQUIRE(cc.num_entities() == 5);
+  for (std::int32_t e = 0; e < cc.num_entities(); ++e)
+  {
+    CHECK(cc.size(e) == c0[e].size());
+    const std::vector<std::int32_t> v(cc.begin(e), cc.end(e));
+    CHECK(v == c0[e]);
+  }
+
+  const mesh::Connectivity c1 = cc.decompress();
+  CHECK(c1.hash() == c.hash());
+  CHECK((c1.entity_positions() == c.entity_positions()).all());
+
+  // Empty connectivity
+  const mesh::Connectivity c_empty(std::vector<std::vector<std::int32_t>>{});
+  const mesh::CompressedConnectivity cc_empty(c_empty);
+  CHECK(cc_empty.num_entities() == 0);
+  CHECK(cc_empty.decompress().num_entities() == 0);
+}
+
+TEST_CASE("Compressed vertex - cell connectivity",
+          "[connectivity_compressed]")
+{
+  // Vertex - cell connectivity of a structured triangle mesh, with
+  // sorted cells of varying number per vertex
+  const std::int32_t n = 60;
+  std::vector<std::vector<std::int32_t>> c0((n + 1) * (n + 1));
+  for (std::int32_t j = 0; j < n; ++j)
+  {
+    for (std::int32_t i = 0; i < n; ++i)
+    {
+      const std::int32_t v0 = j * (n + 1) + i;
+      const std::int32_t v1 = v0 + 1, v2 = v0 + n + 1, v3 = v2 + 1;
+      const std::int32_t cell = 2 * (j * n + i);
+      for (std::int32_t v : {v0, v1, v3})
+        c0[v].push_back(cell);
+      for (std::int32_t v : {v0, v2, v3})
+        c0[v].push_back(cell + 1);
+    }
+  }
+
+  const mesh::Connectivity c(c0);
+  CHECK(c.num_connections_per_entity() == -1);
+  const mesh::CompressedConnectivity cc(c);
+  for (std::int32_t e = 0; e < cc.num_entities(); ++e)
+  {
+    REQUIRE(cc.size(e) == c.size(e));
+    CHECK(std::equal(cc.begin(e), cc.end(e), c.connections(e)));
+  }
+  CHECK(cc.decompress().hash() == c.hash());
+  CHECK(2 * cc.memory_usage() < c.memory_usage());
+}
+
+TEST_CASE("Connectivity view", "[connectivity_view]")
+{
+  const mesh::Connectivity c(std::vector<std::vector<std::int32_t>>(
+      {{0, 1, 2}, {1, 2, 3}, {5, 2, 4}}));
+  const mesh::ConnectivityView v(c);
+  CHECK(v.num_entities() == 3);
+  CHECK(v.size(1) == 3);
+  CHECK(v.size_global(1) == 3);
+  CHECK(v.connections(2)[0] == 5);
+  CHECK(v.local_index(2, 4) == 2);
+  CHECK(v.local_index(2, 0) == -1);
+
+  // Variable number of connections
+  const mesh::Connectivity c1(std::vector<std::int32_t>({0, 1, 2, 3, 4}),
+                              std::vector<std::int32_t>({0, 2, 2, 5}));
+  const mesh::ConnectivityView v1(c1);
+  CHECK(v1.num_entities() == 3);
+  CHECK(v1.size(1) == 0);
+  CHECK(v1.size(2) == 3);
+  CHECK(v1.connections(2)[0] == 2);
+  CHECK(v1.local_index(2, 4) == 2);
+}
@@ -0,0 +1,45 @@
+// Copyright (C) 2026 agent
+//
+// This file is part of DOLFIN (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include <catch.hpp>
+#include <cstdint>
+#include <dolfin/mesh/SharedEntities.h>
+#include <map>
+#include <set>
+#include <vector>
+
+using namespace dolfin;
+
+TEST_CASE("Shared entities", "[shared_entities]")
+{
+  const std::map<std::int32_t, std::set<std::int32_t>> m
+      = {{2, {1, 3}}, {5, {0}}, {9, {0, 1, 4}}};
+  const mesh::SharedEntities s(m);
+  CHECK(s.size() == 3);
+  CHECK(s.entities() == std::vector<std::int32_t>({2, 5, 9}));
+  CHECK(s.offsets() == std::vector<std::int32_t>({0, 2, 3, 6}));
+  CHECK(s.find(5) == 1);
+  CHECK(s.find(4) == -1);
+  CHECK(s.contains(9));
+  CHECK(!s.contains(10));
+  CHECK(s.num_processes(2) == 3);
+  CHECK(s.processes(2)[1] == 1);
+  CHECK(s.sharing_processes(2) == std::vector<std::int32_t>({1, 3}));
+  CHECK(s.sharing_processes(3).empty());
+  CHECK(s.to_map() == m);
+
+  // Unsorted pairs, with duplicates
+  const mesh::SharedEntities s1 = mesh::SharedEntities::create(
+      {{9, 4}, {2, 3}, {5, 0}, {9, 0}, {2, 1}, {9, 1}, {2, 3}});
+  CHECK(s1.entities() == s.entities());
+  CHECK(s1.offsets() == s.offsets());
+  CHECK(s1.processes() == s.processes());
+
+  const mesh::SharedEntities s2;
+  CHECK(s2.empty());
+  CHECK(!s2.contains(0));
+  CHECK(s2.to_map().empty());
+}
@@ -26,6 +26,13 @@ def list_timings(timing_types: list):
     return cpp.common.list_timings(timing_types)
 
 
+def memory_report(comm, objects: dict):
+    """Return table (on rank 0) with the memory usage of objects, given
+    as a dict of (name, object), and the peak memory recorded for tasks"""
+    return cpp.common.memory_report(
+        comm, [(name, obj.memory_usage()) for name, obj in objects.items()])
+
+
 class Timer:
     """A timer can be used for timing tasks. The basic usage is::
 
@@ -183,3 +183,10 @@ class Function(ufl.Coefficient):
         V_collapsed = functionspace.FunctionSpace(None, self.ufl_element(),
                                                   u_collapsed.function_space())
         return Function(V_collapsed, u_collapsed.vector())
+
+    def migrate(self, plan, V):
+        """Move the function to a rebalanced mesh without interpolation.
+        V is the function space on the new mesh, with the same element
+        (see cpp.mesh.rebalance)."""
+        u = self._cpp_object.migrate(plan, V._cpp_object)
+        return Function(V, u.vector())
@@ -59,7 +59,8 @@ def RectangleMesh(comm,
                   n: list,
                   cell_type=cpp.mesh.CellType.Type.triangle,
                   ghost_mode=cpp.mesh.GhostMode.none,
-                  diagonal: str = "right"):
+                  diagonal: str = "right",
+                  partitioner: str = "SCOTCH"):
     """Create rectangle mesh
 
     Parameters
@@ -72,13 +73,18 @@ def RectangleMesh(comm,
         List of number of cells in each direction
     diagonal
         Direction of diagonal
+    partitioner
+        Partitioner ("SCOTCH", "ParMETIS" or "Hilbert"), or "block" to
+        create a block of rows of cells on each process without
+        partitioning
 
     Note
     ----
     Coordinate mapping is not attached
 
     """
-    return cpp.generation.RectangleMesh.create(comm, points, n, cell_type, ghost_mode, diagonal)
+    return cpp.generation.RectangleMesh.create(comm, points, n, cell_type, ghost_mode, diagonal,
+                                               partitioner)
 
 
 def UnitSquareMesh(comm,
@@ -86,7 +92,8 @@ def UnitSquareMesh(comm,
                    ny,
                    cell_type=cpp.mesh.CellType.Type.triangle,
                    ghost_mode=cpp.mesh.GhostMode.none,
-                   diagonal="right"):
+                   diagonal="right",
+                   partitioner="SCOTCH"):
     """Create a mesh of a unit square with coordinate mapping attached
 
     Parameters
@@ -99,11 +106,15 @@ def UnitSquareMesh(comm,
         Number of cells in "y" direction
     diagonal
         Direction of diagonal
+    partitioner
+        Partitioner ("SCOTCH", "ParMETIS" or "Hilbert"), or "block" to
+        create a block of rows of cells on each process without
+        partitioning
 
     """
     mesh = RectangleMesh(comm, [numpy.array([0.0, 0.0, 0.0]),
                                 numpy.array([1.0, 1.0, 0.0])],
-                         [nx, ny], cell_type, ghost_mode, diagonal)
+                         [nx, ny], cell_type, ghost_mode, diagonal, partitioner)
     mesh.geometry.coord_mapping = fem.create_coordinate_map(mesh)
     return mesh
 
@@ -112,7 +123,8 @@ def BoxMesh(comm,
             points: typing.List[numpy.array],
             n: list,
             cell_type=cpp.mesh.CellType.Type.tetrahedron,
-            ghost_mode=cpp.mesh.GhostMode.none):
+            ghost_mode=cpp.mesh.GhostMode.none,
+            partitioner: str = "SCOTCH"):
     """Create box mesh
 
     Parameters
@@ -123,12 +135,16 @@ def BoxMesh(comm,
         List of points representing vertices
     n
         List of cells in each direction
+    partitioner
+        Partitioner ("SCOTCH", "ParMETIS" or "Hilbert"), or "block" to
+        create a block of layers of cells on each process without
+        partitioning
 
     Note
     ----
     Coordinate mapping is not attached
     """
-    return cpp.generation.BoxMesh.create(comm, points, n, cell_type, ghost_mode)
+    return cpp.generation.BoxMesh.create(comm, points, n, cell_type, ghost_mode, partitioner)
 
 
 def UnitCubeMesh(comm,
@@ -136,7 +152,8 @@ def UnitCubeMesh(comm,
                  ny,
                  nz,
                  cell_type=cpp.mesh.CellType.Type.tetrahedron,
-                 ghost_mode=cpp.mesh.GhostMode.none):
+                 ghost_mode=cpp.mesh.GhostMode.none,
+                 partitioner="SCOTCH"):
     """Create a mesh of a unit cube with coordinate mapping attached
 
     Parameters
@@ -149,10 +166,14 @@ def UnitCubeMesh(comm,
         Number of cells in "y" direction
     nz
         Number of cells in "z" direction
+    partitioner
+        Partitioner ("SCOTCH", "ParMETIS" or "Hilbert"), or "block" to
+        create a block of layers of cells on each process without
+        partitioning
 
     """
     mesh = BoxMesh(comm, [numpy.array([0.0, 0.0, 0.0]),
                           numpy.array([1.0, 1.0, 1.0])],
-                   [nx, ny, nz], cell_type, ghost_mode)
+                   [nx, ny, nz], cell_type, ghost_mode, partitioner)
     mesh.geometry.coord_mapping = fem.create_coordinate_map(mesh)
     return mesh
@@ -12,6 +12,7 @@
 #include <dolfin/common/Table.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/defines.h>
+#include <dolfin/common/memory.h>
 #include <dolfin/common/timing.h>
 #include <memory>
 #include <pybind11/eigen.h>
@@ -98,6 +99,21 @@ void common(py::module& m)
     dolfin::list_timings(_type);
   });
 
+  // dolfin::common::MemoryTracker
+  py::class_<dolfin::common::MemoryTracker,
+             std::shared_ptr<dolfin::common::MemoryTracker>>(
+      m, "MemoryTracker", "Peak memory tracker")
+      .def(py::init<std::string>())
+      .def("stop", &dolfin::common::MemoryTracker::stop)
+      .def_static("peaks", &dolfin::common::MemoryTracker::peaks);
+
+  m.def("memory_report",
+        [](const MPICommWrapper comm,
+           const std::vector<
+               std::pair<std::string, dolfin::common::MemoryUsage>>& objects) {
+          return dolfin::common::memory_report(comm.get(), objects);
+        });
+
   // dolfin::SubSystemsManager
   py::class_<dolfin::common::SubSystemsManager,
              std::unique_ptr<dolfin::common::SubSystemsManager, py::nodelete>>(
@@ -8,6 +8,7 @@
 #include <Eigen/Dense>
 #include <dolfin/common/IndexMap.h>
 #include <dolfin/common/types.h>
+#include <dolfin/fem/CellCostRecorder.h>
 #include <dolfin/fem/CoordinateMapping.h>
 #include <dolfin/fem/DirichletBC.h>
 #include <dolfin/fem/DiscreteOperators.h>
@@ -22,6 +23,7 @@
 #include <dolfin/la/PETScMatrix.h>
 #include <dolfin/la/PETScVector.h>
 #include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/MeshFunction.h>
 #include <memory>
 #include <petsc4py/petsc4py.h>
 #include <pybind11/eigen.h>
@@ -172,7 +174,21 @@ void fem(py::module& m)
   // dolfin::fem::DofMap
   py::class_<dolfin::fem::DofMap, std::shared_ptr<dolfin::fem::DofMap>,
              dolfin::fem::GenericDofMap>(m, "DofMap", "DofMap object")
-      .def(py::init<const ufc_dofmap&, const dolfin::mesh::Mesh&>());
+      .def(py::init<const ufc_dofmap&, const dolfin::mesh::Mesh&>())
+      .def("memory_usage", &dolfin::fem::DofMap::memory_usage);
+
+  // dolfin::fem::CellCostRecorder
+  py::class_<dolfin::fem::CellCostRecorder,
+             std::shared_ptr<dolfin::fem::CellCostRecorder>>(
+      m, "CellCostRecorder", "Recorder for the cost of assembly over cells")
+      .def(py::init<std::shared_ptr<const dolfin::mesh::Mesh>>())
+      .def("mesh", &dolfin::fem::CellCostRecorder::mesh)
+      .def("costs", &dolfin::fem::CellCostRecorder::costs)
+      .def("reset", &dolfin::fem::CellCostRecorder::reset)
+      .def("weights", &dolfin::fem::CellCostRecorder::weights,
+           py::arg("scale") = 100)
+      .def("subdomain_costs",
+           &dolfin::fem::CellCostRecorder::subdomain_costs);
 
   // dolfin::fem::CoordinateMapping
   py::class_<dolfin::fem::CoordinateMapping,
@@ -290,6 +306,9 @@ void fem(py::module& m)
       .def("set_interior_facet_domains",
            &dolfin::fem::Form::set_interior_facet_domains)
       .def("set_vertex_domains", &dolfin::fem::Form::set_vertex_domains)
+      .def("set_cell_cost_recorder",
+           &dolfin::fem::Form::set_cell_cost_recorder)
+      .def("cell_cost_recorder", &dolfin::fem::Form::cell_cost_recorder)
       .def("set_tabulate_cell",
            [](dolfin::fem::Form& self, int i, std::intptr_t addr) {
              auto tabulate_tensor_ptr
@@ -13,6 +13,7 @@
 #include <dolfin/geometry/BoundingBoxTree.h>
 #include <dolfin/la/PETScVector.h>
 #include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/MigrationPlan.h>
 #include <memory>
 #include <petsc4py/petsc4py.h>
 #include <pybind11/eigen.h>
@@ -42,6 +43,8 @@ void function(py::module& m)
            "Return sub-function (view into parent Function")
       .def("collapse", &dolfin::function::Function::collapse,
            "Collapse sub-function view")
+      .def("migrate", &dolfin::function::Function::migrate, py::arg("plan"),
+           py::arg("V"), "Move function to a rebalanced mesh")
       .def(
           "interpolate",
           py::overload_cast<const std::function<void(
@@ -47,12 +47,15 @@ void generation(py::module& m)
           [](const MPICommWrapper comm, std::array<Eigen::Vector3d, 2> p,
              std::array<std::size_t, 2> n,
              dolfin::mesh::CellType::Type cell_type,
-             dolfin::mesh::GhostMode ghost_mode, std::string diagonal) {
+             dolfin::mesh::GhostMode ghost_mode, std::string diagonal,
+             std::string partitioner) {
             return dolfin::generation::RectangleMesh::create(
-                comm.get(), p, n, cell_type, ghost_mode, diagonal);
+                comm.get(), p, n, cell_type, ghost_mode, diagonal,
+                partitioner);
           },
           py::arg("comm"), py::arg("p"), py::arg("n"), py::arg("cell_type"),
-          py::arg("ghost_mode"), py::arg("diagonal") = "right");
+          py::arg("ghost_mode"), py::arg("diagonal") = "right",
+          py::arg("partitioner") = "SCOTCH");
 
   // dolfin::UnitTriangleMesh
   py::class_<dolfin::generation::UnitTriangleMesh>(m, "UnitTriangleMesh")
@@ -74,11 +77,12 @@ void generation(py::module& m)
           [](const MPICommWrapper comm, std::array<Eigen::Vector3d, 2> p,
              std::array<std::size_t, 3> n,
              dolfin::mesh::CellType::Type cell_type,
-             const dolfin::mesh::GhostMode ghost_mode) {
-            return dolfin::generation::BoxMesh::create(comm.get(), p, n,
-                                                       cell_type, ghost_mode);
+             const dolfin::mesh::GhostMode ghost_mode,
+             std::string partitioner) {
+            return dolfin::generation::BoxMesh::create(
+                comm.get(), p, n, cell_type, ghost_mode, partitioner);
           },
           py::arg("comm"), py::arg("p"), py::arg("n"), py::arg("cell_type"),
-          py::arg("ghost_mode"));
+          py::arg("ghost_mode"), py::arg("partitioner") = "SCOTCH");
 }
 } // namespace dolfin_wrappers
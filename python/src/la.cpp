@@ -50,6 +50,7 @@ void la(py::module& m)
       .def("assemble", &dolfin::la::SparsityPattern::assemble)
       .def("str", &dolfin::la::SparsityPattern::str)
       .def("num_nonzeros", &dolfin::la::SparsityPattern::num_nonzeros)
+      .def("memory_usage", &dolfin::la::SparsityPattern::memory_usage)
       .def("num_nonzeros_diagonal",
            &dolfin::la::SparsityPattern::num_nonzeros_diagonal)
       .def("num_nonzeros_off_diagonal",
@@ -87,9 +88,16 @@ void la(py::module& m)
            &dolfin::la::PETScKrylovSolver::set_options_prefix)
       .def("set_operator", &dolfin::la::PETScKrylovSolver::set_operator)
       .def("set_operators", &dolfin::la::PETScKrylovSolver::set_operators)
-      .def("solve", &dolfin::la::PETScKrylovSolver::solve,
+      .def("solve",
+           py::overload_cast<Vec, const Vec, bool>(
+               &dolfin::la::PETScKrylovSolver::solve),
            "Solve linear system", py::arg("x"), py::arg("b"),
            py::arg("transpose") = false)
+      .def("solve",
+           py::overload_cast<Mat, const Mat>(
+               &dolfin::la::PETScKrylovSolver::solve),
+           "Solve linear system with multiple right-hand sides",
+           py::arg("X"), py::arg("B"))
       .def("set_from_options", &dolfin::la::PETScKrylovSolver::set_from_options)
       .def("set_dm", &dolfin::la::PETScKrylovSolver::set_dm)
       .def("set_dm_active", &dolfin::la::PETScKrylovSolver::set_dm_active)
@@ -142,6 +150,9 @@ void la(py::module& m)
                                                block_size);
       },
       py::return_value_policy::take_ownership, "Create a PETSc Vec.");
+  m.def("create_multivector", &dolfin::la::create_petsc_multivector,
+        py::return_value_policy::take_ownership,
+        "Create a dense PETSc Mat with n columns for index map.");
   m.def(
       "create_matrix",
       [](const MPICommWrapper comm, const dolfin::la::SparsityPattern& p) {
@@ -10,6 +10,7 @@
 #include <dolfin/mesh/Cell.h>
 #include <dolfin/mesh/CellType.h>
 #include <dolfin/mesh/Connectivity.h>
+#include <dolfin/mesh/ConnectivityLease.h>
 #include <dolfin/mesh/CoordinateDofs.h>
 #include <dolfin/mesh/Edge.h>
 #include <dolfin/mesh/Face.h>
@@ -21,10 +22,12 @@
 #include <dolfin/mesh/MeshIterator.h>
 #include <dolfin/mesh/MeshQuality.h>
 #include <dolfin/mesh/MeshValueCollection.h>
+#include <dolfin/mesh/MigrationPlan.h>
 #include <dolfin/mesh/Ordering.h>
 #include <dolfin/mesh/Partitioning.h>
 #include <dolfin/mesh/Topology.h>
 #include <dolfin/mesh/Vertex.h>
+#include <dolfin/mesh/utils.h>
 #include <memory>
 #include <pybind11/eigen.h>
 #include <pybind11/eval.h>
@@ -68,6 +71,91 @@ void mesh(py::module& m)
       .value("shared_facet", dolfin::mesh::GhostMode::shared_facet)
       .value("shared_vertex", dolfin::mesh::GhostMode::shared_vertex);
 
+  // dolfin::mesh::CellMetric enums
+  py::enum_<dolfin::mesh::CellMetric>(m, "CellMetric")
+      .value("volume", dolfin::mesh::CellMetric::volume)
+      .value("h", dolfin::mesh::CellMetric::h)
+      .value("circumradius", dolfin::mesh::CellMetric::circumradius)
+      .value("inradius", dolfin::mesh::CellMetric::inradius)
+      .value("radius_ratio", dolfin::mesh::CellMetric::radius_ratio);
+
+  m.def("cell_metric", &dolfin::mesh::cell_metric,
+        "Compute metric for all cells (not cached)");
+  m.def("cell_facet_areas", &dolfin::mesh::cell_facet_areas,
+        "Compute area of each facet of all cells");
+  m.def("cell_facet_normals", &dolfin::mesh::cell_facet_normals,
+        "Compute outward unit normal of each facet of all cells");
+
+  // dolfin::mesh::CellReordering enums
+  py::enum_<dolfin::mesh::CellReordering>(m, "CellReordering")
+      .value("none", dolfin::mesh::CellReordering::none)
+      .value("hilbert", dolfin::mesh::CellReordering::hilbert)
+      .value("reverse_cuthill_mckee",
+             dolfin::mesh::CellReordering::reverse_cuthill_mckee);
+
+  // dolfin::mesh::Partitioning
+  py::class_<dolfin::mesh::Partitioning>(m, "Partitioning")
+      .def_static(
+          "build_distributed_mesh",
+          [](const MPICommWrapper comm, dolfin::mesh::CellType::Type type,
+             const Eigen::Ref<const dolfin::EigenRowArrayXXd> points,
+             const Eigen::Ref<const dolfin::EigenRowArrayXXi64> cells,
+             const std::vector<std::int64_t>& global_cell_indices,
+             const dolfin::mesh::GhostMode ghost_mode,
+             std::string graph_partitioner,
+             dolfin::mesh::CellReordering cell_reordering,
+             const std::vector<std::size_t>& cell_weights,
+             int num_ghost_layers) {
+            return dolfin::mesh::Partitioning::build_distributed_mesh(
+                comm.get(), type, points, cells, global_cell_indices,
+                ghost_mode, graph_partitioner, cell_reordering, cell_weights,
+                num_ghost_layers);
+          },
+          py::arg("comm"), py::arg("type"), py::arg("points"),
+          py::arg("cells"), py::arg("global_cell_indices"),
+          py::arg("ghost_mode"), py::arg("graph_partitioner") = "SCOTCH",
+          py::arg("cell_reordering") = dolfin::mesh::CellReordering::none,
+          py::arg("cell_weights") = std::vector<std::size_t>(),
+          py::arg("num_ghost_layers") = 1);
+
+  // dolfin::mesh::MigrationPlan
+  py::class_<dolfin::mesh::MigrationPlan,
+             std::shared_ptr<dolfin::mesh::MigrationPlan>>(
+      m, "MigrationPlan", "Plan for moving cell data between meshes")
+      .def(py::init<const dolfin::mesh::Mesh&, const dolfin::mesh::Mesh&>())
+      .def("num_cells_old", &dolfin::mesh::MigrationPlan::num_cells_old)
+      .def("num_cells_new", &dolfin::mesh::MigrationPlan::num_cells_new)
+      .def("num_received_cells",
+           &dolfin::mesh::MigrationPlan::num_received_cells)
+      .def("migrate", &dolfin::mesh::MigrationPlan::migrate<double>,
+           py::arg("values"), "Move cell data to the new mesh")
+      .def("migrate",
+           [](const dolfin::mesh::MigrationPlan& self,
+              const dolfin::mesh::MeshFunction<std::size_t>& f,
+              std::shared_ptr<const dolfin::mesh::Mesh> mesh) {
+             return self.migrate(f, mesh);
+           },
+           py::arg("f"), py::arg("mesh"))
+      .def("migrate",
+           [](const dolfin::mesh::MigrationPlan& self,
+              const dolfin::mesh::MeshFunction<int>& f,
+              std::shared_ptr<const dolfin::mesh::Mesh> mesh) {
+             return self.migrate(f, mesh);
+           },
+           py::arg("f"), py::arg("mesh"))
+      .def("migrate",
+           [](const dolfin::mesh::MigrationPlan& self,
+              const dolfin::mesh::MeshFunction<double>& f,
+              std::shared_ptr<const dolfin::mesh::Mesh> mesh) {
+             return self.migrate(f, mesh);
+           },
+           py::arg("f"), py::arg("mesh"));
+
+  m.def("rebalance", &dolfin::mesh::rebalance, py::arg("mesh"),
+        py::arg("cell_weights"), py::arg("partitioner") = "ParMETIS-adaptive",
+        "Rebalance a distributed mesh, returning the new mesh and the "
+        "plan for moving cell data to it");
+
   // dolfin::mesh::CoordinateDofs class
   py::class_<dolfin::mesh::CoordinateDofs,
              std::shared_ptr<dolfin::mesh::CoordinateDofs>>(
@@ -76,7 +164,7 @@ void mesh(py::module& m)
         const dolfin::mesh::Connectivity& connectivity = self.entity_points();
         Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>
             connections = connectivity.connections();
-        const int num_entities = connectivity.entity_positions().size() - 1;
+        const int num_entities = connectivity.num_entities();
 
         // FIXME: mesh::CoordinateDofs should know its dimension
         // (entity_size) to handle empty case on a process.
@@ -106,6 +194,9 @@ void mesh(py::module& m)
             self.points() = values;
           },
           "Return coordinates of all points")
+      .def("mark_modified", &dolfin::mesh::Geometry::mark_modified,
+           "Mark coordinates as modified after writing through a kept view "
+           "of points")
       .def_readwrite("coord_mapping", &dolfin::mesh::Geometry::coord_mapping);
 
   // dolfin::mesh::Topology class
@@ -118,10 +209,15 @@ void mesh(py::module& m)
                &dolfin::mesh::Topology::connectivity, py::const_))
       .def("size", &dolfin::mesh::Topology::size)
       .def("hash", &dolfin::mesh::Topology::hash)
+      .def("num_connectivity_leases",
+           &dolfin::mesh::Topology::num_connectivity_leases)
       .def("have_global_indices", &dolfin::mesh::Topology::have_global_indices)
       .def("ghost_offset", &dolfin::mesh::Topology::ghost_offset)
       .def("cell_owner",
            py::overload_cast<>(&dolfin::mesh::Topology::cell_owner, py::const_))
+      .def("ghost_layer_offsets",
+           py::overload_cast<>(&dolfin::mesh::Topology::ghost_layer_offsets,
+                               py::const_))
       .def("global_indices",
            [](const dolfin::mesh::Topology& self, int dim) {
              auto& indices = self.global_indices(dim);
@@ -130,7 +226,9 @@ void mesh(py::module& m)
       .def("have_shared_entities",
            &dolfin::mesh::Topology::have_shared_entities)
       .def("shared_entities",
-           py::overload_cast<int>(&dolfin::mesh::Topology::shared_entities))
+           [](dolfin::mesh::Topology& self, int dim) {
+             return self.shared_entities(dim).to_map();
+           })
       .def("str", &dolfin::mesh::Topology::str);
 
   // dolfin::mesh::Mesh
@@ -162,6 +260,9 @@ void mesh(py::module& m)
           py::overload_cast<>(&dolfin::mesh::Mesh::coordinate_dofs, py::const_))
       .def("degree", &dolfin::mesh::Mesh::degree)
       .def("hash", &dolfin::mesh::Mesh::hash)
+      .def("memory_usage", &dolfin::mesh::Mesh::memory_usage)
+      .def("cell_metric", &dolfin::mesh::Mesh::cell_metric,
+           "Return metric for all cells (cached)")
       .def("hmax", &dolfin::mesh::Mesh::hmax)
       .def("hmin", &dolfin::mesh::Mesh::hmin)
       .def("create_global_indices", &dolfin::mesh::Mesh::create_global_indices)
@@ -203,10 +304,27 @@ void mesh(py::module& m)
            py::overload_cast<>(&dolfin::mesh::Connectivity::connections),
            "Return all connectivities")
       .def("pos",
-           py::overload_cast<>(&dolfin::mesh::Connectivity::entity_positions),
+           &dolfin::mesh::Connectivity::entity_positions,
            "Index to each entity in the connectivity array")
       .def("size", &dolfin::mesh::Connectivity::size);
 
+  // dolfin::mesh::ConnectivityLease
+  py::class_<dolfin::mesh::ConnectivityLease>(m, "ConnectivityLease",
+                                              "ConnectivityLease object")
+      .def(py::init<const dolfin::mesh::Mesh&, std::size_t, std::size_t>(),
+           py::keep_alive<1, 2>())
+      .def("connectivity", &dolfin::mesh::ConnectivityLease::connectivity,
+           py::return_value_policy::reference_internal)
+      .def("pin", &dolfin::mesh::ConnectivityLease::pin)
+      .def("release", &dolfin::mesh::ConnectivityLease::release)
+      .def("__enter__",
+           [](dolfin::mesh::ConnectivityLease& self)
+               -> dolfin::mesh::ConnectivityLease& { return self; },
+           py::return_value_policy::reference_internal)
+      .def("__exit__",
+           [](dolfin::mesh::ConnectivityLease& self, py::object, py::object,
+              py::object) { self.release(); });
+
   // dolfin::mesh::MeshEntity class
   py::class_<dolfin::mesh::MeshEntity,
              std::shared_ptr<dolfin::mesh::MeshEntity>>(m, "MeshEntity",
@@ -51,19 +51,83 @@ void nls(py::module& m)
 
   // dolfin::NewtonSolver
   py::class_<dolfin::nls::NewtonSolver,
-             std::shared_ptr<dolfin::nls::NewtonSolver>, PyNewtonSolver>(
-      m, "NewtonSolver")
+             std::shared_ptr<dolfin::nls::NewtonSolver>, PyNewtonSolver>
+      newton_solver(m, "NewtonSolver");
+
+  py::enum_<dolfin::nls::NewtonSolver::ForcingTerm>(newton_solver,
+                                                    "ForcingTerm")
+      .value("fixed", dolfin::nls::NewtonSolver::ForcingTerm::fixed)
+      .value("eisenstat_walker_1",
+             dolfin::nls::NewtonSolver::ForcingTerm::eisenstat_walker_1)
+      .value("eisenstat_walker_2",
+             dolfin::nls::NewtonSolver::ForcingTerm::eisenstat_walker_2);
+
+  py::enum_<dolfin::nls::NewtonSolver::LineSearch>(newton_solver,
+                                                   "LineSearch")
+      .value("basic", dolfin::nls::NewtonSolver::LineSearch::basic)
+      .value("backtracking",
+             dolfin::nls::NewtonSolver::LineSearch::backtracking)
+      .value("critical_point",
+             dolfin::nls::NewtonSolver::LineSearch::critical_point);
+
+  newton_solver
       .def(py::init([](const MPICommWrapper comm) {
         return std::make_unique<PyNewtonSolver>(comm.get());
       }))
       .def("solve", &dolfin::nls::NewtonSolver::solve)
       .def("converged", &PyPublicNewtonSolver::converged)
       .def("update_solution", &PyPublicNewtonSolver::update_solution)
+      .def("get_krylov_solver",
+           py::overload_cast<>(&dolfin::nls::NewtonSolver::get_krylov_solver),
+           py::return_value_policy::reference_internal)
+      .def("residual", &dolfin::nls::NewtonSolver::residual)
+      .def("residual0", &dolfin::nls::NewtonSolver::residual0)
+      .def("krylov_iterations",
+           &dolfin::nls::NewtonSolver::krylov_iterations)
+      .def("jacobian_evaluations",
+           &dolfin::nls::NewtonSolver::jacobian_evaluations)
+      .def("preconditioner_setups",
+           &dolfin::nls::NewtonSolver::preconditioner_setups)
+      .def("line_search_evaluations",
+           &dolfin::nls::NewtonSolver::line_search_evaluations)
       .def_readwrite("atol", &dolfin::nls::NewtonSolver::atol)
       .def_readwrite("rtol", &dolfin::nls::NewtonSolver::rtol)
       .def_readwrite("max_it", &dolfin::nls::NewtonSolver::max_it)
+      .def_readwrite("error_on_nonconvergence",
+                     &dolfin::nls::NewtonSolver::error_on_nonconvergence)
       .def_readwrite("convergence_criterion",
-                     &dolfin::nls::NewtonSolver::convergence_criterion);
+                     &dolfin::nls::NewtonSolver::convergence_criterion)
+      .def_readwrite("relaxation_parameter",
+                     &dolfin::nls::NewtonSolver::relaxation_parameter)
+      .def_readwrite("line_search", &dolfin::nls::NewtonSolver::line_search)
+      .def_readwrite("line_search_max_it",
+                     &dolfin::nls::NewtonSolver::line_search_max_it)
+      .def_readwrite("line_search_alpha",
+                     &dolfin::nls::NewtonSolver::line_search_alpha)
+      .def_readwrite("line_search_rtol",
+                     &dolfin::nls::NewtonSolver::line_search_rtol)
+      .def_readwrite("line_search_min_step",
+                     &dolfin::nls::NewtonSolver::line_search_min_step)
+      .def_readwrite("jacobian_free",
+                     &dolfin::nls::NewtonSolver::jacobian_free)
+      .def_readwrite("lag_jacobian", &dolfin::nls::NewtonSolver::lag_jacobian)
+      .def_readwrite("lag_preconditioner",
+                     &dolfin::nls::NewtonSolver::lag_preconditioner)
+      .def_readwrite("lag_preconditioner_persists",
+                     &dolfin::nls::NewtonSolver::lag_preconditioner_persists)
+      .def_readwrite("lag_rebuild_rate",
+                     &dolfin::nls::NewtonSolver::lag_rebuild_rate)
+      .def_readwrite("forcing_term", &dolfin::nls::NewtonSolver::forcing_term)
+      .def_readwrite("forcing_rtol0",
+                     &dolfin::nls::NewtonSolver::forcing_rtol0)
+      .def_readwrite("forcing_rtol_max",
+                     &dolfin::nls::NewtonSolver::forcing_rtol_max)
+      .def_readwrite("forcing_gamma",
+                     &dolfin::nls::NewtonSolver::forcing_gamma)
+      .def_readwrite("forcing_alpha",
+                     &dolfin::nls::NewtonSolver::forcing_alpha)
+      .def_readwrite("forcing_threshold",
+                     &dolfin::nls::NewtonSolver::forcing_threshold);
 
   // dolfin::NonlinearProblem 'trampoline' for overloading from
   // Python
@@ -89,6 +153,12 @@ void nls(py::module& m)
           "Tried to call pure virtual function dolfin::NonlinearProblem::F");
     }
 
+    Mat P(const Vec x) override
+    {
+      PYBIND11_OVERLOAD_INT(Mat, dolfin::nls::NonlinearProblem, "P", x);
+      return dolfin::nls::NonlinearProblem::P(x);
+    }
+
     void form(Vec x) override
     {
       PYBIND11_OVERLOAD_INT(void, dolfin::nls::NonlinearProblem, "form", x);
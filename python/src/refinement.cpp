@@ -4,9 +4,16 @@
 //
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
+#include <dolfin/fem/PETScDMCollection.h>
+#include <dolfin/function/Function.h>
+#include <dolfin/function/FunctionSpace.h>
+#include <dolfin/la/PETScMatrix.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshFunction.h>
+#include <dolfin/refinement/MeshHierarchy.h>
 #include <dolfin/refinement/refine.h>
+#include <memory>
+#include <pybind11/stl.h>
 
 #include "casters.h"
 
@@ -29,6 +36,46 @@ void refinement(py::module& m)
                           const dolfin::mesh::MeshFunction<bool>&, bool>(
             &dolfin::refinement::refine),
         py::arg("mesh"), py::arg("marker"), py::arg("redistribute") = true);
+
+  // dolfin::refinement::refine_with_parents
+  m.def("refine_with_parents",
+        py::overload_cast<const dolfin::mesh::Mesh&, bool>(
+            &dolfin::refinement::refine_with_parents),
+        py::arg("mesh"), py::arg("redistribute") = true);
+
+  m.def("refine_with_parents",
+        py::overload_cast<const dolfin::mesh::Mesh&,
+                          const dolfin::mesh::MeshFunction<bool>&, bool>(
+            &dolfin::refinement::refine_with_parents),
+        py::arg("mesh"), py::arg("marker"), py::arg("redistribute") = true);
+
+  m.def("interpolate_to_refined", &dolfin::refinement::interpolate_to_refined,
+        py::arg("u"), py::arg("V"), py::arg("parent_cells"));
+
+  // dolfin::refinement::MeshHierarchy
+  py::class_<dolfin::refinement::MeshHierarchy,
+             std::shared_ptr<dolfin::refinement::MeshHierarchy>>(
+      m, "MeshHierarchy")
+      .def(py::init<std::shared_ptr<const dolfin::mesh::Mesh>, int>(),
+           py::arg("mesh"), py::arg("num_refinements"))
+      .def(py::init<std::vector<std::shared_ptr<const dolfin::mesh::Mesh>>,
+                    const std::vector<std::vector<std::int64_t>>&>(),
+           py::arg("meshes"), py::arg("parent_cells"))
+      .def("num_levels", &dolfin::refinement::MeshHierarchy::num_levels)
+      .def("mesh", &dolfin::refinement::MeshHierarchy::mesh)
+      .def("parent_cells", &dolfin::refinement::MeshHierarchy::parent_cells)
+      .def("create_prolongation",
+           [](const dolfin::refinement::MeshHierarchy& self,
+              const dolfin::function::FunctionSpace& V0,
+              const dolfin::function::FunctionSpace& V1) {
+             auto A = self.create_prolongation(V0, V1);
+             Mat _A = A.mat();
+             PetscObjectReference((PetscObject)_A);
+             return _A;
+           },
+           py::return_value_policy::take_ownership)
+      .def("create_dm_collection",
+           &dolfin::refinement::MeshHierarchy::create_dm_collection);
 }
 
 } // namespace dolfin_wrappers
@@ -0,0 +1,36 @@
+"""Unit tests for memory usage reporting"""
+
+# Copyright (C) 2026 agent
+#
+# This file is part of DOLFIN (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+
+from dolfin import MPI, UnitCubeMesh, common, cpp
+
+
+def test_mesh_memory_usage():
+    mesh = UnitCubeMesh(MPI.comm_world, 4, 4, 4)
+    usage = mesh.memory_usage()
+    assert usage["geometry points"] >= 8 * 3 * mesh.num_entities(0)
+    assert usage["topology connectivity 3-0"] >= 4 * 4 * mesh.num_cells()
+
+    mesh.create_connectivity(0, 3)
+    assert "topology connectivity 0-3" in mesh.memory_usage()
+
+
+def test_memory_report():
+    mesh = UnitCubeMesh(MPI.comm_world, 4, 4, 4)
+    tracker = cpp.common.MemoryTracker("Create connectivity 1-3")
+    mesh.create_connectivity(1, 3)
+    peak = tracker.stop()
+
+    # The peak includes the work arrays and the new edge-cell
+    # connectivity
+    assert peak >= mesh.memory_usage()["topology connectivity 1-3"]
+    assert cpp.common.MemoryTracker.peaks()["Create connectivity 1-3"] >= peak
+
+    table = common.memory_report(mesh.mpi_comm(), {"Mesh": mesh})
+    if MPI.rank(mesh.mpi_comm()) == 0:
+        assert "Mesh: total" in table.str(True)
+        assert "Peak: Create connectivity 1-3" in table.str(True)
@@ -157,3 +157,46 @@ def test_assembly_ds_domains(mesh):
     s2 = dolfin.MPI.sum(mesh.mpi_comm(), s2)
 
     assert (s == pytest.approx(s2, 1.0e-12) and 2.0 == pytest.approx(s, 1.0e-12))
+
+
+def test_cell_cost_recorder(mesh):
+    V = dolfin.FunctionSpace(mesh, ("CG", 1))
+    u, v = dolfin.TrialFunction(V), dolfin.TestFunction(V)
+
+    # Mark cells in left half of domain
+    tdim = mesh.topology.dim
+    marker = dolfin.MeshFunction("size_t", mesh, tdim, 0)
+    for c in dolfin.Cells(mesh, dolfin.cpp.mesh.MeshRangeType.ALL):
+        if c.midpoint()[0] < 0.5:
+            marker.array()[c.index()] = 1
+    dx = ufl.Measure('dx', subdomain_data=marker, domain=mesh)
+
+    a = dolfin.fem.Form(ufl.inner(u, v) * dx(1))._cpp_object
+    recorder = dolfin.cpp.fem.CellCostRecorder(mesh)
+    a.set_cell_cost_recorder(recorder)
+    for i in range(10):
+        A = dolfin.fem.assemble_matrix(a)
+        A.assemble()
+
+    # Only cells in the integration domain have a cost
+    num_owned = mesh.topology.ghost_offset(tdim)
+    costs = numpy.array(recorder.costs())
+    assert costs.shape[0] == mesh.num_entities(tdim)
+    assert numpy.all(costs[marker.array() == 0] == 0.0)
+    assert numpy.all(costs[num_owned:] == 0.0)
+    subdomain_costs = recorder.subdomain_costs(marker)
+    assert subdomain_costs[0] == 0.0
+    assert subdomain_costs[1] > 0.0
+
+    weights = recorder.weights()
+    assert len(weights) == num_owned
+    assert min(weights) >= 1
+
+    recorder.reset()
+    assert not numpy.any(recorder.costs())
+
+    # A recorder for another mesh cannot be attached
+    mesh1 = dolfin.generation.UnitSquareMesh(dolfin.MPI.comm_world, 4, 4)
+    with pytest.raises(RuntimeError):
+        a.set_cell_cost_recorder(dolfin.cpp.fem.CellCostRecorder(mesh1))
+    assert a.cell_cost_recorder() is recorder
@@ -9,7 +9,7 @@
 import pytest
 
 from dolfin import (MPI, Function, FunctionSpace, UnitCubeMesh, UnitSquareMesh,
-                    VectorFunctionSpace, interpolate)
+                    VectorFunctionSpace, cpp, interpolate)
 from dolfin.cpp.fem import PETScDMCollection
 from ufl import FiniteElement, MixedElement, VectorElement
 
@@ -177,6 +177,64 @@ def test_vector_p1_3d():
     assert diff.norm() < 1.0e-12
 
 
+def test_vector_p1_3d_hierarchy():
+    """Transfer through the levels of a non-nested 3-level hierarchy"""
+    meshes = [UnitCubeMesh(MPI.comm_world, n, n + 1, n + 2)
+              for n in (2, 3, 5)]
+    spaces = [VectorFunctionSpace(mesh, ("CG", 1)) for mesh in meshes]
+
+    def u(values, x):
+        values[:, 0] = x[:, 0] + 2.0 * x[:, 1]
+        values[:, 1] = 4.0 * x[:, 0]
+        values[:, 2] = 3.0 * x[:, 2] + x[:, 0]
+
+    uc = interpolate(u, spaces[0])
+    for Vc, Vf in zip(spaces[:-1], spaces[1:]):
+        mat = PETScDMCollection.create_transfer_matrix(Vc._cpp_object,
+                                                       Vf._cpp_object)
+        Vuc = Function(Vf)
+        mat.mult(uc.vector(), Vuc.vector())
+
+        diff = Vuc.vector().copy()
+        diff.axpy(-1, interpolate(u, Vf).vector())
+        assert diff.norm() < 1.0e-12
+        uc = Vuc
+
+
+@pytest.mark.parametrize("mode", [
+    cpp.mesh.GhostMode.none,
+    pytest.param(cpp.mesh.GhostMode.shared_facet,
+                 marks=pytest.mark.xfail(condition=MPI.size(MPI.comm_world) == 1,
+                                         reason="Shared ghost modes fail in serial")),
+    pytest.param(cpp.mesh.GhostMode.shared_vertex,
+                 marks=pytest.mark.xfail(condition=MPI.size(MPI.comm_world) == 1,
+                                         reason="Shared ghost modes fail in serial"))
+])
+@pytest.mark.parametrize("degree", [1, 2])
+def test_ghost_modes(degree, mode):
+    """Rows are located and evaluated by several processes when cells are
+    ghosted. Each row must be inserted once, by its owner."""
+    meshc = UnitSquareMesh(MPI.comm_world, 3, 4, ghost_mode=mode)
+    meshf = UnitSquareMesh(MPI.comm_world, 5, 7, ghost_mode=mode)
+
+    Vc = FunctionSpace(meshc, ("CG", degree))
+    Vf = FunctionSpace(meshf, ("CG", degree))
+
+    def u(values, x):
+        values[:, 0] = 1.0 + x[:, 0] + 2.0 * x[:, 1]
+
+    mat = PETScDMCollection.create_transfer_matrix(Vc._cpp_object,
+                                                   Vf._cpp_object)
+    assert mat.getSize() == (Vf.dim(), Vc.dim())
+
+    Vuc = Function(Vf)
+    mat.mult(interpolate(u, Vc).vector(), Vuc.vector())
+
+    diff = Vuc.vector()
+    diff.axpy(-1, interpolate(u, Vf).vector())
+    assert diff.norm() < 1.0e-12
+
+
 @pytest.mark.xfail
 def test_taylor_hood_cube():
     pytest.xfail("Problem with Mixed Function Spaces")
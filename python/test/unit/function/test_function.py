@@ -16,7 +16,7 @@ from dolfin_utils.test.skips import skip_if_complex, skip_in_parallel
 from petsc4py import PETSc
 
 import ufl
-from dolfin import (MPI, Function, FunctionSpace, TensorFunctionSpace,
+from dolfin import (MPI, Cells, Function, FunctionSpace, TensorFunctionSpace,
                     UnitCubeMesh, VectorFunctionSpace, Vertex, cpp,
                     interpolate)
 
@@ -282,6 +282,26 @@ def test_interpolation_rank1(W):
     assert x.min()[1] == 1.0
 
 
+def test_migrate(mesh):
+    def f(values, x):
+        values[:, 0] = x[:, 0] + 2 * x[:, 1] + 3 * x[:, 2]
+
+    V = FunctionSpace(mesh, ('CG', 2))
+    u = interpolate(f, V)
+    u.vector().ghostUpdate(addv=PETSc.InsertMode.INSERT,
+                           mode=PETSc.ScatterMode.FORWARD)
+
+    # Rebalance with more expensive cells near x = 0
+    num_owned = mesh.topology.ghost_offset(mesh.topology.dim)
+    weights = [10 if c.midpoint()[0] < 0.3 else 1 for c in Cells(mesh)]
+    mesh1, plan = cpp.mesh.rebalance(mesh, weights[:num_owned], "Hilbert")
+
+    # Coefficients are copied, so match interpolation on the new mesh
+    V1 = FunctionSpace(mesh1, ('CG', 2))
+    u1 = u.migrate(plan, V1)
+    assert np.allclose(u1.vector().array, interpolate(f, V1).vector().array)
+
+
 @skip_in_parallel
 def test_interpolation_old(V, W, mesh):
     def f0(values, x):
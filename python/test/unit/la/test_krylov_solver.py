@@ -12,6 +12,7 @@ import numpy as np
 import pytest
 
 import ufl
+from dolfin import cpp
 from dolfin import (MPI, DirichletBC, Function, FunctionSpace, TestFunction,
                     TrialFunction, UnitSquareMesh, VectorFunctionSpace)
 from dolfin.fem import apply_lifting, assemble_matrix, assemble_vector, set_bc
@@ -48,6 +49,91 @@ def test_krylov_solver_lu():
     assert round(x.norm(PETSc.NormType.N2) - norm, 12) == 0
 
 
+def test_krylov_solver_multiple_rhs():
+    """Test PETScKrylovSolver with multiple right-hand sides"""
+    mesh = UnitSquareMesh(MPI.comm_world, 12, 12)
+    V = FunctionSpace(mesh, ("Lagrange", 1))
+    u, v = TrialFunction(V), TestFunction(V)
+
+    a = inner(u, v) * dx + inner(grad(u), grad(v)) * dx
+    A = assemble_matrix(a)
+    A.assemble()
+
+    # Right-hand sides
+    B = cpp.la.create_multivector(V.dofmap().index_map, 3)
+    b = []
+    for j in range(3):
+        L = inner(float(j + 1), v) * dx
+        bj = assemble_vector(L)
+        bj.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+        b.append(bj)
+        r0, r1 = bj.getOwnershipRange()
+        B.setValues(range(r0, r1), [j], bj.array_r, addv=PETSc.InsertMode.INSERT)
+    B.assemble()
+    X = B.duplicate()
+
+    solver = PETScKrylovSolver(mesh.mpi_comm())
+    solver.set_options_prefix("test_multirhs_")
+    PETScOptions.set("test_multirhs_ksp_type", "cg")
+    PETScOptions.set("test_multirhs_pc_type", "jacobi")
+    PETScOptions.set("test_multirhs_ksp_rtol", 1.0e-12)
+    solver.set_from_options()
+    solver.set_operator(A)
+    solver.solve(X, B)
+
+    # Compare each column to a single right-hand side solve
+    for j in range(3):
+        x = A.createVecRight()
+        solver.solve(x, b[j])
+        xj = X.getColumnVector(j)
+        xj.axpy(-1.0, x)
+        assert xj.norm() < 1.0e-8 * x.norm()
+
+
+def test_krylov_solver_multiple_rhs_shell():
+    """Test PETScKrylovSolver with multiple right-hand sides and a
+    shell (matrix-free) operator"""
+    mesh = UnitSquareMesh(MPI.comm_world, 12, 12)
+    V = FunctionSpace(mesh, ("Lagrange", 1))
+    u, v = TrialFunction(V), TestFunction(V)
+
+    a = inner(u, v) * dx + inner(grad(u), grad(v)) * dx
+    A = assemble_matrix(a)
+    A.assemble()
+
+    class Operator:
+        def mult(self, mat, x, y):
+            A.mult(x, y)
+
+    S = PETSc.Mat().createPython(A.getSizes(), Operator(), comm=A.comm)
+    S.setUp()
+
+    B = cpp.la.create_multivector(V.dofmap().index_map, 2)
+    r0, r1 = B.getOwnershipRange()
+    for j in range(2):
+        B.setValues(range(r0, r1), [j], np.full(r1 - r0, float(j + 1)),
+                    addv=PETSc.InsertMode.INSERT)
+    B.assemble()
+    X = B.duplicate()
+
+    solver = PETScKrylovSolver(mesh.mpi_comm())
+    solver.set_options_prefix("test_multirhs_shell_")
+    PETScOptions.set("test_multirhs_shell_ksp_type", "cg")
+    PETScOptions.set("test_multirhs_shell_pc_type", "none")
+    PETScOptions.set("test_multirhs_shell_ksp_rtol", 1.0e-12)
+    solver.set_from_options()
+    solver.set_operator(S)
+    assert solver.solve(X, B) > 0
+
+    # Residual of each column with the assembled operator
+    for j in range(2):
+        xj, bj = X.getColumnVector(j), B.getColumnVector(j)
+        r = bj.copy()
+        A.mult(xj, r)
+        r.axpy(-1.0, bj)
+        assert r.norm() < 1.0e-8 * bj.norm()
+
+
 @pytest.mark.skip
 def test_krylov_samg_solver_elasticity():
     "Test PETScKrylovSolver with smoothed aggregation AMG"
@@ -103,3 +103,69 @@ def test_ghost_connectivities(mode):
             cell = Cell(meshG, cidx)
             cell_mp = tuple(cell.midpoint()[:])
             assert cell_mp in reference[facet_mp]
+
+
+@pytest.mark.parametrize("mode", [cpp.mesh.GhostMode.none,
+                                  cpp.mesh.GhostMode.shared_vertex,
+                                  cpp.mesh.GhostMode.shared_facet])
+@pytest.mark.parametrize("cell_type", [cpp.mesh.CellType.Type.triangle,
+                                       cpp.mesh.CellType.Type.quadrilateral,
+                                       cpp.mesh.CellType.Type.tetrahedron,
+                                       cpp.mesh.CellType.Type.hexahedron])
+def test_ghost_block_partitioner(mode, cell_type):
+    N = 2 * MPI.size(MPI.comm_world)
+    if cell_type in (cpp.mesh.CellType.Type.triangle, cpp.mesh.CellType.Type.quadrilateral):
+        mesh = UnitSquareMesh(MPI.comm_world, 3, N, cell_type, mode, partitioner="block")
+        num_vertices, num_cells = 4 * (N + 1), 3 * N
+    else:
+        mesh = UnitCubeMesh(MPI.comm_world, 3, 2, N, cell_type, mode, partitioner="block")
+        num_vertices, num_cells = 12 * (N + 1), 6 * N
+    if cell_type == cpp.mesh.CellType.Type.triangle:
+        num_cells *= 2
+    elif cell_type == cpp.mesh.CellType.Type.tetrahedron:
+        num_cells *= 6
+
+    tdim = mesh.topology.dim
+    assert mesh.num_entities_global(0) == num_vertices
+    assert mesh.num_entities_global(tdim) == num_cells
+
+    # Owned cells are split evenly by layers
+    num_owned = mesh.topology.ghost_offset(tdim)
+    assert num_owned == num_cells // MPI.size(mesh.mpi_comm())
+    if MPI.size(mesh.mpi_comm()) > 1 and mode != cpp.mesh.GhostMode.none:
+        assert mesh.num_cells() > num_owned
+    else:
+        assert mesh.num_cells() == num_owned
+
+
+@pytest.mark.parametrize("mode", [cpp.mesh.GhostMode.none,
+                                  pytest.param(cpp.mesh.GhostMode.shared_vertex,
+                                               marks=pytest.mark.xfail(condition=MPI.size(MPI.comm_world) == 1,
+                                                                       reason="Shared ghost modes fail in serial")),
+                                  pytest.param(cpp.mesh.GhostMode.shared_facet,
+                                               marks=pytest.mark.xfail(condition=MPI.size(MPI.comm_world) == 1,
+                                                                       reason="Shared ghost modes fail in serial"))])
+@pytest.mark.parametrize("cell_type", [cpp.mesh.CellType.Type.triangle,
+                                       cpp.mesh.CellType.Type.quadrilateral,
+                                       cpp.mesh.CellType.Type.tetrahedron,
+                                       cpp.mesh.CellType.Type.hexahedron])
+def test_ghost_hilbert_partitioner(mode, cell_type):
+    if cell_type in (cpp.mesh.CellType.Type.triangle, cpp.mesh.CellType.Type.quadrilateral):
+        mesh = UnitSquareMesh(MPI.comm_world, 5, 7, cell_type, mode, partitioner="Hilbert")
+        num_vertices, num_cells = 6 * 8, 5 * 7
+    else:
+        mesh = UnitCubeMesh(MPI.comm_world, 3, 4, 5, cell_type, mode, partitioner="Hilbert")
+        num_vertices, num_cells = 4 * 5 * 6, 3 * 4 * 5
+    if cell_type == cpp.mesh.CellType.Type.triangle:
+        num_cells *= 2
+    elif cell_type == cpp.mesh.CellType.Type.tetrahedron:
+        num_cells *= 6
+
+    tdim = mesh.topology.dim
+    assert mesh.num_entities_global(0) == num_vertices
+    assert mesh.num_entities_global(tdim) == num_cells
+
+    # Owned cells are balanced to within one cell
+    num_owned = mesh.topology.ghost_offset(tdim)
+    size = MPI.size(mesh.mpi_comm())
+    assert num_cells // size <= num_owned <= -(-num_cells // size)
@@ -18,7 +18,7 @@ from dolfin import (MPI, BoxMesh, Cell, Cells, CellType, MeshEntities,
                     cpp)
 from dolfin.io import XDMFFile
 from dolfin_utils.test.fixtures import fixture
-from dolfin_utils.test.skips import skip_in_parallel
+from dolfin_utils.test.skips import skip_in_parallel, skip_in_serial
 
 
 @fixture
@@ -575,3 +575,195 @@ def test_small_mesh(interval):
     mesh1d = UnitIntervalMesh(MPI.comm_world, 2)
     gdim = mesh1d.geometry.dim
     assert mesh1d.num_entities_global(gdim) == 2
+
+
+@pytest.mark.parametrize("reordering", [cpp.mesh.CellReordering.none,
+                                        cpp.mesh.CellReordering.hilbert,
+                                        cpp.mesh.CellReordering.reverse_cuthill_mckee])
+def test_cell_reordering(reordering):
+    mesh0 = UnitCubeMesh(MPI.comm_self, 4, 3, 5)
+    points, cells = mesh0.geometry.points, mesh0.cells()
+    mesh1 = cpp.mesh.Partitioning.build_distributed_mesh(
+        MPI.comm_self, CellType.Type.tetrahedron, points, cells,
+        list(range(cells.shape[0])), cpp.mesh.GhostMode.none,
+        cell_reordering=reordering)
+    assert mesh1.num_entities(3) == mesh0.num_entities(3)
+    assert mesh1.num_entities(0) == mesh0.num_entities(0)
+
+    # Check that each cell has the same vertices and coordinates as the
+    # original cell with the same global index
+    cell_indices = mesh1.topology.global_indices(3)
+    vertex_indices = mesh1.topology.global_indices(0)
+    for c, cell in enumerate(mesh1.cells()):
+        cell0 = cells[cell_indices[c]]
+        assert numpy.array_equal(vertex_indices[cell], cell0)
+        assert numpy.allclose(mesh1.geometry.points[cell], points[cell0])
+
+
+def test_cell_weights():
+    # Create all cells on process 0, with cells in the left half of the
+    # domain four times as expensive as the others
+    mesh0 = UnitCubeMesh(MPI.comm_self, 4, 3, 5)
+    points, cells = mesh0.geometry.points, mesh0.cells()
+    midpoints = numpy.array([c.midpoint()[0] for c in Cells(mesh0)])
+    weights = numpy.where(midpoints < 0.5, 4, 1)
+    if MPI.rank(MPI.comm_world) > 0:
+        points, cells = points[:0], cells[:0]
+    mesh1 = cpp.mesh.Partitioning.build_distributed_mesh(
+        MPI.comm_world, CellType.Type.tetrahedron, points, cells,
+        list(range(cells.shape[0])), cpp.mesh.GhostMode.none,
+        graph_partitioner="Hilbert", cell_weights=list(weights[:cells.shape[0]]))
+    assert mesh1.num_entities_global(3) == mesh0.num_entities(3)
+
+    # The owned cells of each process have the same total weight (to
+    # within one cell)
+    local_weight = weights[mesh1.topology.global_indices(3)].sum()
+    average_weight = weights.sum() / MPI.size(mesh1.mpi_comm())
+    assert abs(local_weight - average_weight) <= weights.max()
+
+
+@skip_in_serial
+@pytest.mark.parametrize("ghost_mode", [cpp.mesh.GhostMode.shared_facet,
+                                        cpp.mesh.GhostMode.shared_vertex])
+def test_ghost_layers(ghost_mode):
+    mesh0 = UnitCubeMesh(MPI.comm_self, 6, 5, 4)
+    points, cells = mesh0.geometry.points, mesh0.cells()
+    if MPI.rank(MPI.comm_world) > 0:
+        points, cells = points[:0], cells[:0]
+    mesh1 = cpp.mesh.Partitioning.build_distributed_mesh(
+        MPI.comm_world, CellType.Type.tetrahedron, points, cells,
+        list(range(cells.shape[0])), ghost_mode,
+        graph_partitioner="Hilbert", num_ghost_layers=3)
+    assert mesh1.num_entities_global(3) == mesh0.num_entities(3)
+
+    # Ghost cells are ordered by layer
+    offsets = mesh1.topology.ghost_layer_offsets()
+    assert len(offsets) == 4
+    assert offsets[0] == mesh1.topology.ghost_offset(3)
+    assert offsets[-1] == mesh1.num_cells()
+    assert all(numpy.diff(offsets) >= 0)
+
+    # Each ghost cell is connected to a cell in the previous layer
+    tdim = mesh1.topology.dim
+    num_common = 3 if ghost_mode == cpp.mesh.GhostMode.shared_facet else 1
+    vertices = [set(cell) for cell in mesh1.cells()]
+    for layer in range(1, 4):
+        for c in range(offsets[layer - 1], offsets[layer]):
+            inner = range(0 if layer == 1 else offsets[layer - 2],
+                          offsets[layer - 1])
+            assert any(len(vertices[c] & vertices[d]) >= num_common
+                       for d in inner)
+
+    # Ghost cells are shared with their owner
+    shared_cells = mesh1.topology.shared_entities(tdim)
+    owners = mesh1.topology.cell_owner()
+    for c in range(offsets[0], offsets[-1]):
+        assert owners[c - offsets[0]] in shared_cells[c]
+
+
+def test_rebalance():
+    # Cells with x < 0.3 are ten times as expensive as the others
+    mesh0 = UnitCubeMesh(MPI.comm_world, 6, 5, 4)
+    tdim = mesh0.topology.dim
+    num_owned = mesh0.topology.ghost_offset(tdim)
+    midpoints = numpy.array([c.midpoint()[0] for c in Cells(mesh0)])
+    weights = numpy.where(midpoints[:num_owned] < 0.3, 10, 1)
+
+    cell_markers = MeshFunction("size_t", mesh0, tdim, 0)
+    cell_markers.array()[:] = mesh0.topology.global_indices(tdim)
+    vertex_markers = MeshFunction("size_t", mesh0, 0, 0)
+    vertex_markers.array()[:] = mesh0.topology.global_indices(0)
+
+    mesh1, plan = cpp.mesh.rebalance(mesh0, list(weights), "Hilbert")
+    assert mesh1.num_entities_global(tdim) == mesh0.num_entities_global(tdim)
+    assert mesh1.num_entities_global(0) == mesh0.num_entities_global(0)
+    assert plan.num_cells_new() == mesh1.num_entities(tdim)
+
+    # The owned cells of each process have the same total weight (to
+    # within one cell)
+    num_owned = mesh1.topology.ghost_offset(tdim)
+    midpoints = numpy.array([c.midpoint()[0] for c in Cells(mesh1)])
+    local_weight = numpy.where(midpoints[:num_owned] < 0.3, 10, 1).sum()
+    average_weight = MPI.sum(mesh1.mpi_comm(), float(weights.sum())) / MPI.size(
+        mesh1.mpi_comm())
+    assert abs(local_weight - average_weight) <= weights.max()
+
+    # Mesh functions follow the cells and vertices
+    cell_markers1 = plan.migrate(cell_markers, mesh1)
+    assert (cell_markers1.array() == mesh1.topology.global_indices(tdim)).all()
+    vertex_markers1 = plan.migrate(vertex_markers, mesh1)
+    assert (vertex_markers1.array() == mesh1.topology.global_indices(0)).all()
+
+
+def test_connectivity_lease():
+    mesh = UnitCubeMesh(MPI.comm_world, 3, 3, 3)
+    topology = mesh.topology
+    assert topology.connectivity(1, 0) is None
+
+    # Edges are freed when the last lease is released
+    with cpp.mesh.ConnectivityLease(mesh, 1, 3) as lease0:
+        num_edges = mesh.num_entities(1)
+        assert lease0.connectivity().size(0) > 0
+        lease1 = cpp.mesh.ConnectivityLease(mesh, 1, 0)
+        assert topology.num_connectivity_leases(1, 0) == 2
+    assert topology.connectivity(1, 0) is not None
+    lease1.release()
+    assert topology.connectivity(1, 0) is None
+    assert topology.connectivity(1, 3) is None
+    assert topology.connectivity(3, 1) is None
+
+    # Pinned connectivities are kept
+    with cpp.mesh.ConnectivityLease(mesh, 1, 3) as lease:
+        lease.pin()
+    assert mesh.num_entities(1) == num_edges
+    assert topology.connectivity(1, 3) is not None
+
+    # Existing connectivities are not affected
+    with cpp.mesh.ConnectivityLease(mesh, 1, 3):
+        pass
+    assert topology.connectivity(1, 3) is not None
+
+
+@pytest.mark.parametrize("mesh_factory", [(UnitIntervalMesh, (MPI.comm_world, 8)),
+                                          (UnitSquareMesh, (MPI.comm_world, 4, 4)),
+                                          (UnitCubeMesh, (MPI.comm_world, 2, 2, 2))])
+def test_cell_metrics(mesh_factory):
+    func, args = mesh_factory
+    mesh = func(*args)
+    CellMetric = cpp.mesh.CellMetric
+    volume = mesh.cell_metric(CellMetric.volume)
+    h = mesh.cell_metric(CellMetric.h)
+    circumradius = mesh.cell_metric(CellMetric.circumradius)
+    inradius = mesh.cell_metric(CellMetric.inradius)
+    radius_ratio = mesh.cell_metric(CellMetric.radius_ratio)
+    for c in Cells(mesh):
+        i = c.index()
+        assert volume[i] == pytest.approx(c.volume())
+        assert h[i] == pytest.approx(c.h())
+        assert circumradius[i] == pytest.approx(c.circumradius())
+        assert inradius[i] == pytest.approx(c.inradius())
+        assert radius_ratio[i] == pytest.approx(c.radius_ratio())
+
+    tdim = mesh.topology.dim
+    mesh.create_entities(tdim - 1)
+    areas = cpp.mesh.cell_facet_areas(mesh)
+    normals = cpp.mesh.cell_facet_normals(mesh)
+    num_facets = areas.shape[1]
+    for c in Cells(mesh):
+        for i in range(num_facets):
+            assert areas[c.index(), i] == pytest.approx(c.facet_area(i))
+            assert numpy.allclose(normals[c.index() * num_facets + i],
+                                  c.normal(i))
+
+    # Cached values are recomputed when the geometry changes
+    hmin = mesh.hmin()
+    mesh.geometry.points[:] *= 2.0
+    assert mesh.hmin() == pytest.approx(2.0 * hmin)
+
+    # Writes through a kept view must be marked
+    x = mesh.geometry.points
+    rmax = mesh.rmax()
+    x *= 0.5
+    mesh.geometry.mark_modified()
+    assert mesh.hmin() == pytest.approx(hmin)
+    assert mesh.rmax() == pytest.approx(0.5 * rmax)
@@ -4,8 +4,15 @@
 #
 # SPDX-License-Identifier:    LGPL-3.0-or-later
 
-from dolfin import UnitSquareMesh, UnitCubeMesh, MPI
-from dolfin.cpp.refinement import refine
+import numpy as np
+import pytest
+from dolfin_utils.test.skips import skip_in_parallel
+
+from dolfin import (MPI, Cells, Function, FunctionSpace, UnitCubeMesh,
+                    UnitSquareMesh, VectorFunctionSpace, cpp, interpolate)
+from dolfin.cpp.fem import PETScDMCollection
+from dolfin.cpp.refinement import (MeshHierarchy, interpolate_to_refined,
+                                   refine, refine_with_parents)
 
 
 def test_RefineUnitSquareMesh():
@@ -22,3 +29,135 @@ def test_RefineUnitCubeMesh():
     mesh = refine(mesh, False)
     assert mesh.num_entities_global(0) == 3135
     assert mesh.num_entities_global(3) == 15120
+
+
+@pytest.mark.parametrize("mode", [
+    cpp.mesh.GhostMode.none,
+    pytest.param(cpp.mesh.GhostMode.shared_facet,
+                 marks=pytest.mark.xfail(condition=MPI.size(MPI.comm_world) == 1,
+                                         reason="Shared ghost modes fail in serial")),
+    pytest.param(cpp.mesh.GhostMode.shared_vertex,
+                 marks=pytest.mark.xfail(condition=MPI.size(MPI.comm_world) == 1,
+                                         reason="Shared ghost modes fail in serial"))
+])
+def test_refine_in_place(mode):
+    """Refine without redistribution: each process keeps the children
+    of its cells, including its ghost cells"""
+    mesh = UnitCubeMesh(MPI.comm_world, 4, 3, 5, ghost_mode=mode)
+    mesh1 = refine(mesh, False)
+    assert mesh1.num_entities_global(3) == 8 * mesh.num_entities_global(3)
+    assert mesh1.topology.ghost_offset(3) == 8 * mesh.topology.ghost_offset(3)
+    assert mesh1.num_entities(3) == 8 * mesh.num_entities(3)
+
+
+@skip_in_parallel
+@pytest.mark.parametrize("mesh", [
+    UnitSquareMesh(MPI.comm_world, 3, 4),
+    UnitCubeMesh(MPI.comm_world, 2, 3, 2)
+])
+def test_refine_with_parents(mesh):
+    """Check that each cell of a uniformly refined mesh lies inside its
+    parent cell"""
+    tdim = mesh.topology.dim
+    mesh1, parent_cells, parent_facets = refine_with_parents(mesh, False)
+    assert len(parent_cells) == mesh1.num_entities(tdim)
+    assert len(parent_facets) == mesh1.num_entities(tdim - 1)
+    assert np.all(np.bincount(parent_cells) == 2**tdim)
+    assert np.all(np.array(parent_facets) < mesh.num_entities(tdim - 1))
+
+    points = mesh.geometry.points[:, :tdim]
+    cells = mesh.cells()
+    for c in Cells(mesh1):
+        x = points[cells[parent_cells[c.index()]]]
+        A = (x[1:] - x[0]).T
+        b = np.linalg.solve(A, c.midpoint()[:tdim] - x[0])
+        assert np.all(b > 0.0) and b.sum() < 1.0
+
+
+@pytest.mark.parametrize("mode", [
+    cpp.mesh.GhostMode.none,
+    pytest.param(cpp.mesh.GhostMode.shared_facet,
+                 marks=pytest.mark.xfail(condition=MPI.size(MPI.comm_world) == 1,
+                                         reason="Shared ghost modes fail in serial"))
+])
+@pytest.mark.parametrize("degree", [1, 2])
+@pytest.mark.parametrize("create_mesh", [
+    lambda mode: UnitSquareMesh(MPI.comm_world, 3, 4, ghost_mode=mode),
+    lambda mode: UnitCubeMesh(MPI.comm_world, 2, 3, 2, ghost_mode=mode)
+])
+def test_interpolate_to_refined(create_mesh, degree, mode):
+    """Transfer a linear function to a space of the given degree on the
+    refined mesh. The ghost values of the result are updated."""
+    def f(values, x):
+        values[:, 0] = 1.0 + x[:, 0] + 2 * x[:, 1]
+
+    mesh = create_mesh(mode)
+    u = interpolate(f, FunctionSpace(mesh, ('CG', 1)))
+    mesh1, parent_cells, parent_facets = refine_with_parents(mesh)
+    V1 = FunctionSpace(mesh1, ('CG', degree))
+    u1 = interpolate_to_refined(u._cpp_object, V1._cpp_object, parent_cells)
+    uf = interpolate(f, V1)
+    with u1.vector().localForm() as u1_local, \
+            uf.vector().localForm() as uf_local:
+        assert np.allclose(u1_local.array, uf_local.array)
+
+
+@pytest.mark.parametrize("mode", [
+    cpp.mesh.GhostMode.none,
+    pytest.param(cpp.mesh.GhostMode.shared_facet,
+                 marks=pytest.mark.xfail(condition=MPI.size(MPI.comm_world) == 1,
+                                         reason="Shared ghost modes fail in serial"))
+])
+@pytest.mark.parametrize("space", [
+    lambda mesh: FunctionSpace(mesh, ("CG", 1)),
+    lambda mesh: FunctionSpace(mesh, ("CG", 2)),
+    lambda mesh: VectorFunctionSpace(mesh, ("CG", 1))
+])
+@pytest.mark.parametrize("create_mesh", [
+    lambda mode: UnitSquareMesh(MPI.comm_world, 3, 4, ghost_mode=mode),
+    lambda mode: UnitCubeMesh(MPI.comm_world, 2, 3, 2, ghost_mode=mode)
+])
+def test_mesh_hierarchy_prolongation(create_mesh, space, mode):
+    """Prolongate a linear function through the levels of a mesh
+    hierarchy. Linear functions are in every space, so the prolongation
+    must reproduce them exactly."""
+    def f(values, x):
+        for i in range(values.shape[1]):
+            values[:, i] = 1.0 + i + x[:, 0] + 2 * x[:, 1] - 0.5 * x[:, i]
+
+    mesh = create_mesh(mode)
+    hierarchy = MeshHierarchy(mesh, 2)
+    assert hierarchy.num_levels() == 3
+    tdim = mesh.topology.dim
+    for i in range(1, 3):
+        assert hierarchy.mesh(i).num_entities_global(tdim) \
+            == 2**(tdim * i) * mesh.num_entities_global(tdim)
+
+    spaces = [space(hierarchy.mesh(i)) for i in range(3)]
+    u = interpolate(f, spaces[0])
+    for i in range(1, 3):
+        P = hierarchy.create_prolongation(spaces[i - 1]._cpp_object,
+                                          spaces[i]._cpp_object)
+        assert P.getSize() == (spaces[i].dim(), spaces[i - 1].dim())
+        u1 = Function(spaces[i])
+        P.mult(u.vector(), u1.vector())
+        diff = u1.vector()
+        diff.axpy(-1, interpolate(f, spaces[i]).vector())
+        assert diff.norm() < 1.0e-12
+        u = u1
+
+
+def test_mesh_hierarchy_transfer_matrix():
+    """Compare the prolongation of a mesh hierarchy with the transfer
+    matrix from point location"""
+    hierarchy = MeshHierarchy(UnitSquareMesh(MPI.comm_world, 5, 4), 1)
+    V0 = VectorFunctionSpace(hierarchy.mesh(0), ("CG", 1))
+    V1 = VectorFunctionSpace(hierarchy.mesh(1), ("CG", 1))
+    P = hierarchy.create_prolongation(V0._cpp_object, V1._cpp_object)
+    Q = PETScDMCollection.create_transfer_matrix(V0._cpp_object,
+                                                 V1._cpp_object)
+    Q.axpy(-1, P)
+    assert Q.norm() < 1.0e-12
+
+    dms = hierarchy.create_dm_collection([V0._cpp_object, V1._cpp_object])
+    assert dms.get_dm(0) is not None
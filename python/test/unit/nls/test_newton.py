@@ -6,6 +6,7 @@
 """Unit tests for Newton solver assembly"""
 
 import numpy as np
+import pytest
 from petsc4py import PETSc
 
 import dolfin
@@ -160,6 +161,164 @@ def test_nonlinear_pde():
     assert n < 6
 
 
+def boundary(x, only_boundary):
+    """Define Dirichlet boundary (x = 0 or x = 1)."""
+    return np.logical_or(x[:, 0] < 1.0e-8, x[:, 0] > 1.0 - 1.0e-8)
+
+
+def set_vector(x, value):
+    """Set all entries of a vector, including ghosts."""
+    x.set(value)
+    x.ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+
+
+@pytest.fixture
+def nonlinear_pde():
+    """Nonlinear PDE problem of test_nonlinear_pde. Returns the
+    problem, the solution u and the boundary value u_bc."""
+    mesh = dolfin.generation.UnitSquareMesh(dolfin.MPI.comm_world, 12, 5)
+    V = dolfin.function.FunctionSpace(mesh, ("Lagrange", 1))
+    u = dolfin.function.Function(V)
+    v = function.TestFunction(V)
+    F = inner(5.0, v) * dx - ufl.sqrt(u * u) * inner(
+        grad(u), grad(v)) * dx - inner(u, v) * dx
+
+    u_bc = function.Function(V)
+    set_vector(u_bc.vector(), 1.0)
+    bc = fem.DirichletBC(V, u_bc, boundary)
+
+    return NonlinearPDEProblem(F, u, bc), u, u_bc
+
+
+def create_krylov_newton_solver():
+    """Newton solver with GMRES and Jacobi preconditioning"""
+    solver = dolfin.cpp.nls.NewtonSolver(dolfin.MPI.comm_world)
+    ksp = solver.get_krylov_solver().ksp()
+    ksp.setType("gmres")
+    ksp.getPC().setType("jacobi")
+    ksp.setTolerances(rtol=1.0e-10, max_it=1000)
+    return solver
+
+
+def test_nonlinear_pde_lagged(nonlinear_pde):
+    """Test Newton solver with lagged Jacobian and preconditioner"""
+    problem, u, u_bc = nonlinear_pde
+
+    set_vector(u.vector(), 0.9)
+    solver = dolfin.cpp.nls.NewtonSolver(dolfin.MPI.comm_world)
+    solver.lag_jacobian = 2
+    solver.lag_preconditioner = -1
+    solver.lag_preconditioner_persists = True
+    solver.lag_rebuild_rate = 0.9
+    n, converged = solver.solve(problem, u.vector())
+    assert converged
+    assert solver.jacobian_evaluations() <= n
+    assert solver.preconditioner_setups() <= solver.jacobian_evaluations()
+
+    # Solve again, keeping the preconditioner from the first solve
+    set_vector(u_bc.vector(), 0.5)
+    n, converged = solver.solve(problem, u.vector())
+    assert converged
+    assert solver.jacobian_evaluations() <= n
+
+
+@pytest.mark.parametrize("forcing", [dolfin.cpp.nls.NewtonSolver.ForcingTerm.eisenstat_walker_1,
+                                     dolfin.cpp.nls.NewtonSolver.ForcingTerm.eisenstat_walker_2])
+def test_nonlinear_pde_forcing(nonlinear_pde, forcing):
+    """Test inexact Newton solver with Eisenstat-Walker forcing terms"""
+    problem, u, u_bc = nonlinear_pde
+
+    def solve(forcing_term):
+        set_vector(u.vector(), 0.9)
+        solver = create_krylov_newton_solver()
+        solver.forcing_term = forcing_term
+        solver.max_it = 20
+        n, converged = solver.solve(problem, u.vector())
+        assert converged
+        return n, solver.krylov_iterations()
+
+    # The adapted linear solver tolerance needs fewer Krylov
+    # iterations than the fixed tolerance, while Newton still converges
+    n_fixed, krylov_fixed = solve(dolfin.cpp.nls.NewtonSolver.ForcingTerm.fixed)
+    n, krylov = solve(forcing)
+    assert n < 20
+    assert krylov < krylov_fixed
+
+
+def test_nonlinear_pde_jacobian_free(nonlinear_pde):
+    """Test Jacobian-free Newton-Krylov solver, with the assembled
+    Jacobian used only as the preconditioner"""
+    problem, u, u_bc = nonlinear_pde
+
+    def solve(jacobian_free):
+        set_vector(u.vector(), 0.9)
+        solver = create_krylov_newton_solver()
+        solver.jacobian_free = jacobian_free
+        solver.rtol = 1.0e-8
+        n, converged = solver.solve(problem, u.vector())
+        assert converged
+        return n, solver.krylov_iterations()
+
+    # The Krylov solver applies the finite difference Jacobian, which
+    # should give (nearly) the same Newton iterations as the assembled
+    # Jacobian
+    n_assembled, krylov_assembled = solve(False)
+    n, krylov = solve(True)
+    assert n < 10
+    assert abs(n - n_assembled) <= 1
+    assert krylov > n
+
+
+@pytest.mark.parametrize("line_search", [dolfin.cpp.nls.NewtonSolver.LineSearch.backtracking,
+                                         dolfin.cpp.nls.NewtonSolver.LineSearch.critical_point])
+def test_nonlinear_pde_line_search(line_search):
+    """Test Newton solver with line search on a problem where the full
+    Newton step overshoots"""
+    # For atan(u) = 0 the Newton step from |u| > 1.39 lands further
+    # from the root than the starting point
+    mesh = dolfin.generation.UnitSquareMesh(dolfin.MPI.comm_world, 12, 5)
+    V = dolfin.function.FunctionSpace(mesh, ("Lagrange", 1))
+    u = dolfin.function.Function(V)
+    v = function.TestFunction(V)
+    F = inner(ufl.atan(u), v) * dx + 1.0e-4 * inner(grad(u), grad(v)) * dx
+
+    u_bc = function.Function(V)
+    set_vector(u_bc.vector(), 0.0)
+    bc = fem.DirichletBC(V, u_bc, boundary)
+    problem = NonlinearPDEProblem(F, u, bc)
+
+    def solve(line_search, max_it):
+        set_vector(u.vector(), 3.0)
+        fem.set_bc(u.vector(), [bc])
+        u.vector().ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+        solver = dolfin.cpp.nls.NewtonSolver(dolfin.MPI.comm_world)
+        solver.line_search = line_search
+        solver.max_it = max_it
+        solver.error_on_nonconvergence = False
+        n, converged = solver.solve(problem, u.vector())
+        return solver, n, converged
+
+    # The full step increases the residual, the line search shortens
+    # it and decreases the residual
+    solver, n, converged = solve(dolfin.cpp.nls.NewtonSolver.LineSearch.basic, 1)
+    assert solver.residual() > solver.residual0()
+    assert solver.line_search_evaluations() == 0
+
+    solver, n, converged = solve(line_search, 1)
+    assert solver.residual() < solver.residual0()
+    assert solver.line_search_evaluations() > 0
+
+    # Without the line search Newton diverges from this initial guess
+    solver, n, converged = solve(dolfin.cpp.nls.NewtonSolver.LineSearch.basic, 3)
+    assert not converged
+    assert solver.residual() > solver.residual0()
+
+    solver, n, converged = solve(line_search, 20)
+    assert converged
+    assert n < 20
+    assert solver.line_search_evaluations() > 0
+
+
 def test_nonlinear_pde_snes():
     """Test Newton solver for a simple nonlinear PDE"""
     # Create mesh and function space